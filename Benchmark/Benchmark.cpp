@@ -0,0 +1,144 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <ctime>
+
+volatile uint64_t Benchmark::sink = 0;
+
+void Benchmark::Run::Measure(const std::function<uint64_t()>& work)
+{
+	typedef std::chrono::high_resolution_clock Clock;
+
+	// Warm up caches and lazily created data, then grow batch until it fills whole sample
+	uint64_t items = work();
+	uint64_t batch = 1;
+	for (;;)
+	{
+		const auto start = Clock::now();
+		for (uint64_t i = 0; i < batch; ++i)
+			items = work();
+		const double time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		if (time >= sampleTime || batch >= (1ULL << 30))
+			break;
+		batch = time <= sampleTime / 16.0 ? batch * 16 : batch * 2;
+	}
+
+	std::vector<double> times;
+	times.reserve(sampleCount);
+	for (uint64_t sample = 0; sample < sampleCount; ++sample)
+	{
+		const auto start = Clock::now();
+		for (uint64_t i = 0; i < batch; ++i)
+			work();
+		times.emplace_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(batch));
+	}
+	std::sort(times.begin(), times.end());
+
+	result.batch = batch;
+	result.samples = sampleCount;
+	result.items = items;
+	result.min = times.front();
+	result.median = times.at(times.size() / 2);
+	double sum = 0.0;
+	for (double time : times)
+		sum += time;
+	result.mean = sum / static_cast<double>(times.size());
+	result.itemsPerSecond = result.median > 0.0 ? static_cast<double>(items) * 1e9 / result.median : 0.0;
+}
+
+void Benchmark::Run::MeasureOnce(const std::function<uint64_t()>& work)
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+	const uint64_t items = work();
+	const double time = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+
+	result.batch = 1;
+	result.samples = 1;
+	result.items = items;
+	result.min = result.median = result.mean = time;
+	result.itemsPerSecond = time > 0.0 ? static_cast<double>(items) * 1e9 / time : 0.0;
+}
+
+size_t Benchmark::Execute()
+{
+	results.clear();
+	failures.clear();
+	for (const auto& benchCase : cases)
+	{
+		if (options.filter.size() && benchCase.name.find(options.filter) == std::string::npos)
+			continue;
+		Result result;
+		result.name = benchCase.name;
+		Run run(result, options.sampleTime, options.samples < 1 ? 1 : options.samples);
+		try
+		{
+			benchCase.body(run);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "[" << benchCase.name << "] failed: " << e.what() << std::endl;
+			failures.emplace_back(benchCase.name);
+			continue;
+		}
+		for (const auto& error : result.errors)
+			std::cerr << "[" << benchCase.name << "] check failed: " << error << std::endl;
+		if (result.errors.size())
+			failures.emplace_back(benchCase.name);
+		std::cerr << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(16) << result.median << " ns" << std::endl;
+		results.emplace_back(std::move(result));
+	}
+	return failures.size();
+}
+
+void Benchmark::Print() const
+{
+	std::cout << std::left << std::setw(40) << "Case" << std::right
+		<< std::setw(16) << "Median [ns]" << std::setw(16) << "Min [ns]" << std::setw(18) << "Items/s" << std::endl;
+	for (const auto& result : results)
+	{
+		std::cout << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(16) << result.median << std::setw(16) << result.min
+			<< std::setw(18) << std::setprecision(0) << result.itemsPerSecond << std::endl;
+		for (const auto& metric : result.metrics)
+			std::cout << "    " << std::left << std::setw(36) << metric.first << std::right
+				<< std::setprecision(6) << std::setw(16) << metric.second << std::endl;
+	}
+}
+
+json::json Benchmark::ToJson() const
+{
+	json::json document;
+	document["timestamp"] = static_cast<int64_t>(std::time(nullptr));
+	document["sampleTime"] = options.sampleTime;
+	document["samples"] = options.samples;
+	document["exhaustive"] = options.exhaustive;
+#if IS_DEBUG
+	document["configuration"] = "Debug";
+#else
+	document["configuration"] = "Release";
+#endif
+
+	json::json& list = document["results"] = json::json::array();
+	for (const auto& result : results)
+	{
+		json::json entry;
+		entry["name"] = result.name;
+		entry["batch"] = result.batch;
+		entry["samples"] = result.samples;
+		entry["medianNs"] = result.median;
+		entry["minNs"] = result.min;
+		entry["meanNs"] = result.mean;
+		entry["items"] = result.items;
+		entry["itemsPerSecond"] = result.itemsPerSecond;
+		entry["metrics"] = json::json::object();
+		for (const auto& metric : result.metrics)
+			entry["metrics"][metric.first] = metric.second;
+		entry["errors"] = result.errors;
+		list.emplace_back(std::move(entry));
+	}
+	document["failures"] = failures;
+	return document;
+}
\ No newline at end of file
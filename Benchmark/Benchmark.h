@@ -0,0 +1,125 @@
+#pragma once
+#include "json.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace json = nlohmann;
+
+// Registry of CPU microbenchmarks, each case measures median time of repeated samples.
+// Results are printed as table or JSON document for tracking regressions between runs.
+class Benchmark
+{
+public:
+	struct Result
+	{
+		std::string name;
+		// Iterations executed in each sample
+		uint64_t batch = 0;
+		uint64_t samples = 0;
+		// Times of single iteration in ns
+		double median = 0.0;
+		double min = 0.0;
+		double mean = 0.0;
+		// Items processed by single iteration
+		uint64_t items = 0;
+		double itemsPerSecond = 0.0;
+		std::map<std::string, double> metrics;
+		// Descriptions of checks that did not hold
+		std::vector<std::string> errors;
+	};
+
+	class Run
+	{
+		friend class Benchmark;
+
+		Result& result;
+		double sampleTime;
+		uint64_t sampleCount;
+
+		inline Run(Result& result, double sampleTime, uint64_t sampleCount) noexcept
+			: result(result), sampleTime(sampleTime), sampleCount(sampleCount) {}
+
+	public:
+		Run(const Run&) = delete;
+		Run& operator=(const Run&) = delete;
+		~Run() = default;
+
+		// Work returns number of items processed in single call, batch size is chosen to fill sample time
+		void Measure(const std::function<uint64_t()>& work);
+		// For expensive work that is executed exactly once
+		void MeasureOnce(const std::function<uint64_t()>& work);
+		inline void Metric(const std::string& name, double value) { result.metrics[name] = value; }
+		// Marks case as failed when condition does not hold, case continues so every broken check is reported
+		inline bool Check(bool condition, const std::string& description) { if (!condition) result.errors.emplace_back(description); return condition; }
+	};
+
+	struct Options
+	{
+		// Only cases containing this text are executed
+		std::string filter = "";
+		// Minimal duration of single sample in ms
+		double sampleTime = 5.0;
+		uint64_t samples = 15;
+		// Long running precision measurements over whole input domain
+		bool exhaustive = false;
+		std::string scenePath = "";
+		std::string shaderArchive = "";
+		std::string texturePath = "";
+		// Directory with engine data (shaders, textures), enables cases running on GPU
+		std::string devicePath = "";
+		// Device cases use WARP rasterizer instead of GPU
+		bool softwareDevice = false;
+		// Output of golden scene recorded by earlier run on same kind of device, written when file does not exist yet
+		std::string baselineImage = "";
+	};
+
+private:
+	struct Case
+	{
+		std::string name;
+		std::function<void(Run&)> body;
+	};
+
+	static volatile uint64_t sink;
+
+	Options options;
+	std::vector<Case> cases;
+	std::vector<Result> results;
+	std::vector<std::string> failures;
+
+public:
+	inline Benchmark(const Options& options) noexcept : options(options) {}
+	Benchmark(const Benchmark&) = delete;
+	Benchmark& operator=(const Benchmark&) = delete;
+	~Benchmark() = default;
+
+	// Keeps results of measured work from being optimized away
+	static inline void Consume(uint64_t value) noexcept { sink = sink + value; }
+	static inline void Consume(float value) noexcept { Consume(static_cast<uint64_t>(value * 1000.0f)); }
+	// Number of requests to general heap made by whole process so far, difference around work tells its allocations
+	static uint64_t GetHeapAllocations() noexcept;
+
+	constexpr const Options& GetOptions() const noexcept { return options; }
+	constexpr const std::vector<Result>& GetResults() const noexcept { return results; }
+	constexpr const std::vector<std::string>& GetFailures() const noexcept { return failures; }
+
+	inline void Add(std::string name, std::function<void(Run&)> body) { cases.push_back({ std::move(name), std::move(body) }); }
+	// Returns number of failed cases, exceptions thrown by case or failed checks mark it as failed
+	size_t Execute();
+	void Print() const;
+	json::json ToJson() const;
+};
+
+// Suites of cases grouped by engine area
+namespace Suites
+{
+	void AddBuffers(Benchmark& bench);
+	void AddGeometry(Benchmark& bench);
+	void AddScene(Benchmark& bench);
+	void AddRendering(Benchmark& bench);
+	void AddSystems(Benchmark& bench);
+	// Needs Direct3D 11, registered only by builds defining BENCHMARK_DEVICE
+	void AddDevice(Benchmark& bench);
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "Benchmark.h"
+#include "DynamicCBuffer.h"
+#include "VertexBufferData.h"
+
+namespace Suites
+{
+	using namespace GFX::Data;
+
+	static constexpr size_t VERTEX_COUNT = 4096;
+	static constexpr size_t CASCADES = 4;
+
+	// Same shape as layouts of lighting passes
+	static CBuffer::DCBLayout MakeLayout()
+	{
+		CBuffer::DCBLayout layout;
+		layout.Add(DCBElementType::Color3, "lightColor");
+		layout.Add(DCBElementType::Float, "lightIntensity");
+		layout.Add(DCBElementType::Color3, "shadowColor");
+		layout.Add(DCBElementType::Float3, "direction");
+		layout.Add(DCBElementType::Array, "cascadeViewProjection");
+		layout["cascadeViewProjection"].InitArray(DCBElementType::Matrix, CASCADES);
+		layout.Add(DCBElementType::Array, "cascadeLightPos");
+		layout["cascadeLightPos"].InitArray(DCBElementType::Float4, CASCADES);
+		layout.Add(DCBElementType::Float4, "cascadeSplits");
+		layout.Add(DCBElementType::UInteger, "cascadeCount");
+		return layout;
+	}
+
+	static std::shared_ptr<VertexLayout> MakeVertexLayout()
+	{
+		std::shared_ptr<VertexLayout> layout = std::make_shared<VertexLayout>();
+		layout->Append(VertexAttribute::Normal).Append(VertexAttribute::Texture2D);
+		return layout;
+	}
+
+	void AddBuffers(Benchmark& bench)
+	{
+		bench.Add("DCBLayout/Finalize", [](Benchmark::Run& run)
+			{
+				// Signature is computed for every layout, codex returns already finalized one
+				run.Measure([]()
+					{
+						CBuffer::DCBLayoutFinal layout = CBuffer::DCBLayoutCodex::Resolve(MakeLayout());
+						Benchmark::Consume(static_cast<uint64_t>(layout.GetByteSize()));
+						return 1ULL;
+					});
+			});
+		bench.Add("DCBLayout/Lookup", [](Benchmark::Run& run)
+			{
+				const CBuffer::DynamicCBuffer buffer(MakeLayout());
+				run.Metric("byteSize", static_cast<double>(buffer.GetByteSize()));
+				run.Measure([&buffer]()
+					{
+						float sum = static_cast<float>(buffer["lightIntensity"]);
+						sum += static_cast<const DirectX::XMFLOAT3&>(buffer["direction"]).x;
+						sum += static_cast<const DirectX::XMFLOAT4&>(buffer["cascadeSplits"]).y;
+						for (size_t i = 0; i < CASCADES; ++i)
+							sum += static_cast<const DirectX::XMFLOAT4&>(buffer["cascadeLightPos"][i]).w;
+						Benchmark::Consume(sum);
+						return 3ULL + CASCADES;
+					});
+			});
+		bench.Add("DynamicCBuffer/Write", [](Benchmark::Run& run)
+			{
+				CBuffer::DynamicCBuffer buffer(MakeLayout());
+				DirectX::XMFLOAT4X4 matrix;
+				DirectX::XMStoreFloat4x4(&matrix, DirectX::XMMatrixIdentity());
+				run.Measure([&buffer, &matrix]()
+					{
+						buffer["lightColor"] = ColorFloat3(1.0f, 0.9f, 0.8f);
+						buffer["lightIntensity"] = 1.5f;
+						buffer["shadowColor"] = ColorFloat3(0.005f, 0.005f, 0.005f);
+						buffer["direction"] = DirectX::XMFLOAT3(0.0f, -1.0f, 0.0f);
+						for (size_t i = 0; i < CASCADES; ++i)
+						{
+							buffer["cascadeViewProjection"][i] = matrix;
+							buffer["cascadeLightPos"][i] = DirectX::XMFLOAT4(1.0f, 2.0f, 3.0f, 0.5f);
+						}
+						buffer["cascadeSplits"] = DirectX::XMFLOAT4(5.0f, 20.0f, 80.0f, 500.0f);
+						buffer["cascadeCount"] = static_cast<uint32_t>(CASCADES);
+						Benchmark::Consume(static_cast<uint64_t>(buffer.GetData()[0]));
+						return 6ULL + CASCADES * 2;
+					});
+				const CBuffer::DynamicCBuffer& written = buffer;
+				run.Check(static_cast<float>(written["lightIntensity"]) == 1.5f
+					&& static_cast<const DirectX::XMFLOAT4&>(written["cascadeLightPos"][CASCADES - 1]).w == 0.5f
+					&& static_cast<const DirectX::XMFLOAT4&>(written["cascadeSplits"]).w == 500.0f
+					&& static_cast<uint32_t>(written["cascadeCount"]) == CASCADES, "written values read back");
+			});
+
+		bench.Add("VertexLayout/Build", [](Benchmark::Run& run)
+			{
+				run.Measure([]()
+					{
+						VertexLayout layout;
+						layout.Append(VertexAttribute::Normal).Append(VertexAttribute::Texture2D).Append(VertexAttribute::Bitangent);
+						Benchmark::Consume(static_cast<uint64_t>(layout.GetLayoutCode().size() + layout.Size()));
+						return 1ULL;
+					});
+			});
+		bench.Add("VertexBufferData/EmplaceBack", [](Benchmark::Run& run)
+			{
+				const std::shared_ptr<VertexLayout> layout = MakeVertexLayout();
+				run.Measure([&layout]()
+					{
+						VertexBufferData vertices(layout);
+						vertices.Reserve(VERTEX_COUNT);
+						for (size_t i = 0; i < VERTEX_COUNT; ++i)
+						{
+							const float x = static_cast<float>(i);
+							vertices.EmplaceBack(DirectX::XMFLOAT3(x, 0.0f, 1.0f), DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f), DirectX::XMFLOAT2(x, 0.5f));
+						}
+						Benchmark::Consume(static_cast<uint64_t>(vertices.Bytes()));
+						return static_cast<uint64_t>(VERTEX_COUNT);
+					});
+			});
+		bench.Add("VertexBufferData/Fill", [](Benchmark::Run& run)
+			{
+				VertexBufferData vertices(MakeVertexLayout(), VERTEX_COUNT);
+				run.Measure([&vertices]()
+					{
+						for (size_t i = 0; i < VERTEX_COUNT; ++i)
+						{
+							const float x = static_cast<float>(i);
+							auto vertex = vertices[i];
+							vertex.Get<VertexAttribute::Position3D>() = { x, 0.0f, 1.0f };
+							vertex.Get<VertexAttribute::Normal>() = { 0.0f, 1.0f, 0.0f };
+							vertex.Get<VertexAttribute::Texture2D>() = { x, 0.5f };
+						}
+						Benchmark::Consume(static_cast<uint64_t>(vertices.GetData()[0]));
+						return static_cast<uint64_t>(VERTEX_COUNT);
+					});
+			});
+	}
+}
\ No newline at end of file
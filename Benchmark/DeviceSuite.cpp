@@ -0,0 +1,624 @@
+#include "Benchmark.h"
+#include "Window.h"
+#include "MainPipelineGraph.h"
+#include "RenderPasses.h"
+#include "Cameras.h"
+#include "Shapes.h"
+#include "Lights.h"
+#include "SceneLoader.h"
+#include "TextureStreamer.h"
+#include "GfxResources.h"
+#include "Profiler.h"
+#include "Surface.h"
+#include "ShaderArchive.h"
+#include "ThreadPool.h"
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+
+namespace Suites
+{
+	static constexpr unsigned int DEVICE_WIDTH = 1280;
+	static constexpr unsigned int DEVICE_HEIGHT = 720;
+	static constexpr int DEVICE_GRID = 12;
+	static constexpr const char* GOLDEN_SCENE = "Scenes/Golden.json";
+	// Frames rendered before comparison so shadow maps and streamed textures settle
+	static constexpr size_t GOLDEN_WARMUP_FRAMES = 16;
+	// Channel difference tolerated between drivers and fraction of texels allowed to exceed it
+	static constexpr int BASELINE_TOLERANCE = 8;
+	static constexpr double BASELINE_MAX_DIFFERENT = 0.001;
+	// Small chunks so parity check splits even small scene queue into many recordings
+	static constexpr size_t PARITY_CHUNK_JOBS = 2;
+	// Frames GPU can lag behind and frames timed for cost of single pass
+	static constexpr size_t DEVICE_LATENCY_FRAMES = 8;
+	static constexpr size_t EXPOSURE_FRAMES = 120;
+	// Startup of scene is repeated few times and fastest run is taken
+	static constexpr size_t STARTUP_RUNS = 3;
+	// Frames timed for throughput of serial and pipelined submission
+	static constexpr size_t PIPELINE_FRAMES = 60;
+
+	// Engine with its real render graph running on GPU, grid of objects surrounds camera so part of them is culled
+	class DeviceScene
+	{
+		WinAPI::Window window;
+		GFX::Pipeline::MainPipelineGraph graph;
+		Camera::PersonCamera camera;
+		std::vector<std::unique_ptr<GFX::Shape::SolidGlobe>> objects;
+
+	public:
+		DeviceScene(bool software) : window(DEVICE_WIDTH, DEVICE_HEIGHT, "Benchmark", software), graph(window.Gfx()),
+			camera(window.Gfx(), graph, Camera::CameraParams({ 0.0f, 2.0f, 0.0f }, "Benchmark camera", 0.0f, 0.0f, 1.047f, 0.01f, 500.0f))
+		{
+			window.Gfx().DisableGUI();
+			graph.BindMainCamera(camera);
+			for (int x = -DEVICE_GRID; x <= DEVICE_GRID; ++x)
+			{
+				for (int z = -DEVICE_GRID; z <= DEVICE_GRID; ++z)
+				{
+					if (x == 0 && z == 0)
+						continue;
+					objects.emplace_back(std::make_unique<GFX::Shape::SolidGlobe>(window.Gfx(), graph,
+						DirectX::XMFLOAT3(x * 4.0f, 0.0f, z * 4.0f), "Object " + std::to_string(objects.size()),
+						GFX::Data::ColorFloat3(0.2f + 0.05f * (x + DEVICE_GRID), 0.5f, 0.2f + 0.05f * (z + DEVICE_GRID)), 8, 12));
+				}
+			}
+		}
+
+		constexpr GFX::Graphics& Gfx() noexcept { return window.Gfx(); }
+		constexpr GFX::Pipeline::MainPipelineGraph& Graph() noexcept { return graph; }
+		constexpr const Camera::PersonCamera& GetCamera() const noexcept { return camera; }
+		constexpr size_t GetObjectCount() const noexcept { return objects.size(); }
+
+		inline void Submit() noexcept
+		{
+			GFX::Object::FlushTransforms();
+			for (auto& object : objects)
+				object->Submit(RenderChannel::Main | RenderChannel::Shadow);
+		}
+
+		// Objects whose bounds intersect camera frustum, computed without scene hierarchy
+		size_t CountInsideFrustum() const noexcept
+		{
+			const DirectX::BoundingFrustum frustum = camera.GetFrustum();
+			size_t count = 0;
+			for (const auto& object : objects)
+			{
+				const DirectX::XMMATRIX transform = DirectX::XMLoadFloat4x4(&object->GetTransform());
+				if (frustum.Intersects(object->GetBoundingBox().GetTransformed(transform)))
+					++count;
+			}
+			return count;
+		}
+
+		// Graph is executed but not reset, so queues can be inspected afterwards
+		void Render()
+		{
+			WinAPI::Window::ProcessMessage();
+			window.Gfx().BeginFrame();
+			Submit();
+			graph.EndSubmission(window.Gfx());
+			graph.Execute(window.Gfx());
+		}
+
+		void Present()
+		{
+			graph.Reset();
+			window.Gfx().EndFrame();
+			Utils::Profiler::Get().EndFrame();
+		}
+	};
+
+	// Binds of two fullscreen passes differing only in pixel shader and blender, with sampler that is not grouped
+	class PassStates
+	{
+		typedef std::vector<GfxResPtr<GFX::Resource::IBindable>> Binds;
+
+	public:
+		Binds first;
+		Binds second;
+		GfxResPtr<GFX::Resource::PipelineState> firstState;
+		GfxResPtr<GFX::Resource::PipelineState> secondState;
+
+		PassStates(GFX::Graphics& gfx)
+		{
+			using namespace GFX::Resource;
+			first = { VertexShader::Get(gfx, "FullscreenVS"), PixelShader::Get(gfx, "LuminancePS"), Blender::Get(gfx, Blender::Type::None),
+				Rasterizer::Get(gfx, D3D11_CULL_MODE::D3D11_CULL_NONE, false), Topology::Get(gfx, D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST),
+				Sampler::Get(gfx, Sampler::Type::Point, Sampler::CoordType::Wrap) };
+			second = first;
+			second.at(1) = PixelShader::Get(gfx, "FullscreenPS");
+			second.at(2) = Blender::Get(gfx, Blender::Type::Light);
+			firstState = PipelineState::Get(gfx, first);
+			secondState = PipelineState::Get(gfx, second);
+		}
+
+		// Counts of states set and skipped by work done between two frame ends
+		template<typename Work>
+		static GFX::Resource::PipelineState::Stats Count(Work&& work)
+		{
+			GFX::Resource::PipelineState::EndFrame();
+			work();
+			GFX::Resource::PipelineState::EndFrame();
+			return GFX::Resource::PipelineState::GetLastFrameStats();
+		}
+	};
+
+	// Scene with shadows, normal, parallax and specular maps and skybox, created the same way as by application
+	class GoldenScene
+	{
+		GFX::Pipeline::MainPipelineGraph graph;
+		std::unique_ptr<Camera::PersonCamera> camera;
+		std::vector<GFX::Light::PointLight> pointLights;
+		std::vector<GFX::Light::SpotLight> spotLights;
+		std::vector<GFX::Light::DirectionalLight> directionalLights;
+		std::vector<GFX::Shape::Model> models;
+		// Pipelined graph holds frame submitted by previous render
+		bool framePending = false;
+
+		inline void Submit() noexcept
+		{
+			GFX::Object::FlushTransforms();
+			for (auto& light : pointLights)
+				light.Submit(RenderChannel::Main | RenderChannel::Light);
+			for (auto& light : spotLights)
+				light.Submit(RenderChannel::Main | RenderChannel::Light);
+			for (auto& light : directionalLights)
+				light.Submit(RenderChannel::Main | RenderChannel::Light);
+			for (auto& model : models)
+				model.Submit(RenderChannel::Main | RenderChannel::Shadow);
+		}
+
+	public:
+		GoldenScene(GFX::Graphics& gfx) : graph(gfx)
+		{
+			const GFX::SceneFile scene = GFX::SceneFile::Load(GOLDEN_SCENE);
+			if (scene.cameras.empty())
+				throw std::runtime_error(std::string("No camera in ") + GOLDEN_SCENE);
+			GFX::SceneLoader loader(scene);
+			loader.PrewarmShaders(gfx);
+
+			const auto& view = scene.cameras.front();
+			camera = std::make_unique<Camera::PersonCamera>(gfx, graph,
+				Camera::CameraParams(view.position, view.name, view.angleHorizontal, view.angleVertical, view.fov, view.nearClip, view.farClip));
+			graph.BindMainCamera(*camera);
+			graph.SetAutoExposure(false);
+			for (const auto& light : scene.pointLights)
+				pointLights.emplace_back(gfx, graph, light.name, light.intensity, light.color, light.position, light.range, light.radius, light.castShadows);
+			for (const auto& light : scene.spotLights)
+				spotLights.emplace_back(gfx, graph, light.name, light.intensity, light.color, light.position, light.range, light.size, light.innerAngle, light.outerAngle, light.direction);
+			for (const auto& light : scene.directionalLights)
+				directionalLights.emplace_back(gfx, graph, light.name, light.intensity, light.color, light.direction);
+			for (const auto& model : scene.models)
+				models.emplace_back(gfx, graph, model.file, loader.GetModel(model.file), GFX::Shape::ModelParams(model.position, model.rotation, model.name, model.scale));
+		}
+
+		constexpr GFX::Pipeline::MainPipelineGraph& Graph() noexcept { return graph; }
+
+		// Back buffer is read before present, after it content of flip model buffer is undefined.
+		// Pipelined graph draws frame submitted by previous call while next one is submitted on worker
+		void Render(GFX::Graphics& gfx, std::vector<uint32_t>* texels)
+		{
+			WinAPI::Window::ProcessMessage();
+			gfx.BeginFrame();
+			GFX::Resource::TextureStreamer::Get().Update(gfx);
+			if (graph.IsPipelined())
+			{
+				if (!framePending)
+				{
+					Submit();
+					graph.EndSubmission(gfx);
+				}
+				auto submission = Utils::ThreadPool::Get().Schedule([this]() { Submit(); });
+				try
+				{
+					graph.Execute(gfx);
+				}
+				catch (...)
+				{
+					submission.wait();
+					throw;
+				}
+				submission.get();
+			}
+			else
+			{
+				Submit();
+				graph.EndSubmission(gfx);
+				graph.Execute(gfx);
+			}
+			if (texels)
+				gfx.ReadBackBuffer(*texels);
+			graph.Reset();
+			framePending = graph.IsPipelined();
+			if (framePending)
+				graph.EndSubmission(gfx);
+			gfx.EndFrame();
+		}
+	};
+
+	// Graph with single pass reading output of pass that does not exist
+	class BrokenGraph : public GFX::Pipeline::RenderGraph
+	{
+	public:
+		BrokenGraph(GFX::Graphics& gfx) : RenderGraph(gfx)
+		{
+			auto pass = std::make_unique<GFX::Pipeline::RenderPass::ClearBufferPass>("clear");
+			pass->SetSinkLinkage("buffer", "missing.buffer");
+			AppendPass(std::move(pass));
+			Finalize();
+		}
+		virtual ~BrokenGraph() = default;
+	};
+
+	void AddDevice(Benchmark& bench)
+	{
+		const Benchmark::Options& options = bench.GetOptions();
+		if (options.devicePath.empty())
+			return;
+
+		// Created by first executed case so device errors fail only that case, released together with benchmark
+		auto scene = std::make_shared<std::unique_ptr<DeviceScene>>();
+		auto getScene = [scene, path = options.devicePath, software = options.softwareDevice]() -> DeviceScene&
+		{
+			if (*scene == nullptr)
+			{
+				// Shaders and textures are loaded relative to engine data directory
+				std::filesystem::current_path(path);
+				*scene = std::make_unique<DeviceScene>(software);
+			}
+			return **scene;
+		};
+
+		bench.Add("ShaderArchive/Startup", [path = options.devicePath, software = options.softwareDevice](Benchmark::Run& run)
+			{
+				// Golden scene with creation and prewarm of its shaders up to end of its first frame, on fresh device every time.
+				// Added before other device cases so no shader is left in codex by them
+				std::filesystem::current_path(path);
+				size_t cached = 0;
+				auto startup = [&](bool archive)
+				{
+					GFX::ShaderArchive::SetEnabled(archive);
+					cached = std::max(cached, GFX::Resource::Codex::GetCount());
+					WinAPI::Window window(DEVICE_WIDTH, DEVICE_HEIGHT, "Benchmark startup", software);
+					window.Gfx().DisableGUI();
+					const auto start = std::chrono::steady_clock::now();
+					GoldenScene scene(window.Gfx());
+					scene.Render(window.Gfx(), nullptr);
+					return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+				};
+
+				double archiveTime = 0.0;
+				run.MeasureOnce([&]()
+					{
+						archiveTime = startup(true);
+						return 1ULL;
+					});
+				// Both ways read from system file cache after first run
+				double fileTime = startup(false);
+				for (size_t i = 1; i < STARTUP_RUNS; ++i)
+				{
+					archiveTime = std::min(archiveTime, startup(true));
+					fileTime = std::min(fileTime, startup(false));
+				}
+				GFX::ShaderArchive::SetEnabled(true);
+				run.Metric("archiveMs", archiveTime);
+				run.Metric("looseFilesMs", fileTime);
+				run.Metric("speedup", archiveTime > 0.0 ? fileTime / archiveTime : 0.0);
+				run.Check(GFX::ShaderArchive::Get().IsOpen(), "shader archive opened from engine data directory");
+				run.Check(cached == 0, "every startup created its resources from scratch");
+			});
+		bench.Add("RenderGraph/Link", [getScene](Benchmark::Run& run)
+			{
+				DeviceScene& device = getScene();
+				// Creation of all passes with their resources and linking of sinks to sources
+				run.MeasureOnce([&device]()
+					{
+						GFX::Pipeline::MainPipelineGraph graph(device.Gfx());
+						Benchmark::Consume(static_cast<uint64_t>(graph.GetRenderQueue("lambertianDepthOptimized").GetJobCount()));
+						return 1ULL;
+					});
+				bool nestedFound = true;
+				try
+				{
+					device.Graph().GetRenderQueue("dirLighting.shadowMap");
+				}
+				catch (const std::exception&)
+				{
+					nestedFound = false;
+				}
+				run.Check(nestedFound, "nested queue resolved");
+				bool brokenRejected = false;
+				try
+				{
+					BrokenGraph broken(device.Gfx());
+				}
+				catch (const Exception::RenderGraphCompileException&)
+				{
+					brokenRejected = true;
+				}
+				run.Check(brokenRejected, "missing source rejected");
+			});
+
+		bench.Add("QueuePass/Submit", [getScene](Benchmark::Run& run)
+			{
+				// Render proxies gathered from every object into pass queues
+				DeviceScene& device = getScene();
+				auto& queue = device.Graph().GetRenderQueue("lambertianDepthOptimized");
+				size_t submitted = 0;
+				run.Measure([&]()
+					{
+						device.Submit();
+						device.Graph().EndSubmission(device.Gfx());
+						submitted = queue.GetJobCount();
+						device.Graph().Reset();
+						return static_cast<uint64_t>(device.GetObjectCount());
+					});
+				run.Check(submitted == device.GetObjectCount(), "every object submitted once");
+				// Queues keep capacity of last frame on frame arena
+				const uint64_t heapAllocations = Benchmark::GetHeapAllocations();
+				device.Submit();
+				run.Check(Benchmark::GetHeapAllocations() == heapAllocations, "steady state submission makes no heap allocations");
+				device.Graph().EndSubmission(device.Gfx());
+				device.Graph().Reset();
+			});
+
+		bench.Add("PipelineState/Bind", [getScene](Benchmark::Run& run)
+			{
+				// Passes drawn alternately, every bundle sets only states that differ from previous pass
+				using namespace GFX::Resource;
+				GFX::Graphics& gfx = getScene().Gfx();
+				PassStates states(gfx);
+				run.Measure([&states, &gfx]()
+					{
+						states.firstState->Bind(gfx);
+						states.secondState->Bind(gfx);
+						return 2ULL;
+					});
+
+				// Grouping
+				const auto& first = states.first;
+				run.Check(PipelineState::GenerateRID(first) == PipelineState::GenerateRID({ first.at(0), first.at(1), first.at(2), first.at(3), first.at(4) }),
+					"resources are left out of bundle");
+				run.Check(PipelineState::GenerateRID({ states.second.at(1), first.at(1) }) == PipelineState::GenerateRID({ first.at(1) }),
+					"later bindable overrides earlier one in same slot");
+				run.Check(&*PipelineState::Get(gfx, first) == &*states.firstState && &*states.firstState != &*states.secondState,
+					"equal bundles are shared, different are not");
+
+				// Filtering against states already on context
+				states.secondState->Bind(gfx);
+				PipelineState::Stats stats = PassStates::Count([&]() { states.firstState->Bind(gfx); });
+				run.Check(stats.bundles == 1 && stats.issued == 2 && stats.skipped == 3, "only differing states set after other bundle");
+				stats = PassStates::Count([&]() { states.firstState->Bind(gfx); });
+				run.Check(stats.issued == 0 && stats.skipped == 5, "nothing set when bundle is already bound");
+				stats = PassStates::Count([&]() { states.second.at(1)->Bind(gfx); states.firstState->Bind(gfx); });
+				run.Check(stats.issued == 1 && stats.skipped == 4, "state changed outside of bundle is set again");
+
+				// Invalidation, every recording starts from default state
+				gfx.CreateDeferredContexts(1);
+				stats = PassStates::Count([&]()
+					{
+						gfx.BeginRecording(0);
+						states.firstState->Bind(gfx);
+						gfx.CancelRecording();
+					});
+				run.Check(stats.issued == 5 && stats.skipped == 0, "all states set at start of recording");
+				stats = PassStates::Count([&]() { states.firstState->Bind(gfx); });
+				run.Check(stats.issued == 0, "recording does not change state tracked for immediate context");
+			});
+		bench.Add("PipelineState/Separate", [getScene](Benchmark::Run& run)
+			{
+				// Same passes with bundles disabled, every state is set on each pass
+				GFX::Graphics& gfx = getScene().Gfx();
+				PassStates states(gfx);
+				run.Measure([&states, &gfx]()
+					{
+						for (auto& bind : states.first)
+							bind->Bind(gfx);
+						for (auto& bind : states.second)
+							bind->Bind(gfx);
+						return 2ULL;
+					});
+			});
+
+		bench.Add("MainPipelineGraph/Frame", [getScene](Benchmark::Run& run)
+			{
+				// Whole frame of real pipeline, time includes present so recording time is reported separately
+				DeviceScene& device = getScene();
+				auto& queue = device.Graph().GetRenderQueue("lambertianDepthOptimized");
+				size_t visible = 0;
+				float recordTime = 0.0f;
+				run.Measure([&]()
+					{
+						device.Render();
+						visible = queue.GetJobCount();
+						recordTime = device.Graph().GetRecordTime();
+						device.Present();
+						return 1ULL;
+					});
+				auto& profiler = Utils::Profiler::Get();
+				const auto& states = GFX::Resource::PipelineState::GetLastFrameStats();
+				run.Metric("recordMs", recordTime);
+				run.Metric("gpuFrameMs", device.Gfx().GetGpuFrameTime());
+				run.Metric("cullFrustumMs", profiler.GetAverageTime("Cull frustum"));
+				run.Metric("sortMs", profiler.GetAverageTime("Sort"));
+				run.Metric("visible", static_cast<double>(visible));
+				run.Metric("stateBundles", static_cast<double>(states.bundles));
+				run.Metric("statesIssued", static_cast<double>(states.issued));
+				run.Metric("statesSkipped", static_cast<double>(states.skipped));
+				const size_t expected = device.CountInsideFrustum();
+				run.Check(device.Gfx().GetGpuFrameCount() > 0, "GPU frame time resolved from timestamps");
+				run.Check(visible == expected && visible < device.GetObjectCount(), "culled queue matches brute force frustum test");
+
+				// Frames were already measured so every per frame container reached its steady size
+				const uint64_t heapAllocations = Benchmark::GetHeapAllocations();
+				device.Render();
+				device.Present();
+				const uint64_t frameAllocations = Benchmark::GetHeapAllocations() - heapAllocations;
+				run.Metric("heapAllocationsPerFrame", static_cast<double>(frameAllocations));
+				run.Check(frameAllocations == 0, "steady state frame does not allocate from heap");
+			});
+		bench.Add("AutoExposurePass/Cost", [getScene](Benchmark::Run& run)
+			{
+				// GPU cost of luminance pass and its readback is difference of frame times with auto exposure on and off
+				DeviceScene& device = getScene();
+				auto& pass = dynamic_cast<GFX::Pipeline::RenderPass::AutoExposurePass&>(device.Graph().FindPass("autoExposure"));
+				auto gpuFrameTime = [&device](bool autoExposure)
+				{
+					device.Graph().SetAutoExposure(autoExposure);
+					// Frames still in flight were recorded with previous setting
+					for (size_t i = 0; i < DEVICE_LATENCY_FRAMES; ++i)
+					{
+						device.Render();
+						device.Present();
+					}
+					std::vector<float> times;
+					uint64_t count = device.Gfx().GetGpuFrameCount();
+					for (size_t i = 0; i < EXPOSURE_FRAMES; ++i)
+					{
+						device.Render();
+						device.Present();
+						if (device.Gfx().GetGpuFrameCount() != count)
+						{
+							count = device.Gfx().GetGpuFrameCount();
+							times.emplace_back(device.Gfx().GetGpuFrameTime());
+						}
+					}
+					if (times.empty())
+						return 0.0f;
+					std::sort(times.begin(), times.end());
+					return times.at(times.size() / 2);
+				};
+				float enabledTime = 0.0f;
+				float disabledTime = 0.0f;
+				float readbackTime = 0.0f;
+				run.MeasureOnce([&]()
+					{
+						enabledTime = gpuFrameTime(true);
+						readbackTime = Utils::Profiler::Get().GetAverageTime("Exposure readback");
+						disabledTime = gpuFrameTime(false);
+						return static_cast<uint64_t>(2 * (EXPOSURE_FRAMES + DEVICE_LATENCY_FRAMES));
+					});
+				device.Graph().SetAutoExposure(true);
+				run.Metric("gpuFrameMsEnabled", enabledTime);
+				run.Metric("gpuFrameMsDisabled", disabledTime);
+				run.Metric("gpuCostMs", enabledTime - disabledTime);
+				run.Metric("readbackMs", readbackTime);
+				run.Metric("exposure", pass.GetExposure());
+				const GFX::AutoExposure::Params params;
+				run.Check(enabledTime > 0.0f && disabledTime > 0.0f, "GPU frame times resolved with auto exposure on and off");
+				run.Check(readbackTime > 0.0f, "luminance read back while enabled");
+				run.Check(pass.GetExposure() >= params.minExposure && pass.GetExposure() <= params.maxExposure, "exposure inside allowed range");
+			});
+
+		bench.Add("MainPipelineGraph/Parity", [getScene](Benchmark::Run& run)
+			{
+				// Both recordings run on same prepared frame, fixed scene without auto exposure keeps them independent
+				DeviceScene& device = getScene();
+				GFX::Graphics& gfx = device.Gfx();
+				GoldenScene scene(gfx);
+				scene.Graph().GetRenderQueue("lambertianClassic").SetChunkJobs(PARITY_CHUNK_JOBS);
+				run.MeasureOnce([&]()
+					{
+						for (size_t i = 0; i < GOLDEN_WARMUP_FRAMES; ++i)
+							scene.Render(gfx, nullptr);
+						scene.Graph().RequestParityCheck();
+						scene.Render(gfx, nullptr);
+						return static_cast<uint64_t>(GOLDEN_WARMUP_FRAMES + 1);
+					});
+				const auto& parity = scene.Graph().GetParity();
+				run.Metric("differentTexels", static_cast<double>(parity.differentTexels));
+				run.Metric("maxDifference", parity.maxDifference);
+				run.Check(parity.checked && parity.differentTexels == 0, "parallel recording with chunked queue matches serial one");
+			});
+
+		bench.Add("MainPipelineGraph/Pipelined", [getScene](Benchmark::Run& run)
+			{
+				// Frame submitted during drawing of previous one has to give same image as frame submitted right before drawing
+				DeviceScene& device = getScene();
+				GFX::Graphics& gfx = device.Gfx();
+				GoldenScene scene(gfx);
+				auto render = [&](bool pipelined, std::vector<uint32_t>& texels)
+				{
+					scene.Graph().SetPipelined(pipelined);
+					for (size_t i = 0; i < GOLDEN_WARMUP_FRAMES; ++i)
+						scene.Render(gfx, nullptr);
+					const auto start = std::chrono::steady_clock::now();
+					for (size_t i = 0; i < PIPELINE_FRAMES; ++i)
+						scene.Render(gfx, nullptr);
+					const double frameTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / PIPELINE_FRAMES;
+					scene.Render(gfx, &texels);
+					return frameTime;
+				};
+				std::vector<uint32_t> serial;
+				std::vector<uint32_t> pipelined;
+				double serialTime = 0.0;
+				double pipelinedTime = 0.0;
+				run.MeasureOnce([&]()
+					{
+						serialTime = render(false, serial);
+						pipelinedTime = render(true, pipelined);
+						return static_cast<uint64_t>(2 * (GOLDEN_WARMUP_FRAMES + PIPELINE_FRAMES + 1));
+					});
+				scene.Graph().SetPipelined(false);
+
+				size_t different = 0;
+				for (size_t i = 0, size = std::min(serial.size(), pipelined.size()); i < size; ++i)
+					if (serial[i] != pipelined[i])
+						++different;
+				run.Metric("serialFrameMs", serialTime);
+				run.Metric("pipelinedFrameMs", pipelinedTime);
+				run.Metric("speedup", pipelinedTime > 0.0 ? serialTime / pipelinedTime : 0.0);
+				run.Metric("differentTexels", static_cast<double>(different));
+				run.Check(serial.size() && serial.size() == pipelined.size() && different == 0, "pipelined frame matches serial one");
+			});
+
+		if (options.baselineImage.empty())
+			return;
+		bench.Add("MainPipelineGraph/Baseline", [getScene, baseline = options.baselineImage](Benchmark::Run& run)
+			{
+				// Real pipeline output of fixed scene against image recorded by previous run, not a committed reference.
+				// Catches regressions between revisions on one machine, WARP device makes it independent of GPU and driver
+				DeviceScene& device = getScene();
+				GFX::Graphics& gfx = device.Gfx();
+				GoldenScene scene(gfx);
+				std::vector<uint32_t> texels;
+				run.MeasureOnce([&]()
+					{
+						for (size_t i = 0; i < GOLDEN_WARMUP_FRAMES; ++i)
+							scene.Render(gfx, nullptr);
+						scene.Render(gfx, &texels);
+						return static_cast<uint64_t>(GOLDEN_WARMUP_FRAMES + 1);
+					});
+
+				if (!std::filesystem::exists(baseline))
+				{
+					GFX::Surface surface(gfx.GetWidth(), gfx.GetHeight());
+					for (size_t i = 0; i < texels.size(); ++i)
+						surface.GetBuffer()[i] = GFX::Surface::Pixel(texels.at(i) | 0xFF000000U);
+					surface.Save(baseline);
+					run.Check(false, "baseline image did not exist, current frame saved as " + baseline);
+					return;
+				}
+				const GFX::Surface expected(baseline);
+				if (!run.Check(expected.GetWidth() == gfx.GetWidth() && expected.GetHeight() == gfx.GetHeight(), "baseline image has size of frame"))
+					return;
+				size_t different = 0;
+				int maxDifference = 0;
+				for (size_t i = 0; i < texels.size(); ++i)
+				{
+					const GFX::Surface::Pixel actual(texels.at(i));
+					const GFX::Surface::Pixel reference = expected.GetBuffer()[i];
+					const int difference = std::max({ std::abs(actual.GetR() - reference.GetR()),
+						std::abs(actual.GetG() - reference.GetG()), std::abs(actual.GetB() - reference.GetB()) });
+					maxDifference = std::max(maxDifference, difference);
+					if (difference > BASELINE_TOLERANCE)
+						++different;
+				}
+				run.Metric("differentTexels", static_cast<double>(different));
+				run.Metric("maxDifference", maxDifference);
+				run.Check(static_cast<double>(different) <= BASELINE_MAX_DIFFERENT * static_cast<double>(texels.size()), "frame matches baseline image");
+			});
+	}
+}
\ No newline at end of file
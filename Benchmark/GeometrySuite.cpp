@@ -0,0 +1,57 @@
+#include "Benchmark.h"
+#include "Sphere.h"
+#include "Cube.h"
+
+namespace Suites
+{
+	using namespace GFX::Primitive;
+
+	static constexpr unsigned int ICO_DENSITY = 4;
+
+	void AddGeometry(Benchmark& bench)
+	{
+		bench.Add("Sphere/MakeIco", [](Benchmark::Run& run)
+			{
+				const IndexedTriangleList sphere = Sphere::MakeIco(ICO_DENSITY);
+				run.Metric("vertices", static_cast<double>(sphere.vertices.Size()));
+				run.Metric("triangles", static_cast<double>(sphere.indices.size() / 3));
+				run.Measure([]()
+					{
+						IndexedTriangleList list = Sphere::MakeIco(ICO_DENSITY);
+						Benchmark::Consume(static_cast<uint64_t>(list.indices.size()));
+						return static_cast<uint64_t>(list.indices.size() / 3);
+					});
+			});
+		bench.Add("Cube/Make", [](Benchmark::Run& run)
+			{
+				run.Measure([]()
+					{
+						IndexedTriangleList list = Cube::Make({ VertexAttribute::Texture2D });
+						Benchmark::Consume(static_cast<uint64_t>(list.vertices.Bytes()));
+						return static_cast<uint64_t>(list.indices.size() / 3);
+					});
+			});
+		bench.Add("IndexedTriangleList/Transform", [](Benchmark::Run& run)
+			{
+				IndexedTriangleList list = Sphere::MakeIco(ICO_DENSITY);
+				// Rotation only so positions stay bounded over all iterations
+				const DirectX::XMMATRIX transform = DirectX::XMMatrixRotationRollPitchYaw(0.01f, 0.02f, 0.03f);
+				run.Measure([&list, &transform]()
+					{
+						list.Transform(transform);
+						Benchmark::Consume(static_cast<uint64_t>(list.vertices.GetData()[0]));
+						return static_cast<uint64_t>(list.vertices.Size());
+					});
+			});
+		bench.Add("IndexedTriangleList/SetNormals", [](Benchmark::Run& run)
+			{
+				IndexedTriangleList list = Sphere::MakeIco(ICO_DENSITY);
+				run.Measure([&list]()
+					{
+						list.SetNormals();
+						Benchmark::Consume(static_cast<uint64_t>(list.vertices.GetData()[0]));
+						return static_cast<uint64_t>(list.indices.size() / 3);
+					});
+			});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Replacement of global allocation functions counting every request that reaches general heap.
+// Array and nothrow forms forward to these ones, so single counter sees all of them
+static std::atomic_uint64_t heapAllocations = 0;
+
+// Memory from aligned allocation has to be released by matching function on Windows
+static void* AlignedAlloc(size_t size, size_t alignment) noexcept
+{
+#ifdef _WIN32
+	return _aligned_malloc(size, alignment);
+#else
+	// Size has to be multiple of alignment, which is always power of two
+	return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+static void AlignedFree(void* memory) noexcept
+{
+#ifdef _WIN32
+	_aligned_free(memory);
+#else
+	std::free(memory);
+#endif
+}
+
+uint64_t Benchmark::GetHeapAllocations() noexcept
+{
+	return heapAllocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size)
+{
+	heapAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	heapAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = AlignedAlloc(size ? size : 1, static_cast<size_t>(alignment)))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	AlignedFree(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept
+{
+	AlignedFree(memory);
+}
\ No newline at end of file
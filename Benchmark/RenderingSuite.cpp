@@ -0,0 +1,517 @@
+#include "Benchmark.h"
+#include "SoftwareRenderer.h"
+#include "GBufferEncoding.h"
+#include "AutoExposure.h"
+#include "ResolutionController.h"
+#include "Surface.h"
+#include "Sphere.h"
+#include "Cube.h"
+#include <random>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <initializer_list>
+
+namespace Suites
+{
+	static constexpr uint32_t FRAME_WIDTH = 640;
+	static constexpr uint32_t FRAME_HEIGHT = 360;
+	static constexpr uint32_t SURFACE_SIZE = 1024;
+	static constexpr uint32_t ENCODING_SAMPLES = 65536;
+	// Bound of angle (in degrees) between normal and its decoded R16G16 code, measured max is about 0.04
+	static constexpr float NORMAL_MAX_ANGLE = 0.05f;
+	// Frames allowed for dynamic resolution to settle after load changes
+	static constexpr uint32_t RESOLUTION_SETTLE_FRAMES = 120;
+
+	// Small procedural scene: grid of spheres on floor lit by directional and point lights
+	class TestScene
+	{
+		GFX::SoftwareRenderer::Mesh sphere;
+		GFX::SoftwareRenderer::Mesh floor;
+		GFX::SoftwareRenderer::Material sphereMaterial;
+		GFX::SoftwareRenderer::Material floorMaterial;
+
+		static GFX::SoftwareRenderer::Mesh MakeMesh(GFX::Primitive::IndexedTriangleList&& list)
+		{
+			GFX::SoftwareRenderer::Mesh mesh;
+			mesh.vertices.reserve(list.vertices.Size());
+			for (size_t i = 0, size = list.vertices.Size(); i < size; ++i)
+			{
+				auto vertex = list.vertices[i];
+				mesh.vertices.push_back({ vertex.Get<VertexAttribute::Position3D>(), vertex.Get<VertexAttribute::Normal>(), { 0.0f, 0.0f } });
+			}
+			mesh.indices.assign(list.indices.begin(), list.indices.end());
+			return mesh;
+		}
+
+	public:
+		TestScene()
+		{
+			sphere = MakeMesh(GFX::Primitive::Sphere::MakeIco(3));
+			GFX::Primitive::IndexedTriangleList cube = GFX::Primitive::Cube::Make();
+			cube.SetNormals();
+			floor = MakeMesh(std::move(cube));
+			floorMaterial.color = { 0.6f, 0.6f, 0.6f, 1.0f };
+			floorMaterial.specularIntensity = 0.2f;
+		}
+
+		void Setup(GFX::SoftwareRenderer& renderer) const
+		{
+			const DirectX::XMFLOAT3 cameraPos = { 0.0f, 6.0f, -14.0f };
+			renderer.SetCamera(DirectX::XMMatrixLookAtLH(DirectX::XMLoadFloat3(&cameraPos), DirectX::XMVectorZero(), DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)),
+				DirectX::XMMatrixPerspectiveFovLH(1.047f, static_cast<float>(renderer.GetWidth()) / static_cast<float>(renderer.GetHeight()), 0.1f, 100.0f),
+				cameraPos, 0.1f, 100.0f);
+			GFX::SceneFile::DirectionalLight sun;
+			sun.direction = { 0.3f, -1.0f, 0.4f };
+			renderer.AddLight(sun);
+			for (int i = 0; i < 4; ++i)
+			{
+				GFX::SceneFile::PointLight light;
+				light.position = { -6.0f + 4.0f * i, 2.0f, 0.0f };
+				light.color = { 1.0f, 0.5f + 0.1f * i, 0.3f };
+				light.range = 20;
+				renderer.AddLight(light);
+			}
+		}
+
+		void Draw(GFX::SoftwareRenderer& renderer) const
+		{
+			renderer.DrawIndexed(floor, floorMaterial, DirectX::XMMatrixScaling(30.0f, 1.0f, 30.0f) * DirectX::XMMatrixTranslation(0.0f, -1.5f, 0.0f));
+			for (int x = -2; x <= 2; ++x)
+				for (int z = -2; z <= 2; ++z)
+					renderer.DrawIndexed(sphere, sphereMaterial, DirectX::XMMatrixTranslation(3.0f * x, 0.0f, 3.0f * z));
+		}
+	};
+
+	// Dynamic resolution over GPU bound frames whose time is proportional to rendered area, with slight noise.
+	// Load of full resolution frame changes to second value at given frame
+	struct ResolutionTrace
+	{
+		static constexpr uint32_t STABLE_FRAMES = 30;
+		static constexpr float FIXED_TIME = 2.0f;
+
+		// Frames before filtered time settled near budget, counted from start and from load change
+		uint32_t convergence = 0;
+		uint32_t reconvergence = 0;
+		// Scale changes after settling and changes going opposite way than previous one
+		uint32_t changes = 0;
+		uint32_t reversals = 0;
+		float stepScale = 0.0f;
+		float scale = 0.0f;
+		float filteredTime = 0.0f;
+
+		static ResolutionTrace Simulate(uint32_t frames, float fullTime, uint32_t stepFrame, float stepFullTime)
+		{
+			ResolutionTrace trace;
+			std::mt19937 engine(6);
+			std::uniform_real_distribution<float> noise(0.97f, 1.03f);
+			GFX::ResolutionController controller;
+			const float target = controller.GetParams().targetTime;
+			const float tolerance = target * controller.GetParams().deadband * 2.0f;
+
+			trace.scale = trace.stepScale = controller.GetScale();
+			trace.convergence = stepFrame;
+			trace.reconvergence = frames - stepFrame;
+			uint32_t stable = 0;
+			bool settled = false;
+			float direction = 0.0f;
+			for (uint32_t frame = 0; frame < frames; ++frame)
+			{
+				if (frame == stepFrame)
+				{
+					trace.stepScale = trace.scale;
+					stable = 0;
+					settled = false;
+				}
+				const float load = frame < stepFrame ? fullTime : stepFullTime;
+				const float next = controller.Update((FIXED_TIME + load * trace.scale * trace.scale) * noise(engine));
+				if (next != trace.scale && settled)
+				{
+					++trace.changes;
+					if (direction != 0.0f && (next > trace.scale) != (direction > 0.0f))
+						++trace.reversals;
+					direction = next - trace.scale;
+				}
+				trace.scale = next;
+				if (std::abs(controller.GetFilteredTime() - target) > tolerance)
+					stable = 0;
+				else if (++stable == STABLE_FRAMES && !settled)
+				{
+					settled = true;
+					direction = 0.0f;
+					if (frame < stepFrame)
+						trace.convergence = frame + 1 - STABLE_FRAMES;
+					else
+						trace.reconvergence = frame + 1 - STABLE_FRAMES - stepFrame;
+				}
+			}
+			trace.filteredTime = controller.GetFilteredTime();
+			return trace;
+		}
+	};
+
+	void AddRendering(Benchmark& bench)
+	{
+		bench.Add("SoftwareRenderer/Frame", [](Benchmark::Run& run)
+			{
+				const TestScene scene;
+				GFX::SoftwareRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT);
+				scene.Setup(renderer);
+				run.Measure([&]()
+					{
+						scene.Draw(renderer);
+						renderer.Render();
+						Benchmark::Consume(static_cast<uint64_t>(renderer.GetImage().front()));
+						return static_cast<uint64_t>(FRAME_WIDTH) * FRAME_HEIGHT;
+					});
+				// Throughput of passes in last frame
+				for (const auto& pass : renderer.GetStats())
+					run.Metric(std::string(pass.name) + " Mpix/s", pass.throughput);
+			});
+		bench.Add("SoftwareRenderer/Determinism", [](Benchmark::Run& run)
+			{
+				// Tiles are rasterized on thread pool so image cannot depend on order of their completion.
+				// Hash of image is tracked between runs in JSON results, it changes only with changes of renderer or test scene
+				const TestScene scene;
+				GFX::SoftwareRenderer first(FRAME_WIDTH, FRAME_HEIGHT);
+				scene.Setup(first);
+				scene.Draw(first);
+				first.Render();
+				GFX::SoftwareRenderer second(FRAME_WIDTH, FRAME_HEIGHT);
+				scene.Setup(second);
+				run.MeasureOnce([&]()
+					{
+						scene.Draw(second);
+						second.Render();
+						return static_cast<uint64_t>(FRAME_WIDTH) * FRAME_HEIGHT;
+					});
+				// FNV-1a over whole texels
+				uint32_t hash = 2166136261U;
+				for (uint32_t texel : second.GetImage())
+					hash = (hash ^ texel) * 16777619U;
+				run.Metric("imageHash", static_cast<double>(hash));
+				run.Check(first.GetImage() == second.GetImage(), "frames rendered twice are identical");
+			});
+		bench.Add("SoftwareRenderer/ReducedSSAO", [](Benchmark::Run& run)
+			{
+				// Error of occlusion at reduced resolution against full resolution one, timing of reduced frames
+				const TestScene scene;
+				GFX::SoftwareRenderer reference(FRAME_WIDTH, FRAME_HEIGHT);
+				scene.Setup(reference);
+				scene.Draw(reference);
+				reference.Render();
+
+				for (uint32_t downscale : { 2U, 4U })
+				{
+					GFX::SoftwareRenderer::Params params;
+					params.ssaoDownscale = downscale;
+					GFX::SoftwareRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT, params);
+					scene.Setup(renderer);
+					scene.Draw(renderer);
+					renderer.Render();
+					const GFX::SoftwareRenderer::ErrorMetrics error = GFX::SoftwareRenderer::Compare(reference.GetAmbientOcclusion(), renderer.GetAmbientOcclusion());
+					const std::string prefix = "downscale" + std::to_string(downscale) + " ";
+					run.Metric(prefix + "meanAbsolute", error.meanAbsolute);
+					run.Metric(prefix + "rootMeanSquare", error.rootMeanSquare);
+					run.Metric(prefix + "maxAbsolute", error.maxAbsolute);
+				}
+
+				GFX::SoftwareRenderer::Params params;
+				params.ssaoDownscale = 2;
+				GFX::SoftwareRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT, params);
+				scene.Setup(renderer);
+				run.Measure([&]()
+					{
+						scene.Draw(renderer);
+						renderer.Render();
+						Benchmark::Consume(static_cast<uint64_t>(renderer.GetImage().front()));
+						return static_cast<uint64_t>(FRAME_WIDTH) * FRAME_HEIGHT;
+					});
+			});
+
+		bench.Add("GBufferEncoding/Normal", [](Benchmark::Run& run)
+			{
+				std::mt19937 engine(4);
+				std::normal_distribution<float> axis(0.0f, 1.0f);
+				std::vector<DirectX::XMFLOAT3> normals(ENCODING_SAMPLES);
+				for (auto& normal : normals)
+				{
+					const float x = axis(engine);
+					const float y = axis(engine);
+					DirectX::XMStoreFloat3(&normal, DirectX::XMVector3Normalize(DirectX::XMVectorSet(x, y, axis(engine), 0.0f)));
+				}
+				run.Measure([&normals]()
+					{
+						float sum = 0.0f;
+						for (const auto& normal : normals)
+							sum += GFX::GBufferEncoding::DecodeNormal(GFX::GBufferEncoding::EncodeNormal(normal)).z;
+						Benchmark::Consume(sum);
+						return static_cast<uint64_t>(normals.size());
+					});
+			});
+		bench.Add("GBufferEncoding/Specular", [](Benchmark::Run& run)
+			{
+				run.Measure([]()
+					{
+						float sum = 0.0f;
+						for (uint32_t i = 0; i < ENCODING_SAMPLES; ++i)
+						{
+							const float value = static_cast<float>(i) / ENCODING_SAMPLES;
+							sum += GFX::GBufferEncoding::DecodeSpecular(GFX::GBufferEncoding::EncodeSpecular({ value * 4.0f, value, 1.0f - value }, value)).w;
+						}
+						Benchmark::Consume(sum);
+						return static_cast<uint64_t>(ENCODING_SAMPLES);
+					});
+			});
+		// Whole R16G16 domain takes minutes, by default grid finer than codes of 8 bit channels is enough
+		const uint32_t precisionSteps = bench.GetOptions().exhaustive ? 65536U : 4097U;
+		bench.Add("GBufferEncoding/NormalPrecision", [steps = precisionSteps](Benchmark::Run& run)
+			{
+				GFX::GBufferEncoding::NormalError error;
+				run.MeasureOnce([&]()
+					{
+						error = GFX::GBufferEncoding::MeasureNormalPrecision(steps);
+						return static_cast<uint64_t>(steps) * steps;
+					});
+				run.Metric("maxAngle", error.maxAngle);
+				run.Metric("meanAngle", error.meanAngle);
+				run.Metric("unstableCodes", static_cast<double>(error.unstableCodes));
+				run.Check(error.maxAngle <= NORMAL_MAX_ANGLE, "normal error below bound of 16 bit octahedral mapping");
+				run.Check(error.meanAngle <= NORMAL_MAX_ANGLE * 0.25f, "mean normal error well below max one");
+				run.Check(error.unstableCodes == 0, "normal codes stable after repeated decoding and encoding");
+			});
+		bench.Add("GBufferEncoding/SpecularPrecision", [](Benchmark::Run& run)
+			{
+				// Every code of 8 bit channels and inputs sampled finer than codes
+				constexpr float COLOR_STEP = GFX::GBufferEncoding::SPECULAR_RANGE / 255.0f;
+				float maxColorError = 0.0f;
+				float maxPowerError = 0.0f;
+				bool stable = true;
+				run.MeasureOnce([&]()
+					{
+						for (uint32_t i = 0; i <= ENCODING_SAMPLES; ++i)
+						{
+							const float value = static_cast<float>(i) / ENCODING_SAMPLES;
+							const DirectX::XMFLOAT4 decoded = GFX::GBufferEncoding::DecodeSpecular(GFX::GBufferEncoding::EncodeSpecular({ value * GFX::GBufferEncoding::SPECULAR_RANGE, 0.0f, 0.0f }, value));
+							maxColorError = std::max(maxColorError, std::abs(decoded.x - value * GFX::GBufferEncoding::SPECULAR_RANGE));
+							maxPowerError = std::max(maxPowerError, std::abs(std::log2(decoded.w) / GFX::GBufferEncoding::SPECULAR_POWER_SCALE - value));
+						}
+						for (uint32_t code = 0; code < 256; ++code)
+						{
+							const uint32_t packed = code | (code << 8) | (code << 16) | (code << 24);
+							const DirectX::XMFLOAT4 decoded = GFX::GBufferEncoding::DecodeSpecular(packed);
+							stable &= GFX::GBufferEncoding::EncodeSpecular({ decoded.x, decoded.y, decoded.z },
+								std::log2(decoded.w) / GFX::GBufferEncoding::SPECULAR_POWER_SCALE) == packed;
+						}
+						return static_cast<uint64_t>(ENCODING_SAMPLES) + 257;
+					});
+				run.Metric("maxColorError", maxColorError);
+				run.Metric("maxPowerError", maxPowerError);
+				run.Check(maxColorError <= COLOR_STEP * 0.5f + 1e-5f, "color inside range rounded to nearest code");
+				run.Check(maxPowerError <= 0.5f / 255.0f + 1e-5f, "power rounded to nearest code");
+				run.Check(stable, "every specular code survives decoding and encoding");
+
+				// Brighter colors are clipped, materials keep intensity within range
+				const DirectX::XMFLOAT4 clipped = GFX::GBufferEncoding::DecodeSpecular(GFX::GBufferEncoding::EncodeSpecular({ GFX::GBufferEncoding::SPECULAR_RANGE * 2.0f, -1.0f, 0.0f }, 2.0f));
+				run.Check(clipped.x == GFX::GBufferEncoding::SPECULAR_RANGE && clipped.y == 0.0f
+					&& clipped.w == std::exp2(GFX::GBufferEncoding::SPECULAR_POWER_SCALE), "values outside range clamped to its limits");
+			});
+
+		bench.Add("AutoExposure/Update", [](Benchmark::Run& run)
+			{
+				std::mt19937 engine(5);
+				std::normal_distribution<float> luminance(-1.0f, 2.0f);
+				std::vector<float> logLuminance(static_cast<size_t>(FRAME_WIDTH) * FRAME_HEIGHT);
+				for (auto& value : logLuminance)
+					value = luminance(engine);
+
+				GFX::AutoExposure exposure;
+				run.Measure([&]()
+					{
+						Benchmark::Consume(exposure.Update(logLuminance.data(), logLuminance.size(), 1.0f / 60.0f));
+						return static_cast<uint64_t>(logLuminance.size());
+					});
+
+				// Frames needed to settle after scene gets 4 times brighter
+				const float start = exposure.GetExposure();
+				for (auto& value : logLuminance)
+					value += 2.0f;
+				exposure.BuildHistogram(logLuminance.data(), logLuminance.size());
+				uint32_t frames = 0;
+				float previous = start;
+				while (frames < 1000)
+				{
+					const float current = exposure.Update(1.0f / 60.0f);
+					++frames;
+					if (std::abs(current - previous) <= current * 0.001f)
+						break;
+					previous = current;
+				}
+				run.Metric("exposure", exposure.GetExposure());
+				run.Metric("settleFrames", frames);
+				run.Metric("exposureRatio", start / exposure.GetExposure());
+				// Percentile average moves with scene up to size of single bin
+				run.Check(std::abs(start / exposure.GetExposure() - 4.0f) <= 4.0f * 0.2f, "exposure follows 4 times brighter scene");
+				run.Check(frames < 1000, "exposure settles after scene change");
+			});
+		bench.Add("AutoExposure/Histogram", [](Benchmark::Run& run)
+			{
+				// Bucketing of known values and percentile trimming of outliers
+				GFX::AutoExposure exposure;
+				const GFX::AutoExposure::Params params = exposure.GetParams();
+				const float binSize = (params.maxLogLuminance - params.minLogLuminance) / static_cast<float>(GFX::AutoExposure::BIN_COUNT);
+				std::vector<float> values;
+				for (uint32_t bin = 0; bin < GFX::AutoExposure::BIN_COUNT; ++bin)
+					for (uint32_t i = 0; i <= bin; ++i)
+						values.emplace_back(params.minLogLuminance + binSize * (static_cast<float>(bin) + 0.5f));
+				run.Measure([&]()
+					{
+						exposure.BuildHistogram(values.data(), values.size());
+						Benchmark::Consume(exposure.GetPercentileAverage());
+						return static_cast<uint64_t>(values.size());
+					});
+				bool binned = exposure.GetSampleCount() == values.size();
+				for (uint32_t bin = 0; bin < GFX::AutoExposure::BIN_COUNT; ++bin)
+					binned &= exposure.GetHistogram().at(bin) == bin + 1;
+				run.Check(binned, "values at bin centers land in their bins");
+
+				const std::vector<float> edges =
+				{
+					params.minLogLuminance - 5.0f, params.minLogLuminance,
+					params.maxLogLuminance, params.maxLogLuminance + 3.0f,
+					std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity()
+				};
+				exposure.BuildHistogram(edges.data(), edges.size());
+				run.Check(exposure.GetHistogram().front() == 2, "values below range go into first bin");
+				run.Check(exposure.GetHistogram().back() == 3, "values above range go into last bin");
+				run.Check(exposure.GetSampleCount() == edges.size() - 1, "NaN is skipped");
+
+				// Dark half is below low percentile and few bright pixels above high one
+				std::vector<float> scene(1000, 0.0f);
+				std::fill_n(scene.begin(), 500, -4.0f);
+				std::fill_n(scene.rbegin(), 20, params.maxLogLuminance);
+				exposure.BuildHistogram(scene.data(), scene.size());
+				run.Metric("percentileAverage", exposure.GetPercentileAverage());
+				run.Check(std::abs(exposure.GetPercentileAverage()) <= binSize, "outliers outside percentiles are skipped");
+			});
+		bench.Add("AutoExposure/Adaptation", [](Benchmark::Run& run)
+			{
+				// Adaptation over 1 s after scene gets 4 times brighter, sampled at different frame rates
+				constexpr uint32_t PIXELS = 1024;
+				const std::vector<float> dark(PIXELS, -2.0f);
+				const std::vector<float> bright(PIXELS, 0.0f);
+				auto adapt = [&](const std::vector<float>& from, const std::vector<float>& to, uint32_t frames, float time, bool& monotonic)
+				{
+					GFX::AutoExposure exposure;
+					exposure.Update(from.data(), from.size(), 1.0f / 60.0f);
+					exposure.BuildHistogram(to.data(), to.size());
+					float distance = std::abs(exposure.GetPercentileAverage() - exposure.GetAdaptedLogLuminance());
+					monotonic = true;
+					for (uint32_t i = 0; i < frames; ++i)
+					{
+						exposure.Update(time / static_cast<float>(frames));
+						const float current = std::abs(exposure.GetTargetLogLuminance() - exposure.GetAdaptedLogLuminance());
+						monotonic &= current <= distance;
+						distance = current;
+					}
+					return exposure;
+				};
+				bool monotonic = true;
+				run.Measure([&]()
+					{
+						Benchmark::Consume(adapt(dark, bright, 60, 1.0f, monotonic).GetExposure());
+						return 60ULL;
+					});
+
+				GFX::AutoExposure first;
+				first.Update(dark.data(), dark.size(), 1.0f / 60.0f);
+				run.Check(first.GetAdaptedLogLuminance() == first.GetTargetLogLuminance(), "first update jumps to scene luminance");
+				run.Check(std::abs(first.GetExposure() - first.GetParams().key / std::exp2(first.GetTargetLogLuminance())) <= 1e-4f, "exposure maps adapted luminance to key");
+
+				// Remaining distance after time t is exp(-t * speed)
+				const GFX::AutoExposure::Params params;
+				const GFX::AutoExposure up60 = adapt(dark, bright, 60, 1.0f, monotonic);
+				run.Check(monotonic, "brightening approaches target monotonically");
+				const GFX::AutoExposure up30 = adapt(dark, bright, 30, 1.0f, monotonic);
+				const GFX::AutoExposure up144 = adapt(dark, bright, 144, 1.0f, monotonic);
+				const GFX::AutoExposure down60 = adapt(bright, dark, 60, 1.0f, monotonic);
+				run.Check(monotonic, "darkening approaches target monotonically");
+				const float remainingUp = (up60.GetTargetLogLuminance() - up60.GetAdaptedLogLuminance()) / 2.0f;
+				const float remainingDown = (down60.GetAdaptedLogLuminance() - down60.GetTargetLogLuminance()) / 2.0f;
+				run.Metric("remainingUp", remainingUp);
+				run.Metric("remainingDown", remainingDown);
+				run.Check(std::abs(remainingUp - std::exp(-params.speedUp)) <= 1e-3f, "brightening follows speed up rate");
+				run.Check(std::abs(remainingDown - std::exp(-params.speedDown)) <= 1e-3f, "darkening follows speed down rate");
+				run.Check(std::abs(up30.GetAdaptedLogLuminance() - up60.GetAdaptedLogLuminance()) <= 1e-4f
+					&& std::abs(up144.GetAdaptedLogLuminance() - up60.GetAdaptedLogLuminance()) <= 1e-4f, "adaptation does not depend on frame rate");
+
+				const std::vector<float> black(PIXELS, params.minLogLuminance);
+				const std::vector<float> white(PIXELS, params.maxLogLuminance);
+				GFX::AutoExposure clamped;
+				run.Check(clamped.Update(black.data(), black.size(), 1.0f / 60.0f) == params.maxExposure, "exposure clamped in dark scene");
+				clamped.Reset();
+				run.Check(clamped.Update(white.data(), white.size(), 1.0f / 60.0f) == params.minExposure, "exposure clamped in bright scene");
+			});
+		bench.Add("ResolutionController/Convergence", [](Benchmark::Run& run)
+			{
+				// Frame at full resolution is over budget, controller has to find scale that fits it and stay there
+				constexpr uint32_t FRAMES = 600;
+				GFX::ResolutionController::Params params;
+				ResolutionTrace trace;
+				run.Measure([&]()
+					{
+						trace = ResolutionTrace::Simulate(FRAMES, 24.0f, FRAMES, 24.0f);
+						Benchmark::Consume(trace.scale);
+						return static_cast<uint64_t>(FRAMES);
+					});
+				run.Metric("convergenceFrames", trace.convergence);
+				run.Metric("changesAfterConvergence", trace.changes);
+				run.Metric("finalScale", trace.scale);
+				run.Check(trace.convergence <= RESOLUTION_SETTLE_FRAMES, "frame time settles near budget");
+				run.Check(std::abs(trace.filteredTime - params.targetTime) <= params.targetTime * params.deadband * 2.0f, "final frame time near budget");
+				run.Check(trace.scale > params.minScale && trace.scale < params.maxScale, "scale found inside allowed range");
+				run.Check(trace.changes <= 2 && trace.reversals == 0, "scale does not oscillate after settling");
+			});
+		bench.Add("ResolutionController/LoadStep", [](Benchmark::Run& run)
+			{
+				// Scene gets heavier and lighter in the middle of trace
+				constexpr uint32_t FRAMES = 900;
+				constexpr uint32_t STEP = 450;
+				GFX::ResolutionController::Params params;
+				ResolutionTrace heavier;
+				ResolutionTrace lighter;
+				run.Measure([&]()
+					{
+						heavier = ResolutionTrace::Simulate(FRAMES, 12.0f, STEP, 36.0f);
+						lighter = ResolutionTrace::Simulate(FRAMES, 36.0f, STEP, 16.0f);
+						Benchmark::Consume(heavier.scale + lighter.scale);
+						return static_cast<uint64_t>(FRAMES) * 2;
+					});
+				run.Metric("heavierFrames", heavier.reconvergence);
+				run.Metric("lighterFrames", lighter.reconvergence);
+				run.Check(heavier.stepScale == params.maxScale, "frames under budget keep full resolution");
+				run.Check(heavier.reconvergence <= RESOLUTION_SETTLE_FRAMES && heavier.scale < heavier.stepScale, "scale drops when load grows");
+				run.Check(lighter.convergence <= RESOLUTION_SETTLE_FRAMES && lighter.reconvergence <= RESOLUTION_SETTLE_FRAMES
+					&& lighter.scale > lighter.stepScale, "scale grows back when load drops");
+				run.Check(heavier.reversals == 0 && lighter.reversals == 0, "scale does not oscillate after settling");
+			});
+
+		bench.Add("Surface/PixelOps", [](Benchmark::Run& run)
+			{
+				GFX::Surface surface(SURFACE_SIZE, SURFACE_SIZE);
+				run.Measure([&surface]()
+					{
+						surface.Clear({ 0, 0, 0 });
+						for (uint32_t y = 0; y < SURFACE_SIZE; ++y)
+							for (uint32_t x = 0; x < SURFACE_SIZE; ++x)
+								surface.PutPixel(x, y, { static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(x ^ y) });
+						uint64_t sum = 0;
+						for (uint32_t y = 0; y < SURFACE_SIZE; ++y)
+							for (uint32_t x = 0; x < SURFACE_SIZE; ++x)
+								sum += surface.GetPixel(x, y).GetB();
+						Benchmark::Consume(sum);
+						return static_cast<uint64_t>(SURFACE_SIZE) * SURFACE_SIZE;
+					});
+			});
+	}
+}
\ No newline at end of file
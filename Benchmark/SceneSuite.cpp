@@ -0,0 +1,608 @@
+#include "Benchmark.h"
+#include "BVH.h"
+#include "TransformBatch.h"
+#include "LightBounds.h"
+#include "ShadowCascades.h"
+#include "OcclusionBuffer.h"
+#include "Cube.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <cmath>
+#include <cfloat>
+#include <string>
+
+namespace Suites
+{
+	static constexpr size_t OBJECT_COUNT = 4096;
+	static constexpr size_t LIGHT_COUNT = 1024;
+	static constexpr uint32_t SCREEN_WIDTH = 1920;
+	static constexpr uint32_t SCREEN_HEIGHT = 1080;
+	static constexpr float SCENE_SIZE = 200.0f;
+	static constexpr uint32_t OCCLUSION_WIDTH = 256U;
+	static constexpr uint32_t OCCLUSION_HEIGHT = 144U;
+	static constexpr size_t OCCLUDER_GRID = 16;
+	static constexpr size_t OCCLUSION_QUERIES = 4096;
+	// Object counts of scenes for hierarchy queries and number of lights or rays per query batch
+	static constexpr std::array<size_t, 3> BVH_QUERY_SCALES = { 1000, 10000, 100000 };
+	static constexpr size_t BVH_QUERIES = 256;
+
+	// Objects scattered over scene with random sizes, same seed for every run
+	static std::vector<DirectX::BoundingBox> MakeBoxes(size_t count, uint32_t seed)
+	{
+		std::mt19937 engine(seed);
+		std::uniform_real_distribution<float> position(-SCENE_SIZE, SCENE_SIZE);
+		std::uniform_real_distribution<float> extent(0.2f, 3.0f);
+		std::vector<DirectX::BoundingBox> boxes;
+		boxes.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			// Separate statements keep order of generated values same on every compiler
+			DirectX::XMFLOAT3 center, extents;
+			center.x = position(engine);
+			center.y = position(engine) * 0.1f;
+			center.z = position(engine);
+			extents.x = extent(engine);
+			extents.y = extent(engine);
+			extents.z = extent(engine);
+			boxes.emplace_back(center, extents);
+		}
+		return boxes;
+	}
+
+	static DirectX::XMMATRIX GetProjection() noexcept
+	{
+		return DirectX::XMMatrixPerspectiveFovLH(1.047f, static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_HEIGHT), 0.01f, 500.0f);
+	}
+
+	static DirectX::XMMATRIX GetView(float angle) noexcept
+	{
+		return DirectX::XMMatrixLookToLH(DirectX::XMVectorSet(0.0f, 10.0f, 0.0f, 0.0f),
+			DirectX::XMVectorSet(sinf(angle), -0.1f, cosf(angle), 0.0f), DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	}
+
+	static DirectX::BoundingFrustum GetFrustum(float angle) noexcept
+	{
+		DirectX::BoundingFrustum frustum(GetProjection());
+		frustum.Transform(frustum, DirectX::XMMatrixInverse(nullptr, GetView(angle)));
+		return frustum;
+	}
+
+	// Marks of hierarchy have to match testing every box on its own
+	template<typename Volume>
+	static size_t CountMismatches(GFX::Pipeline::BVH& bvh, const std::vector<uint32_t>& proxies,
+		const std::vector<DirectX::BoundingBox>& boxes, const Volume& volume) noexcept
+	{
+		const uint64_t stamp = bvh.MarkInside(volume);
+		size_t mismatches = 0;
+		for (size_t i = 0; i < boxes.size(); ++i)
+			if (bvh.IsMarked(proxies.at(i), stamp) != (volume.Contains(boxes.at(i)) != DirectX::ContainmentType::DISJOINT))
+				++mismatches;
+		return mismatches;
+	}
+
+	// Unit cube imported as mesh, all of its faces are big enough to become occluders
+	static GFX::Data::OccluderGeometry MakeCubeOccluder()
+	{
+		GFX::Primitive::IndexedTriangleList cube = GFX::Primitive::Cube::MakeSolid();
+		aiMesh mesh;
+		mesh.mNumVertices = static_cast<unsigned int>(cube.vertices.Size());
+		mesh.mVertices = new aiVector3D[mesh.mNumVertices];
+		for (unsigned int i = 0; i < mesh.mNumVertices; ++i)
+		{
+			const DirectX::XMFLOAT3& position = cube.vertices[i].Get<VertexAttribute::Position3D>();
+			mesh.mVertices[i] = aiVector3D(position.x, position.y, position.z);
+		}
+		mesh.mNumFaces = static_cast<unsigned int>(cube.indices.size() / 3);
+		mesh.mFaces = new aiFace[mesh.mNumFaces];
+		for (unsigned int i = 0; i < mesh.mNumFaces; ++i)
+		{
+			mesh.mFaces[i].mNumIndices = 3;
+			mesh.mFaces[i].mIndices = new unsigned int[3]{ cube.indices.at(i * 3), cube.indices.at(i * 3 + 1), cube.indices.at(i * 3 + 2) };
+		}
+		return GFX::Data::OccluderGeometry(mesh);
+	}
+
+	// Camera in front of wall covering whole view
+	static DirectX::XMMATRIX GetOcclusionViewProjection() noexcept
+	{
+		return DirectX::XMMatrixMultiply(DirectX::XMMatrixLookToLH(DirectX::XMVectorSet(0.0f, 0.0f, -20.0f, 0.0f),
+			DirectX::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)),
+			DirectX::XMMatrixPerspectiveFovLH(1.047f, static_cast<float>(OCCLUSION_WIDTH) / static_cast<float>(OCCLUSION_HEIGHT), 0.1f, 100.0f));
+	}
+
+	void AddScene(Benchmark& bench)
+	{
+		bench.Add("BVH/Build", [](Benchmark::Run& run)
+			{
+				const std::vector<DirectX::BoundingBox> boxes = MakeBoxes(OBJECT_COUNT, 1);
+				const DirectX::BoundingSphere volume({ 0.0f, 0.0f, 0.0f }, 1.0f);
+				run.Measure([&boxes, &volume]()
+					{
+						// First query builds whole tree
+						GFX::Pipeline::BVH bvh;
+						for (const auto& box : boxes)
+							bvh.Insert(box, nullptr);
+						Benchmark::Consume(bvh.MarkInside(volume) + bvh.GetNodeCount());
+						return static_cast<uint64_t>(boxes.size());
+					});
+
+				GFX::Pipeline::BVH bvh;
+				std::vector<uint32_t> proxies;
+				for (const auto& box : boxes)
+					proxies.emplace_back(bvh.Insert(box, nullptr));
+				run.Check(CountMismatches(bvh, proxies, boxes, DirectX::BoundingSphere({ 20.0f, 0.0f, -10.0f }, 40.0f)) == 0, "sphere query matches brute force");
+				run.Check(CountMismatches(bvh, proxies, boxes, GetFrustum(0.3f)) == 0, "frustum query matches brute force");
+			});
+		bench.Add("BVH/Refit", [](Benchmark::Run& run)
+			{
+				std::vector<DirectX::BoundingBox> boxes = MakeBoxes(OBJECT_COUNT, 1);
+				GFX::Pipeline::BVH bvh;
+				std::vector<uint32_t> proxies;
+				proxies.reserve(boxes.size());
+				for (const auto& box : boxes)
+					proxies.emplace_back(bvh.Insert(box, nullptr));
+				const DirectX::BoundingSphere volume({ 0.0f, 0.0f, 0.0f }, 1.0f);
+				bvh.MarkInside(volume);
+
+				// Every 8th object moves back and forth each frame
+				float offset = 0.5f;
+				run.Measure([&]()
+					{
+						uint64_t moved = 0;
+						for (size_t i = 0; i < boxes.size(); i += 8, ++moved)
+						{
+							boxes.at(i).Center.x += offset;
+							bvh.Update(proxies.at(i), boxes.at(i));
+						}
+						offset = -offset;
+						Benchmark::Consume(bvh.MarkInside(volume));
+						return moved;
+					});
+				run.Metric("rebuilds", static_cast<double>(bvh.GetRebuildCount()));
+				run.Metric("buildCost", bvh.GetBuildCost());
+				run.Check(CountMismatches(bvh, proxies, boxes, GetFrustum(1.2f)) == 0, "refitted tree matches brute force");
+			});
+		for (const size_t count : BVH_QUERY_SCALES)
+		{
+			bench.Add("BVH/LightInfluence/" + std::to_string(count), [count](Benchmark::Run& run)
+				{
+					// Objects lit by each point light, gathered same way as QueuePass::GatherInside
+					const std::vector<DirectX::BoundingBox> boxes = MakeBoxes(count, 4);
+					GFX::Pipeline::BVH bvh;
+					std::vector<uint32_t> proxies;
+					proxies.reserve(boxes.size());
+					for (const auto& box : boxes)
+						proxies.emplace_back(bvh.Insert(box, nullptr));
+					std::mt19937 engine(5);
+					std::uniform_real_distribution<float> position(-SCENE_SIZE, SCENE_SIZE);
+					std::uniform_real_distribution<float> radius(5.0f, 30.0f);
+					std::vector<DirectX::BoundingSphere> lights;
+					lights.reserve(BVH_QUERIES);
+					for (size_t i = 0; i < BVH_QUERIES; ++i)
+					{
+						DirectX::XMFLOAT3 center;
+						center.x = position(engine);
+						center.y = position(engine) * 0.1f;
+						center.z = position(engine);
+						lights.emplace_back(center, radius(engine));
+					}
+
+					uint64_t influenced = 0;
+					run.Measure([&]()
+						{
+							influenced = 0;
+							for (const auto& light : lights)
+							{
+								const uint64_t stamp = bvh.MarkInside(light);
+								for (uint32_t proxy : proxies)
+									if (bvh.IsMarked(proxy, stamp))
+										++influenced;
+							}
+							Benchmark::Consume(influenced);
+							return static_cast<uint64_t>(lights.size());
+						});
+					run.Metric("objectsPerLight", static_cast<double>(influenced) / static_cast<double>(lights.size()));
+					size_t mismatches = 0;
+					for (size_t i = 0; i < lights.size(); i += 16)
+						mismatches += CountMismatches(bvh, proxies, boxes, lights.at(i));
+					run.Check(mismatches == 0, "light influence matches brute force");
+				});
+			bench.Add("BVH/RayCast/" + std::to_string(count), [count](Benchmark::Run& run)
+				{
+					// Picking rays from camera, objects are told apart by their data pointers which are never dereferenced
+					const std::vector<DirectX::BoundingBox> boxes = MakeBoxes(count, 6);
+					std::vector<uint8_t> tags(boxes.size());
+					auto getData = [&tags](size_t i) { return reinterpret_cast<GFX::Pipeline::JobData*>(tags.data() + i); };
+					GFX::Pipeline::BVH bvh;
+					for (size_t i = 0; i < boxes.size(); ++i)
+						bvh.Insert(boxes.at(i), getData(i));
+					std::mt19937 engine(7);
+					std::uniform_real_distribution<float> yaw(-3.14159f, 3.14159f);
+					std::uniform_real_distribution<float> pitch(-0.3f, 0.05f);
+					const DirectX::XMVECTOR origin = DirectX::XMVectorSet(0.0f, 10.0f, 0.0f, 0.0f);
+					std::vector<DirectX::XMVECTOR> directions;
+					directions.reserve(BVH_QUERIES);
+					for (size_t i = 0; i < BVH_QUERIES; ++i)
+					{
+						const float angle = yaw(engine);
+						const float slope = pitch(engine);
+						directions.emplace_back(DirectX::XMVector3Normalize(DirectX::XMVectorSet(sinf(angle), slope, cosf(angle), 0.0f)));
+					}
+
+					uint64_t hits = 0;
+					run.Measure([&]()
+						{
+							hits = 0;
+							for (const auto& direction : directions)
+							{
+								float distance;
+								if (bvh.RayCast(origin, direction, distance))
+									++hits;
+							}
+							Benchmark::Consume(hits);
+							return static_cast<uint64_t>(directions.size());
+						});
+					run.Metric("hitRatio", static_cast<double>(hits) / static_cast<double>(directions.size()));
+					const uint64_t heapAllocations = Benchmark::GetHeapAllocations();
+					float lastDistance;
+					Benchmark::Consume(static_cast<uint64_t>(bvh.RayCast(origin, directions.front(), lastDistance) != nullptr));
+					run.Check(Benchmark::GetHeapAllocations() == heapAllocations, "ray cast reuses traversal stack");
+
+					// Closest box not containing camera, the ones around it are picked only when nothing else is hit
+					size_t mismatches = 0;
+					for (const auto& direction : directions)
+					{
+						float distance;
+						GFX::Pipeline::JobData* hit = bvh.RayCast(origin, direction, distance);
+						GFX::Pipeline::JobData* expected = nullptr;
+						float expectedDistance = FLT_MAX;
+						bool surrounded = false;
+						for (size_t i = 0; i < boxes.size(); ++i)
+						{
+							float boxDistance;
+							if (boxes.at(i).Contains(origin) != DirectX::ContainmentType::DISJOINT)
+								surrounded = true;
+							else if (boxes.at(i).Intersects(origin, direction, boxDistance) && boxDistance < expectedDistance)
+							{
+								expectedDistance = boxDistance;
+								expected = getData(i);
+							}
+						}
+						if (expected ? hit != expected || std::abs(distance - expectedDistance) > 1e-3f : (hit != nullptr) != surrounded)
+							++mismatches;
+					}
+					run.Check(mismatches == 0, "picked object matches brute force");
+				});
+		}
+		bench.Add("QueuePass/CullSort", [](Benchmark::Run& run)
+			{
+				// Kernel of QueuePass::CullFrustum and QueuePass::Sort without render jobs, real pass is measured by device cases
+				const std::vector<DirectX::BoundingBox> boxes = MakeBoxes(OBJECT_COUNT, 2);
+				GFX::Pipeline::BVH bvh;
+				std::vector<uint32_t> proxies;
+				proxies.reserve(boxes.size());
+				for (const auto& box : boxes)
+					proxies.emplace_back(bvh.Insert(box, nullptr));
+				const DirectX::BoundingFrustum frustum = GetFrustum(0.3f);
+				const DirectX::XMVECTOR cameraPos = DirectX::XMVectorSet(0.0f, 10.0f, 0.0f, 0.0f);
+
+				std::vector<std::pair<float, uint32_t>> keys;
+				keys.reserve(boxes.size());
+				run.Measure([&]()
+					{
+						keys.clear();
+						const uint64_t stamp = bvh.MarkInside(frustum);
+						for (uint32_t i = 0, size = static_cast<uint32_t>(boxes.size()); i < size; ++i)
+						{
+							if (bvh.IsMarked(proxies[i], stamp))
+								keys.emplace_back(DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&boxes[i].Center), cameraPos))), i);
+						}
+						std::sort(keys.begin(), keys.end());
+						Benchmark::Consume(static_cast<uint64_t>(keys.size()));
+						return static_cast<uint64_t>(boxes.size());
+					});
+				run.Metric("visible", static_cast<double>(keys.size()));
+				size_t expected = 0;
+				for (const auto& box : boxes)
+					if (frustum.Contains(box) != DirectX::ContainmentType::DISJOINT)
+						++expected;
+				run.Check(keys.size() == expected, "culled set matches brute force");
+				run.Check(std::is_sorted(keys.begin(), keys.end()), "jobs sorted by distance");
+			});
+
+		bench.Add("TransformBatch/Flush", [](Benchmark::Run& run)
+			{
+				// Thousands of animated objects spinning every frame
+				std::vector<GFX::TRS> transforms(OBJECT_COUNT);
+				std::vector<DirectX::XMFLOAT4X4> worlds(OBJECT_COUNT);
+				const DirectX::XMFLOAT3 localScale = { 1.0f, 2.0f, 1.0f };
+				for (size_t i = 0; i < transforms.size(); ++i)
+				{
+					transforms.at(i).position = { static_cast<float>(i % 64), 0.0f, static_cast<float>(i / 64) };
+					transforms.at(i).scale = 0.5f + static_cast<float>(i % 7) * 0.25f;
+				}
+				const DirectX::XMVECTOR spin = DirectX::XMQuaternionRotationRollPitchYaw(0.01f, 0.02f, 0.0f);
+
+				GFX::TransformBatch batch;
+				run.Measure([&]()
+					{
+						for (size_t i = 0; i < transforms.size(); ++i)
+						{
+							DirectX::XMStoreFloat4(&transforms[i].rotation,
+								DirectX::XMQuaternionNormalize(DirectX::XMQuaternionMultiply(DirectX::XMLoadFloat4(&transforms[i].rotation), spin)));
+							batch.Push(transforms[i], localScale, worlds[i]);
+						}
+						batch.Flush();
+						Benchmark::Consume(worlds.back()._11);
+						return static_cast<uint64_t>(batch.GetLastFlushed());
+					});
+
+				float maxError = 0.0f;
+				for (size_t i = 0; i < transforms.size(); ++i)
+				{
+					DirectX::XMFLOAT4X4 reference;
+					DirectX::XMStoreFloat4x4(&reference, GFX::TransformBatch::GetMatrix(transforms[i], localScale));
+					for (uint8_t j = 0; j < 16; ++j)
+						maxError = std::max(maxError, fabsf(reference.m[j / 4][j % 4] - worlds[i].m[j / 4][j % 4]));
+				}
+				run.Metric("maxErrorToScalar", maxError);
+				run.Check(maxError <= 1e-4f, "batched matrices match scalar ones");
+			});
+		bench.Add("TransformBatch/Scalar", [](Benchmark::Run& run)
+			{
+				// Reference for Flush: matrices computed one by one
+				std::vector<GFX::TRS> transforms(OBJECT_COUNT);
+				std::vector<DirectX::XMFLOAT4X4> worlds(OBJECT_COUNT);
+				const DirectX::XMFLOAT3 localScale = { 1.0f, 2.0f, 1.0f };
+				const DirectX::XMVECTOR spin = DirectX::XMQuaternionRotationRollPitchYaw(0.01f, 0.02f, 0.0f);
+				run.Measure([&]()
+					{
+						for (size_t i = 0; i < transforms.size(); ++i)
+						{
+							DirectX::XMStoreFloat4(&transforms[i].rotation,
+								DirectX::XMQuaternionNormalize(DirectX::XMQuaternionMultiply(DirectX::XMLoadFloat4(&transforms[i].rotation), spin)));
+							DirectX::XMStoreFloat4x4(&worlds[i], GFX::TransformBatch::GetMatrix(transforms[i], localScale));
+						}
+						Benchmark::Consume(worlds.back()._11);
+						return static_cast<uint64_t>(worlds.size());
+					});
+			});
+
+		bench.Add("LightBounds/Project", [](Benchmark::Run& run)
+			{
+				std::mt19937 engine(3);
+				std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+				std::uniform_real_distribution<float> radius(1.0f, 20.0f);
+				std::vector<DirectX::BoundingSphere> volumes;
+				volumes.reserve(LIGHT_COUNT);
+				for (size_t i = 0; i < LIGHT_COUNT; ++i)
+				{
+					DirectX::XMFLOAT3 center;
+					center.x = position(engine);
+					center.y = position(engine) * 0.2f;
+					center.z = position(engine);
+					const float size = radius(engine);
+					// Half of lights are spot lights bounded by sphere around cone
+					if (i % 2)
+						volumes.emplace_back(GFX::LightBounds::GetConeSphere(center, { 0.0f, -1.0f, 0.0f }, size, 0.5f));
+					else
+						volumes.emplace_back(center, size);
+				}
+				const DirectX::XMMATRIX view = GetView(0.3f);
+				const DirectX::XMMATRIX projection = GetProjection();
+
+				uint64_t visible = 0;
+				uint64_t area = 0;
+				run.Measure([&]()
+					{
+						visible = area = 0;
+						for (const auto& volume : volumes)
+						{
+							GFX::LightBounds::Screen screen;
+							if (GFX::LightBounds::Project(volume, view, projection, SCREEN_WIDTH, SCREEN_HEIGHT, screen))
+							{
+								++visible;
+								area += screen.GetArea();
+							}
+						}
+						Benchmark::Consume(area);
+						return static_cast<uint64_t>(volumes.size());
+					});
+				run.Metric("visible", static_cast<double>(visible));
+				run.Check(visible > 0 && visible <= volumes.size(), "part of lights visible");
+				for (const auto& volume : volumes)
+				{
+					GFX::LightBounds::Screen screen;
+					if (GFX::LightBounds::Project(volume, view, projection, SCREEN_WIDTH, SCREEN_HEIGHT, screen))
+					{
+						if (!run.Check(screen.left >= 0 && screen.top >= 0 && screen.left < screen.right && screen.top < screen.bottom
+							&& screen.right <= static_cast<int32_t>(SCREEN_WIDTH) && screen.bottom <= static_cast<int32_t>(SCREEN_HEIGHT)
+							&& screen.minDepth <= screen.maxDepth, "scissor rect inside screen"))
+							break;
+					}
+				}
+				// Shaded pixels relative to full screen passes for every visible light
+				run.Metric("scissorAreaRatio", visible ? static_cast<double>(area) / (static_cast<double>(visible) * SCREEN_WIDTH * SCREEN_HEIGHT) : 0.0);
+			});
+		bench.Add("ShadowCascades/Update", [](Benchmark::Run& run)
+			{
+				GFX::ShadowCascades cascades(GFX::ShadowCascades::MAX_CASCADES, 2048);
+				const DirectX::XMMATRIX projection = GetProjection();
+				const DirectX::XMFLOAT3 direction = { 0.3f, -1.0f, 0.2f };
+				float angle = 0.0f;
+				run.Measure([&]()
+					{
+						angle += 0.01f;
+						cascades.Update(GetView(angle), projection, direction);
+						Benchmark::Consume(cascades.GetCascade(cascades.GetCount() - 1).splitFar);
+						return static_cast<uint64_t>(cascades.GetCount());
+					});
+				for (uint32_t i = 0; i < cascades.GetCount(); ++i)
+					run.Metric("texelSize" + std::to_string(i), cascades.GetCascade(i).texelSize);
+
+				// Every slice of camera frustum is inside its sphere, and sphere stays inside shadow map after snapping
+				const DirectX::BoundingFrustum cameraFrustum(projection);
+				std::array<float, GFX::ShadowCascades::MAX_CASCADES> texelSizes;
+				for (uint32_t i = 0; i < cascades.GetCount(); ++i)
+					texelSizes.at(i) = cascades.GetCascade(i).texelSize;
+				size_t outside = 0;
+				size_t uncovered = 0;
+				bool stableTexels = true;
+				bool splitsOrdered = true;
+				for (float step = 0.0f; step < 6.28f; step += 0.37f)
+				{
+					const DirectX::XMMATRIX view = GetView(step);
+					const DirectX::XMMATRIX inverseView = DirectX::XMMatrixInverse(nullptr, view);
+					cascades.Update(view, projection, direction);
+					for (uint32_t i = 0; i < cascades.GetCount(); ++i)
+					{
+						const auto& cascade = cascades.GetCascade(i);
+						splitsOrdered &= cascade.splitNear < cascade.splitFar && (i == 0 || cascade.splitNear == cascades.GetCascade(i - 1).splitFar);
+						stableTexels &= cascade.texelSize == texelSizes.at(i);
+						DirectX::BoundingFrustum slice = cameraFrustum;
+						slice.Near = cascade.splitNear;
+						slice.Far = cascade.splitFar;
+						slice.Transform(slice, inverseView);
+						DirectX::XMFLOAT3 corners[DirectX::BoundingFrustum::CORNER_COUNT];
+						slice.GetCorners(corners);
+						DirectX::BoundingSphere sphere = cascade.slice;
+						sphere.Radius *= 1.0001f;
+						for (const auto& corner : corners)
+							if (sphere.Contains(DirectX::XMLoadFloat3(&corner)) == DirectX::ContainmentType::DISJOINT)
+								++outside;
+						sphere.Radius = cascade.slice.Radius * 0.999f;
+						if (cascade.casterVolume.Contains(sphere) != DirectX::ContainmentType::CONTAINS)
+							++uncovered;
+					}
+				}
+				run.Check(splitsOrdered && std::abs(cascades.GetCascade(cascades.GetCount() - 1).splitFar - 500.0f) < 0.01f, "splits cover whole depth range in order");
+				run.Check(outside == 0, "frustum slices fit in cascade spheres");
+				run.Check(uncovered == 0, "cascade spheres stay inside shadow maps after snapping");
+				run.Check(stableTexels, "texel size does not change when camera rotates");
+
+				// Camera moving by fractions of texel, fixed point has to move in shadow map only by whole texels
+				const DirectX::XMVECTOR point = DirectX::XMVectorSet(3.0f, 1.0f, 20.0f, 1.0f);
+				const DirectX::XMMATRIX rotation = GetView(0.5f);
+				// Position inside texel in both axes of every cascade at start
+				std::array<std::array<double, 2>, GFX::ShadowCascades::MAX_CASCADES> offsets = {};
+				double maxDrift = 0.0;
+				for (uint32_t move = 0; move < 64; ++move)
+				{
+					const DirectX::XMMATRIX view = DirectX::XMMatrixMultiply(DirectX::XMMatrixTranslation(-0.013f * move, 0.0f, -0.007f * move), rotation);
+					cascades.Update(view, projection, direction);
+					for (uint32_t i = 0; i < cascades.GetCount(); ++i)
+					{
+						const auto& cascade = cascades.GetCascade(i);
+						DirectX::XMFLOAT3 position;
+						DirectX::XMStoreFloat3(&position, DirectX::XMVector3TransformCoord(point, DirectX::XMLoadFloat4x4(&cascade.view)));
+						const double texels[2] = { static_cast<double>(position.x) / cascade.texelSize, static_cast<double>(position.y) / cascade.texelSize };
+						for (size_t axis = 0; axis < 2; ++axis)
+						{
+							const double fraction = texels[axis] - std::floor(texels[axis]);
+							if (move == 0)
+								offsets.at(i).at(axis) = fraction;
+							const double drift = std::abs(fraction - offsets.at(i).at(axis));
+							maxDrift = std::max(maxDrift, std::min(drift, 1.0 - drift));
+						}
+					}
+				}
+				run.Metric("maxTexelDrift", maxDrift);
+				run.Check(maxDrift < 0.01, "shadow map moves by whole texels");
+
+				// Casters between light and slice are kept, ones behind slice, too far towards light or aside are culled
+				cascades.Update(GetView(1.0f), projection, direction);
+				const DirectX::XMVECTOR towardsLight = DirectX::XMVector3Normalize(DirectX::XMVectorNegate(DirectX::XMLoadFloat3(&direction)));
+				const DirectX::XMVECTOR aside = DirectX::XMVector3Normalize(DirectX::XMVector3Cross(towardsLight, DirectX::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f)));
+				bool culledCorrectly = true;
+				for (uint32_t i = 0; i < cascades.GetCount(); ++i)
+				{
+					const auto& cascade = cascades.GetCascade(i);
+					const DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&cascade.slice.Center);
+					const float radius = cascade.slice.Radius;
+					const float distance = cascades.CasterDistance();
+					auto isKept = [&cascade, &center](const DirectX::XMVECTOR& offset, float length)
+					{
+						return cascade.casterVolume.Contains(DirectX::XMVectorMultiplyAdd(offset, DirectX::XMVectorReplicate(length), center)) != DirectX::ContainmentType::DISJOINT;
+					};
+					culledCorrectly &= isKept(towardsLight, radius + 0.5f * distance);
+					culledCorrectly &= isKept(towardsLight, 0.0f);
+					culledCorrectly &= !isKept(towardsLight, radius + distance + 1.0f);
+					culledCorrectly &= !isKept(towardsLight, -1.01f * radius - 1.0f);
+					culledCorrectly &= !isKept(aside, 1.5f * radius + 1.0f);
+				}
+				run.Check(culledCorrectly, "caster volume keeps only objects able to cast shadow into slice");
+			});
+
+		bench.Add("OcclusionBuffer/Rasterize", [](Benchmark::Run& run)
+			{
+				// Grid of boxes standing in front of camera, rasterized on thread pool
+				const GFX::Data::OccluderGeometry cube = MakeCubeOccluder();
+				std::vector<DirectX::XMFLOAT4X4> transforms(OCCLUDER_GRID * OCCLUDER_GRID);
+				for (size_t i = 0; i < transforms.size(); ++i)
+				{
+					const float x = (static_cast<float>(i % OCCLUDER_GRID) - OCCLUDER_GRID / 2.0f) * 3.0f;
+					const float y = (static_cast<float>(i / OCCLUDER_GRID) - OCCLUDER_GRID / 2.0f) * 3.0f;
+					DirectX::XMStoreFloat4x4(&transforms.at(i), DirectX::XMMatrixScaling(2.0f, 2.0f, 2.0f) * DirectX::XMMatrixTranslation(x, y, 10.0f));
+				}
+				const DirectX::XMMATRIX viewProjection = GetOcclusionViewProjection();
+				GFX::Pipeline::OcclusionBuffer buffer(OCCLUSION_WIDTH, OCCLUSION_HEIGHT);
+				run.Measure([&]()
+					{
+						Utils::FrameVector<GFX::Pipeline::OcclusionBuffer::Occluder> occluders;
+						occluders.reserve(transforms.size());
+						for (const auto& transform : transforms)
+							occluders.push_back({ &cube, transform });
+						buffer.Rasterize(occluders, viewProjection);
+						Utils::FrameArena::Get().NextFrame();
+						return static_cast<uint64_t>(buffer.GetTriangleCount());
+					});
+				const float coverage = buffer.GetDepthCoverage(-1.0f, -1.0f, 1.0f, 1.0f, 0.0f, 0.9999f);
+				run.Metric("coverage", coverage);
+				run.Check(buffer.GetTriangleCount() == transforms.size() * cube.GetTriangleCount(), "every occluder triangle set up");
+				run.Check(coverage > 0.0f && coverage < 1.0f, "occluders cover part of screen");
+			});
+		bench.Add("OcclusionBuffer/Query", [](Benchmark::Run& run)
+			{
+				// Boxes in front of wall have to stay visible, ones behind it are culled
+				const GFX::Data::OccluderGeometry cube = MakeCubeOccluder();
+				const DirectX::XMMATRIX viewProjection = GetOcclusionViewProjection();
+				GFX::Pipeline::OcclusionBuffer buffer(OCCLUSION_WIDTH, OCCLUSION_HEIGHT);
+				{
+					Utils::FrameVector<GFX::Pipeline::OcclusionBuffer::Occluder> occluders;
+					occluders.push_back({ &cube, {} });
+					DirectX::XMStoreFloat4x4(&occluders.back().transform, DirectX::XMMatrixScaling(100.0f, 100.0f, 1.0f));
+					buffer.Rasterize(occluders, viewProjection);
+					Utils::FrameArena::Get().NextFrame();
+				}
+
+				const GFX::Data::BoundingBox box(0.5f, -0.5f, -0.5f, 0.5f, -0.5f, 0.5f);
+				std::mt19937 engine(3);
+				std::uniform_real_distribution<float> position(-8.0f, 8.0f);
+				// Every second box is placed behind wall
+				std::vector<DirectX::XMFLOAT4X4> transforms(OCCLUSION_QUERIES);
+				for (size_t i = 0; i < transforms.size(); ++i)
+				{
+					const float x = position(engine);
+					const float y = position(engine);
+					const float z = i % 2 ? 10.0f + std::fabs(position(engine)) : -10.0f;
+					DirectX::XMStoreFloat4x4(&transforms.at(i), DirectX::XMMatrixTranslation(x, y, z) * viewProjection);
+				}
+				size_t visible = 0;
+				run.Measure([&]()
+					{
+						visible = 0;
+						for (const auto& transform : transforms)
+							if (buffer.IsVisible(box, DirectX::XMLoadFloat4x4(&transform)))
+								++visible;
+						return static_cast<uint64_t>(transforms.size());
+					});
+				run.Metric("visible", static_cast<double>(visible));
+				size_t mismatches = 0;
+				for (size_t i = 0; i < transforms.size(); ++i)
+					if (buffer.IsVisible(box, DirectX::XMLoadFloat4x4(&transforms.at(i))) == (i % 2 == 1))
+						++mismatches;
+				run.Check(mismatches == 0, "only boxes in front of wall are visible");
+			});
+	}
+}
\ No newline at end of file
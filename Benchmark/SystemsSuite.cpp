@@ -0,0 +1,382 @@
+#include "Benchmark.h"
+#include "Logger.h"
+#include "RingBuffer.h"
+#include "Mouse.h"
+#include "FrameArena.h"
+#include "Profiler.h"
+#include "TextureResidency.h"
+#include "SceneFile.h"
+#include "ShaderArchive.h"
+#include "TextureMetadata.h"
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+
+namespace Suites
+{
+	static constexpr size_t LOG_MESSAGES = 1024;
+	static constexpr size_t LOG_MAX_THREADS = 8;
+	static constexpr size_t RING_ITEMS = 1ULL << 16;
+	static constexpr size_t INPUT_BUFFER_SIZE = 256;
+	static constexpr size_t INPUT_SCREEN_WIDTH = 1920;
+	static constexpr size_t RESIDENCY_TEXTURES = 512;
+	static constexpr size_t RESIDENCY_FRAMES = 64;
+	static constexpr size_t ARENA_ALLOCATIONS = 4096;
+	static constexpr size_t PROFILE_SCOPES = 1024;
+
+	void AddSystems(Benchmark& bench)
+	{
+		bench.Add("Logger/Info", [](Benchmark::Run& run)
+			{
+				// Sustained throughput, waiting for writer keeps queue from growing during measurement
+				const std::string message = "Benchmark message with some payload to format";
+				run.Measure([&message]()
+					{
+						for (size_t i = 0; i < LOG_MESSAGES; ++i)
+							Utils::Logger::Info(message);
+						Utils::Logger::Drain();
+						return static_cast<uint64_t>(LOG_MESSAGES);
+					});
+			});
+		bench.Add("Logger/Contended", [](Benchmark::Run& run)
+			{
+				// Worker threads logging at once push into same queue, items are messages of all threads together
+				const size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, LOG_MAX_THREADS);
+				const std::string message = "Benchmark message with some payload to format";
+				run.Measure([&]()
+					{
+						std::vector<std::thread> workers;
+						workers.reserve(threads);
+						for (size_t i = 0; i < threads; ++i)
+						{
+							workers.emplace_back([&message]()
+								{
+									for (size_t j = 0; j < LOG_MESSAGES; ++j)
+										Utils::Logger::Info(message);
+								});
+						}
+						for (auto& worker : workers)
+							worker.join();
+						Utils::Logger::Drain();
+						return static_cast<uint64_t>(threads * LOG_MESSAGES);
+					});
+				run.Metric("threads", static_cast<double>(threads));
+			});
+		bench.Add("Logger/Capture", [](Benchmark::Run& run)
+			{
+				// Messages of batch job gathered on worker and flushed at once
+				const std::string message = "Benchmark message with some payload to format";
+				run.Measure([&message]()
+					{
+						Utils::Logger::Buffer buffer;
+						Utils::Logger::BeginCapture(buffer);
+						for (size_t i = 0; i < LOG_MESSAGES; ++i)
+							Utils::Logger::Warning(message, { "file.png", "cook", 1.0f });
+						Utils::Logger::EndCapture();
+						Utils::Logger::Flush(buffer);
+						Utils::Logger::Drain();
+						return static_cast<uint64_t>(LOG_MESSAGES);
+					});
+			});
+
+		bench.Add("RingBuffer/Throughput", [](Benchmark::Run& run)
+			{
+				// Input thread producing mouse events for main thread, queue has same capacity as in Mouse
+				WinAPI::Mouse mouse;
+				uint64_t received = 0;
+				bool ordered = true;
+				run.Measure([&]()
+					{
+						Utils::RingBuffer<WinAPI::Mouse::Event, INPUT_BUFFER_SIZE> ring;
+						std::thread producer([&ring, &mouse]()
+							{
+								for (uint64_t i = 0; i < RING_ITEMS;)
+								{
+									const int x = static_cast<int>(i % INPUT_SCREEN_WIDTH);
+									if (ring.Push({ i % 64 ? WinAPI::Mouse::Event::Type::Move : WinAPI::Mouse::Event::Type::LeftDown, mouse, x, static_cast<int>(i / INPUT_SCREEN_WIDTH) }))
+										++i;
+									else
+										std::this_thread::yield();
+								}
+							});
+						uint64_t sum = 0;
+						auto previous = std::chrono::steady_clock::time_point::min();
+						for (size_t i = 0; i < RING_ITEMS;)
+						{
+							if (auto event = ring.Pop())
+							{
+								ordered &= event->GetTime() >= previous && static_cast<size_t>(event->GetY()) * INPUT_SCREEN_WIDTH + event->GetX() == i;
+								previous = event->GetTime();
+								sum += event->GetX();
+								++i;
+							}
+							else
+								std::this_thread::yield();
+						}
+						producer.join();
+						received = sum;
+						Benchmark::Consume(sum);
+						return static_cast<uint64_t>(RING_ITEMS);
+					});
+				uint64_t expected = 0;
+				for (uint64_t i = 0; i < RING_ITEMS; ++i)
+					expected += i % INPUT_SCREEN_WIDTH;
+				run.Check(received == expected, "every event received exactly once");
+				run.Check(ordered, "events received in order with growing timestamps");
+			});
+		bench.Add("RingBuffer/RawDelta", [](Benchmark::Run& run)
+			{
+				// High rate raw mouse movement merged by producer when queue is full and by consumer once per frame,
+				// same way as in Mouse::OnRawDelta and Mouse::ReadRawDelta
+				int64_t movedX = 0;
+				int64_t movedY = 0;
+				uint64_t merged = 0;
+				uint64_t frames = 0;
+				run.Measure([&]()
+					{
+						Utils::RingBuffer<WinAPI::Mouse::RawDelta, INPUT_BUFFER_SIZE> ring;
+						std::atomic_bool done = false;
+						std::thread producer([&ring, &done]()
+							{
+								WinAPI::Mouse::RawDelta pending;
+								for (uint64_t i = 0; i < RING_ITEMS; ++i)
+								{
+									const auto time = std::chrono::steady_clock::now();
+									if (pending.count == 0)
+										pending.first = time;
+									pending.dX += static_cast<int>(i % 7) - 3;
+									pending.dY += static_cast<int>(i % 5) - 1;
+									pending.last = time;
+									++pending.count;
+									if (ring.Push(pending))
+										pending = {};
+								}
+								while (pending.count && !ring.Push(pending));
+								done.store(true, std::memory_order_release);
+							});
+						movedX = movedY = 0;
+						merged = frames = 0;
+						for (bool finished = false; !finished;)
+						{
+							finished = done.load(std::memory_order_acquire);
+							if (auto delta = ring.Pop())
+							{
+								while (auto next = ring.Pop())
+								{
+									delta->dX += next->dX;
+									delta->dY += next->dY;
+									delta->count += next->count;
+									delta->last = next->last;
+								}
+								movedX += delta->dX;
+								movedY += delta->dY;
+								merged += delta->count;
+								++frames;
+							}
+							else
+								std::this_thread::yield();
+						}
+						producer.join();
+						Benchmark::Consume(static_cast<uint64_t>(movedX + movedY));
+						return static_cast<uint64_t>(RING_ITEMS);
+					});
+				int64_t expectedX = 0;
+				int64_t expectedY = 0;
+				for (uint64_t i = 0; i < RING_ITEMS; ++i)
+				{
+					expectedX += static_cast<int64_t>(i % 7) - 3;
+					expectedY += static_cast<int64_t>(i % 5) - 1;
+				}
+				run.Metric("messagesPerRead", frames ? static_cast<double>(merged) / static_cast<double>(frames) : 0.0);
+				run.Check(merged == RING_ITEMS, "every raw message merged exactly once");
+				run.Check(movedX == expectedX && movedY == expectedY, "merged deltas sum to whole movement");
+			});
+
+		bench.Add("FrameArena/Allocate", [](Benchmark::Run& run)
+			{
+				// Mixed sizes of per frame data, memory is reclaimed every second frame
+				auto& arena = Utils::FrameArena::Get();
+				bool aligned = true;
+				auto frame = [&]()
+				{
+					for (size_t i = 0; i < ARENA_ALLOCATIONS; ++i)
+					{
+						const size_t alignment = 4ULL << (i % 4);
+						void* memory = arena.Allocate(16 + (i % 7) * 24, alignment);
+						aligned &= reinterpret_cast<uintptr_t>(memory) % alignment == 0;
+						Benchmark::Consume(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(memory)));
+					}
+					arena.NextFrame();
+					return static_cast<uint64_t>(ARENA_ALLOCATIONS);
+				};
+				run.Measure(frame);
+				run.Check(aligned, "allocations are aligned");
+				run.Check(arena.GetLastAllocations() == ARENA_ALLOCATIONS, "every allocation counted");
+				run.Check(arena.GetLastOverflowAllocations() == 0, "steady state does not overflow buffers");
+				const uint64_t heapAllocations = Benchmark::GetHeapAllocations();
+				frame();
+				run.Check(Benchmark::GetHeapAllocations() == heapAllocations, "steady state frame makes no heap allocations");
+
+				// Data stays valid for one frame after it was written
+				uint32_t* data = static_cast<uint32_t*>(arena.Allocate(sizeof(uint32_t) * 64, alignof(uint32_t)));
+				for (uint32_t i = 0; i < 64; ++i)
+					data[i] = i * 3;
+				arena.NextFrame();
+				arena.Allocate(sizeof(uint32_t) * 64, alignof(uint32_t));
+				bool intact = true;
+				for (uint32_t i = 0; i < 64; ++i)
+					intact &= data[i] == i * 3;
+				run.Check(intact, "previous frame data is not overwritten");
+				arena.NextFrame();
+			});
+
+		bench.Add("Profiler/Scope", [](Benchmark::Run& run)
+			{
+				// Nested scopes recorded by single thread, frame ends after every batch
+				auto& profiler = Utils::Profiler::Get();
+				profiler.SetEnabled(true);
+				profiler.EndFrame();
+				const uint64_t dropped = profiler.GetDroppedEvents();
+				run.Measure([&profiler]()
+					{
+						for (size_t i = 0; i < PROFILE_SCOPES / 2; ++i)
+						{
+							PROFILE_SCOPE("Benchmark outer");
+							{
+								PROFILE_SCOPE("Benchmark inner");
+								Benchmark::Consume(static_cast<uint64_t>(i));
+							}
+						}
+						profiler.EndFrame();
+						return static_cast<uint64_t>(PROFILE_SCOPES);
+					});
+				run.Metric("scopeOverheadNs", profiler.GetScopeOverhead());
+				run.Check(profiler.GetDroppedEvents() == dropped, "no events dropped");
+				run.Check(profiler.GetAverageTime("Benchmark outer") >= profiler.GetAverageTime("Benchmark inner")
+					&& profiler.GetAverageTime("Benchmark inner") > 0.0f, "nested scope times recorded");
+			});
+		bench.Add("Profiler/Disabled", [](Benchmark::Run& run)
+			{
+				// Cost left in code when profiler is turned off
+				auto& profiler = Utils::Profiler::Get();
+				profiler.SetEnabled(false);
+				run.Measure([]()
+					{
+						for (size_t i = 0; i < PROFILE_SCOPES; ++i)
+						{
+							PROFILE_SCOPE("Benchmark disabled");
+							Benchmark::Consume(static_cast<uint64_t>(i));
+						}
+						return static_cast<uint64_t>(PROFILE_SCOPES);
+					});
+				profiler.EndFrame();
+				profiler.SetEnabled(true);
+				run.Check(profiler.GetAverageTime("Benchmark disabled") == 0.0f, "disabled scopes are not recorded");
+			});
+
+		bench.Add("TextureResidency/Stream", [](Benchmark::Run& run)
+			{
+				// Camera moving through scene where only part of textures fits in budget
+				GFX::TextureResidency residency(256ULL << 20);
+				std::vector<uint32_t> textures;
+				textures.reserve(RESIDENCY_TEXTURES);
+				for (size_t i = 0; i < RESIDENCY_TEXTURES; ++i)
+				{
+					const uint32_t size = 512U << (i % 3);
+					textures.emplace_back(residency.Add(size, size, static_cast<uint8_t>(10 + i % 3), i % 4 ? 8 : 32, i % 4 != 0));
+				}
+				std::mt19937 engine(7);
+				std::uniform_real_distribution<float> screenSize(16.0f, 2048.0f);
+				std::vector<GFX::TextureResidency::Request> loads;
+				std::vector<GFX::TextureResidency::Request> evictions;
+				size_t frame = 0;
+				uint64_t missed = 0;
+				uint64_t used = 0;
+				run.Measure([&]()
+					{
+						for (size_t i = 0; i < RESIDENCY_FRAMES; ++i, ++frame)
+						{
+							// Visible window slides over textures
+							const size_t first = (frame * 4) % textures.size();
+							for (size_t j = 0; j < textures.size() / 4; ++j)
+								residency.ReportUsage(textures.at((first + j) % textures.size()), screenSize(engine));
+							loads.clear();
+							evictions.clear();
+							residency.Update(loads, evictions, 16);
+							for (const auto& load : loads)
+								residency.CompleteLoad(load.texture);
+							missed += residency.GetMissCount();
+							used += residency.GetUsedCount();
+						}
+						return static_cast<uint64_t>(RESIDENCY_FRAMES);
+					});
+				run.Metric("residentMB", static_cast<double>(residency.GetResidentBytes()) / 1048576.0);
+				run.Metric("loadedMB", static_cast<double>(residency.GetLoadedBytes()) / 1048576.0);
+				run.Metric("evictedMB", static_cast<double>(residency.GetEvictedBytes()) / 1048576.0);
+				run.Metric("missRatio", used ? static_cast<double>(missed) / static_cast<double>(used) : 0.0);
+			});
+
+		// Cases reading data from disk run only when input files are given
+		const Benchmark::Options& options = bench.GetOptions();
+		if (options.scenePath.size())
+		{
+			bench.Add("SceneFile/Load", [path = options.scenePath](Benchmark::Run& run)
+				{
+					// Headless load of scene description, compiled one is used when present
+					size_t entities = 0;
+					run.Measure([&]()
+						{
+							const GFX::SceneFile scene = GFX::SceneFile::Load(path);
+							entities = scene.cameras.size() + scene.pointLights.size() + scene.spotLights.size() + scene.directionalLights.size() + scene.models.size();
+							return static_cast<uint64_t>(entities);
+						});
+					run.Metric("entities", static_cast<double>(entities));
+				});
+		}
+		if (options.shaderArchive.size())
+		{
+			bench.Add("ShaderArchive/Open", [path = options.shaderArchive](Benchmark::Run& run)
+				{
+					size_t count = 0;
+					run.Measure([&]()
+						{
+							GFX::ShaderArchive archive;
+							if (!archive.Open(path))
+								throw std::runtime_error("Cannot open shader archive " + path);
+							count = archive.GetCount();
+							return static_cast<uint64_t>(count);
+						});
+					run.Metric("shaders", static_cast<double>(count));
+				});
+		}
+		if (options.texturePath.size())
+		{
+			bench.Add("TextureMetadata/Compute", [path = options.texturePath](Benchmark::Run& run)
+				{
+					// Decoding image and scanning its pixels when there is no sidecar
+					run.Measure([&path]()
+						{
+							GFX::Surface surface(path);
+							Benchmark::Consume(GFX::TextureMetadata(surface).GetHash());
+							return 1ULL;
+						});
+				});
+			bench.Add("TextureMetadata/Sidecar", [path = options.texturePath](Benchmark::Run& run)
+				{
+					// Creates sidecar when it is missing or outdated
+					GFX::TextureMetadata::Get(path, GFX::Surface(path));
+					run.Measure([&path]()
+						{
+							auto metadata = GFX::TextureMetadata::Read(path);
+							if (!metadata)
+								throw std::runtime_error("Cannot read metadata of " + path);
+							Benchmark::Consume(metadata->GetHash());
+							return 1ULL;
+						});
+				});
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "Benchmark.h"
+#include "Logger.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#ifdef _WIN32
+#define _USE_WINDOWS_DEFINES
+#include "WinApiExceptionMacros.h"
+#endif
+
+static void PrintHelp()
+{
+	std::cout << "Usage: Benchmark [options]\n"
+		<< "  --filter <text>     Run only cases containing text\n"
+		<< "  --json <file>       Write results as JSON document (\"-\" for standard output)\n"
+		<< "  --time <ms>         Minimal duration of single sample (default 5)\n"
+		<< "  --samples <count>   Number of samples per case (default 15)\n"
+		<< "  --exhaustive        Run precision measurements over whole input domain\n"
+		<< "  --scene <file>      Scene description used for loading benchmarks\n"
+		<< "  --shaders <file>    Shader archive used for archive open benchmark\n"
+		<< "  --texture <file>    Image used for texture metadata benchmark\n"
+#ifdef BENCHMARK_DEVICE
+		<< "  --device <dir>      Engine data directory, runs cases on GPU with real render graph\n"
+		<< "  --warp              Run device cases on software rasterizer\n"
+		<< "  --baseline <file>   Image of golden scene from earlier device run, compared with current frame, recorded when missing\n"
+#endif
+		<< "  --help              Show this message" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	Benchmark::Options options;
+	std::string jsonFile = "";
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string option = argv[i];
+		if (option == "--help")
+		{
+			PrintHelp();
+			return 0;
+		}
+		else if (option == "--exhaustive")
+			options.exhaustive = true;
+		else if (option == "--warp")
+			options.softwareDevice = true;
+		else if (i + 1 < argc)
+		{
+			const std::string value = argv[++i];
+			if (option == "--filter")
+				options.filter = value;
+			else if (option == "--json")
+				jsonFile = value;
+			else if (option == "--time")
+				options.sampleTime = std::stod(value);
+			else if (option == "--samples")
+				options.samples = std::stoull(value);
+			else if (option == "--scene")
+				options.scenePath = value;
+			else if (option == "--shaders")
+				options.shaderArchive = value;
+			else if (option == "--texture")
+				options.texturePath = value;
+			else if (option == "--device")
+				options.devicePath = value;
+			else if (option == "--baseline")
+				options.baselineImage = value;
+			else
+			{
+				std::cerr << "Unknown option: " << option << std::endl;
+				return -1;
+			}
+		}
+		else
+		{
+			std::cerr << "No value for option " << option << "!" << std::endl;
+			return -2;
+		}
+	}
+
+#ifdef _WIN32
+	// Needed by WIC for loading textures
+	WIN_ENABLE_EXCEPT();
+	WIN_THROW_FAILED(CoInitializeEx(NULL, COINIT::COINIT_MULTITHREADED));
+#endif
+	// Device cases change working directory to engine data
+	if (jsonFile.size() && jsonFile != "-")
+		jsonFile = std::filesystem::absolute(jsonFile).string();
+	if (options.baselineImage.size())
+		options.baselineImage = std::filesystem::absolute(options.baselineImage).string();
+	// Logs of measured code would mix with results, they are kept only in log file
+	Utils::Logger::SetConsoleOutput(false);
+	Benchmark bench(options);
+	Suites::AddBuffers(bench);
+	Suites::AddGeometry(bench);
+	Suites::AddScene(bench);
+	Suites::AddRendering(bench);
+	Suites::AddSystems(bench);
+#ifdef BENCHMARK_DEVICE
+	Suites::AddDevice(bench);
+#endif
+	const size_t failed = bench.Execute();
+
+	if (jsonFile == "-")
+		std::cout << bench.ToJson().dump(1, '\t') << std::endl;
+	else
+	{
+		bench.Print();
+		if (jsonFile.size())
+		{
+			std::ofstream fout(jsonFile);
+			if (!fout.good())
+			{
+				std::cerr << "Cannot open file " << jsonFile << "!" << std::endl;
+				return -5;
+			}
+			fout << bench.ToJson().dump(1, '\t');
+		}
+	}
+#ifdef _WIN32
+	CoUninitialize();
+#endif
+	return failed ? 1 : 0;
+}
\ No newline at end of file
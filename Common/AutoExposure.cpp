@@ -0,0 +1,91 @@
+#include "AutoExposure.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GFX
+{
+	AutoExposure::AutoExposure() noexcept
+	{
+		Reset();
+	}
+
+	AutoExposure::AutoExposure(const Params& params) noexcept
+		: params(params)
+	{
+		Reset();
+	}
+
+	void AutoExposure::Reset() noexcept
+	{
+		histogram.fill(0);
+		sampleCount = 0;
+		adapted = false;
+	}
+
+	void AutoExposure::BuildHistogram(const float* logLuminance, size_t count) noexcept
+	{
+		histogram.fill(0);
+		sampleCount = 0;
+		const float range = params.maxLogLuminance - params.minLogLuminance;
+		if (!(range > 0.0f))
+			return;
+
+		const float scale = BIN_COUNT / range;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float value = logLuminance[i];
+			if (value != value)
+				continue;
+			const float bin = std::clamp((value - params.minLogLuminance) * scale, 0.0f, BIN_COUNT - 1.0f);
+			++histogram[static_cast<uint32_t>(bin)];
+			++sampleCount;
+		}
+	}
+
+	float AutoExposure::GetPercentileAverage() const noexcept
+	{
+		const float binSize = (params.maxLogLuminance - params.minLogLuminance) / BIN_COUNT;
+		const float low = std::clamp(params.lowPercentile, 0.0f, 1.0f) * sampleCount;
+		const float high = std::max(std::clamp(params.highPercentile, 0.0f, 1.0f) * sampleCount, low);
+
+		// Only part of bin that lies between percentiles counts into average
+		float sum = 0.0f;
+		float weight = 0.0f;
+		float start = 0.0f;
+		for (uint32_t i = 0; i < BIN_COUNT && start < high; ++i)
+		{
+			const float end = start + histogram[i];
+			const float used = std::min(end, high) - std::max(start, low);
+			if (used > 0.0f)
+			{
+				sum += used * (params.minLogLuminance + (i + 0.5f) * binSize);
+				weight += used;
+			}
+			start = end;
+		}
+		if (weight > 0.0f)
+			return sum / weight;
+		return (params.minLogLuminance + params.maxLogLuminance) * 0.5f;
+	}
+
+	float AutoExposure::Update(float deltaTime) noexcept
+	{
+		if (sampleCount == 0)
+			return exposure;
+
+		targetLogLuminance = GetPercentileAverage();
+		if (adapted)
+		{
+			// Exponential decay towards target, independent of frame rate
+			const float speed = targetLogLuminance > adaptedLogLuminance ? params.speedUp : params.speedDown;
+			adaptedLogLuminance += (targetLogLuminance - adaptedLogLuminance) * (1.0f - std::exp(-std::max(deltaTime, 0.0f) * speed));
+		}
+		else
+		{
+			adaptedLogLuminance = targetLogLuminance;
+			adapted = true;
+		}
+		exposure = std::clamp(params.key / std::exp2(adaptedLogLuminance), params.minExposure, params.maxExposure);
+		return exposure;
+	}
+}
\ No newline at end of file
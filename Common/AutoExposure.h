@@ -0,0 +1,66 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace GFX
+{
+	// Chooses tone mapping exposure from histogram of scene log2 luminance, independent of Direct3D.
+	// Darkest and brightest pixels are skipped and average of the rest is followed with exponential adaptation.
+	class AutoExposure
+	{
+	public:
+		static constexpr uint32_t BIN_COUNT = 64U;
+
+		struct Params
+		{
+			// Range of log2 luminance covered by histogram, values outside go into edge bins
+			float minLogLuminance = -10.0f;
+			float maxLogLuminance = 6.0f;
+			// Part of pixels, sorted by luminance, used for average
+			float lowPercentile = 0.5f;
+			float highPercentile = 0.95f;
+			// Adaptation rates (1/s) when scene gets brighter or darker
+			float speedUp = 3.0f;
+			float speedDown = 1.0f;
+			// Value that adapted luminance is mapped to by exposure
+			float key = 0.5f;
+			float minExposure = 0.1f;
+			float maxExposure = 16.0f;
+		};
+
+	private:
+		Params params;
+		std::array<uint32_t, BIN_COUNT> histogram;
+		uint32_t sampleCount = 0;
+		float targetLogLuminance = 0.0f;
+		float adaptedLogLuminance = 0.0f;
+		float exposure = 1.0f;
+		bool adapted = false;
+
+	public:
+		AutoExposure() noexcept;
+		AutoExposure(const Params& params) noexcept;
+		AutoExposure(const AutoExposure&) = default;
+		AutoExposure& operator=(const AutoExposure&) = default;
+		~AutoExposure() = default;
+
+		constexpr Params& GetParams() noexcept { return params; }
+		constexpr const std::array<uint32_t, BIN_COUNT>& GetHistogram() const noexcept { return histogram; }
+		constexpr uint32_t GetSampleCount() const noexcept { return sampleCount; }
+		constexpr float GetExposure() const noexcept { return exposure; }
+		// Log2 luminance of current histogram and the one eye is adapted to
+		constexpr float GetTargetLogLuminance() const noexcept { return targetLogLuminance; }
+		constexpr float GetAdaptedLogLuminance() const noexcept { return adaptedLogLuminance; }
+
+		// Next update jumps directly to measured luminance
+		void Reset() noexcept;
+		// Replaces histogram with given log2 luminance values, NaNs are skipped
+		void BuildHistogram(const float* logLuminance, size_t count) noexcept;
+		// Average log2 luminance of histogram between low and high percentiles
+		float GetPercentileAverage() const noexcept;
+		// Adapts to current histogram over elapsed time (in s), returns new exposure
+		float Update(float deltaTime) noexcept;
+		inline float Update(const float* logLuminance, size_t count, float deltaTime) noexcept { BuildHistogram(logLuminance, count); return Update(deltaTime); }
+	};
+}
\ No newline at end of file
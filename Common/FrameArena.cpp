@@ -0,0 +1,88 @@
+#include "FrameArena.h"
+#include <cassert>
+#include <cstring>
+#include <new>
+
+namespace Utils
+{
+	FrameArena::FrameArena()
+	{
+		Reserve(buffers[0], INITIAL_SIZE);
+		Reserve(buffers[1], INITIAL_SIZE);
+	}
+
+	void FrameArena::Reserve(Buffer& buffer, size_t size) noexcept
+	{
+		buffer.memory = std::make_unique<uint8_t[]>(size);
+		buffer.size = size;
+	}
+
+	void FrameArena::ReleaseOverflow(Buffer& buffer) noexcept
+	{
+		for (auto& allocation : buffer.overflow)
+			::operator delete(allocation.first, std::align_val_t(allocation.second));
+		buffer.overflow.clear();
+		buffer.overflowSize = 0;
+	}
+
+	void* FrameArena::AllocateOverflow(Buffer& buffer, size_t size, size_t alignment) noexcept
+	{
+		void* memory = ::operator new(size, std::align_val_t(alignment), std::nothrow);
+		if (memory == nullptr)
+			return nullptr;
+		overflowAllocations.fetch_add(1, std::memory_order_relaxed);
+		std::lock_guard<std::mutex> lock(overflowMutex);
+		buffer.overflow.emplace_back(memory, alignment);
+		buffer.overflowSize += size + alignment;
+		return memory;
+	}
+
+	FrameArena::~FrameArena()
+	{
+		ReleaseOverflow(buffers[0]);
+		ReleaseOverflow(buffers[1]);
+	}
+
+	FrameArena& FrameArena::Get() noexcept
+	{
+		static FrameArena arena;
+		return arena;
+	}
+
+	void* FrameArena::Allocate(size_t size, size_t alignment) noexcept
+	{
+		assert(alignment && (alignment & (alignment - 1)) == 0);
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		Buffer& buffer = buffers[current];
+		const uintptr_t base = reinterpret_cast<uintptr_t>(buffer.memory.get());
+		size_t offset = buffer.offset.load(std::memory_order_relaxed);
+		size_t start;
+		do
+		{
+			start = ((base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - base;
+			if (start + size > buffer.size)
+				return AllocateOverflow(buffer, size, alignment);
+		} while (!buffer.offset.compare_exchange_weak(offset, start + size, std::memory_order_relaxed));
+		return buffer.memory.get() + start;
+	}
+
+	void FrameArena::NextFrame() noexcept
+	{
+		Buffer& finished = buffers[current];
+		lastSize = finished.offset.load(std::memory_order_relaxed) + finished.overflowSize;
+		lastAllocations = allocations.exchange(0, std::memory_order_relaxed);
+		lastOverflowAllocations = overflowAllocations.exchange(0, std::memory_order_relaxed);
+
+		current ^= 1;
+		Buffer& next = buffers[current];
+		ReleaseOverflow(next);
+		// Grow when last frame did not fit so steady state never touches general heap
+		if (lastSize > next.size)
+			Reserve(next, lastSize + lastSize / 2);
+#if IS_DEBUG
+		else
+			std::memset(next.memory.get(), 0xCD, next.offset.load(std::memory_order_relaxed));
+#endif
+		next.offset.store(0, std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+
+namespace Utils
+{
+	// Double-buffered bump allocator for data living no longer than one frame after it was created.
+	// Memory is never freed by its users, whole buffer is reclaimed when it becomes current again.
+	class FrameArena
+	{
+		static constexpr size_t INITIAL_SIZE = 1ULL << 22;
+
+		struct Buffer
+		{
+			std::unique_ptr<uint8_t[]> memory;
+			size_t size = 0;
+			std::atomic_size_t offset = 0;
+			// Requests not fitting into buffer, freed on next use of buffer
+			std::vector<std::pair<void*, size_t>> overflow;
+			size_t overflowSize = 0;
+		};
+
+		Buffer buffers[2];
+		uint8_t current = 0;
+		std::mutex overflowMutex;
+		std::atomic_uint64_t allocations = 0;
+		std::atomic_uint64_t overflowAllocations = 0;
+		uint64_t lastAllocations = 0;
+		uint64_t lastOverflowAllocations = 0;
+		size_t lastSize = 0;
+
+		FrameArena();
+
+		static void Reserve(Buffer& buffer, size_t size) noexcept;
+		static void ReleaseOverflow(Buffer& buffer) noexcept;
+
+		void* AllocateOverflow(Buffer& buffer, size_t size, size_t alignment) noexcept;
+
+	public:
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+		~FrameArena();
+
+		static FrameArena& Get() noexcept;
+
+		constexpr size_t GetCapacity() const noexcept { return buffers[current].size; }
+		// Statistics of last finished frame
+		constexpr uint64_t GetLastAllocations() const noexcept { return lastAllocations; }
+		constexpr uint64_t GetLastOverflowAllocations() const noexcept { return lastOverflowAllocations; }
+		constexpr size_t GetLastSize() const noexcept { return lastSize; }
+
+		// Thread safe, falls back to general heap when buffer is full, returns nullptr when that fails too
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+		// Data allocated two frames ago is no longer valid after this call
+		void NextFrame() noexcept;
+	};
+
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		constexpr ArenaAllocator() noexcept = default;
+		template<typename U>
+		constexpr ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+		inline T* allocate(size_t count)
+		{
+			if (count > SIZE_MAX / sizeof(T))
+				throw std::bad_array_new_length();
+			void* memory = FrameArena::Get().Allocate(count * sizeof(T), alignof(T));
+			if (memory == nullptr)
+				throw std::bad_alloc();
+			return static_cast<T*>(memory);
+		}
+		constexpr void deallocate(T*, size_t) noexcept {}
+
+		template<typename U>
+		constexpr bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+		template<typename U>
+		constexpr bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+	};
+
+	// Has to be recreated every frame, growing reallocates without freeing so reserve size up front
+	template<typename T>
+	using FrameVector = std::vector<T, ArenaAllocator<T>>;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "GBufferEncoding.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GFX
+{
+	namespace
+	{
+		constexpr float UNORM16_MAX = 65535.0f;
+		constexpr float UNORM8_MAX = 255.0f;
+
+		// Same rounding as float to UNORM conversion on write to render target
+		inline uint32_t ToUNorm(float value, float max) noexcept
+		{
+			return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * max + 0.5f);
+		}
+
+		inline float Sign(float value) noexcept { return value >= 0.0f ? 1.0f : -1.0f; }
+
+		inline float GetAngle(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b) noexcept
+		{
+			const float cosine = std::clamp(a.x * b.x + a.y * b.y + a.z * b.z, -1.0f, 1.0f);
+			return std::acos(cosine) * 180.0f / 3.14159265358979f;
+		}
+	}
+
+	uint32_t GBufferEncoding::EncodeNormal(const DirectX::XMFLOAT3& normal) noexcept
+	{
+		const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		float x = normal.x / length;
+		float y = normal.y / length;
+		// Lower hemisphere is folded over diagonals of upper one
+		if (normal.z < 0.0f)
+		{
+			const float foldX = (1.0f - std::abs(y)) * Sign(x);
+			y = (1.0f - std::abs(x)) * Sign(y);
+			x = foldX;
+		}
+		const float minCode = 1.0f / UNORM16_MAX;
+		return ToUNorm(std::max(x * 0.5f + 0.5f, minCode), UNORM16_MAX)
+			| (ToUNorm(std::max(y * 0.5f + 0.5f, minCode), UNORM16_MAX) << 16);
+	}
+
+	DirectX::XMFLOAT3 GBufferEncoding::DecodeNormal(uint32_t code) noexcept
+	{
+		DirectX::XMFLOAT3 normal;
+		normal.x = (code & 0xFFFF) / UNORM16_MAX * 2.0f - 1.0f;
+		normal.y = (code >> 16) / UNORM16_MAX * 2.0f - 1.0f;
+		normal.z = 1.0f - std::abs(normal.x) - std::abs(normal.y);
+		// Unfold lower hemisphere
+		const float fold = std::max(-normal.z, 0.0f);
+		normal.x += normal.x >= 0.0f ? -fold : fold;
+		normal.y += normal.y >= 0.0f ? -fold : fold;
+		const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+		return { normal.x / length, normal.y / length, normal.z / length };
+	}
+
+	uint32_t GBufferEncoding::EncodeSpecular(const DirectX::XMFLOAT3& color, float power) noexcept
+	{
+		return ToUNorm(color.x / SPECULAR_RANGE, UNORM8_MAX) | (ToUNorm(color.y / SPECULAR_RANGE, UNORM8_MAX) << 8)
+			| (ToUNorm(color.z / SPECULAR_RANGE, UNORM8_MAX) << 16) | (ToUNorm(power, UNORM8_MAX) << 24);
+	}
+
+	DirectX::XMFLOAT4 GBufferEncoding::DecodeSpecular(uint32_t code) noexcept
+	{
+		return
+		{
+			(code & 0xFF) / UNORM8_MAX * SPECULAR_RANGE,
+			((code >> 8) & 0xFF) / UNORM8_MAX * SPECULAR_RANGE,
+			((code >> 16) & 0xFF) / UNORM8_MAX * SPECULAR_RANGE,
+			std::exp2((code >> 24) / UNORM8_MAX * SPECULAR_POWER_SCALE)
+		};
+	}
+
+	GBufferEncoding::NormalError GBufferEncoding::MeasureNormalPrecision(uint32_t steps) noexcept
+	{
+		NormalError error = { 0.0f, 0.0f, 0 };
+		if (steps < 2)
+			return error;
+
+		// Directions from uniform grid over octahedron cover sphere densely without poles being oversampled
+		double angleSum = 0.0;
+		const float step = 2.0f / (steps - 1);
+		for (uint32_t i = 0; i < steps; ++i)
+		{
+			for (uint32_t j = 0; j < steps; ++j)
+			{
+				const float x = -1.0f + step * j;
+				const float y = -1.0f + step * i;
+				DirectX::XMFLOAT3 direction = { x, y, 1.0f - std::abs(x) - std::abs(y) };
+				if (direction.z < 0.0f)
+				{
+					direction.x += direction.x >= 0.0f ? direction.z : -direction.z;
+					direction.y += direction.y >= 0.0f ? direction.z : -direction.z;
+				}
+				const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+				direction = { direction.x / length, direction.y / length, direction.z / length };
+
+				const float angle = GetAngle(direction, DecodeNormal(EncodeNormal(direction)));
+				error.maxAngle = std::max(error.maxAngle, angle);
+				angleSum += angle;
+
+				// Codes with any channel equal to 0 are never written
+				const uint32_t code = std::max(static_cast<uint32_t>(static_cast<uint64_t>(j) * 65535 / (steps - 1)), 1U)
+					| (std::max(static_cast<uint32_t>(static_cast<uint64_t>(i) * 65535 / (steps - 1)), 1U) << 16);
+				// Edges of octahedron describe same normal twice and may move to mirrored code once,
+				// afterwards repeated decoding and encoding must not drift
+				const uint32_t reencoded = EncodeNormal(DecodeNormal(code));
+				if (EncodeNormal(DecodeNormal(reencoded)) != reencoded)
+					++error.unstableCodes;
+			}
+		}
+		error.meanAngle = static_cast<float>(angleSum / (static_cast<double>(steps) * steps));
+		return error;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+
+namespace GFX
+{
+	// Reference of G-buffer packing done by shaders (EncodeNormal, EncodeSpecular in UtilsPS.hlsli and decoding in LightUtilsPS.hlsli).
+	// Codes are stored the same way as in R16G16_UNORM and R8G8B8A8_UNORM textures, first channel in lowest bits.
+	class GBufferEncoding
+	{
+	public:
+		// Max value of specular color channel after scaling by intensity, brighter channels are clipped to it.
+		// Range is kept small for precision of 8 bit codes (step 0.016), so material intensity is limited to it
+		static constexpr float SPECULAR_RANGE = 4.0f;
+		// Specular power is mapped into exponent 2^(13 * power)
+		static constexpr float SPECULAR_POWER_SCALE = 13.0f;
+
+		struct NormalError
+		{
+			// In degrees
+			float maxAngle;
+			float meanAngle;
+			// Codes that keep changing after repeated decoding and encoding
+			uint64_t unstableCodes;
+		};
+
+		// Octahedral mapping, code 0 is reserved for pixels without geometry
+		static uint32_t EncodeNormal(const DirectX::XMFLOAT3& normal) noexcept;
+		static DirectX::XMFLOAT3 DecodeNormal(uint32_t code) noexcept;
+		// Color has to be already scaled by intensity, power is value before mapping into exponent
+		static uint32_t EncodeSpecular(const DirectX::XMFLOAT3& color, float power) noexcept;
+		// Returns color in XYZ and exponent in W
+		static DirectX::XMFLOAT4 DecodeSpecular(uint32_t code) noexcept;
+
+		// Angular error of normals sampled from grid of steps x steps directions over whole sphere,
+		// stability is checked for codes on grid of same size. Exhaustive check of all codes uses 65536 steps
+		static NormalError MeasureNormalPrecision(uint32_t steps) noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "LightBounds.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace GFX
+{
+	DirectX::BoundingSphere LightBounds::GetConeSphere(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& direction, float length, float angle) noexcept
+	{
+		const float tangent = std::tan(angle);
+		// Wide cones are bounded by sphere around base, narrow ones by sphere through apex and base rim
+		const float center = tangent > 1.0f ? length : 0.5f * length * (1.0f + tangent * tangent);
+		DirectX::BoundingSphere sphere;
+		DirectX::XMStoreFloat3(&sphere.Center, DirectX::XMVectorMultiplyAdd(DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction)),
+			DirectX::XMVectorReplicate(center), DirectX::XMLoadFloat3(&position)));
+		sphere.Radius = tangent > 1.0f ? length * tangent : center;
+		return sphere;
+	}
+
+	bool LightBounds::Project(const DirectX::BoundingSphere& volume, const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& projection,
+		uint32_t width, uint32_t height, Screen& bounds) noexcept
+	{
+		DirectX::XMFLOAT4X4 proj;
+		DirectX::XMStoreFloat4x4(&proj, projection);
+		const float nearClip = -proj._43 / proj._33;
+		const float farClip = proj._43 / (1.0f - proj._33);
+
+		DirectX::XMFLOAT3 center;
+		DirectX::XMStoreFloat3(&center, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&volume.Center), view));
+		const float radius = volume.Radius;
+		if (center.z + radius < nearClip || center.z - radius > farClip)
+			return false;
+		bounds.minDepth = std::max(nearClip, center.z - radius);
+		bounds.maxDepth = std::min(farClip, center.z + radius);
+
+		// Box around sphere cut by near plane, its projection contains projected sphere
+		float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX;
+		for (uint8_t i = 0; i < 8; ++i)
+		{
+			const DirectX::XMVECTOR corner = DirectX::XMVectorSet(center.x + (i & 1 ? radius : -radius),
+				center.y + (i & 2 ? radius : -radius), i & 4 ? bounds.maxDepth : bounds.minDepth, 1.0f);
+			DirectX::XMFLOAT4 position;
+			DirectX::XMStoreFloat4(&position, DirectX::XMVector4Transform(corner, projection));
+			const float invW = 1.0f / position.w;
+			minX = std::min(minX, position.x * invW);
+			maxX = std::max(maxX, position.x * invW);
+			minY = std::min(minY, position.y * invW);
+			maxY = std::max(maxY, position.y * invW);
+		}
+
+		const float screenWidth = static_cast<float>(width);
+		const float screenHeight = static_cast<float>(height);
+		bounds.left = static_cast<int32_t>(std::clamp(std::floor((minX + 1.0f) * 0.5f * screenWidth), 0.0f, screenWidth));
+		bounds.right = static_cast<int32_t>(std::clamp(std::ceil((maxX + 1.0f) * 0.5f * screenWidth), 0.0f, screenWidth));
+		bounds.top = static_cast<int32_t>(std::clamp(std::floor((1.0f - maxY) * 0.5f * screenHeight), 0.0f, screenHeight));
+		bounds.bottom = static_cast<int32_t>(std::clamp(std::ceil((1.0f - minY) * 0.5f * screenHeight), 0.0f, screenHeight));
+		return bounds.left < bounds.right && bounds.top < bounds.bottom;
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+#include <cstdint>
+
+namespace GFX
+{
+	// Screen space bounds of light volumes, used to limit pixels shaded by light passes
+	class LightBounds
+	{
+	public:
+		struct Screen
+		{
+			// Pixel rectangle, right and bottom are exclusive
+			int32_t left;
+			int32_t top;
+			int32_t right;
+			int32_t bottom;
+			// View space depth range of volume
+			float minDepth;
+			float maxDepth;
+
+			constexpr uint64_t GetArea() const noexcept { return static_cast<uint64_t>(right - left) * static_cast<uint64_t>(bottom - top); }
+		};
+
+		// Minimal sphere around cone with apex at position, length is measured along direction
+		static DirectX::BoundingSphere GetConeSphere(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& direction, float length, float angle) noexcept;
+		// Returns false when volume is outside of view. Projection have to be perspective
+		static bool Project(const DirectX::BoundingSphere& volume, const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& projection,
+			uint32_t width, uint32_t height, Screen& bounds) noexcept;
+	};
+}
@@ -0,0 +1,176 @@
+#include "Logger.h"
+#include <iostream>
+#include <fstream>
+
+namespace Utils
+{
+	std::atomic<Logger::Level> Logger::level = Logger::COMPILED_LEVEL;
+	std::atomic_bool Logger::consoleOutput = true;
+	thread_local std::vector<Logger::Entry>* Logger::capture = nullptr;
+
+	Logger& Logger::Get() noexcept
+	{
+		static Logger logger;
+		return logger;
+	}
+
+	void Logger::Log(Level type, const std::string& log, Fields* fields)
+	{
+		if (type < GetLevel())
+			return;
+		Entry entry = { type, fields != nullptr, log, fields ? std::move(*fields) : Fields{}, std::chrono::system_clock::now() };
+		if (capture)
+			capture->emplace_back(std::move(entry));
+		else
+			Get().Push(new Entry(std::move(entry)));
+	}
+
+	Logger::Logger()
+	{
+		writer = std::thread([this]() { Write(); });
+	}
+
+	void Logger::Push(Entry* entry) noexcept
+	{
+		pushedCount.fetch_add(1, std::memory_order_relaxed);
+		Entry* head = pending.load(std::memory_order_relaxed);
+		do
+		{
+			entry->next = head;
+		} while (!pending.compare_exchange_weak(head, entry, std::memory_order_release, std::memory_order_relaxed));
+		// Writer sleeps only on empty stack so only first message of batch has to wake it
+		if (head == nullptr)
+			pending.notify_one();
+	}
+
+	void Logger::Write() noexcept
+	{
+		std::ofstream fout;
+		bool fileOpened = false;
+		std::string console, file;
+		for (;;)
+		{
+			pending.wait(nullptr, std::memory_order_acquire);
+			Entry* batch = pending.exchange(nullptr, std::memory_order_acquire);
+			// Reverse to order of pushing
+			Entry* ordered = nullptr;
+			while (batch)
+			{
+				Entry* next = batch->next;
+				batch->next = ordered;
+				ordered = batch;
+				batch = next;
+			}
+
+			console.clear();
+			file.clear();
+			uint64_t written = 0;
+			while (ordered)
+			{
+				++written;
+				if (ordered == &stopEntry)
+				{
+					ordered = ordered->next;
+					continue;
+				}
+				std::string line;
+				switch (ordered->type)
+				{
+				case Level::Debug:
+				{
+					line = "[DEBUG] ";
+					break;
+				}
+				case Level::Info:
+				{
+					line = "[INFO] ";
+					break;
+				}
+				case Level::Warning:
+				{
+					line = "[WARNING] ";
+					break;
+				}
+				case Level::Error:
+				{
+					line = "[ERROR] ";
+					break;
+				}
+				}
+				line += ordered->log;
+				if (ordered->fields.file.size())
+					line += " | file: \"" + ordered->fields.file + "\"";
+				if (ordered->fields.command.size())
+					line += " | command: " + ordered->fields.command;
+				if (ordered->fields.duration >= 0.0f)
+					line += " | duration: " + std::to_string(ordered->fields.duration) + " ms";
+				line += '\n';
+				if (ordered->record)
+					file += line;
+				console += line;
+
+				Entry* next = ordered->next;
+				delete ordered;
+				ordered = next;
+			}
+
+			if (file.size())
+			{
+				if (!fileOpened)
+				{
+					fileOpened = true;
+					fout.open(LOG_FILE, std::ofstream::trunc);
+				}
+				if (fout.good())
+					fout.write(file.data(), file.size()).flush();
+				else
+					console = "[ERROR] Cannot open log file! Inner log:\n\t" + console;
+			}
+			if (consoleOutput.load(std::memory_order_relaxed))
+				std::cout.write(console.data(), console.size()).flush();
+			writtenCount.fetch_add(written, std::memory_order_release);
+			writtenCount.notify_all();
+			if (!running && pending.load(std::memory_order_acquire) == nullptr)
+				break;
+		}
+	}
+
+	Logger::~Logger()
+	{
+		running = false;
+		// Wakes writer even when nothing is pending
+		Push(&stopEntry);
+		writer.join();
+	}
+
+	bool Logger::ParseLevel(const std::string& name, Level& minLevel) noexcept
+	{
+		if (name == "debug")
+			minLevel = Level::Debug;
+		else if (name == "info")
+			minLevel = Level::Info;
+		else if (name == "warning")
+			minLevel = Level::Warning;
+		else if (name == "error")
+			minLevel = Level::Error;
+		else
+			return false;
+		return true;
+	}
+
+	void Logger::Drain() noexcept
+	{
+		Logger& logger = Get();
+		const uint64_t target = logger.pushedCount.load(std::memory_order_relaxed);
+		for (uint64_t written = logger.writtenCount.load(std::memory_order_acquire); written < target; written = logger.writtenCount.load(std::memory_order_acquire))
+			logger.writtenCount.wait(written, std::memory_order_acquire);
+	}
+
+	void Logger::Flush(Buffer& buffer)
+	{
+		Logger& logger = Get();
+		for (auto& entry : buffer)
+			logger.Push(new Entry(std::move(entry)));
+		buffer.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+// Messages below this level are removed at compile time
+#ifndef LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define LOG_MIN_LEVEL 0
+#else
+#define LOG_MIN_LEVEL 1
+#endif
+#endif
+
+namespace Utils
+{
+	// Messages are queued without locking and written in batches by background thread
+	class Logger
+	{
+	public:
+		enum class Level : uint8_t { Debug, Info, Warning, Error };
+
+		// Context of message, entries containing fields are stored in log file too
+		struct Fields
+		{
+			std::string file = "";
+			std::string command = "";
+			// Time in ms, negative when not measured
+			float duration = -1.0f;
+		};
+
+	private:
+		struct Entry
+		{
+			Level type = Level::Debug;
+			bool record = false;
+			std::string log = "";
+			Fields fields = {};
+			std::chrono::system_clock::time_point time = {};
+			Entry* next = nullptr;
+		};
+
+		static constexpr const char* LOG_FILE = "log.txt";
+		static constexpr Level COMPILED_LEVEL = static_cast<Level>(LOG_MIN_LEVEL);
+
+		static std::atomic<Level> level;
+		static std::atomic_bool consoleOutput;
+		static thread_local std::vector<Entry>* capture;
+
+		// Stack of pending entries, writer takes all of them at once and restores their order
+		std::atomic<Entry*> pending = nullptr;
+		std::atomic_uint64_t pushedCount = 0;
+		std::atomic_uint64_t writtenCount = 0;
+		std::atomic_bool running = true;
+		// Pushed on shutdown to wake writer, never printed
+		Entry stopEntry = {};
+		std::thread writer;
+
+		static Logger& Get() noexcept;
+		static void Log(Level type, const std::string& log, Fields* fields = nullptr);
+
+		Logger();
+
+		void Push(Entry* entry) noexcept;
+		void Write() noexcept;
+
+	public:
+		using Buffer = std::vector<Entry>;
+
+		Logger(const Logger&) = delete;
+		Logger& operator=(const Logger&) = delete;
+		~Logger();
+
+		static inline Level GetLevel() noexcept { return level.load(std::memory_order_relaxed); }
+		static inline void SetLevel(Level minLevel) noexcept { level.store(minLevel, std::memory_order_relaxed); }
+		static bool ParseLevel(const std::string& name, Level& minLevel) noexcept;
+		// When disabled messages are only stored in log file, keeps standard output free for other data
+		static inline void SetConsoleOutput(bool enable) noexcept { consoleOutput.store(enable, std::memory_order_relaxed); }
+		// Blocks until all messages pushed before the call are written
+		static void Drain() noexcept;
+
+		// Logs of current thread are stored in buffer until flushed, keeps output ordered between concurrent commands
+		static inline void BeginCapture(Buffer& buffer) noexcept { capture = &buffer; }
+		static inline void EndCapture() noexcept { capture = nullptr; }
+		static void Flush(Buffer& buffer);
+
+		static inline void Debug(const std::string& debug) { if constexpr (COMPILED_LEVEL <= Level::Debug) Log(Level::Debug, debug); }
+		static inline void Info(const std::string& info) { if constexpr (COMPILED_LEVEL <= Level::Info) Log(Level::Info, info); }
+		static inline void Info(const std::string& info, Fields fields) { if constexpr (COMPILED_LEVEL <= Level::Info) Log(Level::Info, info, &fields); }
+		static inline void Warning(const std::string& warning) { if constexpr (COMPILED_LEVEL <= Level::Warning) Log(Level::Warning, warning); }
+		static inline void Warning(const std::string& warning, Fields fields) { if constexpr (COMPILED_LEVEL <= Level::Warning) Log(Level::Warning, warning, &fields); }
+		static inline void Error(const std::string& error) { Log(Level::Error, error); }
+		static inline void Error(const std::string& error, Fields fields) { Log(Level::Error, error, &fields); }
+	};
+}
\ No newline at end of file
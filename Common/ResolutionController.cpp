@@ -0,0 +1,53 @@
+#include "ResolutionController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GFX
+{
+	ResolutionController::ResolutionController() noexcept
+	{
+		Reset();
+	}
+
+	ResolutionController::ResolutionController(const Params& params) noexcept
+		: params(params)
+	{
+		Reset();
+	}
+
+	void ResolutionController::Reset() noexcept
+	{
+		scale = params.maxScale;
+		area = scale * scale;
+		filteredTime = lastError = previousError = 0.0f;
+		updates = 0;
+	}
+
+	float ResolutionController::Update(float frameTime) noexcept
+	{
+		if (!(frameTime > 0.0f))
+			return scale;
+		filteredTime = updates++ ? filteredTime + (frameTime - filteredTime) * params.smoothing : frameTime;
+
+		// Positive when frame is below budget and area can grow
+		float error = (params.targetTime - filteredTime) / params.targetTime;
+		if (std::abs(error) <= params.deadband)
+			error = 0.0f;
+		else
+			error -= std::copysign(params.deadband, error);
+
+		// Velocity form, integral part drives area towards budget while proportional and derivative ones damp changes.
+		// Output is clamped directly so there is no integral windup
+		const float step = std::clamp(params.integral * error + params.proportional * (error - lastError)
+			+ params.derivative * (error - 2.0f * lastError + previousError), -params.maxStep, params.maxStep);
+		previousError = lastError;
+		lastError = error;
+		area = std::clamp(area * (1.0f + step), params.minScale * params.minScale, params.maxScale * params.maxScale);
+
+		// Quantized scale keeps previous value while area changes within single step
+		const float target = std::sqrt(area);
+		if (std::abs(target - scale) >= params.quantization || target == params.minScale || target == params.maxScale)
+			scale = std::clamp(std::round(target / params.quantization) * params.quantization, params.minScale, params.maxScale);
+		return scale;
+	}
+}
\ No newline at end of file
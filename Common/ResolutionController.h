@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+
+namespace GFX
+{
+	// Chooses render scale for dynamic resolution from measured frame times, independent of Direct3D.
+	// Incremental PID controller works on rendered area (scale squared) since frame time of GPU bound frame is proportional to it.
+	class ResolutionController
+	{
+	public:
+		struct Params
+		{
+			// Frame budget in ms
+			float targetTime = 16.0f;
+			float minScale = 0.5f;
+			float maxScale = 1.0f;
+			// Gains for relative error of frame time
+			float proportional = 0.2f;
+			float integral = 0.3f;
+			float derivative = 0.05f;
+			// Relative error ignored so noise do not change resolution
+			float deadband = 0.04f;
+			// Max relative change of area in single update
+			float maxStep = 0.08f;
+			// Weight of new frame time in filtered one
+			float smoothing = 0.25f;
+			// Returned scale is multiple of this value so render targets are not resized by tiny steps every frame
+			float quantization = 1.0f / 64.0f;
+		};
+
+	private:
+		Params params;
+		float area;
+		float scale;
+		float filteredTime = 0.0f;
+		float lastError = 0.0f;
+		float previousError = 0.0f;
+		uint64_t updates = 0;
+
+	public:
+		ResolutionController() noexcept;
+		ResolutionController(const Params& params) noexcept;
+		ResolutionController(const ResolutionController&) = default;
+		ResolutionController& operator=(const ResolutionController&) = default;
+		~ResolutionController() = default;
+
+		constexpr Params& GetParams() noexcept { return params; }
+		constexpr float GetScale() const noexcept { return scale; }
+		constexpr float GetFilteredTime() const noexcept { return filteredTime; }
+
+		// Starts again from max scale, should be called after changing params
+		void Reset() noexcept;
+		// Frame time in ms, returns scale for next frame
+		float Update(float frameTime) noexcept;
+	};
+}
\ No newline at end of file
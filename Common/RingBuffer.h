@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <optional>
+
+namespace Utils
+{
+	// Fixed size queue for single producer and single consumer thread, works without locks.
+	// Capacity has to be power of 2, when buffer is full new elements are rejected.
+	template<typename T, size_t Capacity>
+	class RingBuffer
+	{
+		static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "Capacity of RingBuffer has to be power of 2!");
+
+		static constexpr size_t CACHE_LINE = 64U;
+		static constexpr size_t MASK = Capacity - 1;
+
+		// Indices only grow, every side keeps last seen index of the other one to avoid touching its cache line
+		alignas(CACHE_LINE) std::atomic<size_t> head = 0;
+		size_t cachedTail = 0;
+		alignas(CACHE_LINE) std::atomic<size_t> tail = 0;
+		size_t cachedHead = 0;
+		alignas(CACHE_LINE) std::array<T, Capacity> buffer;
+
+	public:
+		RingBuffer() = default;
+		RingBuffer(const RingBuffer&) = delete;
+		RingBuffer& operator=(const RingBuffer&) = delete;
+		~RingBuffer() = default;
+
+		static constexpr size_t GetCapacity() noexcept { return Capacity; }
+
+		inline bool IsEmpty() const noexcept { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+		inline size_t GetSize() const noexcept { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+
+		// Producer only
+		bool Push(const T& value) noexcept;
+		// Consumer only
+		std::optional<T> Pop() noexcept;
+		// Consumer only, drops all elements pushed so far
+		inline void Clear() noexcept { head.store(cachedTail = tail.load(std::memory_order_acquire), std::memory_order_release); }
+	};
+
+	template<typename T, size_t Capacity>
+	bool RingBuffer<T, Capacity>::Push(const T& value) noexcept
+	{
+		const size_t current = tail.load(std::memory_order_relaxed);
+		if (current - cachedHead == Capacity)
+		{
+			cachedHead = head.load(std::memory_order_acquire);
+			if (current - cachedHead == Capacity)
+				return false;
+		}
+		buffer[current & MASK] = value;
+		tail.store(current + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T, size_t Capacity>
+	std::optional<T> RingBuffer<T, Capacity>::Pop() noexcept
+	{
+		const size_t current = head.load(std::memory_order_relaxed);
+		if (current == cachedTail)
+		{
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (current == cachedTail)
+				return {};
+		}
+		T value = buffer[current & MASK];
+		head.store(current + 1, std::memory_order_release);
+		return value;
+	}
+}
\ No newline at end of file
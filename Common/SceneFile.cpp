@@ -0,0 +1,340 @@
+#include "SceneFile.h"
+#include "json.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+
+#define SCENE_EXCEPT(info) GFX::SceneFile::SceneException(__LINE__, __FILE__, info)
+
+namespace GFX
+{
+	class BinaryWriter
+	{
+		std::ofstream& fout;
+
+	public:
+		constexpr BinaryWriter(std::ofstream& fout) noexcept : fout(fout) {}
+
+		template<typename T>
+		inline void Write(const T& value) { fout.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+		inline void Write(const std::string& value)
+		{
+			Write(static_cast<uint32_t>(value.size()));
+			fout.write(value.data(), value.size());
+		}
+	};
+
+	class BinaryReader
+	{
+		const std::vector<char>& data;
+		size_t offset = 0;
+
+	public:
+		constexpr BinaryReader(const std::vector<char>& data) noexcept : data(data) {}
+
+		template<typename T>
+		inline void Read(T& value)
+		{
+			if (offset + sizeof(T) > data.size())
+				throw SCENE_EXCEPT("Unexpected end of compiled scene!");
+			std::memcpy(&value, data.data() + offset, sizeof(T));
+			offset += sizeof(T);
+		}
+		inline void Read(std::string& value)
+		{
+			uint32_t size;
+			Read(size);
+			if (offset + size > data.size())
+				throw SCENE_EXCEPT("Unexpected end of compiled scene!");
+			value.assign(data.data() + offset, size);
+			offset += size;
+		}
+		// Count of elements that take at least given number of bytes each, so corrupted count cannot cause huge allocation
+		inline uint32_t ReadCount(size_t elementSize)
+		{
+			uint32_t count;
+			Read(count);
+			if (count > (data.size() - offset) / elementSize)
+				throw SCENE_EXCEPT("Unexpected end of compiled scene!");
+			return count;
+		}
+	};
+
+	static DirectX::XMFLOAT3 GetFloat3(const nlohmann::json& json, const char* key, const DirectX::XMFLOAT3& value)
+	{
+		if (!json.contains(key))
+			return value;
+		const auto& array = json.at(key);
+		return { array.at(0).get<float>(), array.at(1).get<float>(), array.at(2).get<float>() };
+	}
+
+	static DirectX::XMFLOAT3 GetAngles(const nlohmann::json& json, const char* key)
+	{
+		const DirectX::XMFLOAT3 angles = GetFloat3(json, key, { 0.0f, 0.0f, 0.0f });
+		return { DirectX::XMConvertToRadians(angles.x), DirectX::XMConvertToRadians(angles.y), DirectX::XMConvertToRadians(angles.z) };
+	}
+
+	static DirectX::XMFLOAT3 GetDirection(const nlohmann::json& json, const DirectX::XMFLOAT3& value)
+	{
+		DirectX::XMFLOAT3 direction = GetFloat3(json, "direction", value);
+		DirectX::XMStoreFloat3(&direction, DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction)));
+		return direction;
+	}
+
+	std::string SceneFile::GetCompiledPath(const std::string& path) noexcept
+	{
+		return std::filesystem::path(path).replace_extension(COMPILED_EXTENSION).string();
+	}
+
+	SceneFile SceneFile::Load(const std::string& path)
+	{
+		if (std::filesystem::path(path).extension() == COMPILED_EXTENSION)
+			return ReadBinary(path);
+
+		const std::string compiled = GetCompiledPath(path);
+		std::error_code error;
+		if (std::filesystem::exists(compiled, error) &&
+			std::filesystem::last_write_time(compiled, error) >= std::filesystem::last_write_time(path, error) && !error)
+		{
+			try
+			{
+				return ReadBinary(compiled);
+			}
+			catch (const SceneException&)
+			{
+				// Truncated, corrupted or from older version, compiled again from JSON
+			}
+		}
+
+		SceneFile scene = ParseJson(path);
+		try
+		{
+			scene.WriteBinary(compiled);
+		}
+		catch (const SceneException&)
+		{
+			// Read-only location, JSON will be parsed next time again
+		}
+		return scene;
+	}
+
+	SceneFile SceneFile::ParseJson(const std::string& path)
+	{
+		std::ifstream fin(path);
+		if (!fin.good())
+			throw SCENE_EXCEPT("Cannot open scene file \"" + path + "\"!");
+		SceneFile scene;
+		try
+		{
+			nlohmann::json json;
+			fin >> json;
+			for (const auto& entry : json.value("cameras", nlohmann::json::array()))
+			{
+				Camera& camera = scene.cameras.emplace_back();
+				camera.name = entry.at("name").get<std::string>();
+				camera.position = GetFloat3(entry, "position", camera.position);
+				camera.angleHorizontal = DirectX::XMConvertToRadians(entry.value("angleHorizontal", 0.0f));
+				camera.angleVertical = DirectX::XMConvertToRadians(entry.value("angleVertical", 0.0f));
+				camera.fov = DirectX::XMConvertToRadians(entry.value("fov", 60.0f));
+				camera.nearClip = entry.value("nearClip", camera.nearClip);
+				camera.farClip = entry.value("farClip", camera.farClip);
+				camera.type = entry.value("type", std::string("person")) == "floating" ? 1 : 0;
+			}
+			for (const auto& entry : json.value("pointLights", nlohmann::json::array()))
+			{
+				PointLight& light = scene.pointLights.emplace_back();
+				light.name = entry.at("name").get<std::string>();
+				light.intensity = entry.value("intensity", light.intensity);
+				light.color = GetFloat3(entry, "color", light.color);
+				light.position = GetFloat3(entry, "position", light.position);
+				light.range = entry.value("range", light.range);
+				light.radius = entry.value("radius", light.radius);
+				light.castShadows = entry.value("castShadows", light.castShadows);
+			}
+			for (const auto& entry : json.value("spotLights", nlohmann::json::array()))
+			{
+				SpotLight& light = scene.spotLights.emplace_back();
+				light.name = entry.at("name").get<std::string>();
+				light.intensity = entry.value("intensity", light.intensity);
+				light.color = GetFloat3(entry, "color", light.color);
+				light.position = GetFloat3(entry, "position", light.position);
+				light.range = entry.value("range", light.range);
+				light.size = entry.value("size", light.size);
+				light.innerAngle = DirectX::XMConvertToRadians(entry.value("innerAngle", 15.0f));
+				light.outerAngle = DirectX::XMConvertToRadians(entry.value("outerAngle", 30.0f));
+				light.direction = GetDirection(entry, light.direction);
+			}
+			for (const auto& entry : json.value("directionalLights", nlohmann::json::array()))
+			{
+				DirectionalLight& light = scene.directionalLights.emplace_back();
+				light.name = entry.at("name").get<std::string>();
+				light.intensity = entry.value("intensity", light.intensity);
+				light.color = GetFloat3(entry, "color", light.color);
+				light.direction = GetDirection(entry, light.direction);
+			}
+			for (const auto& entry : json.value("models", nlohmann::json::array()))
+			{
+				Model& model = scene.models.emplace_back();
+				model.name = entry.at("name").get<std::string>();
+				model.file = entry.at("file").get<std::string>();
+				model.position = GetFloat3(entry, "position", model.position);
+				model.rotation = GetAngles(entry, "rotation");
+				model.scale = entry.value("scale", model.scale);
+			}
+		}
+		catch (const nlohmann::json::exception& e)
+		{
+			throw SCENE_EXCEPT("Incorrect scene file \"" + path + "\": " + e.what());
+		}
+		return scene;
+	}
+
+	SceneFile SceneFile::ReadBinary(const std::string& path)
+	{
+		std::ifstream fin(path, std::ios::binary | std::ios::ate);
+		if (!fin.good())
+			throw SCENE_EXCEPT("Cannot open compiled scene \"" + path + "\"!");
+		std::vector<char> data(static_cast<size_t>(fin.tellg()));
+		fin.seekg(0);
+		fin.read(data.data(), data.size());
+
+		BinaryReader reader(data);
+		uint32_t magic, version;
+		reader.Read(magic);
+		reader.Read(version);
+		if (magic != MAGIC || version != VERSION)
+			throw SCENE_EXCEPT("Compiled scene \"" + path + "\" has unsupported format!");
+
+		SceneFile scene;
+		scene.cameras.resize(reader.ReadCount(sizeof(uint32_t) + sizeof(DirectX::XMFLOAT3) + 5 * sizeof(float) + sizeof(uint8_t)));
+		for (auto& camera : scene.cameras)
+		{
+			reader.Read(camera.name);
+			reader.Read(camera.position);
+			reader.Read(camera.angleHorizontal);
+			reader.Read(camera.angleVertical);
+			reader.Read(camera.fov);
+			reader.Read(camera.nearClip);
+			reader.Read(camera.farClip);
+			reader.Read(camera.type);
+		}
+		scene.pointLights.resize(reader.ReadCount(sizeof(uint32_t) + 2 * sizeof(DirectX::XMFLOAT3) + 2 * sizeof(float) + sizeof(uint32_t) + sizeof(bool)));
+		for (auto& light : scene.pointLights)
+		{
+			reader.Read(light.name);
+			reader.Read(light.intensity);
+			reader.Read(light.color);
+			reader.Read(light.position);
+			reader.Read(light.range);
+			reader.Read(light.radius);
+			reader.Read(light.castShadows);
+		}
+		scene.spotLights.resize(reader.ReadCount(sizeof(uint32_t) + 3 * sizeof(DirectX::XMFLOAT3) + 4 * sizeof(float) + sizeof(uint32_t)));
+		for (auto& light : scene.spotLights)
+		{
+			reader.Read(light.name);
+			reader.Read(light.intensity);
+			reader.Read(light.color);
+			reader.Read(light.position);
+			reader.Read(light.range);
+			reader.Read(light.size);
+			reader.Read(light.innerAngle);
+			reader.Read(light.outerAngle);
+			reader.Read(light.direction);
+		}
+		scene.directionalLights.resize(reader.ReadCount(sizeof(uint32_t) + 2 * sizeof(DirectX::XMFLOAT3) + sizeof(float)));
+		for (auto& light : scene.directionalLights)
+		{
+			reader.Read(light.name);
+			reader.Read(light.intensity);
+			reader.Read(light.color);
+			reader.Read(light.direction);
+		}
+		scene.models.resize(reader.ReadCount(2 * sizeof(uint32_t) + 2 * sizeof(DirectX::XMFLOAT3) + sizeof(float)));
+		for (auto& model : scene.models)
+		{
+			reader.Read(model.name);
+			reader.Read(model.file);
+			reader.Read(model.position);
+			reader.Read(model.rotation);
+			reader.Read(model.scale);
+		}
+		return scene;
+	}
+
+	void SceneFile::WriteBinary(const std::string& path) const
+	{
+		std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+		if (!fout.good())
+			throw SCENE_EXCEPT("Cannot create compiled scene \"" + path + "\"!");
+		BinaryWriter writer(fout);
+		writer.Write(MAGIC);
+		writer.Write(VERSION);
+		writer.Write(static_cast<uint32_t>(cameras.size()));
+		for (const auto& camera : cameras)
+		{
+			writer.Write(camera.name);
+			writer.Write(camera.position);
+			writer.Write(camera.angleHorizontal);
+			writer.Write(camera.angleVertical);
+			writer.Write(camera.fov);
+			writer.Write(camera.nearClip);
+			writer.Write(camera.farClip);
+			writer.Write(camera.type);
+		}
+		writer.Write(static_cast<uint32_t>(pointLights.size()));
+		for (const auto& light : pointLights)
+		{
+			writer.Write(light.name);
+			writer.Write(light.intensity);
+			writer.Write(light.color);
+			writer.Write(light.position);
+			writer.Write(light.range);
+			writer.Write(light.radius);
+			writer.Write(light.castShadows);
+		}
+		writer.Write(static_cast<uint32_t>(spotLights.size()));
+		for (const auto& light : spotLights)
+		{
+			writer.Write(light.name);
+			writer.Write(light.intensity);
+			writer.Write(light.color);
+			writer.Write(light.position);
+			writer.Write(light.range);
+			writer.Write(light.size);
+			writer.Write(light.innerAngle);
+			writer.Write(light.outerAngle);
+			writer.Write(light.direction);
+		}
+		writer.Write(static_cast<uint32_t>(directionalLights.size()));
+		for (const auto& light : directionalLights)
+		{
+			writer.Write(light.name);
+			writer.Write(light.intensity);
+			writer.Write(light.color);
+			writer.Write(light.direction);
+		}
+		writer.Write(static_cast<uint32_t>(models.size()));
+		for (const auto& model : models)
+		{
+			writer.Write(model.name);
+			writer.Write(model.file);
+			writer.Write(model.position);
+			writer.Write(model.rotation);
+			writer.Write(model.scale);
+		}
+		if (!fout.good())
+			throw SCENE_EXCEPT("Error writing compiled scene \"" + path + "\"!");
+	}
+
+#pragma region Exception
+	const char* SceneFile::SceneException::what() const noexcept
+	{
+		std::ostringstream stream;
+		stream << this->BasicException::what()
+			<< "\n[Scene Info] " << GetSceneInfo();
+		whatBuffer = stream.str();
+		return whatBuffer.c_str();
+	}
+#pragma endregion
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+#include "BasicException.h"
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+
+namespace GFX
+{
+	// Scene description authored as JSON, compiled to binary file next to it for faster loading.
+	// Angles are stored in radians, JSON uses degrees.
+	class SceneFile
+	{
+		static constexpr uint32_t MAGIC = 0x4E435348; // HSCN
+		static constexpr uint32_t VERSION = 2;
+
+	public:
+		static constexpr const char* COMPILED_EXTENSION = ".hscn";
+
+		struct Camera
+		{
+			std::string name;
+			DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+			float angleHorizontal = 0.0f;
+			float angleVertical = 0.0f;
+			float fov = 1.047f;
+			float nearClip = 0.01f;
+			float farClip = 500.0f;
+			// 0 - person camera, 1 - floating camera
+			uint8_t type = 0;
+		};
+		struct PointLight
+		{
+			std::string name;
+			float intensity = 1.0f;
+			DirectX::XMFLOAT3 color = { 1.0f, 1.0f, 1.0f };
+			DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+			uint32_t range = 50;
+			float radius = 0.5f;
+			bool castShadows = true;
+		};
+		struct SpotLight
+		{
+			std::string name;
+			float intensity = 1.0f;
+			DirectX::XMFLOAT3 color = { 1.0f, 1.0f, 1.0f };
+			DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+			uint32_t range = 50;
+			float size = 1.0f;
+			float innerAngle = 0.3f;
+			float outerAngle = 0.5f;
+			DirectX::XMFLOAT3 direction = { 0.0f, -1.0f, 0.0f };
+		};
+		struct DirectionalLight
+		{
+			std::string name;
+			float intensity = 1.0f;
+			DirectX::XMFLOAT3 color = { 1.0f, 1.0f, 1.0f };
+			DirectX::XMFLOAT3 direction = { 0.0f, -1.0f, 0.0f };
+		};
+		struct Model
+		{
+			std::string name;
+			std::string file;
+			DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+			DirectX::XMFLOAT3 rotation = { 0.0f, 0.0f, 0.0f };
+			float scale = 1.0f;
+		};
+
+		std::vector<Camera> cameras;
+		std::vector<PointLight> pointLights;
+		std::vector<SpotLight> spotLights;
+		std::vector<DirectionalLight> directionalLights;
+		std::vector<Model> models;
+
+		SceneFile() = default;
+		SceneFile(SceneFile&&) = default;
+		SceneFile& operator=(SceneFile&&) = default;
+		~SceneFile() = default;
+
+		static std::string GetCompiledPath(const std::string& path) noexcept;
+		// Uses compiled file when it is not older than source JSON and can be read, otherwise parses JSON and tries to compile it
+		static SceneFile Load(const std::string& path);
+		static SceneFile ParseJson(const std::string& path);
+		static SceneFile ReadBinary(const std::string& path);
+
+		void WriteBinary(const std::string& path) const;
+
+		class SceneException : public virtual Exception::BasicException
+		{
+			std::string info;
+
+		public:
+			inline SceneException(unsigned int line, const char* file, std::string note) noexcept
+				: BasicException(line, file), info(std::move(note)) {}
+			virtual ~SceneException() = default;
+
+			constexpr const std::string& GetSceneInfo() const noexcept { return info; }
+			inline const char* GetType() const noexcept override { return "Scene Exception"; }
+
+			const char* what() const noexcept override;
+		};
+	};
+}
\ No newline at end of file
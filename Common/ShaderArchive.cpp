@@ -0,0 +1,216 @@
+#include "ShaderArchive.h"
+#include "Utils.h"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <mutex>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace GFX
+{
+	std::atomic_bool ShaderArchive::enabled = true;
+
+	void ShaderArchive::Close() noexcept
+	{
+		shaders.clear();
+#ifdef _WIN32
+		if (view)
+		{
+			UnmapViewOfFile(view);
+			view = nullptr;
+		}
+		if (mapping)
+		{
+			CloseHandle(mapping);
+			mapping = nullptr;
+		}
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file);
+			file = INVALID_HANDLE_VALUE;
+		}
+#else
+		if (view)
+		{
+			munmap(const_cast<uint8_t*>(view), viewSize);
+			view = nullptr;
+		}
+#endif
+		viewSize = 0;
+	}
+
+	ShaderArchive& ShaderArchive::Get() noexcept
+	{
+		static ShaderArchive archive;
+		// Shaders can be first requested from multiple threads at once
+		static std::once_flag init;
+		std::call_once(init, []()
+		{
+			if (IsOutdated(SHADER_DIRECTORY, ARCHIVE_FILE))
+				Pack(SHADER_DIRECTORY, ARCHIVE_FILE);
+			archive.Open(ARCHIVE_FILE);
+		});
+		return archive;
+	}
+
+	size_t ShaderArchive::Pack(const std::string& directory, const std::string& archive) noexcept
+	{
+		try
+		{
+			std::vector<std::pair<std::string, std::vector<char>>> files;
+			for (const auto& entry : std::filesystem::directory_iterator(directory))
+			{
+				if (!entry.is_regular_file() || entry.path().extension() != ".cso")
+					continue;
+				std::ifstream fin(entry.path(), std::ios::binary | std::ios::ate);
+				if (!fin.good())
+					return 0;
+				auto& shader = files.emplace_back(entry.path().stem().string(), std::vector<char>(static_cast<size_t>(fin.tellg())));
+				fin.seekg(0);
+				fin.read(shader.second.data(), shader.second.size());
+			}
+			if (files.size() == 0)
+				return 0;
+
+			Header header = { MAGIC, VERSION, static_cast<uint32_t>(files.size()) };
+			std::vector<IndexEntry> index(files.size());
+			uint32_t offset = static_cast<uint32_t>(sizeof(Header) + sizeof(IndexEntry) * files.size());
+			for (size_t i = 0; i < files.size(); ++i)
+			{
+				index.at(i).nameOffset = offset;
+				index.at(i).nameSize = static_cast<uint32_t>(files.at(i).first.size());
+				offset += index.at(i).nameSize;
+			}
+			for (size_t i = 0; i < files.size(); ++i)
+			{
+				offset = (offset + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+				index.at(i).dataOffset = offset;
+				index.at(i).dataSize = static_cast<uint32_t>(files.at(i).second.size());
+				offset += index.at(i).dataSize;
+			}
+
+			std::ofstream fout(archive, std::ios::binary | std::ios::trunc);
+			if (!fout.good())
+				return 0;
+			fout.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			fout.write(reinterpret_cast<const char*>(index.data()), sizeof(IndexEntry) * index.size());
+			for (const auto& shader : files)
+				fout.write(shader.first.data(), shader.first.size());
+			for (size_t i = 0; i < files.size(); ++i)
+			{
+				const char padding[DATA_ALIGNMENT] = { 0 };
+				fout.write(padding, index.at(i).dataOffset - fout.tellp());
+				fout.write(files.at(i).second.data(), files.at(i).second.size());
+			}
+			return fout.good() ? files.size() : 0;
+		}
+		catch (const std::exception&)
+		{
+			return 0;
+		}
+	}
+
+	bool ShaderArchive::IsOutdated(const std::string& directory, const std::string& archive) noexcept
+	{
+		std::error_code error;
+		if (!std::filesystem::exists(archive, error))
+			return true;
+		const auto archiveTime = std::filesystem::last_write_time(archive, error);
+		uint32_t count = 0;
+		for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+		{
+			if (entry.path().extension() == ".cso")
+			{
+				if (entry.last_write_time(error) > archiveTime)
+					return true;
+				++count;
+			}
+		}
+		// Deleted shader does not change time of any other one
+		Header header = {};
+		std::ifstream fin(archive, std::ios::binary);
+		if (!fin.read(reinterpret_cast<char*>(&header), sizeof(Header)))
+			return true;
+		return header.magic != MAGIC || header.version != VERSION || header.count != count;
+	}
+
+	bool ShaderArchive::Open(const std::string& archive) noexcept
+	{
+		Close();
+#ifdef _WIN32
+		file = CreateFileW(Utils::ToUtf8(archive).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || static_cast<uint64_t>(size.QuadPart) < sizeof(Header))
+		{
+			Close();
+			return false;
+		}
+		mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping)
+			view = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (view == nullptr)
+		{
+			Close();
+			return false;
+		}
+		viewSize = static_cast<size_t>(size.QuadPart);
+#else
+		const int descriptor = open(archive.c_str(), O_RDONLY);
+		if (descriptor < 0)
+			return false;
+		// Mapping stays valid after closing file descriptor
+		struct stat info;
+		if (fstat(descriptor, &info) == 0 && static_cast<uint64_t>(info.st_size) >= sizeof(Header))
+		{
+			void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (mapped != MAP_FAILED)
+			{
+				view = static_cast<const uint8_t*>(mapped);
+				viewSize = static_cast<size_t>(info.st_size);
+			}
+		}
+		close(descriptor);
+		if (view == nullptr)
+			return false;
+#endif
+
+		const Header& header = *reinterpret_cast<const Header*>(view);
+		const uint64_t fileSize = viewSize;
+		if (header.magic != MAGIC || header.version != VERSION ||
+			sizeof(Header) + sizeof(IndexEntry) * static_cast<uint64_t>(header.count) > fileSize)
+		{
+			Close();
+			return false;
+		}
+		const IndexEntry* index = reinterpret_cast<const IndexEntry*>(view + sizeof(Header));
+		shaders.reserve(header.count);
+		for (uint32_t i = 0; i < header.count; ++i)
+		{
+			const IndexEntry& entry = index[i];
+			if (static_cast<uint64_t>(entry.nameOffset) + entry.nameSize > fileSize ||
+				static_cast<uint64_t>(entry.dataOffset) + entry.dataSize > fileSize)
+			{
+				Close();
+				return false;
+			}
+			shaders.emplace(std::string_view(reinterpret_cast<const char*>(view + entry.nameOffset), entry.nameSize),
+				Bytecode{ view + entry.dataOffset, entry.dataSize });
+		}
+		return true;
+	}
+
+	std::optional<ShaderArchive::Bytecode> ShaderArchive::Find(const std::string& name) const noexcept
+	{
+		const auto it = shaders.find(name);
+		if (it == shaders.end())
+			return {};
+		return it->second;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#ifdef _WIN32
+#include "WinAPI.h"
+#endif
+#include <unordered_map>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <cstdint>
+
+namespace GFX
+{
+	// Compiled shaders packed into single file with index of all of them, mapped into memory once
+	class ShaderArchive
+	{
+	public:
+		struct Bytecode
+		{
+			const void* data = nullptr;
+			size_t size = 0;
+		};
+
+	private:
+		static constexpr uint32_t MAGIC = 0x41485348; // HSHA
+		static constexpr uint32_t VERSION = 1;
+		static constexpr uint32_t DATA_ALIGNMENT = 16U;
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t count;
+		};
+		struct IndexEntry
+		{
+			uint32_t nameOffset;
+			uint32_t nameSize;
+			uint32_t dataOffset;
+			uint32_t dataSize;
+		};
+
+		static std::atomic_bool enabled;
+
+#ifdef _WIN32
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+#endif
+		const uint8_t* view = nullptr;
+		size_t viewSize = 0;
+		std::unordered_map<std::string_view, Bytecode> shaders;
+
+		void Close() noexcept;
+
+	public:
+		static constexpr const char* SHADER_DIRECTORY = "Shaders";
+		static constexpr const char* ARCHIVE_FILE = "Shaders/Shaders.hsa";
+
+		ShaderArchive() = default;
+		ShaderArchive(const ShaderArchive&) = delete;
+		ShaderArchive& operator=(const ShaderArchive&) = delete;
+		inline ~ShaderArchive() { Close(); }
+
+		// Archive of engine shaders, packed again when any compiled shader is newer than it
+		static ShaderArchive& Get() noexcept;
+		// Packs all .cso files from directory, returns number of packed shaders or 0 on failure
+		static size_t Pack(const std::string& directory, const std::string& archive) noexcept;
+		// Any compiled shader newer than archive or different number of them (ex. deleted one) makes archive outdated
+		static bool IsOutdated(const std::string& directory, const std::string& archive) noexcept;
+		// When disabled shaders are read from loose files, used for comparison of startup times
+		static inline void SetEnabled(bool enable) noexcept { enabled.store(enable, std::memory_order_relaxed); }
+		static inline bool IsEnabled() noexcept { return enabled.load(std::memory_order_relaxed); }
+
+		constexpr bool IsOpen() const noexcept { return view != nullptr; }
+		inline size_t GetCount() const noexcept { return shaders.size(); }
+
+		// Returns false when file is missing or has wrong format
+		bool Open(const std::string& archive) noexcept;
+		std::optional<Bytecode> Find(const std::string& name) const noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "ShadowCascades.h"
+#include <cmath>
+
+namespace GFX
+{
+	ShadowCascades::ShadowCascades(uint32_t count, uint32_t mapSize, float lambda, float casterDistance) noexcept
+		: mapSize(mapSize), lambda(lambda), casterDistance(casterDistance)
+	{
+		SetCount(count);
+		for (auto& cascade : cascades)
+		{
+			DirectX::XMStoreFloat4x4(&cascade.view, DirectX::XMMatrixIdentity());
+			DirectX::XMStoreFloat4x4(&cascade.projection, DirectX::XMMatrixIdentity());
+			cascade.lightPos = { 0.0f, 0.0f, 0.0f };
+			cascade.texelSize = 0.0f;
+			cascade.splitNear = cascade.splitFar = 0.0f;
+		}
+	}
+
+	void ShadowCascades::ComputeSplits(float nearClip, float farClip, uint32_t count, float lambda, float* splits) noexcept
+	{
+		// https://developer.nvidia.com/gpugems/gpugems3/part-ii-light-and-shadows/chapter-10-parallel-split-shadow-maps-programmable-gpus
+		const float ratio = farClip / nearClip;
+		const float range = farClip - nearClip;
+		for (uint32_t i = 1; i < count; ++i)
+		{
+			const float part = static_cast<float>(i) / static_cast<float>(count);
+			const float logSplit = nearClip * std::pow(ratio, part);
+			const float uniformSplit = nearClip + range * part;
+			splits[i - 1] = lambda * logSplit + (1.0f - lambda) * uniformSplit;
+		}
+		splits[count - 1] = farClip;
+	}
+
+	DirectX::BoundingSphere ShadowCascades::FitSlice(const DirectX::XMMATRIX& inverseView, float scaleX, float scaleY, float splitNear, float splitFar) noexcept
+	{
+		// Squared distance of frustum corner from view axis at depth 1
+		const float corner = 1.0f / (scaleX * scaleX) + 1.0f / (scaleY * scaleY);
+		// Point on axis with same distance to near and far corners, for wide slices sphere around far plane is enough
+		float center = 0.5f * (splitNear + splitFar) * (1.0f + corner);
+		float radius;
+		if (center >= splitFar)
+		{
+			center = splitFar;
+			radius = splitFar * std::sqrt(corner);
+		}
+		else
+			radius = std::sqrt((splitFar - center) * (splitFar - center) + splitFar * splitFar * corner);
+
+		DirectX::BoundingSphere sphere;
+		DirectX::XMStoreFloat3(&sphere.Center, DirectX::XMVector3TransformCoord(DirectX::XMVectorSet(0.0f, 0.0f, center, 1.0f), inverseView));
+		sphere.Radius = radius;
+		return sphere;
+	}
+
+	DirectX::XMMATRIX ShadowCascades::GetLightRotation(const DirectX::XMVECTOR& direction) noexcept
+	{
+		const DirectX::XMVECTOR up = std::abs(DirectX::XMVectorGetY(direction)) > 0.99f ?
+			DirectX::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+		return DirectX::XMMatrixLookToLH(DirectX::XMVectorZero(), direction, up);
+	}
+
+	void ShadowCascades::Update(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& projection, const DirectX::XMFLOAT3& direction) noexcept
+	{
+		DirectX::XMFLOAT4X4 proj;
+		DirectX::XMStoreFloat4x4(&proj, projection);
+		const float nearClip = -proj._43 / proj._33;
+		const float farClip = proj._43 / (1.0f - proj._33);
+		std::array<float, MAX_CASCADES> splits;
+		ComputeSplits(nearClip, farClip, count, lambda, splits.data());
+
+		const DirectX::XMMATRIX inverseView = DirectX::XMMatrixInverse(nullptr, view);
+		const DirectX::XMMATRIX rotation = GetLightRotation(DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction)));
+		// Light space is orthonormal so transposition moves back to world space
+		const DirectX::XMMATRIX inverseRotation = DirectX::XMMatrixTranspose(rotation);
+		const DirectX::XMVECTOR orientation = DirectX::XMQuaternionRotationMatrix(inverseRotation);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Cascade& cascade = cascades[i];
+			cascade.splitNear = i ? splits[i - 1] : nearClip;
+			cascade.splitFar = splits[i];
+			cascade.slice = FitSlice(inverseView, proj._11, proj._22, cascade.splitNear, cascade.splitFar);
+
+			// Keep one texel margin so slice is covered after snapping
+			const float radius = cascade.slice.Radius;
+			const float extent = radius * static_cast<float>(mapSize) / static_cast<float>(mapSize - 2U);
+			cascade.texelSize = 2.0f * extent / static_cast<float>(mapSize);
+
+			// Move light only by whole texels so static shadows do not shimmer when camera moves
+			DirectX::XMFLOAT3 center;
+			DirectX::XMStoreFloat3(&center, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&cascade.slice.Center), rotation));
+			center.x = std::floor(center.x / cascade.texelSize) * cascade.texelSize;
+			center.y = std::floor(center.y / cascade.texelSize) * cascade.texelSize;
+
+			const float depth = 2.0f * radius + casterDistance;
+			const DirectX::XMFLOAT3 eye = { center.x, center.y, center.z - radius - casterDistance };
+			DirectX::XMStoreFloat4x4(&cascade.view, DirectX::XMMatrixMultiply(rotation, DirectX::XMMatrixTranslation(-eye.x, -eye.y, -eye.z)));
+			DirectX::XMStoreFloat4x4(&cascade.projection, DirectX::XMMatrixOrthographicLH(2.0f * extent, 2.0f * extent, 0.0f, depth));
+			DirectX::XMStoreFloat3(&cascade.lightPos, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&eye), inverseRotation));
+
+			DirectX::XMStoreFloat3(&cascade.casterVolume.Center,
+				DirectX::XMVector3TransformCoord(DirectX::XMVectorSet(center.x, center.y, eye.z + 0.5f * depth, 1.0f), inverseRotation));
+			cascade.casterVolume.Extents = { extent, extent, 0.5f * depth };
+			DirectX::XMStoreFloat4(&cascade.casterVolume.Orientation, orientation);
+		}
+	}
+}
\ No newline at end of file
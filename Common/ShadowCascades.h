@@ -0,0 +1,66 @@
+#pragma once
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+#include <array>
+#include <cstdint>
+
+namespace GFX
+{
+	// CPU side setup of cascaded shadow maps for directional lights, independent of Direct3D.
+	// Splits camera frustum with practical split scheme and fits stable light projection to every slice.
+	class ShadowCascades
+	{
+	public:
+		static constexpr uint32_t MAX_CASCADES = 4U;
+
+		struct Cascade
+		{
+			DirectX::XMFLOAT4X4 view;
+			DirectX::XMFLOAT4X4 projection;
+			// Virtual light position, shadow map holds distances from it
+			DirectX::XMFLOAT3 lightPos;
+			// Size of shadow map texel in world units
+			float texelSize;
+			// View space depth range of camera covered by cascade
+			float splitNear;
+			float splitFar;
+			// Bounding sphere of camera frustum slice
+			DirectX::BoundingSphere slice;
+			// Light space box of slice extended towards light, contains every possible shadow caster
+			DirectX::BoundingOrientedBox casterVolume;
+		};
+
+	private:
+		uint32_t count;
+		uint32_t mapSize;
+		// Blend between logarithmic (1) and uniform (0) splits
+		float lambda;
+		// How far behind slice casters are searched
+		float casterDistance;
+		std::array<Cascade, MAX_CASCADES> cascades;
+
+	public:
+		ShadowCascades(uint32_t count, uint32_t mapSize, float lambda = 0.8f, float casterDistance = 100.0f) noexcept;
+		ShadowCascades(const ShadowCascades&) = default;
+		ShadowCascades& operator=(const ShadowCascades&) = default;
+		~ShadowCascades() = default;
+
+		// Far depths of every split, last one equals farClip
+		static void ComputeSplits(float nearClip, float farClip, uint32_t count, float lambda, float* splits) noexcept;
+		// Minimal sphere around slice of symmetric perspective frustum, radius depends only on projection and depth range
+		// so it stays constant when camera rotates. Scales are projection terms _11 and _22
+		static DirectX::BoundingSphere FitSlice(const DirectX::XMMATRIX& inverseView, float scaleX, float scaleY, float splitNear, float splitFar) noexcept;
+		// Rotation of light space looking along direction
+		static DirectX::XMMATRIX GetLightRotation(const DirectX::XMVECTOR& direction) noexcept;
+
+		constexpr uint32_t GetCount() const noexcept { return count; }
+		constexpr void SetCount(uint32_t cascadeCount) noexcept { count = cascadeCount < 1U ? 1U : (cascadeCount > MAX_CASCADES ? MAX_CASCADES : cascadeCount); }
+		constexpr uint32_t GetMapSize() const noexcept { return mapSize; }
+		constexpr float& Lambda() noexcept { return lambda; }
+		constexpr float& CasterDistance() noexcept { return casterDistance; }
+		constexpr const Cascade& GetCascade(uint32_t index) const noexcept { return cascades[index]; }
+
+		// Projection have to be perspective, direction points from light into scene
+		void Update(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& projection, const DirectX::XMFLOAT3& direction) noexcept;
+	};
+}
\ No newline at end of file
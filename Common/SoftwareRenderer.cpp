@@ -0,0 +1,683 @@
+#include "SoftwareRenderer.h"
+#include "GBufferEncoding.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+namespace GFX
+{
+	DirectX::XMVECTOR SoftwareRenderer::Sample(const Texture& texture, float u, float v) noexcept
+	{
+		// Bilinear filtering with wrap addressing
+		const float x = u * texture.width - 0.5f;
+		const float y = v * texture.height - 0.5f;
+		const float fx = std::floor(x);
+		const float fy = std::floor(y);
+		const int w = static_cast<int>(texture.width);
+		const int h = static_cast<int>(texture.height);
+		const int x0 = ((static_cast<int>(fx) % w) + w) % w;
+		const int y0 = ((static_cast<int>(fy) % h) + h) % h;
+		const int x1 = (x0 + 1) % w;
+		const int y1 = (y0 + 1) % h;
+
+		auto texel = [&texture](int x, int y) -> DirectX::XMVECTOR
+		{
+			const uint32_t pixel = texture.pixels[static_cast<size_t>(y) * texture.width + x];
+			return DirectX::XMVectorScale(DirectX::XMVectorSet(static_cast<float>(pixel & 0xFF), static_cast<float>((pixel >> 8) & 0xFF),
+				static_cast<float>((pixel >> 16) & 0xFF), static_cast<float>(pixel >> 24)), 1.0f / 255.0f);
+		};
+		const float tx = x - fx;
+		const float ty = y - fy;
+		return DirectX::XMVectorLerp(DirectX::XMVectorLerp(texel(x0, y0), texel(x1, y0), tx),
+			DirectX::XMVectorLerp(texel(x0, y1), texel(x1, y1), tx), ty);
+	}
+
+	DirectX::XMVECTOR SoftwareRenderer::DeleteGammaCorrection(DirectX::XMVECTOR srgb, float gamma) noexcept
+	{
+		return DirectX::XMVectorPow(DirectX::XMVectorMax(srgb, DirectX::XMVectorZero()), DirectX::XMVectorReplicate(gamma));
+	}
+
+	void SoftwareRenderer::SetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const Material* material)
+	{
+		const ClipVertex* vertices[3] = { &v0, &v1, &v2 };
+		float x[3], y[3];
+		Triangle triangle;
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			const DirectX::XMFLOAT4& pos = vertices[i]->position;
+			const float invW = 1.0f / pos.w;
+			x[i] = (pos.x * invW * 0.5f + 0.5f) * width;
+			y[i] = (0.5f - pos.y * invW * 0.5f) * height;
+			(&triangle.depth.x)[i] = pos.z * invW;
+			(&triangle.invW.x)[i] = invW;
+			DirectX::XMStoreFloat3(&triangle.normals[i], DirectX::XMVectorScale(DirectX::XMLoadFloat3(&vertices[i]->normal), invW));
+			triangle.texCoords[i] = { vertices[i]->texCoord.x * invW, vertices[i]->texCoord.y * invW };
+		}
+		// Clockwise triangles in screen space are front facing, back ones are culled
+		const float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+		if (area <= 0.0f)
+			return;
+
+		triangle.minX = std::max(0, static_cast<int>(std::floor(std::min({ x[0], x[1], x[2] }))));
+		triangle.maxX = std::min(static_cast<int>(width) - 1, static_cast<int>(std::ceil(std::max({ x[0], x[1], x[2] }))));
+		triangle.minY = std::max(0, static_cast<int>(std::floor(std::min({ y[0], y[1], y[2] }))));
+		triangle.maxY = std::min(static_cast<int>(height) - 1, static_cast<int>(std::ceil(std::max({ y[0], y[1], y[2] }))));
+		if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+			return;
+
+		// Edge opposite to vertex gives its barycentric coordinate
+		const float invArea = 1.0f / area;
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			const uint8_t a = (i + 1) % 3;
+			const uint8_t b = (i + 2) % 3;
+			triangle.edges[i] = { (y[a] - y[b]) * invArea, (x[b] - x[a]) * invArea,
+				((y[b] - y[a]) * x[a] - (x[b] - x[a]) * y[a]) * invArea };
+		}
+		triangle.material = material;
+		triangles.emplace_back(triangle);
+	}
+
+	void SoftwareRenderer::ClipTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const Material* material)
+	{
+		const ClipVertex* input[3] = { &v0, &v1, &v2 };
+		uint8_t inside = 0;
+		for (uint8_t i = 0; i < 3; ++i)
+			if (input[i]->position.z >= 0.0f)
+				++inside;
+		if (inside == 3)
+		{
+			SetupTriangle(v0, v1, v2, material);
+			return;
+		}
+		else if (inside == 0)
+			return;
+
+		// Sutherland-Hodgman against near plane, gives polygon of at most 4 vertices
+		ClipVertex polygon[4];
+		uint8_t count = 0;
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			const ClipVertex& current = *input[i];
+			const ClipVertex& next = *input[(i + 1) % 3];
+			const bool currentInside = current.position.z >= 0.0f;
+			if (currentInside)
+				polygon[count++] = current;
+			if (currentInside != (next.position.z >= 0.0f))
+			{
+				const float t = current.position.z / (current.position.z - next.position.z);
+				ClipVertex& vertex = polygon[count++];
+				DirectX::XMStoreFloat4(&vertex.position, DirectX::XMVectorLerp(DirectX::XMLoadFloat4(&current.position), DirectX::XMLoadFloat4(&next.position), t));
+				DirectX::XMStoreFloat3(&vertex.normal, DirectX::XMVectorLerp(DirectX::XMLoadFloat3(&current.normal), DirectX::XMLoadFloat3(&next.normal), t));
+				DirectX::XMStoreFloat2(&vertex.texCoord, DirectX::XMVectorLerp(DirectX::XMLoadFloat2(&current.texCoord), DirectX::XMLoadFloat2(&next.texCoord), t));
+			}
+		}
+		for (uint8_t i = 2; i < count; ++i)
+			SetupTriangle(polygon[0], polygon[i - 1], polygon[i], material);
+	}
+
+	DirectX::XMVECTOR SoftwareRenderer::GetWorldPosition(float u, float v, float pixelDepth) const noexcept
+	{
+		const DirectX::XMVECTOR position = DirectX::XMVector4Transform(DirectX::XMVectorSet(u * 2.0f - 1.0f, 1.0f - v * 2.0f, pixelDepth, 1.0f),
+			DirectX::XMLoadFloat4x4(&inverseViewProjection));
+		return DirectX::XMVectorDivide(position, DirectX::XMVectorSplatW(position));
+	}
+
+	DirectX::XMVECTOR SoftwareRenderer::GetWorldPosition(uint32_t x, uint32_t y) const noexcept
+	{
+		return GetWorldPosition((x + 0.5f) / width, (y + 0.5f) / height, depth.at(static_cast<size_t>(y) * width + x));
+	}
+
+	void SoftwareRenderer::RasterizeTile(uint32_t tile) noexcept
+	{
+		const int tileMinX = static_cast<int>((tile % tilesX) * TILE_SIZE);
+		const int tileMinY = static_cast<int>((tile / tilesX) * TILE_SIZE);
+		const int tileMaxX = std::min(tileMinX + static_cast<int>(TILE_SIZE), static_cast<int>(width)) - 1;
+		const int tileMaxY = std::min(tileMinY + static_cast<int>(TILE_SIZE), static_cast<int>(height)) - 1;
+		const DirectX::XMVECTOR laneOffsets = DirectX::XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+		const DirectX::XMVECTOR zero = DirectX::XMVectorZero();
+
+		// Triangles are stored in submission order so depth ties resolve the same way every frame
+		for (uint32_t index : bins.at(tile))
+		{
+			const Triangle& triangle = triangles.at(index);
+			const Material& material = *triangle.material;
+			const int minX = std::max(triangle.minX, tileMinX);
+			const int maxX = std::min(triangle.maxX, tileMaxX);
+			const int minY = std::max(triangle.minY, tileMinY);
+			const int maxY = std::min(triangle.maxY, tileMaxY);
+			const DirectX::XMVECTOR edgeX[3] =
+			{
+				DirectX::XMVectorReplicate(triangle.edges[0].x),
+				DirectX::XMVectorReplicate(triangle.edges[1].x),
+				DirectX::XMVectorReplicate(triangle.edges[2].x)
+			};
+			for (int y = minY; y <= maxY; ++y)
+			{
+				const float centerY = y + 0.5f;
+				DirectX::XMVECTOR edgeRow[3];
+				for (uint8_t i = 0; i < 3; ++i)
+					edgeRow[i] = DirectX::XMVectorReplicate(triangle.edges[i].y * centerY + triangle.edges[i].z);
+				// 4 pixels at once, barycentrics as l(x) = a * x + row
+				for (int x = minX; x <= maxX; x += 4)
+				{
+					const DirectX::XMVECTOR centerX = DirectX::XMVectorAdd(DirectX::XMVectorReplicate(static_cast<float>(x)), laneOffsets);
+					const DirectX::XMVECTOR l0 = DirectX::XMVectorMultiplyAdd(edgeX[0], centerX, edgeRow[0]);
+					const DirectX::XMVECTOR l1 = DirectX::XMVectorMultiplyAdd(edgeX[1], centerX, edgeRow[1]);
+					const DirectX::XMVECTOR l2 = DirectX::XMVectorMultiplyAdd(edgeX[2], centerX, edgeRow[2]);
+					const DirectX::XMVECTOR inside = DirectX::XMVectorAndInt(DirectX::XMVectorGreaterOrEqual(l0, zero),
+						DirectX::XMVectorAndInt(DirectX::XMVectorGreaterOrEqual(l1, zero), DirectX::XMVectorGreaterOrEqual(l2, zero)));
+					uint32_t mask[4];
+					DirectX::XMStoreInt4(mask, inside);
+					if ((mask[0] | mask[1] | mask[2] | mask[3]) == 0)
+						continue;
+
+					DirectX::XMFLOAT4 lambda[3];
+					DirectX::XMStoreFloat4(&lambda[0], l0);
+					DirectX::XMStoreFloat4(&lambda[1], l1);
+					DirectX::XMStoreFloat4(&lambda[2], l2);
+					const int count = std::min(4, maxX - x + 1);
+					for (int lane = 0; lane < count; ++lane)
+					{
+						if (mask[lane] == 0)
+							continue;
+						const float l[3] = { (&lambda[0].x)[lane], (&lambda[1].x)[lane], (&lambda[2].x)[lane] };
+						const float z = l[0] * triangle.depth.x + l[1] * triangle.depth.y + l[2] * triangle.depth.z;
+						const size_t pixel = static_cast<size_t>(y) * width + x + lane;
+						if (z < 0.0f || z >= depth[pixel])
+							continue;
+
+						// Perspective correct attributes
+						const float w = 1.0f / (l[0] * triangle.invW.x + l[1] * triangle.invW.y + l[2] * triangle.invW.z);
+						const float u = (l[0] * triangle.texCoords[0].x + l[1] * triangle.texCoords[1].x + l[2] * triangle.texCoords[2].x) * w;
+						const float v = (l[0] * triangle.texCoords[0].y + l[1] * triangle.texCoords[1].y + l[2] * triangle.texCoords[2].y) * w;
+
+						// PhongPS
+						DirectX::XMFLOAT4 pixelColor;
+						if (material.texture.pixels)
+							DirectX::XMStoreFloat4(&pixelColor, Sample(material.texture, u, v));
+						else
+							pixelColor = material.color;
+						if (pixelColor.w - 0.0039f < 0.0f)
+							continue;
+						pixelColor.w = 0.0f;
+
+						const DirectX::XMVECTOR pixelNormal = DirectX::XMVectorAdd(DirectX::XMVectorAdd(
+							DirectX::XMVectorScale(DirectX::XMLoadFloat3(&triangle.normals[0]), l[0]),
+							DirectX::XMVectorScale(DirectX::XMLoadFloat3(&triangle.normals[1]), l[1])),
+							DirectX::XMVectorScale(DirectX::XMLoadFloat3(&triangle.normals[2]), l[2]));
+						depth[pixel] = z;
+						color[pixel] = pixelColor;
+						// Pass through G-buffer encoding to keep precision of GPU targets
+						DirectX::XMFLOAT3 geometryNormal;
+						DirectX::XMStoreFloat3(&geometryNormal, DirectX::XMVector3Normalize(pixelNormal));
+						normal[pixel] = GBufferEncoding::DecodeNormal(GBufferEncoding::EncodeNormal(geometryNormal));
+						specular[pixel] = GBufferEncoding::DecodeSpecular(GBufferEncoding::EncodeSpecular({ material.specularColor.x * material.specularIntensity,
+							material.specularColor.y * material.specularIntensity, material.specularColor.z * material.specularIntensity }, material.specularPower));
+					}
+				}
+			}
+		}
+	}
+
+	void SoftwareRenderer::ShadeLights(uint32_t y) noexcept
+	{
+		const DirectX::XMVECTOR eye = DirectX::XMLoadFloat3(&cameraPos);
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			const size_t pixel = static_cast<size_t>(y) * width + x;
+			if (color[pixel].w != 0.0f)
+				continue;
+
+			const DirectX::XMVECTOR position = GetWorldPosition(x, y);
+			const DirectX::XMVECTOR pixelNormal = DirectX::XMLoadFloat3(&normal[pixel]);
+			const DirectX::XMVECTOR specularColor = DirectX::XMLoadFloat4(&specular[pixel]);
+			const float specularPower = specular[pixel].w;
+			const DirectX::XMVECTOR directionToCamera = DirectX::XMVector3Normalize(DirectX::XMVectorSubtract(eye, position));
+			DirectX::XMVECTOR diffuse = DirectX::XMVectorZero();
+			DirectX::XMVECTOR shine = DirectX::XMVectorZero();
+
+			// Shadows are not computed, equal to shadow level of 1 in light shaders
+			auto shade = [&](DirectX::XMVECTOR lightColor, DirectX::XMVECTOR directionToLight)
+			{
+				const DirectX::XMVECTOR lightDiffuse = DirectX::XMVectorScale(lightColor,
+					std::max(0.0f, DirectX::XMVectorGetX(DirectX::XMVector3Dot(directionToLight, pixelNormal))));
+				const DirectX::XMVECTOR halfway = DirectX::XMVector3Normalize(DirectX::XMVectorAdd(directionToCamera, directionToLight));
+				const float highlight = std::pow(std::max(DirectX::XMVectorGetX(DirectX::XMVector3Dot(pixelNormal, halfway)), 0.0f), specularPower);
+				diffuse = DirectX::XMVectorAdd(diffuse, lightDiffuse);
+				shine = DirectX::XMVectorAdd(shine, DirectX::XMVectorScale(DirectX::XMVectorMultiply(lightDiffuse, specularColor), highlight));
+			};
+
+			for (const auto& light : directionalLights)
+			{
+				shade(DirectX::XMVectorScale(DeleteGammaCorrection(DirectX::XMLoadFloat3(&light.color), params.gamma), light.intensity),
+					DirectX::XMVector3Normalize(DirectX::XMVectorNegate(DirectX::XMLoadFloat3(&light.direction))));
+			}
+			for (const auto& light : pointLights)
+			{
+				const DirectX::XMVECTOR toLight = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&light.position), position);
+				const float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(toLight));
+				// Outside of light volume
+				if (distance > light.range)
+					continue;
+				const float range = static_cast<float>(light.range);
+				const float attenuation = 1.0f + (4.5f / range + 75.0f / (range * range) * distance) * distance;
+				shade(DirectX::XMVectorScale(DeleteGammaCorrection(DirectX::XMLoadFloat3(&light.color), params.gamma), light.intensity / attenuation),
+					DirectX::XMVectorScale(toLight, 1.0f / distance));
+			}
+			for (const auto& light : spotLights)
+			{
+				const DirectX::XMVECTOR toLight = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&light.position), position);
+				const float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(toLight));
+				if (distance > light.range)
+					continue;
+				const DirectX::XMVECTOR directionToLight = DirectX::XMVectorScale(toLight, 1.0f / distance);
+				const float theta = -DirectX::XMVectorGetX(DirectX::XMVector3Dot(directionToLight, DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&light.direction))));
+				const float outer = std::cos(light.outerAngle);
+				if (theta <= outer)
+					continue;
+				float cone = std::clamp((theta - outer) / (std::cos(light.innerAngle) - outer), 0.0f, 1.0f);
+				cone *= cone * (3.0f - 2.0f * cone);
+				const float range = static_cast<float>(light.range);
+				const float attenuation = 1.0f + (4.5f / range + 75.0f / (range * range) * distance) * distance;
+				shade(DirectX::XMVectorScale(DeleteGammaCorrection(DirectX::XMLoadFloat3(&light.color), params.gamma), cone * light.intensity / attenuation),
+					directionToLight);
+			}
+			DirectX::XMStoreFloat3(&lighting[pixel], diffuse);
+			DirectX::XMStoreFloat3(&specularLighting[pixel], shine);
+		}
+	}
+
+	float SoftwareRenderer::GetOcclusion(const DirectX::XMVECTOR& position, const DirectX::XMVECTOR& pixelNormal,
+		uint32_t noiseX, uint32_t noiseY, const float* depthMap, uint32_t mapWidth, uint32_t mapHeight) const noexcept
+	{
+		const DirectX::XMFLOAT2& noise = ssaoNoise.at((noiseY % SSAO_NOISE_SIZE) * SSAO_NOISE_SIZE + noiseX % SSAO_NOISE_SIZE);
+		// Tangent space from random vector (not normalized)
+		const DirectX::XMVECTOR randomVec = DirectX::XMVector3Normalize(DirectX::XMVectorSet(noise.x, noise.y, 0.0f, 0.0f));
+		const DirectX::XMVECTOR tangent = DirectX::XMVector3Normalize(DirectX::XMVectorSubtract(randomVec,
+			DirectX::XMVectorMultiply(DirectX::XMVector3Dot(randomVec, pixelNormal), pixelNormal)));
+		const DirectX::XMVECTOR bitangent = DirectX::XMVector3Cross(pixelNormal, tangent);
+		const DirectX::XMMATRIX viewProj = DirectX::XMLoadFloat4x4(&viewProjection);
+
+		float occlusion = 0.0f;
+		uint32_t size = SSAO_KERNEL_SIZE;
+		for (const auto& sample : ssaoKernel)
+		{
+			const DirectX::XMVECTOR sampleRay = DirectX::XMVectorAdd(DirectX::XMVectorAdd(DirectX::XMVectorScale(tangent, sample.x),
+				DirectX::XMVectorScale(bitangent, sample.y)), DirectX::XMVectorScale(pixelNormal, sample.z));
+			if (DirectX::XMVectorGetX(DirectX::XMVector3Dot(DirectX::XMVector3Normalize(sampleRay), pixelNormal)) < 0.15f)
+			{
+				--size;
+				continue;
+			}
+			DirectX::XMFLOAT4 samplePos;
+			DirectX::XMStoreFloat4(&samplePos, DirectX::XMVector4Transform(DirectX::XMVectorSetW(DirectX::XMVectorAdd(position,
+				DirectX::XMVectorScale(sampleRay, params.ssaoRadius)), 1.0f), viewProj));
+			const float offsetX = samplePos.x / (samplePos.w * 2.0f) + 0.5f;
+			const float offsetY = 0.5f - samplePos.y / (samplePos.w * 2.0f);
+			const uint32_t sampleX = static_cast<uint32_t>(std::clamp(offsetX * mapWidth, 0.0f, mapWidth - 1.0f));
+			const uint32_t sampleY = static_cast<uint32_t>(std::clamp(offsetY * mapHeight, 0.0f, mapHeight - 1.0f));
+			const float sampleDepth = nearClip * farClip / (farClip + depthMap[static_cast<size_t>(sampleY) * mapWidth + sampleX] * (nearClip - farClip)) + params.ssaoBias;
+
+			float rangeCheck = std::clamp(params.ssaoRadius / std::abs(sampleDepth - samplePos.z), 0.0f, 1.0f);
+			rangeCheck *= rangeCheck * (3.0f - 2.0f * rangeCheck);
+			if (sampleDepth < samplePos.z)
+				occlusion += rangeCheck;
+		}
+		if (size == 0)
+			return 1.0f;
+		return std::pow(1.0f - occlusion / size, params.ssaoPower);
+	}
+
+	float SoftwareRenderer::GetUpsampledOcclusion(uint32_t x, uint32_t y) const noexcept
+	{
+		// SSAOUpsamplePS, tent filter over 4x4 reduced texels weighted by depth and normal similarity
+		const size_t pixel = static_cast<size_t>(y) * width + x;
+		const DirectX::XMVECTOR pixelNormal = DirectX::XMLoadFloat3(&normal[pixel]);
+		if (DirectX::XMVector3Equal(pixelNormal, DirectX::XMVectorZero()))
+			return 1.0f;
+		const float linearDepth = nearClip * farClip / (farClip + depth[pixel] * (nearClip - farClip));
+
+		const float lowX = (x + 0.5f) / params.ssaoDownscale - 0.5f;
+		const float lowY = (y + 0.5f) / params.ssaoDownscale - 0.5f;
+		const int baseX = static_cast<int>(std::floor(lowX)) - 1;
+		const int baseY = static_cast<int>(std::floor(lowY)) - 1;
+		const float fractionX = lowX - std::floor(lowX);
+		const float fractionY = lowY - std::floor(lowY);
+
+		float result = 0.0f;
+		float weightSum = 0.0f;
+		for (int i = 0; i < 4; ++i)
+		{
+			const size_t row = static_cast<size_t>(std::clamp(baseY + i, 0, static_cast<int>(ssaoHeight) - 1)) * ssaoWidth;
+			const float tentY = std::clamp(1.0f - std::abs(i - 1.0f - fractionY) * 0.5f, 0.0f, 1.0f);
+			for (int j = 0; j < 4; ++j)
+			{
+				const size_t texel = row + std::clamp(baseX + j, 0, static_cast<int>(ssaoWidth) - 1);
+				const DirectX::XMVECTOR lowNormal = DirectX::XMLoadFloat3(&ssaoNormal[texel]);
+				if (DirectX::XMVector3Equal(lowNormal, DirectX::XMVectorZero()))
+					continue;
+
+				const float tentX = std::clamp(1.0f - std::abs(j - 1.0f - fractionX) * 0.5f, 0.0f, 1.0f);
+				const float lowDepth = nearClip * farClip / (farClip + ssaoDepth[texel] * (nearClip - farClip));
+				const float similarity = std::exp(-std::abs(lowDepth - linearDepth) / linearDepth * SSAO_DEPTH_SHARPNESS)
+					* std::pow(std::clamp(DirectX::XMVectorGetX(DirectX::XMVector3Dot(lowNormal, pixelNormal)), 0.0f, 1.0f), SSAO_NORMAL_POWER);
+				const float weight = tentX * tentY * (similarity + SSAO_WEIGHT_EPSILON);
+				result += ssaoLow[texel] * weight;
+				weightSum += weight;
+			}
+		}
+		return weightSum > 0.0f ? result / weightSum : 1.0f;
+	}
+
+	template<typename F>
+	void SoftwareRenderer::RunPass(const char* name, F&& pass)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		pass();
+		const float time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		stats.emplace_back(PassStats{ name, time, time > 0.0f ? static_cast<float>(width) * height / (time * 1000.0f) : 0.0f });
+	}
+
+	void SoftwareRenderer::GeometryPass()
+	{
+		std::fill(depth.begin(), depth.end(), 1.0f);
+		std::fill(color.begin(), color.end(), DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
+		std::fill(normal.begin(), normal.end(), DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f));
+		std::fill(specular.begin(), specular.end(), DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f));
+		triangles.clear();
+		for (auto& bin : bins)
+			bin.clear();
+
+		// PhongVS, positions go into clip space and normals into world space
+		std::vector<ClipVertex> vertices;
+		const DirectX::XMMATRIX viewProj = DirectX::XMLoadFloat4x4(&viewProjection);
+		for (const auto& draw : draws)
+		{
+			const Mesh& mesh = *draw.mesh;
+			const DirectX::XMMATRIX transform = DirectX::XMLoadFloat4x4(&draw.transform);
+			const DirectX::XMMATRIX transformViewProj = DirectX::XMMatrixMultiply(transform, viewProj);
+			vertices.resize(mesh.vertices.size());
+			Utils::ThreadPool::Get().ParallelFor(vertices.size(), [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						const Vertex& vertex = mesh.vertices[i];
+						DirectX::XMStoreFloat4(&vertices[i].position, DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&vertex.position), transformViewProj));
+						DirectX::XMStoreFloat3(&vertices[i].normal, DirectX::XMVector3TransformNormal(DirectX::XMLoadFloat3(&vertex.normal), transform));
+						vertices[i].texCoord = vertex.texCoord;
+					}
+				}, 1024U);
+			for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+				ClipTriangle(vertices.at(mesh.indices[i]), vertices.at(mesh.indices[i + 1]), vertices.at(mesh.indices[i + 2]), draw.material);
+		}
+
+		// Bin triangles into screen tiles that can be rasterized independently
+		for (uint32_t i = 0; i < triangles.size(); ++i)
+		{
+			const Triangle& triangle = triangles[i];
+			for (uint32_t tileY = triangle.minY / TILE_SIZE; tileY <= triangle.maxY / TILE_SIZE; ++tileY)
+				for (uint32_t tileX = triangle.minX / TILE_SIZE; tileX <= triangle.maxX / TILE_SIZE; ++tileX)
+					bins.at(static_cast<size_t>(tileY) * tilesX + tileX).emplace_back(i);
+		}
+		Utils::ThreadPool::Get().ParallelFor(bins.size(), [this](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					RasterizeTile(static_cast<uint32_t>(i));
+			});
+	}
+
+	void SoftwareRenderer::LightingPass()
+	{
+		Utils::ThreadPool::Get().ParallelFor(height, [this](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
+					ShadeLights(static_cast<uint32_t>(y));
+			}, 16U);
+	}
+
+	void SoftwareRenderer::AmbientOcclusionPass()
+	{
+		Utils::ThreadPool::Get().ParallelFor(height, [this](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
+				{
+					for (uint32_t x = 0; x < width; ++x)
+					{
+						const size_t pixel = y * width + x;
+						const DirectX::XMVECTOR pixelNormal = DirectX::XMLoadFloat3(&normal[pixel]);
+						if (DirectX::XMVector3Equal(pixelNormal, DirectX::XMVectorZero()))
+							ssao[pixel] = 1.0f;
+						else
+							ssao[pixel] = GetOcclusion(GetWorldPosition(x, static_cast<uint32_t>(y)), pixelNormal,
+								x, static_cast<uint32_t>(y), depth.data(), width, height);
+					}
+				}
+			}, 16U);
+
+		// SSAOBlurPS, horizontal and vertical box filter
+		constexpr int RANGE = 3;
+		Utils::ThreadPool::Get().ParallelFor(height, [this](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
+				{
+					for (int x = 0; x < static_cast<int>(width); ++x)
+					{
+						float result = 0.0f;
+						for (int i = -RANGE; i < RANGE; ++i)
+							result += ssao[y * width + std::clamp(x + i, 0, static_cast<int>(width) - 1)];
+						ssaoScratch[y * width + x] = result / (RANGE * 2);
+					}
+				}
+			}, 16U);
+		Utils::ThreadPool::Get().ParallelFor(height, [this](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
+				{
+					for (uint32_t x = 0; x < width; ++x)
+					{
+						float result = 0.0f;
+						for (int i = -RANGE; i < RANGE; ++i)
+							result += ssaoScratch[static_cast<size_t>(std::clamp(static_cast<int>(y) + i, 0, static_cast<int>(height) - 1)) * width + x];
+						ssao[y * width + x] = result / (RANGE * 2);
+					}
+				}
+			}, 16U);
+	}
+
+	void SoftwareRenderer::ReducedAmbientOcclusionPass()
+	{
+		// SSAODownsamplePS, single texel per block with nearest and farthest surfaces in checkerboard
+		const uint32_t downscale = params.ssaoDownscale;
+		Utils::ThreadPool::Get().ParallelFor(ssaoHeight, [&](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
+				{
+					for (uint32_t x = 0; x < ssaoWidth; ++x)
+					{
+						const bool selectFar = ((x + y) & 1U) != 0U;
+						const size_t texel = y * ssaoWidth + x;
+						ssaoDepth[texel] = 1.0f;
+						ssaoNormal[texel] = { 0.0f, 0.0f, 0.0f };
+						bool found = false;
+						for (size_t blockY = y * downscale; blockY < std::min<size_t>((y + 1) * downscale, height); ++blockY)
+						{
+							for (size_t blockX = static_cast<size_t>(x) * downscale; blockX < std::min<size_t>((x + 1ULL) * downscale, width); ++blockX)
+							{
+								const size_t pixel = blockY * width + blockX;
+								if (DirectX::XMVector3Equal(DirectX::XMLoadFloat3(&normal[pixel]), DirectX::XMVectorZero()))
+									continue;
+								if (!found || (selectFar ? depth[pixel] > ssaoDepth[texel] : depth[pixel] < ssaoDepth[texel]))
+								{
+									found = true;
+									ssaoDepth[texel] = depth[pixel];
+									ssaoNormal[texel] = normal[pixel];
+								}
+							}
+						}
+					}
+				}
+			}, 16U);
+
+		// AmbientOcclusionLowPS, noise rotation changes with every reduced texel
+		Utils::ThreadPool::Get().ParallelFor(ssaoHeight, [this](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
+				{
+					for (uint32_t x = 0; x < ssaoWidth; ++x)
+					{
+						const size_t texel = y * ssaoWidth + x;
+						const DirectX::XMVECTOR texelNormal = DirectX::XMLoadFloat3(&ssaoNormal[texel]);
+						if (DirectX::XMVector3Equal(texelNormal, DirectX::XMVectorZero()))
+							ssaoLow[texel] = 1.0f;
+						else
+							ssaoLow[texel] = GetOcclusion(GetWorldPosition((x + 0.5f) / ssaoWidth, (y + 0.5f) / ssaoHeight, ssaoDepth[texel]),
+								texelNormal, x, static_cast<uint32_t>(y), ssaoDepth.data(), ssaoWidth, ssaoHeight);
+					}
+				}
+			}, 16U);
+
+		Utils::ThreadPool::Get().ParallelFor(height, [this](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
+					for (uint32_t x = 0; x < width; ++x)
+						ssao[y * width + x] = GetUpsampledOcclusion(x, static_cast<uint32_t>(y));
+			}, 16U);
+	}
+
+	void SoftwareRenderer::LightCombinePass()
+	{
+		const DirectX::XMVECTOR ambient = DeleteGammaCorrection(DirectX::XMLoadFloat3(&params.ambientColor), params.gamma);
+		Utils::ThreadPool::Get().ParallelFor(color.size(), [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const DirectX::XMVECTOR srgb = DirectX::XMLoadFloat4(&color[i]);
+					const DirectX::XMVECTOR diffuse = DirectX::XMVectorScale(DirectX::XMVectorMultiply(DeleteGammaCorrection(srgb, params.gamma),
+						DirectX::XMVectorAdd(ambient, DirectX::XMVectorAbs(DirectX::XMLoadFloat3(&lighting[i])))), ssao[i]);
+					DirectX::XMStoreFloat4(&scene[i], DirectX::XMVectorSetW(DirectX::XMVectorAdd(diffuse,
+						DirectX::XMLoadFloat3(&specularLighting[i])), color[i].w));
+				}
+			}, 4096U);
+	}
+
+	void SoftwareRenderer::ToneMappingPass()
+	{
+		// HDRGammaPS, Reinhard tone mapping followed by gamma correction
+		const DirectX::XMVECTOR exposure = DirectX::XMVectorReplicate(-params.hdrExposure);
+		const DirectX::XMVECTOR gammaInv = DirectX::XMVectorReplicate(1.0f / params.gamma);
+		Utils::ThreadPool::Get().ParallelFor(scene.size(), [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const DirectX::XMVECTOR mapped = DirectX::XMVectorSubtract(DirectX::XMVectorSplatOne(),
+						DirectX::XMVectorExpE(DirectX::XMVectorMultiply(DirectX::XMLoadFloat4(&scene[i]), exposure)));
+					DirectX::XMFLOAT4 pixel;
+					DirectX::XMStoreFloat4(&pixel, DirectX::XMVectorSaturate(DirectX::XMVectorPow(mapped, gammaInv)));
+					image[i] = static_cast<uint32_t>(pixel.x * 255.0f + 0.5f) | (static_cast<uint32_t>(pixel.y * 255.0f + 0.5f) << 8)
+						| (static_cast<uint32_t>(pixel.z * 255.0f + 0.5f) << 16) | 0xFF000000;
+				}
+			}, 4096U);
+	}
+
+	SoftwareRenderer::SoftwareRenderer(uint32_t width, uint32_t height)
+		: SoftwareRenderer(width, height, Params()) {}
+
+	SoftwareRenderer::SoftwareRenderer(uint32_t width, uint32_t height, const Params& params)
+		: params(params), width(width), height(height), tilesX((width + TILE_SIZE - 1) / TILE_SIZE), tilesY((height + TILE_SIZE - 1) / TILE_SIZE)
+	{
+		if (this->params.ssaoDownscale == 0)
+			this->params.ssaoDownscale = 1;
+		ssaoWidth = (width + this->params.ssaoDownscale - 1) / this->params.ssaoDownscale;
+		ssaoHeight = (height + this->params.ssaoDownscale - 1) / this->params.ssaoDownscale;
+		const size_t size = static_cast<size_t>(width) * height;
+		bins.resize(static_cast<size_t>(tilesX) * tilesY);
+		depth.resize(size);
+		color.resize(size);
+		normal.resize(size);
+		specular.resize(size);
+		lighting.resize(size);
+		specularLighting.resize(size);
+		ssao.resize(size);
+		ssaoScratch.resize(size);
+		if (this->params.ssaoDownscale > 1)
+		{
+			const size_t ssaoSize = static_cast<size_t>(ssaoWidth) * ssaoHeight;
+			ssaoDepth.resize(ssaoSize);
+			ssaoNormal.resize(ssaoSize);
+			ssaoLow.resize(ssaoSize);
+		}
+		scene.resize(size);
+		image.resize(size);
+		SetCamera(DirectX::XMMatrixIdentity(), DirectX::XMMatrixIdentity(), cameraPos, nearClip, farClip);
+
+		// Fixed seed so reference images are reproducible
+		std::mt19937_64 engine(0);
+		std::uniform_real_distribution<float> ndc(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		for (uint32_t i = 0; i < SSAO_KERNEL_SIZE; ++i)
+		{
+			const DirectX::XMVECTOR sample = DirectX::XMVectorSet(ndc(engine), ndc(engine), unit(engine), 0.0f);
+			float scale = static_cast<float>(i) / SSAO_KERNEL_SIZE;
+			scale = 0.1f + 0.9f * scale * scale;
+			DirectX::XMStoreFloat3(&ssaoKernel[i], DirectX::XMVectorScale(DirectX::XMVector3Normalize(sample), scale));
+		}
+		for (auto& noise : ssaoNoise)
+			noise = { ndc(engine), ndc(engine) };
+	}
+
+	SoftwareRenderer::ErrorMetrics SoftwareRenderer::Compare(const std::vector<float>& reference, const std::vector<float>& values) noexcept
+	{
+		assert(reference.size() == values.size());
+		ErrorMetrics metrics = { 0.0f, 0.0f, 0.0f };
+		if (reference.size() == 0)
+			return metrics;
+
+		double sum = 0.0;
+		double squareSum = 0.0;
+		for (size_t i = 0; i < reference.size(); ++i)
+		{
+			const float error = std::abs(values[i] - reference[i]);
+			sum += error;
+			squareSum += static_cast<double>(error) * error;
+			metrics.maxAbsolute = std::max(metrics.maxAbsolute, error);
+		}
+		metrics.meanAbsolute = static_cast<float>(sum / reference.size());
+		metrics.rootMeanSquare = static_cast<float>(std::sqrt(squareSum / reference.size()));
+		return metrics;
+	}
+
+	void SoftwareRenderer::SetCamera(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& projection, const DirectX::XMFLOAT3& position, float nearClip, float farClip) noexcept
+	{
+		const DirectX::XMMATRIX viewProj = DirectX::XMMatrixMultiply(view, projection);
+		DirectX::XMStoreFloat4x4(&viewProjection, viewProj);
+		DirectX::XMStoreFloat4x4(&inverseViewProjection, DirectX::XMMatrixInverse(nullptr, viewProj));
+		cameraPos = position;
+		this->nearClip = nearClip;
+		this->farClip = farClip;
+	}
+
+	void SoftwareRenderer::DrawIndexed(const Mesh& mesh, const Material& material, const DirectX::XMMATRIX& transform)
+	{
+		Draw draw = { &mesh, &material };
+		DirectX::XMStoreFloat4x4(&draw.transform, transform);
+		draws.emplace_back(draw);
+	}
+
+	void SoftwareRenderer::Render()
+	{
+		stats.clear();
+		RunPass("Geometry", [this]() { GeometryPass(); });
+		RunPass("Lighting", [this]() { LightingPass(); });
+		if (params.ssaoDownscale > 1)
+			RunPass("Ambient occlusion (reduced)", [this]() { ReducedAmbientOcclusionPass(); });
+		else
+			RunPass("Ambient occlusion", [this]() { AmbientOcclusionPass(); });
+		RunPass("Light combine", [this]() { LightCombinePass(); });
+		RunPass("Tone mapping", [this]() { ToneMappingPass(); });
+		draws.clear();
+	}
+}
\ No newline at end of file
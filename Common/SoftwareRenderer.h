@@ -0,0 +1,199 @@
+#pragma once
+#include "SceneFile.h"
+#include <array>
+
+namespace GFX
+{
+	// Standalone CPU approximation of main deferred pipeline, rendering its own list of draws (it is not a backend of Graphics).
+	// Ports shaders of geometry, lighting, ambient occlusion, light combine and tone mapping passes for measuring their cost
+	// on deterministic device. Shadows, normal and parallax mapping and skybox are not rendered, so its output
+	// does not validate MainPipelineGraph, which is checked only on Direct3D device (Benchmark device suite).
+	class SoftwareRenderer
+	{
+	public:
+		struct Vertex
+		{
+			DirectX::XMFLOAT3 position;
+			DirectX::XMFLOAT3 normal;
+			DirectX::XMFLOAT2 texCoord;
+		};
+		struct Mesh
+		{
+			std::vector<Vertex> vertices;
+			std::vector<uint32_t> indices;
+		};
+		// Image in R8G8B8A8 format
+		struct Texture
+		{
+			const uint32_t* pixels = nullptr;
+			uint32_t width = 0;
+			uint32_t height = 0;
+		};
+		struct Material
+		{
+			// sRGB color used when there is no texture
+			DirectX::XMFLOAT4 color = { 0.0f, 0.8f, 1.0f, 1.0f };
+			Texture texture;
+			DirectX::XMFLOAT3 specularColor = { 1.0f, 1.0f, 1.0f };
+			float specularIntensity = 0.9f;
+			// Mapped into exponent 2^(13 * power) like in shaders
+			float specularPower = 0.409f;
+		};
+		struct Params
+		{
+			float gamma = 2.2f;
+			float hdrExposure = 1.5f;
+			DirectX::XMFLOAT3 ambientColor = { 0.05f, 0.05f, 0.05f };
+			float ssaoBias = 0.188f;
+			float ssaoRadius = 0.86f;
+			float ssaoPower = 2.77f;
+			// 1 - occlusion at full resolution with blur, 2 or 4 - reduced resolution with bilateral upsampling
+			uint32_t ssaoDownscale = 1U;
+		};
+		struct PassStats
+		{
+			const char* name;
+			// In ms
+			float time;
+			// Processed pixels, in Mpix/s
+			float throughput;
+		};
+		struct ErrorMetrics
+		{
+			float meanAbsolute;
+			float rootMeanSquare;
+			float maxAbsolute;
+		};
+
+	private:
+		static constexpr uint32_t TILE_SIZE = 64U;
+		static constexpr uint32_t SSAO_KERNEL_SIZE = 32U;
+		static constexpr uint32_t SSAO_NOISE_SIZE = 4U;
+		// Same as in SSAOUpsamplePS
+		static constexpr float SSAO_DEPTH_SHARPNESS = 32.0f;
+		static constexpr float SSAO_NORMAL_POWER = 8.0f;
+		static constexpr float SSAO_WEIGHT_EPSILON = 0.0001f;
+
+		struct Draw
+		{
+			const Mesh* mesh;
+			const Material* material;
+			DirectX::XMFLOAT4X4 transform;
+		};
+		struct ClipVertex
+		{
+			DirectX::XMFLOAT4 position;
+			DirectX::XMFLOAT3 normal;
+			DirectX::XMFLOAT2 texCoord;
+		};
+		struct Triangle
+		{
+			// Barycentric coordinates as edge functions l(x, y) = a * x + b * y + c
+			DirectX::XMFLOAT3 edges[3];
+			// Screen space depth of vertices
+			DirectX::XMFLOAT3 depth;
+			DirectX::XMFLOAT3 invW;
+			// Attributes divided by w for perspective correct interpolation
+			DirectX::XMFLOAT3 normals[3];
+			DirectX::XMFLOAT2 texCoords[3];
+			const Material* material;
+			int minX;
+			int maxX;
+			int minY;
+			int maxY;
+		};
+
+		Params params;
+		uint32_t width;
+		uint32_t height;
+		uint32_t tilesX;
+		uint32_t tilesY;
+		uint32_t ssaoWidth;
+		uint32_t ssaoHeight;
+		DirectX::XMFLOAT4X4 viewProjection;
+		DirectX::XMFLOAT4X4 inverseViewProjection;
+		DirectX::XMFLOAT3 cameraPos = { 0.0f, 0.0f, 0.0f };
+		float nearClip = 0.01f;
+		float farClip = 500.0f;
+		std::vector<Draw> draws;
+		std::vector<SceneFile::PointLight> pointLights;
+		std::vector<SceneFile::SpotLight> spotLights;
+		std::vector<SceneFile::DirectionalLight> directionalLights;
+		std::array<DirectX::XMFLOAT3, SSAO_KERNEL_SIZE> ssaoKernel;
+		std::array<DirectX::XMFLOAT2, SSAO_NOISE_SIZE * SSAO_NOISE_SIZE> ssaoNoise;
+
+		std::vector<Triangle> triangles;
+		std::vector<std::vector<uint32_t>> bins;
+		// Geometry buffer, color alpha: 0 - solid, 1 - empty
+		std::vector<float> depth;
+		std::vector<DirectX::XMFLOAT4> color;
+		std::vector<DirectX::XMFLOAT3> normal;
+		std::vector<DirectX::XMFLOAT4> specular;
+		// Light buffer
+		std::vector<DirectX::XMFLOAT3> lighting;
+		std::vector<DirectX::XMFLOAT3> specularLighting;
+		std::vector<float> ssao;
+		std::vector<float> ssaoScratch;
+		// Downsampled geometry and occlusion for reduced SSAO resolution
+		std::vector<float> ssaoDepth;
+		std::vector<DirectX::XMFLOAT3> ssaoNormal;
+		std::vector<float> ssaoLow;
+		std::vector<DirectX::XMFLOAT4> scene;
+		std::vector<uint32_t> image;
+		std::vector<PassStats> stats;
+
+		static DirectX::XMVECTOR Sample(const Texture& texture, float u, float v) noexcept;
+		static DirectX::XMVECTOR DeleteGammaCorrection(DirectX::XMVECTOR srgb, float gamma) noexcept;
+
+		void SetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const Material* material);
+		void ClipTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const Material* material);
+		// Texture coordinates in range 0-1
+		DirectX::XMVECTOR GetWorldPosition(float u, float v, float pixelDepth) const noexcept;
+		DirectX::XMVECTOR GetWorldPosition(uint32_t x, uint32_t y) const noexcept;
+		void RasterizeTile(uint32_t tile) noexcept;
+		void ShadeLights(uint32_t y) noexcept;
+		// Sample depths are read from given map that covers whole screen, noise is chosen by coordinates of target pixel
+		float GetOcclusion(const DirectX::XMVECTOR& position, const DirectX::XMVECTOR& pixelNormal,
+			uint32_t noiseX, uint32_t noiseY, const float* depthMap, uint32_t mapWidth, uint32_t mapHeight) const noexcept;
+		float GetUpsampledOcclusion(uint32_t x, uint32_t y) const noexcept;
+
+		template<typename F>
+		void RunPass(const char* name, F&& pass);
+
+		void GeometryPass();
+		void LightingPass();
+		void AmbientOcclusionPass();
+		void ReducedAmbientOcclusionPass();
+		void LightCombinePass();
+		void ToneMappingPass();
+
+	public:
+		SoftwareRenderer(uint32_t width, uint32_t height);
+		SoftwareRenderer(uint32_t width, uint32_t height, const Params& params);
+		SoftwareRenderer(const SoftwareRenderer&) = delete;
+		SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+		~SoftwareRenderer() = default;
+
+		constexpr uint32_t GetWidth() const noexcept { return width; }
+		constexpr uint32_t GetHeight() const noexcept { return height; }
+		// Final image in R8G8B8A8 format
+		constexpr const std::vector<uint32_t>& GetImage() const noexcept { return image; }
+		// Ambient occlusion after blur or upsampling, 1 - no occlusion
+		constexpr const std::vector<float>& GetAmbientOcclusion() const noexcept { return ssao; }
+		// Timings of passes from last frame
+		constexpr const std::vector<PassStats>& GetStats() const noexcept { return stats; }
+
+		// Differences between buffers of same size, ex. reduced resolution SSAO against full resolution one
+		static ErrorMetrics Compare(const std::vector<float>& reference, const std::vector<float>& values) noexcept;
+
+		void SetCamera(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& projection, const DirectX::XMFLOAT3& position, float nearClip, float farClip) noexcept;
+		inline void AddLight(const SceneFile::PointLight& light) { pointLights.emplace_back(light); }
+		inline void AddLight(const SceneFile::SpotLight& light) { spotLights.emplace_back(light); }
+		inline void AddLight(const SceneFile::DirectionalLight& light) { directionalLights.emplace_back(light); }
+		// Mesh and material have to stay alive until frame is rendered
+		void DrawIndexed(const Mesh& mesh, const Material& material, const DirectX::XMMATRIX& transform);
+
+		// Renders all queued draws, they are cleared afterwards while lights and camera stay
+		void Render();
+	};
+}
\ No newline at end of file
@@ -12,7 +12,7 @@
 
 namespace GFX
 {
-	Surface::Surface(const std::string& name)
+	Surface::Surface(const std::string& name, bool decompress)
 	{
 		DXT_ENABLE_EXCEPT();
 		const std::filesystem::path path = name;
@@ -25,7 +25,7 @@ namespace GFX
 				"Loading image \"" + name + "\": failed.");
 			image = scratch.GetImage(0, 0, 0);
 
-			if (image->format != PIXEL_FORMAT)
+			if (decompress && image->format != PIXEL_FORMAT)
 			{
 				DirectX::ScratchImage decompressed;
 				DXT_THROW_FAILED(DirectX::Decompress(*image, PIXEL_FORMAT, decompressed),
@@ -50,6 +50,10 @@ namespace GFX
 		}
 		else
 		{
+#ifndef _WIN32
+			// WIC codecs are part of Windows
+			throw IMG_EXCEPT("Loading image \"" + name + "\": format not supported on this platform.");
+#else
 			DXT_THROW_FAILED(DirectX::LoadFromWICFile(Utils::ToUtf8(name).c_str(), DirectX::WIC_FLAGS::WIC_FLAGS_IGNORE_SRGB, nullptr, scratch),
 				"Loading image \"" + name + "\": failed.");
 			image = scratch.GetImage(0, 0, 0);
@@ -62,6 +66,7 @@ namespace GFX
 				scratch = std::move(converted);
 				image = scratch.GetImage(0, 0, 0);
 			}
+#endif
 		}
 	}
 
@@ -115,6 +120,9 @@ namespace GFX
 		}
 		else
 		{
+#ifndef _WIN32
+			throw IMG_EXCEPT("Saving surface to \"" + filename + "\": format not supported on this platform.");
+#else
 			const auto GetCodecID = [&filename](const std::string& ext) -> DirectX::WICCodecs
 			{
 				if (ext == ".png")
@@ -135,6 +143,7 @@ namespace GFX
 			};
 			DXT_THROW_FAILED(DirectX::SaveToWICFile(*image, DirectX::WIC_FLAGS::WIC_FLAGS_NONE, DirectX::GetWICCodec(GetCodecID(ext)), Utils::ToUtf8(filename).c_str()),
 				"Saving surface to \"" + filename + "\": failed to save.");
+#endif
 		}
 	}
 
@@ -44,7 +44,8 @@ namespace GFX
 		const DirectX::Image* image;
 
 	public:
-		Surface(const std::string& name);
+		// When not decompressing, DDS file is kept in stored format with all mip levels
+		Surface(const std::string& name, bool decompress = true);
 		Surface(size_t width, size_t height, DXGI_FORMAT format = PIXEL_FORMAT);
 		Surface(Surface&& surface) noexcept = default;
 		Surface(const Surface&) = delete;
@@ -57,6 +58,9 @@ namespace GFX
 		constexpr size_t GetHeight() const noexcept { return image->height; }
 		constexpr size_t GetRowByteSize() const noexcept { return image->rowPitch; }
 		constexpr size_t GetSize() const noexcept { return GetWidth() * GetHeight(); }
+		inline size_t GetMipCount() const noexcept { return scratch.GetMetadata().mipLevels; }
+		inline const DirectX::Image& GetMip(size_t level) const noexcept(!IS_DEBUG) { assert(level < GetMipCount()); return *scratch.GetImage(level, 0, 0); }
+		inline bool IsCompressed() const noexcept { return DirectX::IsCompressed(GetFormat()); }
 		inline bool HasAlpha() const noexcept { return !scratch.IsAlphaAllOpaque(); }
 		inline Pixel* GetBuffer() noexcept { return reinterpret_cast<Pixel*>(image->pixels); }
 		inline const Pixel* GetBuffer() const noexcept { return reinterpret_cast<const Pixel*>(image->pixels); }
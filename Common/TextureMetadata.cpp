@@ -0,0 +1,194 @@
+#include "TextureMetadata.h"
+#include "ThreadPool.h"
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+
+namespace GFX
+{
+	std::atomic_size_t TextureMetadata::sidecarHits = 0;
+	std::atomic_size_t TextureMetadata::computed = 0;
+	std::atomic_uint64_t TextureMetadata::computeTime = 0;
+
+	TextureMetadata::Alpha TextureMetadata::ClassifyAlpha(const DirectX::Image& image) noexcept
+	{
+		// Bit 0: some alpha below 255, bit 1: some alpha neither 0 nor 255
+		constexpr uint8_t NOT_OPAQUE = 1;
+		constexpr uint8_t PARTIAL = 2;
+		std::atomic_uint8_t result = 0;
+		Utils::ThreadPool::Get().ParallelFor(image.height, [&image, &result](size_t begin, size_t end)
+			{
+				const DirectX::XMVECTOR alphaMask = DirectX::XMVectorReplicateInt(0xFF000000);
+				const DirectX::XMVECTOR zero = DirectX::XMVectorZero();
+				DirectX::XMVECTOR notOpaque = zero;
+				DirectX::XMVECTOR partial = zero;
+				uint32_t scalarFlags = 0;
+				for (size_t y = begin; y < end; ++y)
+				{
+					const uint32_t* row = reinterpret_cast<const uint32_t*>(image.pixels + y * image.rowPitch);
+					size_t x = 0;
+					// 4 pixels at once, only alpha byte is kept
+					for (; x + 4 <= image.width; x += 4)
+					{
+						const DirectX::XMVECTOR alpha = DirectX::XMVectorAndInt(DirectX::XMLoadInt4(row + x), alphaMask);
+						const DirectX::XMVECTOR belowMax = DirectX::XMVectorNotEqualInt(alpha, alphaMask);
+						notOpaque = DirectX::XMVectorOrInt(notOpaque, belowMax);
+						partial = DirectX::XMVectorOrInt(partial, DirectX::XMVectorAndInt(belowMax, DirectX::XMVectorNotEqualInt(alpha, zero)));
+					}
+					for (; x < image.width; ++x)
+					{
+						const uint32_t alpha = row[x] >> 24;
+						if (alpha != 0xFF)
+							scalarFlags |= alpha ? NOT_OPAQUE | PARTIAL : NOT_OPAQUE;
+					}
+					// Nothing more to find in this chunk
+					if (!DirectX::XMVector4EqualInt(partial, zero) || (scalarFlags & PARTIAL))
+						break;
+				}
+				uint8_t flags = static_cast<uint8_t>(scalarFlags);
+				if (!DirectX::XMVector4EqualInt(notOpaque, zero))
+					flags |= NOT_OPAQUE;
+				if (!DirectX::XMVector4EqualInt(partial, zero))
+					flags |= PARTIAL;
+				result.fetch_or(flags, std::memory_order_relaxed);
+			}, 64U);
+
+		const uint8_t flags = result.load(std::memory_order_relaxed);
+		if (flags & PARTIAL)
+			return Alpha::Translucent;
+		if (flags & NOT_OPAQUE)
+			return Alpha::Mask;
+		return Alpha::Opaque;
+	}
+
+	uint64_t TextureMetadata::ComputeHash(const DirectX::Image& image) noexcept
+	{
+		// FNV-1a over 64 bit words of every block, then over block hashes in order
+		constexpr uint64_t OFFSET = 14695981039346656037ULL;
+		constexpr uint64_t PRIME = 1099511628211ULL;
+		const size_t size = image.slicePitch;
+		std::vector<uint64_t> blocks((size + HASH_BLOCK_SIZE - 1) / HASH_BLOCK_SIZE);
+		Utils::ThreadPool::Get().ParallelFor(blocks.size(), [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const uint8_t* data = image.pixels + i * HASH_BLOCK_SIZE;
+					const size_t blockSize = std::min(HASH_BLOCK_SIZE, size - i * HASH_BLOCK_SIZE);
+					uint64_t hash = OFFSET;
+					size_t j = 0;
+					for (; j + sizeof(uint64_t) <= blockSize; j += sizeof(uint64_t))
+					{
+						uint64_t word;
+						memcpy(&word, data + j, sizeof(uint64_t));
+						hash = (hash ^ word) * PRIME;
+					}
+					for (; j < blockSize; ++j)
+						hash = (hash ^ data[j]) * PRIME;
+					blocks[i] = hash;
+				}
+			});
+		uint64_t hash = OFFSET;
+		for (uint64_t block : blocks)
+			hash = (hash ^ block) * PRIME;
+		return hash;
+	}
+
+	bool TextureMetadata::GetFileStamp(const std::string& file, uint64_t& size, int64_t& time) noexcept
+	{
+		std::error_code error;
+		size = std::filesystem::file_size(file, error);
+		if (error)
+			return false;
+		time = std::filesystem::last_write_time(file, error).time_since_epoch().count();
+		return !error;
+	}
+
+	TextureMetadata::TextureMetadata(const Surface& surface)
+		: width(static_cast<uint32_t>(surface.GetWidth())), height(static_cast<uint32_t>(surface.GetHeight())),
+		format(surface.GetFormat()), mipCount(static_cast<uint32_t>(surface.GetMipCount()))
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		const DirectX::Image& top = surface.GetMip(0);
+		hash = ComputeHash(top);
+		if (!DirectX::HasAlpha(format))
+			alpha = Alpha::Opaque;
+		else if (format == DXGI_FORMAT_R8G8B8A8_UNORM || format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ||
+			format == DXGI_FORMAT_B8G8R8A8_UNORM || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB)
+			alpha = ClassifyAlpha(top);
+		else
+		{
+			// Other formats are expanded to 8 bit per channel first
+			DirectX::ScratchImage converted;
+			const HRESULT hr = surface.IsCompressed() ? DirectX::Decompress(top, DXGI_FORMAT_R8G8B8A8_UNORM, converted) :
+				DirectX::Convert(top, DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+			if (SUCCEEDED(hr))
+				alpha = ClassifyAlpha(*converted.GetImage(0, 0, 0));
+			else
+				alpha = surface.HasAlpha() ? Alpha::Translucent : Alpha::Opaque;
+		}
+		++computed;
+		computeTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	TextureMetadata TextureMetadata::Get(const std::string& file, const Surface& surface)
+	{
+		if (auto metadata = Read(file))
+			return *metadata;
+
+		TextureMetadata metadata(surface);
+		if (GetFileStamp(file, metadata.fileSize, metadata.fileTime))
+			metadata.Write(file);
+		return metadata;
+	}
+
+	std::optional<TextureMetadata> TextureMetadata::Read(const std::string& file) noexcept
+	{
+		uint64_t fileSize;
+		int64_t fileTime;
+		if (!GetFileStamp(file, fileSize, fileTime))
+			return {};
+		std::ifstream fin(GetSidecarPath(file), std::ios::binary);
+		if (!fin.good())
+			return {};
+		Record record;
+		fin.read(reinterpret_cast<char*>(&record), sizeof(Record));
+		if (!fin.good() || record.magic != MAGIC || record.version != VERSION ||
+			record.fileSize != fileSize || record.fileTime != fileTime)
+			return {};
+
+		TextureMetadata metadata;
+		metadata.fileSize = fileSize;
+		metadata.fileTime = fileTime;
+		metadata.width = record.width;
+		metadata.height = record.height;
+		metadata.format = static_cast<DXGI_FORMAT>(record.format);
+		metadata.mipCount = record.mipCount;
+		metadata.hash = record.hash;
+		metadata.alpha = record.alpha;
+		++sidecarHits;
+		return metadata;
+	}
+
+	TextureMetadata::Stats TextureMetadata::GetStats() noexcept
+	{
+		return { sidecarHits.load(), computed.load(), computeTime.load() / 1000.0f };
+	}
+
+	void TextureMetadata::Write(const std::string& file) const noexcept
+	{
+		Record record = {};
+		record.magic = MAGIC;
+		record.version = VERSION;
+		record.fileSize = fileSize;
+		record.fileTime = fileTime;
+		record.width = width;
+		record.height = height;
+		record.format = static_cast<uint32_t>(format);
+		record.mipCount = mipCount;
+		record.hash = hash;
+		record.alpha = alpha;
+		std::ofstream fout(GetSidecarPath(file), std::ios::binary | std::ios::trunc);
+		if (fout.good())
+			fout.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+	}
+}
\ No newline at end of file
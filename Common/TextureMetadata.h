@@ -0,0 +1,88 @@
+#pragma once
+#include "Surface.h"
+#include <optional>
+#include <atomic>
+
+namespace GFX
+{
+	// Properties of texture file needed before creating it, kept in sidecar file next to texture.
+	// Sidecar is valid as long as size and write time of texture file match, otherwise content is classified again.
+	class TextureMetadata
+	{
+	public:
+		static constexpr const char* SIDECAR_EXTENSION = ".hmeta";
+
+		enum class Alpha : uint8_t { Opaque, Mask, Translucent };
+
+		struct Stats
+		{
+			size_t sidecarHits = 0;
+			size_t computed = 0;
+			// In ms
+			float computeTime = 0.0f;
+		};
+
+	private:
+		static constexpr uint32_t MAGIC = 0x4154454D; // META
+		static constexpr uint32_t VERSION = 1;
+		// Content hash is computed in fixed blocks so it does not depend on number of workers
+		static constexpr size_t HASH_BLOCK_SIZE = 65536;
+
+		struct Record
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t fileSize;
+			int64_t fileTime;
+			uint32_t width;
+			uint32_t height;
+			uint32_t format;
+			uint32_t mipCount;
+			uint64_t hash;
+			Alpha alpha;
+		};
+
+		static std::atomic_size_t sidecarHits;
+		static std::atomic_size_t computed;
+		static std::atomic_uint64_t computeTime;
+
+		uint64_t fileSize = 0;
+		int64_t fileTime = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+		uint32_t mipCount = 0;
+		uint64_t hash = 0;
+		Alpha alpha = Alpha::Opaque;
+
+		// Image has to be in 8 bit RGBA or BGRA format, alpha is always in highest byte
+		static Alpha ClassifyAlpha(const DirectX::Image& image) noexcept;
+		static uint64_t ComputeHash(const DirectX::Image& image) noexcept;
+		static bool GetFileStamp(const std::string& file, uint64_t& size, int64_t& time) noexcept;
+
+	public:
+		TextureMetadata() = default;
+		// Scans top mip of surface
+		TextureMetadata(const Surface& surface);
+		TextureMetadata(const TextureMetadata&) = default;
+		TextureMetadata& operator=(const TextureMetadata&) = default;
+		~TextureMetadata() = default;
+
+		static inline std::string GetSidecarPath(const std::string& file) noexcept { return file + SIDECAR_EXTENSION; }
+		// Reads sidecar of texture file when it is up to date, otherwise computes metadata from surface and tries to save it
+		static TextureMetadata Get(const std::string& file, const Surface& surface);
+		static std::optional<TextureMetadata> Read(const std::string& file) noexcept;
+		static Stats GetStats() noexcept;
+
+		constexpr uint32_t GetWidth() const noexcept { return width; }
+		constexpr uint32_t GetHeight() const noexcept { return height; }
+		constexpr DXGI_FORMAT GetFormat() const noexcept { return format; }
+		constexpr uint32_t GetMipCount() const noexcept { return mipCount; }
+		constexpr uint64_t GetHash() const noexcept { return hash; }
+		constexpr Alpha GetAlpha() const noexcept { return alpha; }
+		constexpr bool HasAlpha() const noexcept { return alpha != Alpha::Opaque; }
+
+		// Read-only locations are skipped silently
+		void Write(const std::string& file) const noexcept;
+	};
+}
\ No newline at end of file
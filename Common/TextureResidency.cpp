@@ -0,0 +1,172 @@
+#include "TextureResidency.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GFX
+{
+	size_t TextureResidency::GetMipBytes(const Entry& entry, uint8_t first, uint8_t last) noexcept
+	{
+		size_t bytes = 0;
+		for (uint8_t mip = first; mip < last; ++mip)
+		{
+			const size_t width = std::max(entry.width >> mip, 1U);
+			const size_t height = std::max(entry.height >> mip, 1U);
+			if (entry.compressed)
+				bytes += ((width + 3) / 4) * ((height + 3) / 4) * entry.bitsPerPixel * 2;
+			else
+				bytes += width * height * entry.bitsPerPixel / 8;
+		}
+		return bytes;
+	}
+
+	uint8_t TextureResidency::GetWantedMip(const Entry& entry, float screenSize) noexcept
+	{
+		if (screenSize < 1.0f)
+			return entry.tailMip;
+		// One texel per pixel along bigger dimension
+		const float mip = std::floor(std::log2(static_cast<float>(std::max(entry.width, entry.height)) / screenSize));
+		if (mip <= 0.0f)
+			return 0;
+		return static_cast<uint8_t>(std::min(mip, static_cast<float>(entry.tailMip)));
+	}
+
+	void TextureResidency::Evict(uint32_t index, std::vector<Request>& evictions) noexcept
+	{
+		Entry& entry = entries.at(index);
+		// Textures not visible in current frame are dropped to mip tail
+		const uint8_t mip = entry.lastUsed == frame - 1 ? entry.wantedMip : entry.tailMip;
+		const size_t bytes = GetMipBytes(entry, entry.residentMip, mip);
+		residentBytes -= bytes;
+		evictedBytes += bytes;
+		entry.residentMip = entry.pendingMip = mip;
+		evictions.push_back({ index, mip });
+	}
+
+	uint32_t TextureResidency::Add(uint32_t width, uint32_t height, uint8_t mipCount, uint32_t bitsPerPixel, bool compressed) noexcept
+	{
+		uint32_t index;
+		if (freeEntries.size())
+		{
+			index = freeEntries.back();
+			freeEntries.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(entries.size());
+			entries.emplace_back();
+		}
+		Entry& entry = entries.at(index);
+		entry = {};
+		entry.width = width;
+		entry.height = height;
+		entry.bitsPerPixel = bitsPerPixel;
+		entry.compressed = compressed;
+		entry.alive = true;
+		entry.mipCount = mipCount;
+		while (entry.tailMip + 1 < mipCount && std::max(width >> entry.tailMip, height >> entry.tailMip) > TAIL_SIZE)
+			++entry.tailMip;
+		entry.residentMip = entry.pendingMip = entry.wantedMip = entry.tailMip;
+		residentBytes += GetMipBytes(entry, entry.tailMip, mipCount);
+		++textureCount;
+		return index;
+	}
+
+	void TextureResidency::Remove(uint32_t index) noexcept
+	{
+		Entry& entry = entries.at(index);
+		pendingBytes -= GetMipBytes(entry, entry.pendingMip, entry.residentMip);
+		residentBytes -= GetMipBytes(entry, entry.residentMip, entry.mipCount);
+		entry.alive = false;
+		freeEntries.push_back(index);
+		--textureCount;
+	}
+
+	void TextureResidency::ReportUsage(uint32_t index, float screenSize) noexcept
+	{
+		Entry& entry = entries.at(index);
+		entry.lastUsed = frame;
+		entry.screenSize = std::max(entry.screenSize, screenSize);
+	}
+
+	void TextureResidency::Update(std::vector<Request>& loads, std::vector<Request>& evictions, size_t maxLoads) noexcept
+	{
+		usedCount = missCount = 0;
+		candidates.clear();
+		victims.clear();
+		for (uint32_t i = 0, size = static_cast<uint32_t>(entries.size()); i < size; ++i)
+		{
+			Entry& entry = entries.at(i);
+			if (!entry.alive)
+				continue;
+			if (entry.lastUsed == frame)
+			{
+				entry.wantedMip = GetWantedMip(entry, entry.screenSize);
+				entry.priority = entry.screenSize * (entry.residentMip - entry.wantedMip);
+				++usedCount;
+				if (entry.residentMip > entry.wantedMip)
+					++missCount;
+			}
+			else if (frame - entry.lastUsed > USAGE_TIMEOUT)
+				entry.wantedMip = entry.tailMip;
+			entry.screenSize = 0.0f;
+
+			// Only textures without load in flight can change residency
+			if (entry.pendingMip != entry.residentMip)
+				continue;
+			if (entry.lastUsed == frame && entry.wantedMip < entry.residentMip)
+				candidates.emplace_back(i);
+			else if (entry.wantedMip > entry.residentMip || (entry.lastUsed != frame && entry.residentMip < entry.tailMip))
+				victims.emplace_back(i);
+		}
+		++frame;
+
+		std::sort(candidates.begin(), candidates.end(), [this](uint32_t i1, uint32_t i2)
+			{
+				return entries.at(i1).priority > entries.at(i2).priority;
+			});
+		// Longest unused textures go first, visible ones only give back mips above wanted level
+		std::sort(victims.begin(), victims.end(), [this](uint32_t i1, uint32_t i2)
+			{
+				return entries.at(i1).lastUsed < entries.at(i2).lastUsed;
+			});
+
+		size_t victim = 0;
+		while (residentBytes + pendingBytes > budget && victim < victims.size())
+			Evict(victims.at(victim++), evictions);
+		for (uint32_t index : candidates)
+		{
+			if (loads.size() >= maxLoads)
+				break;
+			Entry& entry = entries.at(index);
+			uint8_t target = entry.wantedMip;
+			size_t cost = GetMipBytes(entry, target, entry.residentMip);
+			while (residentBytes + pendingBytes + cost > budget && victim < victims.size())
+				Evict(victims.at(victim++), evictions);
+			// Stream in only part of mips when whole chain does not fit
+			while (target < entry.residentMip && residentBytes + pendingBytes + cost > budget)
+				cost = GetMipBytes(entry, ++target, entry.residentMip);
+			if (target == entry.residentMip)
+				continue;
+			entry.pendingMip = target;
+			pendingBytes += cost;
+			loads.push_back({ index, target });
+		}
+	}
+
+	void TextureResidency::CompleteLoad(uint32_t index) noexcept
+	{
+		Entry& entry = entries.at(index);
+		const size_t bytes = GetMipBytes(entry, entry.pendingMip, entry.residentMip);
+		pendingBytes -= bytes;
+		residentBytes += bytes;
+		loadedBytes += bytes;
+		entry.residentMip = entry.pendingMip;
+	}
+
+	void TextureResidency::CancelLoad(uint32_t index) noexcept
+	{
+		Entry& entry = entries.at(index);
+		pendingBytes -= GetMipBytes(entry, entry.pendingMip, entry.residentMip);
+		entry.pendingMip = entry.residentMip;
+	}
+}
\ No newline at end of file
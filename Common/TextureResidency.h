@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace GFX
+{
+	// CPU side bookkeeping of streamed texture mips, decides which mips to load and evict under memory budget.
+	// Mip tail is always resident, higher mips are requested by priority computed from screen-space size of objects using texture.
+	class TextureResidency
+	{
+	public:
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+		// Mips not bigger than this size are never evicted
+		static constexpr uint32_t TAIL_SIZE = 128;
+		// Frames after last usage report when texture is considered unused
+		static constexpr uint64_t USAGE_TIMEOUT = 30;
+
+		struct Request
+		{
+			uint32_t texture;
+			uint8_t mip;
+		};
+
+	private:
+		struct Entry
+		{
+			uint32_t width = 0;
+			uint32_t height = 0;
+			uint32_t bitsPerPixel = 0;
+			bool compressed = false;
+			bool alive = false;
+			uint8_t mipCount = 0;
+			uint8_t tailMip = 0;
+			uint8_t residentMip = 0;
+			uint8_t pendingMip = 0;
+			uint8_t wantedMip = 0;
+			uint64_t lastUsed = 0;
+			// Biggest size reported in current frame
+			float screenSize = 0.0f;
+			float priority = 0.0f;
+		};
+
+		std::vector<Entry> entries;
+		std::vector<uint32_t> freeEntries;
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> victims;
+		uint64_t frame = 1;
+		size_t budget;
+		size_t residentBytes = 0;
+		size_t pendingBytes = 0;
+		size_t textureCount = 0;
+		size_t usedCount = 0;
+		size_t missCount = 0;
+		size_t loadedBytes = 0;
+		size_t evictedBytes = 0;
+
+		// Size of mips in range [first, last)
+		static size_t GetMipBytes(const Entry& entry, uint8_t first, uint8_t last) noexcept;
+		static uint8_t GetWantedMip(const Entry& entry, float screenSize) noexcept;
+
+		void Evict(uint32_t index, std::vector<Request>& evictions) noexcept;
+
+	public:
+		inline TextureResidency(size_t budget) noexcept : budget(budget) {}
+		TextureResidency(const TextureResidency&) = delete;
+		TextureResidency& operator=(const TextureResidency&) = delete;
+		~TextureResidency() = default;
+
+		constexpr size_t GetBudget() const noexcept { return budget; }
+		constexpr void SetBudget(size_t bytes) noexcept { budget = bytes; }
+		constexpr size_t GetResidentBytes() const noexcept { return residentBytes; }
+		constexpr size_t GetPendingBytes() const noexcept { return pendingBytes; }
+		constexpr size_t GetLoadedBytes() const noexcept { return loadedBytes; }
+		constexpr size_t GetEvictedBytes() const noexcept { return evictedBytes; }
+		constexpr size_t GetTextureCount() const noexcept { return textureCount; }
+		// Textures reported as used in last updated frame
+		constexpr size_t GetUsedCount() const noexcept { return usedCount; }
+		// Used textures that were missing wanted mip in last updated frame
+		constexpr size_t GetMissCount() const noexcept { return missCount; }
+		inline uint8_t GetResidentMip(uint32_t index) const noexcept { return entries.at(index).residentMip; }
+		inline uint8_t GetWantedMip(uint32_t index) const noexcept { return entries.at(index).wantedMip; }
+
+		// Only mip tail is resident after adding, bits per pixel as returned by DirectX::BitsPerPixel()
+		uint32_t Add(uint32_t width, uint32_t height, uint8_t mipCount, uint32_t bitsPerPixel, bool compressed) noexcept;
+		void Remove(uint32_t index) noexcept;
+		// Screen size is projected size in pixels of object using texture
+		void ReportUsage(uint32_t index, float screenSize) noexcept;
+		// Ends current frame, fills mip loads ordered by priority and evictions that have to be performed right away
+		void Update(std::vector<Request>& loads, std::vector<Request>& evictions, size_t maxLoads) noexcept;
+		void CompleteLoad(uint32_t index) noexcept;
+		void CancelLoad(uint32_t index) noexcept;
+	};
+}
\ No newline at end of file
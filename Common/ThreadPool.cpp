@@ -0,0 +1,123 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#ifdef _WIN32
+#include "WinAPI.h"
+#include <objbase.h>
+#endif
+
+namespace Utils
+{
+	thread_local bool ThreadPool::isWorker = false;
+
+	void ThreadPool::Work() noexcept
+	{
+		isWorker = true;
+#ifdef _WIN32
+		// Image decoding through WIC requires COM on calling thread
+		const bool comInit = SUCCEEDED(CoInitializeEx(nullptr, COINIT::COINIT_MULTITHREADED));
+#endif
+		std::unique_lock<std::mutex> lock(tasksMutex);
+		for (;;)
+		{
+			tasksCondition.wait(lock, [this]() { return !running || tasks.size() || batches.size(); });
+			// Callers of ParallelFor are blocked until batch is done so it goes first
+			if (batches.size())
+			{
+				RunChunk(lock, *batches.front());
+				continue;
+			}
+			if (tasks.size() == 0)
+				break;
+			{
+				std::function<void()> task = std::move(tasks.front());
+				tasks.pop_front();
+				lock.unlock();
+				task();
+			}
+			lock.lock();
+		}
+		lock.unlock();
+#ifdef _WIN32
+		if (comInit)
+			CoUninitialize();
+#endif
+	}
+
+	void ThreadPool::RunChunk(std::unique_lock<std::mutex>& lock, Batch& batch) noexcept
+	{
+		const size_t begin = batch.next++ * batch.chunkSize;
+		if (batch.next == batch.chunks)
+			batches.erase(std::find(batches.begin(), batches.end(), &batch));
+		lock.unlock();
+
+		std::exception_ptr error = nullptr;
+		try
+		{
+			batch.run(batch.body, begin, std::min(begin + batch.chunkSize, batch.count));
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+		lock.lock();
+		if (error && batch.error == nullptr)
+			batch.error = error;
+		if (--batch.remaining == 0)
+			batchCondition.notify_all();
+	}
+
+	void ThreadPool::RunBatch(Batch& batch)
+	{
+		std::unique_lock<std::mutex> lock(tasksMutex);
+		if (batch.chunks == 1 || batches.size() == batches.capacity())
+		{
+			lock.unlock();
+			batch.run(batch.body, 0U, batch.count);
+			return;
+		}
+		batch.remaining = batch.chunks;
+		batches.push_back(&batch);
+		lock.unlock();
+		for (size_t i = 1; i < batch.chunks; ++i)
+			tasksCondition.notify_one();
+
+		lock.lock();
+		while (batch.next < batch.chunks)
+			RunChunk(lock, batch);
+		// Chunks reference body so all of them have to finish before first error is passed on
+		batchCondition.wait(lock, [&batch]() { return batch.remaining == 0; });
+		lock.unlock();
+		if (batch.error)
+			std::rethrow_exception(batch.error);
+	}
+
+	ThreadPool::ThreadPool(size_t count)
+	{
+		batches.reserve(BATCH_SLOTS);
+		if (count == 0)
+		{
+			count = std::thread::hardware_concurrency();
+			count = count > 1 ? count - 1 : 1;
+		}
+		workers.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+			workers.emplace_back(&ThreadPool::Work, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(tasksMutex);
+			running = false;
+		}
+		tasksCondition.notify_all();
+		for (auto& worker : workers)
+			worker.join();
+	}
+
+	ThreadPool& ThreadPool::Get() noexcept
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+}
\ No newline at end of file
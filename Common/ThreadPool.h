@@ -0,0 +1,110 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <vector>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <type_traits>
+
+namespace Utils
+{
+	class ThreadPool
+	{
+		// Range split by ParallelFor, lives on caller stack so spreading work does not touch heap
+		struct Batch
+		{
+			void* body = nullptr;
+			void (*run)(void*, size_t, size_t) = nullptr;
+			size_t count = 0;
+			size_t chunkSize = 0;
+			size_t chunks = 0;
+			// Guarded by tasksMutex
+			size_t next = 0;
+			size_t remaining = 0;
+			std::exception_ptr error = nullptr;
+		};
+
+		static constexpr size_t BATCH_SLOTS = 64;
+
+		std::vector<std::thread> workers;
+		std::deque<std::function<void()>> tasks;
+		// Only batches with chunks not taken yet, capacity reserved up front
+		std::vector<Batch*> batches;
+		std::mutex tasksMutex;
+		std::condition_variable tasksCondition;
+		std::condition_variable batchCondition;
+		bool running = true;
+
+		static thread_local bool isWorker;
+
+		void Work() noexcept;
+		// Takes next chunk of batch and runs it, lock is released for the time of running
+		void RunChunk(std::unique_lock<std::mutex>& lock, Batch& batch) noexcept;
+		void RunBatch(Batch& batch);
+
+	public:
+		ThreadPool(size_t count = 0U);
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		~ThreadPool();
+
+		// Shared pool sized to hardware threads (without main thread)
+		static ThreadPool& Get() noexcept;
+
+		// Waiting for pool tasks from inside a worker can starve the pool, such work should run inline
+		static inline bool IsWorker() noexcept { return isWorker; }
+
+		inline size_t GetWorkersCount() const noexcept { return workers.size(); }
+
+		template<typename F>
+		auto Schedule(F&& task) -> std::future<decltype(task())>;
+		// Splits range [0, count) into chunks and waits for all of them, caller thread takes part in work.
+		// Does not allocate, runs whole range inline when all batch slots are taken
+		template<typename F>
+		void ParallelFor(size_t count, F&& body, size_t minChunk = 1U);
+	};
+
+	template<typename F>
+	auto ThreadPool::Schedule(F&& task) -> std::future<decltype(task())>
+	{
+		auto job = std::make_shared<std::packaged_task<decltype(task())()>>(std::forward<F>(task));
+		auto result = job->get_future();
+		{
+			std::lock_guard<std::mutex> lock(tasksMutex);
+			tasks.emplace_back([job]() { (*job)(); });
+		}
+		tasksCondition.notify_one();
+		return result;
+	}
+
+	template<typename F>
+	void ThreadPool::ParallelFor(size_t count, F&& body, size_t minChunk)
+	{
+		if (count == 0)
+			return;
+		if (IsWorker())
+		{
+			body(0U, count);
+			return;
+		}
+		if (minChunk == 0)
+			minChunk = 1;
+		size_t chunks = (count + minChunk - 1) / minChunk;
+		if (chunks > workers.size() + 1)
+			chunks = workers.size() + 1;
+		Batch batch;
+		batch.body = const_cast<void*>(static_cast<const void*>(std::addressof(body)));
+		batch.run = [](void* body, size_t begin, size_t end)
+		{
+			(*static_cast<std::remove_reference_t<F>*>(body))(begin, end);
+		};
+		batch.count = count;
+		batch.chunkSize = (count + chunks - 1) / chunks;
+		batch.chunks = (count + batch.chunkSize - 1) / batch.chunkSize;
+		RunBatch(batch);
+	}
+}
\ No newline at end of file
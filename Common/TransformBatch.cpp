@@ -0,0 +1,95 @@
+#include "TransformBatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GFX
+{
+	DirectX::XMMATRIX TransformBatch::GetMatrix(const TRS& transform, const DirectX::XMFLOAT3& localScale) noexcept
+	{
+		DirectX::XMMATRIX world = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&transform.rotation));
+		world.r[0] = DirectX::XMVectorScale(world.r[0], localScale.x * transform.scale);
+		world.r[1] = DirectX::XMVectorScale(world.r[1], localScale.y * transform.scale);
+		world.r[2] = DirectX::XMVectorScale(world.r[2], localScale.z * transform.scale);
+		world.r[3] = DirectX::XMVectorSetW(DirectX::XMLoadFloat3(&transform.position), 1.0f);
+		return world;
+	}
+
+	DirectX::XMFLOAT3 TransformBatch::GetEulerAngles(const DirectX::XMFLOAT4& rotation) noexcept
+	{
+		// Elements of rotation matrix built from roll * pitch * yaw
+		const float m00 = 1.0f - 2.0f * (rotation.y * rotation.y + rotation.z * rotation.z);
+		const float m01 = 2.0f * (rotation.x * rotation.y + rotation.z * rotation.w);
+		const float m10 = 2.0f * (rotation.x * rotation.y - rotation.z * rotation.w);
+		const float m11 = 1.0f - 2.0f * (rotation.x * rotation.x + rotation.z * rotation.z);
+		const float m20 = 2.0f * (rotation.x * rotation.z + rotation.y * rotation.w);
+		const float m21 = 2.0f * (rotation.y * rotation.z - rotation.x * rotation.w);
+		const float m22 = 1.0f - 2.0f * (rotation.x * rotation.x + rotation.y * rotation.y);
+
+		const float pitch = std::asin(std::clamp(-m21, -1.0f, 1.0f));
+		// Gimbal lock, yaw and roll rotate around same axis
+		if (std::abs(m21) > 0.999999f)
+			return { pitch, 0.0f, std::atan2(-m10, m00) };
+		return { pitch, std::atan2(m20, m22), std::atan2(m01, m11) };
+	}
+
+	void TransformBatch::Flush() noexcept
+	{
+		lastFlushed = entries.size();
+		const DirectX::XMVECTOR one = DirectX::XMVectorSplatOne();
+		const DirectX::XMVECTOR zero = DirectX::XMVectorZero();
+		for (size_t i = 0; i < entries.size(); i += LANES)
+		{
+			// Missing lanes repeat last entry, only valid ones are stored
+			const size_t count = std::min(LANES, entries.size() - i);
+			DirectX::XMMATRIX rotation;
+			DirectX::XMMATRIX scale;
+			DirectX::XMVECTOR position[LANES];
+			for (size_t lane = 0; lane < LANES; ++lane)
+			{
+				const Entry& entry = entries[i + std::min(lane, count - 1)];
+				rotation.r[lane] = DirectX::XMLoadFloat4(&entry.transform->rotation);
+				scale.r[lane] = DirectX::XMVectorScale(DirectX::XMLoadFloat3(entry.localScale), entry.transform->scale);
+				position[lane] = DirectX::XMVectorSetW(DirectX::XMLoadFloat3(&entry.transform->position), 1.0f);
+			}
+			// Every register holds one component of all objects
+			rotation = DirectX::XMMatrixTranspose(rotation);
+			scale = DirectX::XMMatrixTranspose(scale);
+
+			const DirectX::XMVECTOR& x = rotation.r[0];
+			const DirectX::XMVECTOR& y = rotation.r[1];
+			const DirectX::XMVECTOR& z = rotation.r[2];
+			const DirectX::XMVECTOR& w = rotation.r[3];
+			const DirectX::XMVECTOR x2 = DirectX::XMVectorAdd(x, x);
+			const DirectX::XMVECTOR y2 = DirectX::XMVectorAdd(y, y);
+			const DirectX::XMVECTOR z2 = DirectX::XMVectorAdd(z, z);
+			const DirectX::XMVECTOR xx = DirectX::XMVectorMultiply(x, x2);
+			const DirectX::XMVECTOR yy = DirectX::XMVectorMultiply(y, y2);
+			const DirectX::XMVECTOR zz = DirectX::XMVectorMultiply(z, z2);
+			const DirectX::XMVECTOR xy = DirectX::XMVectorMultiply(x, y2);
+			const DirectX::XMVECTOR xz = DirectX::XMVectorMultiply(x, z2);
+			const DirectX::XMVECTOR yz = DirectX::XMVectorMultiply(y, z2);
+			const DirectX::XMVECTOR wx = DirectX::XMVectorMultiply(w, x2);
+			const DirectX::XMVECTOR wy = DirectX::XMVectorMultiply(w, y2);
+			const DirectX::XMVECTOR wz = DirectX::XMVectorMultiply(w, z2);
+
+			// Same layout as XMMatrixRotationQuaternion with rows scaled
+			DirectX::XMMATRIX row0(DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(one, DirectX::XMVectorAdd(yy, zz)), scale.r[0]),
+				DirectX::XMVectorMultiply(DirectX::XMVectorAdd(xy, wz), scale.r[0]),
+				DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(xz, wy), scale.r[0]), zero);
+			DirectX::XMMATRIX row1(DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(xy, wz), scale.r[1]),
+				DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(one, DirectX::XMVectorAdd(xx, zz)), scale.r[1]),
+				DirectX::XMVectorMultiply(DirectX::XMVectorAdd(yz, wx), scale.r[1]), zero);
+			DirectX::XMMATRIX row2(DirectX::XMVectorMultiply(DirectX::XMVectorAdd(xz, wy), scale.r[2]),
+				DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(yz, wx), scale.r[2]),
+				DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(one, DirectX::XMVectorAdd(xx, yy)), scale.r[2]), zero);
+			// Back to rows of single object
+			row0 = DirectX::XMMatrixTranspose(row0);
+			row1 = DirectX::XMMatrixTranspose(row1);
+			row2 = DirectX::XMMatrixTranspose(row2);
+
+			for (size_t lane = 0; lane < count; ++lane)
+				DirectX::XMStoreFloat4x4(entries[i + lane].world, DirectX::XMMATRIX(row0.r[lane], row1.r[lane], row2.r[lane], position[lane]));
+		}
+		entries.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include <DirectXMath.h>
+#include <vector>
+
+namespace GFX
+{
+	// Compact transform of object, orientation is stored as quaternion
+	struct TRS
+	{
+		DirectX::XMFLOAT4 rotation = { 0.0f, 0.0f, 0.0f, 1.0f };
+		DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+		float scale = 1.0f;
+	};
+
+	// Queue of world matrices computed lazily, 4 objects at once in lanes of SIMD registers.
+	// World matrix is built as scaling(localScale * scale) * rotation * translation
+	class TransformBatch
+	{
+		static constexpr size_t LANES = 4;
+
+		struct Entry
+		{
+			const TRS* transform;
+			const DirectX::XMFLOAT3* localScale;
+			DirectX::XMFLOAT4X4* world;
+		};
+
+		std::vector<Entry> entries;
+		size_t lastFlushed = 0;
+
+	public:
+		TransformBatch() = default;
+		TransformBatch(const TransformBatch&) = delete;
+		TransformBatch& operator=(const TransformBatch&) = delete;
+		~TransformBatch() = default;
+
+		// Single matrix, reference for batched computation
+		static DirectX::XMMATRIX GetMatrix(const TRS& transform, const DirectX::XMFLOAT3& localScale) noexcept;
+		// Pitch, yaw and roll in order used by XMQuaternionRollPitchYawFromVector, only for editing
+		static DirectX::XMFLOAT3 GetEulerAngles(const DirectX::XMFLOAT4& rotation) noexcept;
+
+		constexpr size_t GetQueued() const noexcept { return entries.size(); }
+		constexpr size_t GetLastFlushed() const noexcept { return lastFlushed; }
+
+		// Room for given number of Push() calls that will not allocate
+		inline void Reserve(size_t count) { entries.reserve(entries.size() + count); }
+		// Transform and output have to stay alive until Flush()
+		inline void Push(const TRS& transform, const DirectX::XMFLOAT3& localScale, DirectX::XMFLOAT4X4& world) { entries.push_back({ &transform, &localScale, &world }); }
+		void Flush() noexcept;
+	};
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "Utils.h"
 #include <sstream>
 #include <iomanip>
-#include <boost\algorithm\string.hpp>
+#include <boost/algorithm/string.hpp>
 
 namespace Utils
 {
@@ -1,5 +1,5 @@
 #pragma once
-
+#ifdef _WIN32
 // Define target system to Windows 10 https://docs.microsoft.com/pl-pl/cpp/porting/modifying-winver-and-win32-winnt?view=vs-2019
 #define _WIN32_WINNT 0x0A00
 #include <sdkddkver.h>
@@ -81,4 +81,8 @@
 // Allow cmath defines
 #define _USE_MATH_DEFINES
 
-#include <Windows.h>
\ No newline at end of file
+#include <Windows.h>
+#else
+// Code shared with tools built on other platforms only needs WinAPI types, provided by DirectX-Headers
+#include <wsl/winadapter.h>
+#endif
\ No newline at end of file
@@ -4,6 +4,7 @@ namespace Exception
 {
 	std::string WinApiException::TranslateErrorCode(HRESULT code) noexcept
 	{
+#ifdef _WIN32
 		// Translation of Windows messages to readable format
 		LPTSTR msgBuffer = nullptr;
 		DWORD msgLen = FormatMessage(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_IGNORE_INSERTS,
@@ -13,6 +14,9 @@ namespace Exception
 		std::string error = msgBuffer;
 		LocalFree(msgBuffer);
 		return error;
+#else
+		return "Unknown error code";
+#endif
 	}
 
 	const char* WinApiException::what() const noexcept
@@ -0,0 +1,206 @@
+#include "PixelKernels.h"
+#include <tmmintrin.h>
+
+uint32_t PixelKernels::GetChannelMask(const std::string& channels) noexcept
+{
+	uint32_t mask = 0;
+	for (char c : channels)
+	{
+		switch (c)
+		{
+		case 'r':
+		{
+			mask |= 0x000000FFU;
+			break;
+		}
+		case 'g':
+		{
+			mask |= 0x0000FF00U;
+			break;
+		}
+		case 'b':
+		{
+			mask |= 0x00FF0000U;
+			break;
+		}
+		case 'a':
+		{
+			mask |= 0xFF000000U;
+			break;
+		}
+		default:
+			return 0;
+		}
+	}
+	return mask;
+}
+
+bool PixelKernels::ParseSwizzle(const std::string& pattern, uint8_t order[4]) noexcept
+{
+	if (pattern.size() != 4)
+		return false;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		switch (pattern.at(i))
+		{
+		case 'r':
+		{
+			order[i] = 0;
+			break;
+		}
+		case 'g':
+		{
+			order[i] = 1;
+			break;
+		}
+		case 'b':
+		{
+			order[i] = 2;
+			break;
+		}
+		case 'a':
+		{
+			order[i] = 3;
+			break;
+		}
+		case '0':
+		{
+			order[i] = SWIZZLE_ZERO;
+			break;
+		}
+		case '1':
+		{
+			order[i] = SWIZZLE_ONE;
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+void PixelKernels::Fill(uint32_t* pixels, size_t count, uint32_t mask, uint32_t value) noexcept
+{
+	value &= mask;
+	const __m128i maskVec = _mm_set1_epi32(mask);
+	const __m128i valueVec = _mm_set1_epi32(value);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i* block = reinterpret_cast<__m128i*>(pixels + i);
+		_mm_storeu_si128(block, _mm_or_si128(_mm_andnot_si128(maskVec, _mm_loadu_si128(block)), valueVec));
+	}
+	for (; i < count; ++i)
+		pixels[i] = (pixels[i] & ~mask) | value;
+}
+
+void PixelKernels::Invert(uint32_t* pixels, size_t count, uint32_t mask) noexcept
+{
+	const __m128i maskVec = _mm_set1_epi32(mask);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i* block = reinterpret_cast<__m128i*>(pixels + i);
+		_mm_storeu_si128(block, _mm_xor_si128(_mm_loadu_si128(block), maskVec));
+	}
+	for (; i < count; ++i)
+		pixels[i] ^= mask;
+}
+
+void PixelKernels::Swizzle(uint32_t* pixels, size_t count, const uint8_t order[4]) noexcept
+{
+	// Shuffle control with high bit set writes zero, constant ones are or-ed afterwards
+	alignas(16) uint8_t control[16];
+	uint32_t ones = 0;
+	for (uint8_t c = 0; c < 4; ++c)
+	{
+		if (order[c] == SWIZZLE_ONE)
+			ones |= 0xFFU << (c * 8);
+		for (uint8_t p = 0; p < 4; ++p)
+			control[p * 4 + c] = order[c] < 4 ? p * 4 + order[c] : 0x80;
+	}
+	const __m128i controlVec = _mm_load_si128(reinterpret_cast<const __m128i*>(control));
+	const __m128i onesVec = _mm_set1_epi32(ones);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i* block = reinterpret_cast<__m128i*>(pixels + i);
+		_mm_storeu_si128(block, _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128(block), controlVec), onesVec));
+	}
+	for (; i < count; ++i)
+	{
+		const uint32_t source = pixels[i];
+		uint32_t result = ones;
+		for (uint8_t c = 0; c < 4; ++c)
+			if (order[c] < 4)
+				result |= ((source >> (order[c] * 8)) & 0xFFU) << (c * 8);
+		pixels[i] = result;
+	}
+}
+
+void PixelKernels::Premultiply(uint32_t* pixels, size_t count) noexcept
+{
+	const __m128i zero = _mm_setzero_si128();
+	// Alpha lanes are multiplied by 255 to keep them after division
+	const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+	const __m128i alphaScale = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+	const __m128i half = _mm_set1_epi16(128);
+	auto multiply = [&](__m128i color)
+	{
+		__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		alpha = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), alphaScale);
+		// x / 255 rounded as (t + (t >> 8)) >> 8 where t = x + 128
+		const __m128i t = _mm_add_epi16(_mm_mullo_epi16(color, alpha), half);
+		return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+	};
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i* block = reinterpret_cast<__m128i*>(pixels + i);
+		const __m128i color = _mm_loadu_si128(block);
+		_mm_storeu_si128(block, _mm_packus_epi16(multiply(_mm_unpacklo_epi8(color, zero)), multiply(_mm_unpackhi_epi8(color, zero))));
+	}
+	for (; i < count; ++i)
+	{
+		const uint32_t alpha = pixels[i] >> 24;
+		uint32_t result = alpha << 24;
+		for (uint8_t c = 0; c < 3; ++c)
+		{
+			const uint32_t t = ((pixels[i] >> (c * 8)) & 0xFFU) * alpha + 128;
+			result |= ((t + (t >> 8)) >> 8) << (c * 8);
+		}
+		pixels[i] = result;
+	}
+}
+
+void PixelKernels::PackORM(uint32_t* destination, const uint32_t* occlusion, const uint32_t* roughness, const uint32_t* metallic, size_t count) noexcept
+{
+	// Defaults: no occlusion, fully rough, dielectric
+	const __m128i red = _mm_set1_epi32(0xFF);
+	const __m128i defaults = _mm_set1_epi32(0xFF000000U | (occlusion ? 0 : 0xFFU) | (roughness ? 0 : 0xFF00U));
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i result = defaults;
+		if (occlusion)
+			result = _mm_or_si128(result, _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(occlusion + i)), red));
+		if (roughness)
+			result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(roughness + i)), red), 8));
+		if (metallic)
+			result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(metallic + i)), red), 16));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), result);
+	}
+	const uint32_t defaultsScalar = 0xFF000000U | (occlusion ? 0 : 0xFFU) | (roughness ? 0 : 0xFF00U);
+	for (; i < count; ++i)
+	{
+		uint32_t result = defaultsScalar;
+		if (occlusion)
+			result |= occlusion[i] & 0xFFU;
+		if (roughness)
+			result |= (roughness[i] & 0xFFU) << 8;
+		if (metallic)
+			result |= (metallic[i] & 0xFFU) << 16;
+		destination[i] = result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Channel operations over RGBA8 pixels processing 4 pixels per SSE register
+class PixelKernels
+{
+public:
+	// Swizzle sources besides channel indices
+	static constexpr uint8_t SWIZZLE_ZERO = 4;
+	static constexpr uint8_t SWIZZLE_ONE = 5;
+
+	PixelKernels() = delete;
+
+	static uint32_t GetChannelMask(const std::string& channels) noexcept;
+	// Returns false on invalid pattern, pattern consists of 4 characters from "rgba01"
+	static bool ParseSwizzle(const std::string& pattern, uint8_t order[4]) noexcept;
+
+	static void Fill(uint32_t* pixels, size_t count, uint32_t mask, uint32_t value) noexcept;
+	static void Invert(uint32_t* pixels, size_t count, uint32_t mask) noexcept;
+	static void Swizzle(uint32_t* pixels, size_t count, const uint8_t order[4]) noexcept;
+	static void Premultiply(uint32_t* pixels, size_t count) noexcept;
+	// Packs red channels of sources into R (occlusion), G (roughness), B (metallic), null source uses default value
+	static void PackORM(uint32_t* destination, const uint32_t* occlusion, const uint32_t* roughness, const uint32_t* metallic, size_t count) noexcept;
+};
\ No newline at end of file
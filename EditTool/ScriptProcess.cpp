@@ -1,14 +1,23 @@
 #include "ScriptProcess.h"
 #include "TextureEdit.h"
 #include "Logger.h"
+#include "ThreadPool.h"
+#include "SceneFile.h"
+#include <unordered_map>
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
 #include <fstream>
+#include <chrono>
+
+size_t ScriptProcess::jobs = 0;
 
 ScriptProcess::OutCode ScriptProcess::GetSrcDest(std::string& source, std::string& destination, std::deque<std::string>& params) noexcept
 {
 	params.pop_front();
 	if (params.size() == 0 || params.front().at(0) == '-')
 	{
-		Logger::Error("No files in input!");
+		Utils::Logger::Error("No files in input!");
 		return OutCode::NotEnoughParams;
 	}
 	source = params.front();
@@ -23,55 +32,341 @@ ScriptProcess::OutCode ScriptProcess::GetSrcDest(std::string& source, std::strin
 	return OutCode::Good;
 }
 
-ScriptProcess::OutCode ScriptProcess::ProcessJsonCommand(const json::json& command)
+ScriptProcess::OutCode ScriptProcess::GetCookOptions(std::optional<TextureCook::Usage>& usage, TextureCook::Filter& filter, std::deque<std::string>& params) noexcept
+{
+	while (params.size() && (params.front() == "--usage" || params.front() == "--filter"))
+	{
+		const std::string option = params.front();
+		params.pop_front();
+		if (params.size() == 0)
+		{
+			Utils::Logger::Error("No value for option " + option + "!");
+			return OutCode::NotEnoughParams;
+		}
+		if (option == "--usage")
+		{
+			TextureCook::Usage value;
+			if (!TextureCook::ParseUsage(params.front(), value))
+			{
+				Utils::Logger::Error("Unknown texture usage: " + params.front());
+				return OutCode::WrongOption;
+			}
+			usage = value;
+		}
+		else if (!TextureCook::ParseFilter(params.front(), filter))
+		{
+			Utils::Logger::Error("Unknown mip filter: " + params.front());
+			return OutCode::WrongOption;
+		}
+		params.pop_front();
+	}
+	return OutCode::Good;
+}
+
+ScriptProcess::OutCode ScriptProcess::Cook(const std::string& source, const std::string& destination, std::optional<TextureCook::Usage> usage, TextureCook::Filter filter)
+{
+	size_t failed = 0;
+	if (std::filesystem::is_directory(source))
+		failed = TextureCook::CookDirectory(source, filter);
+	else
+		failed = TextureCook::Cook({ { source, destination, usage.value_or(TextureCook::GuessUsage(source)) } }, filter);
+	if (failed)
+	{
+		Utils::Logger::Error("Failed to cook " + std::to_string(failed) + " textures!");
+		return OutCode::UnknownError;
+	}
+	return OutCode::Good;
+}
+
+ScriptProcess::OutCode ScriptProcess::CompileScene(const std::string& source, const std::string& destination)
+{
+	try
+	{
+		GFX::SceneFile::ParseJson(source).WriteBinary(destination);
+	}
+	catch (const GFX::SceneFile::SceneException& e)
+	{
+		Utils::Logger::Error(e.GetSceneInfo());
+		return OutCode::UnknownError;
+	}
+	return OutCode::Good;
+}
+
+ScriptProcess::OutCode ScriptProcess::GetOptionParam(std::string& param, std::deque<std::string>& params) noexcept
+{
+	// Parameter stays at front so following GetSrcDest() skips it in place of option
+	params.pop_front();
+	if (params.size() == 0 || params.front().at(0) == '-')
+	{
+		Utils::Logger::Error("No parameter for option!");
+		return OutCode::NotEnoughParams;
+	}
+	param = params.front();
+	return OutCode::Good;
+}
+
+std::string ScriptProcess::GetDestination(const json::json& params, const std::string& source)
+{
+	const auto it = params.find("destination");
+	return it != params.end() ? it->get<std::string>() : source;
+}
+
+std::string ScriptProcess::GetFileKey(const std::string& file)
+{
+	std::string key = std::filesystem::absolute(file).lexically_normal().string();
+	std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return key;
+}
+
+std::string ScriptProcess::GetDirectoryKey(const std::string& directory)
+{
+	std::string key = GetFileKey(directory);
+	if (key.size() && key.back() != std::filesystem::path::preferred_separator)
+		key.push_back(static_cast<char>(std::filesystem::path::preferred_separator));
+	return key;
+}
+
+bool ScriptProcess::IsDirectoryKey(const std::string& key) noexcept
+{
+	return key.size() && key.back() == std::filesystem::path::preferred_separator;
+}
+
+void ScriptProcess::GetCommandFiles(const json::json& command, std::vector<std::string>& reads, std::vector<std::string>& writes)
+{
+	const auto params = command["params"];
+	if (command["command"].get<std::string>() == "cook" && params.contains("source"))
+	{
+		// Cooking directory reads every image inside it and writes DDS file next to each of them,
+		// directory key itself makes command wait for earlier ones writing anything into directory
+		const std::string source = params["source"].get<std::string>();
+		if (std::filesystem::is_directory(source))
+		{
+			reads.emplace_back(GetDirectoryKey(source));
+			for (const auto& task : TextureCook::GetDirectoryTasks(source))
+			{
+				reads.emplace_back(GetFileKey(task.source));
+				writes.emplace_back(GetFileKey(task.destination));
+			}
+			return;
+		}
+	}
+	for (const char* input : { "source", "occlusion", "roughness", "metallic" })
+	{
+		const auto it = params.find(input);
+		if (it != params.end())
+			reads.emplace_back(GetFileKey(it->get<std::string>()));
+	}
+	const auto it = params.find("destination");
+	if (it != params.end())
+		writes.emplace_back(GetFileKey(it->get<std::string>()));
+	else if (params.contains("source"))
+	{
+		const std::string source = params["source"].get<std::string>();
+		const std::string commandName = command["command"].get<std::string>();
+		if (commandName == "cook")
+			writes.emplace_back(GetFileKey(TextureCook::GetCookedName(source)));
+		else if (commandName == "compile-scene")
+			writes.emplace_back(GetFileKey(GFX::SceneFile::GetCompiledPath(source)));
+		else
+			writes.emplace_back(GetFileKey(source));
+	}
+}
+
+ScriptProcess::OutCode ScriptProcess::CheckProcessed(size_t bytes) noexcept
+{
+	// Operations log their own errors and report nothing processed
+	return bytes ? OutCode::Good : OutCode::UnknownError;
+}
+
+ScriptProcess::OutCode ScriptProcess::ProcessJsonCommand(const json::json& command, size_t& bytes)
 {
 	const std::string commandName = command["command"].get<std::string>();
 	const auto params = command["params"];
 	if (commandName == "no-alpha")
 	{
-		const auto it = params.find("destination");
 		const std::string source = params["source"].get<std::string>();
-		const std::string destination = it != params.end() ? it->get<std::string>() : source;
-		TextureEdit::NoAlpha(source, destination);
+		bytes = TextureEdit::NoAlpha(source, GetDestination(params, source));
 	}
 	else if (commandName == "flip-y")
 	{
-		const auto it = params.find("destination");
 		const std::string source = params["source"].get<std::string>();
-		const std::string destination = it != params.end() ? it->get<std::string>() : source;
-		TextureEdit::FlipY(source, destination);
+		bytes = TextureEdit::FlipY(source, GetDestination(params, source));
+	}
+	else if (commandName == "invert")
+	{
+		const std::string source = params["source"].get<std::string>();
+		return CheckProcessed(bytes = TextureEdit::Invert(source, GetDestination(params, source), params["channels"].get<std::string>()));
+	}
+	else if (commandName == "swizzle")
+	{
+		const std::string source = params["source"].get<std::string>();
+		return CheckProcessed(bytes = TextureEdit::Swizzle(source, GetDestination(params, source), params["pattern"].get<std::string>()));
+	}
+	else if (commandName == "premultiply")
+	{
+		const std::string source = params["source"].get<std::string>();
+		bytes = TextureEdit::Premultiply(source, GetDestination(params, source));
+	}
+	else if (commandName == "pack-orm")
+	{
+		auto getSource = [&params](const char* name) { return params.contains(name) ? params[name].get<std::string>() : ""; };
+		return CheckProcessed(bytes = TextureEdit::PackORM(getSource("occlusion"), getSource("roughness"),
+			getSource("metallic"), params["destination"].get<std::string>()));
+	}
+	else if (commandName == "cook")
+	{
+		const std::string source = params["source"].get<std::string>();
+		const std::string destination = GetDestination(params, TextureCook::GetCookedName(source));
+		std::optional<TextureCook::Usage> usage;
+		TextureCook::Filter filter = TextureCook::Filter::Kaiser;
+		const auto usageIt = params.find("usage");
+		if (usageIt != params.end())
+		{
+			TextureCook::Usage value;
+			if (!TextureCook::ParseUsage(usageIt->get<std::string>(), value))
+			{
+				Utils::Logger::Error("Unknown texture usage: " + usageIt->get<std::string>());
+				return OutCode::InvalidJsonCommand;
+			}
+			usage = value;
+		}
+		const auto filterIt = params.find("filter");
+		if (filterIt != params.end() && !TextureCook::ParseFilter(filterIt->get<std::string>(), filter))
+		{
+			Utils::Logger::Error("Unknown mip filter: " + filterIt->get<std::string>());
+			return OutCode::InvalidJsonCommand;
+		}
+		return Cook(source, destination, usage, filter);
+	}
+	else if (commandName == "compile-scene")
+	{
+		const std::string source = params["source"].get<std::string>();
+		return CompileScene(source, GetDestination(params, GFX::SceneFile::GetCompiledPath(source)));
 	}
 	else
 	{
-		Logger::Error("Unknown JSON command! Command: " + commandName);
+		Utils::Logger::Error("Unknown JSON command! Command: " + commandName);
 		return OutCode::InvalidJsonCommand;
 	}
 	return OutCode::Good;
 }
 
+ScriptProcess::OutCode ScriptProcess::ProcessJsonBatch(const json::json& commands)
+{
+	// Command has to wait for earlier ones writing its files or reading its outputs,
+	// every such dependency moves it to later wave while commands in single wave run concurrently
+	const size_t count = commands.size();
+	std::vector<size_t> waves(count, 0);
+	size_t waveCount = 0;
+	{
+		std::unordered_map<std::string, size_t> lastWrite, lastRead;
+		for (size_t i = 0; i < count; ++i)
+		{
+			std::vector<std::string> reads, writes;
+			GetCommandFiles(commands.at(i), reads, writes);
+			size_t& wave = waves.at(i);
+			for (const auto& file : reads)
+			{
+				if (IsDirectoryKey(file))
+				{
+					for (const auto& [written, writeWave] : lastWrite)
+						if (written.compare(0, file.size(), file) == 0)
+							wave = std::max(wave, writeWave + 1);
+				}
+				else if (const auto it = lastWrite.find(file); it != lastWrite.end())
+					wave = std::max(wave, it->second + 1);
+			}
+			for (const auto& file : writes)
+			{
+				if (const auto it = lastWrite.find(file); it != lastWrite.end())
+					wave = std::max(wave, it->second + 1);
+				if (const auto it = lastRead.find(file); it != lastRead.end())
+					wave = std::max(wave, it->second + 1);
+			}
+			for (const auto& file : reads)
+				lastRead[file] = std::max(lastRead[file], wave);
+			for (const auto& file : writes)
+				lastWrite[file] = wave;
+			waveCount = std::max(waveCount, wave + 1);
+		}
+	}
+
+	Utils::ThreadPool pool(jobs);
+	std::vector<Utils::Logger::Buffer> logs(count);
+	std::vector<size_t> bytes(count, 0);
+	std::vector<OutCode> codes(count, OutCode::Good);
+	std::vector<bool> done(count, false);
+	size_t nextLog = 0;
+	// Logs are flushed in order of commands regardless of order of completion
+	auto flushLogs = [&]()
+	{
+		for (; nextLog < count && done.at(nextLog); ++nextLog)
+			Utils::Logger::Flush(logs.at(nextLog));
+	};
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	OutCode result = OutCode::Good;
+	for (size_t wave = 0; wave < waveCount && result == OutCode::Good; ++wave)
+	{
+		std::vector<std::pair<size_t, std::future<void>>> results;
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (waves.at(i) != wave)
+				continue;
+			results.emplace_back(i, pool.Schedule([&, i]()
+				{
+					Utils::Logger::BeginCapture(logs.at(i));
+					try
+					{
+						codes.at(i) = ProcessJsonCommand(commands.at(i), bytes.at(i));
+					}
+					catch (const std::exception& e)
+					{
+						Utils::Logger::Error(e.what(), { .command = commands.at(i).value("command", std::string()) });
+						codes.at(i) = OutCode::UnknownError;
+					}
+					Utils::Logger::EndCapture();
+				}));
+		}
+		for (auto& [i, task] : results)
+		{
+			task.get();
+			done.at(i) = true;
+			flushLogs();
+			if (result == OutCode::Good)
+				result = codes.at(i);
+		}
+	}
+	// Flush rest of finished commands in case of stopping after error
+	for (size_t i = nextLog; i < count; ++i)
+		if (done.at(i))
+			Utils::Logger::Flush(logs.at(i));
+
+	const float time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	size_t totalBytes = 0;
+	for (size_t processed : bytes)
+		totalBytes += processed;
+	Utils::Logger::Info("Processed " + std::to_string(count) + " commands in " + std::to_string(waveCount) + " waves on " +
+		std::to_string(pool.GetWorkersCount()) + " threads: " + std::to_string(totalBytes / 1000000.0f) + " MB (" +
+		std::to_string(time > 0.0f ? totalBytes / (time * 1000.0f) : 0.0f) + " MB/s).", { .command = "batch", .duration = time });
+	return result;
+}
+
 ScriptProcess::OutCode ScriptProcess::ProcessJson(const std::string& jsonFile)
 {
 	std::ifstream fin(jsonFile);
 	if (!fin.good())
 	{
 		fin.close();
-		Logger::Error("Cannot open file: " + jsonFile);
+		Utils::Logger::Error("Cannot open file: " + jsonFile);
 		return OutCode::CannotOpenFile;
 	}
 	json::json jsonArray;
 	fin >> jsonArray;
 	if (jsonArray.is_array())
-	{
-		for (const auto& json : jsonArray)
-		{
-			OutCode code = ProcessJsonCommand(json);
-			if (code != OutCode::Good)
-				return code;
-		}
-		return OutCode::Good;
-	}
-	else
-		return ProcessJsonCommand(jsonArray);
+		return ProcessJsonBatch(jsonArray);
+	size_t bytes = 0;
+	return ProcessJsonCommand(jsonArray, bytes);
 }
 
 int ScriptProcess::Run(std::deque<std::string>& params)
@@ -85,7 +380,7 @@ int ScriptProcess::Run(std::deque<std::string>& params)
 			params.pop_front();
 			if (params.size() == 0)
 			{
-				Logger::Error("No JSON files in input!");
+				Utils::Logger::Error("No JSON files in input!");
 				return OutCode::NotEnoughParams;
 			}
 			size_t i = 0;
@@ -96,7 +391,7 @@ int ScriptProcess::Run(std::deque<std::string>& params)
 				OutCode code = ProcessJson(params.at(i));
 				if (code != OutCode::Good)
 				{
-					Logger::Error("Error processing JSON!");
+					Utils::Logger::Error("Error processing JSON!");
 					return code;
 				}
 			}
@@ -118,9 +413,99 @@ int ScriptProcess::Run(std::deque<std::string>& params)
 				return code;
 			TextureEdit::FlipY(source, destination);
 		}
+		else if (params.front() == "--invert" || params.front() == "--swizzle")
+		{
+			const bool invert = params.front() == "--invert";
+			std::string param, source, destination;
+			OutCode code = GetOptionParam(param, params);
+			if (code != OutCode::Good)
+				return code;
+			if ((code = GetSrcDest(source, destination, params)) != OutCode::Good)
+				return code;
+			if ((code = CheckProcessed(invert ? TextureEdit::Invert(source, destination, param) : TextureEdit::Swizzle(source, destination, param))) != OutCode::Good)
+				return code;
+		}
+		else if (params.front() == "--premultiply")
+		{
+			std::string source, destination;
+			OutCode code = GetSrcDest(source, destination, params);
+			if (code != OutCode::Good)
+				return code;
+			TextureEdit::Premultiply(source, destination);
+		}
+		else if (params.front() == "--pack-orm")
+		{
+			params.pop_front();
+			if (params.size() < 4)
+			{
+				Utils::Logger::Error("Packing ORM requires occlusion, roughness, metallic and destination files!");
+				return OutCode::NotEnoughParams;
+			}
+			// "none" skips given channel
+			std::string sources[3];
+			for (auto& source : sources)
+			{
+				source = params.front() == "none" ? "" : params.front();
+				params.pop_front();
+			}
+			const std::string destination = params.front();
+			params.pop_front();
+			OutCode code = CheckProcessed(TextureEdit::PackORM(sources[0], sources[1], sources[2], destination));
+			if (code != OutCode::Good)
+				return code;
+		}
+		else if (params.front() == "--log-level")
+		{
+			params.pop_front();
+			Utils::Logger::Level level;
+			if (params.size() == 0 || !Utils::Logger::ParseLevel(params.front(), level))
+			{
+				Utils::Logger::Error("No valid log level in input! Use debug, info, warning or error.");
+				return OutCode::WrongOption;
+			}
+			Utils::Logger::SetLevel(level);
+			params.pop_front();
+		}
+		else if (params.front() == "--jobs" || params.front() == "-t")
+		{
+			params.pop_front();
+			if (params.size() == 0 || !std::isdigit(static_cast<unsigned char>(params.front().at(0))))
+			{
+				Utils::Logger::Error("No number of jobs in input!");
+				return OutCode::NotEnoughParams;
+			}
+			jobs = std::stoull(params.front());
+			params.pop_front();
+		}
+		else if (params.front() == "--cook")
+		{
+			std::string source, destination;
+			OutCode code = GetSrcDest(source, destination, params);
+			if (code != OutCode::Good)
+				return code;
+			if (source == destination)
+				destination = TextureCook::GetCookedName(source);
+			std::optional<TextureCook::Usage> usage;
+			TextureCook::Filter filter = TextureCook::Filter::Kaiser;
+			if ((code = GetCookOptions(usage, filter, params)) != OutCode::Good)
+				return code;
+			if ((code = Cook(source, destination, usage, filter)) != OutCode::Good)
+				return code;
+		}
+		else if (params.front() == "--scene")
+		{
+			std::string source, destination;
+			OutCode code = GetSrcDest(source, destination, params);
+			if (code != OutCode::Good)
+				return code;
+			if (source == destination)
+				destination = GFX::SceneFile::GetCompiledPath(source);
+			if ((code = CompileScene(source, destination)) != OutCode::Good)
+				return code;
+		}
 		else
 		{
-			Logger::Error("Invalid option!");
+			Utils::Logger::Error("Invalid option!");
 			return OutCode::WrongOption;
 		}
 	}
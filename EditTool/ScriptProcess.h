@@ -1,7 +1,10 @@
 #pragma once
+#include "TextureCook.h"
 #include "json.hpp"
 #include <string>
 #include <deque>
+#include <optional>
+#include <vector>
 
 namespace json = nlohmann;
 
@@ -19,8 +22,23 @@ class ScriptProcess
 		InvalidJsonCommand = -6
 	};
 
+	// Number of workers used for JSON batches, 0 means hardware threads
+	static size_t jobs;
+
 	static OutCode GetSrcDest(std::string& source, std::string& destination, std::deque<std::string>& params) noexcept;
-	static OutCode ProcessJsonCommand(const json::json& command);
+	static OutCode GetCookOptions(std::optional<TextureCook::Usage>& usage, TextureCook::Filter& filter, std::deque<std::string>& params) noexcept;
+	static OutCode Cook(const std::string& source, const std::string& destination, std::optional<TextureCook::Usage> usage, TextureCook::Filter filter);
+	static OutCode CompileScene(const std::string& source, const std::string& destination);
+	static OutCode GetOptionParam(std::string& param, std::deque<std::string>& params) noexcept;
+	static std::string GetDestination(const json::json& params, const std::string& source);
+	static std::string GetFileKey(const std::string& file);
+	// Key of directory ends with separator, so it is prefix of keys of all files inside
+	static std::string GetDirectoryKey(const std::string& directory);
+	static bool IsDirectoryKey(const std::string& key) noexcept;
+	static void GetCommandFiles(const json::json& command, std::vector<std::string>& reads, std::vector<std::string>& writes);
+	static OutCode CheckProcessed(size_t bytes) noexcept;
+	static OutCode ProcessJsonCommand(const json::json& command, size_t& bytes);
+	static OutCode ProcessJsonBatch(const json::json& commands);
 	static OutCode ProcessJson(const std::string& jsonFile);
 
 public:
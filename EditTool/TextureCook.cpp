@@ -0,0 +1,386 @@
+#include "TextureCook.h"
+#include "Surface.h"
+#include "ThreadPool.h"
+#include "Utils.h"
+#include "Logger.h"
+#include <DirectXPackedVector.h>
+#include <filesystem>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+const float* TextureCook::GetKaiserWeights() noexcept
+{
+	static const auto weights = []()
+	{
+		// Modified Bessel function of first kind, order 0
+		auto bessel = [](float x)
+		{
+			float sum = 1.0f, term = 1.0f;
+			for (int k = 1; k < 16; ++k)
+			{
+				term *= (x * 0.5f / k) * (x * 0.5f / k);
+				sum += term;
+			}
+			return sum;
+		};
+		std::array<float, KAISER_TAPS> w;
+		float total = 0.0f;
+		for (size_t i = 0; i < KAISER_TAPS; ++i)
+		{
+			// Distance from destination texel center in destination texel units
+			const float t = (static_cast<float>(i) - KAISER_TAPS / 2.0f + 0.5f) * 0.5f;
+			const float sinc = t == 0.0f ? 1.0f : std::sin(DirectX::XM_PI * t) / (DirectX::XM_PI * t);
+			const float x = t / KAISER_WIDTH;
+			w.at(i) = sinc * bessel(KAISER_ALPHA * std::sqrt(std::max(0.0f, 1.0f - x * x))) / bessel(KAISER_ALPHA);
+			total += w.at(i);
+		}
+		for (auto& x : w)
+			x /= total;
+		return w;
+	}();
+	return weights.data();
+}
+
+void TextureCook::Decode(const DirectX::Image& image, Usage usage, Level& level) noexcept
+{
+	level.width = image.width;
+	level.height = image.height;
+	level.texels.resize(level.width * level.height);
+	const DirectX::XMVECTOR normalScale = DirectX::XMVectorSet(2.0f, 2.0f, 2.0f, 1.0f);
+	const DirectX::XMVECTOR normalBias = DirectX::XMVectorSet(-1.0f, -1.0f, -1.0f, 0.0f);
+	for (size_t y = 0; y < level.height; ++y)
+	{
+		const DirectX::PackedVector::XMUBYTEN4* row = reinterpret_cast<const DirectX::PackedVector::XMUBYTEN4*>(image.pixels + y * image.rowPitch);
+		DirectX::XMVECTOR* dest = level.texels.data() + y * level.width;
+		for (size_t x = 0; x < level.width; ++x)
+		{
+			DirectX::XMVECTOR texel = DirectX::PackedVector::XMLoadUByteN4(row + x);
+			switch (usage)
+			{
+			case Usage::Diffuse:
+			case Usage::Specular:
+			{
+				texel = DirectX::XMColorSRGBToRGB(texel);
+				break;
+			}
+			case Usage::Normal:
+			{
+				texel = DirectX::XMVectorMultiplyAdd(texel, normalScale, normalBias);
+				break;
+			}
+			}
+			dest[x] = texel;
+		}
+	}
+}
+
+void TextureCook::Encode(const Level& level, Usage usage, const DirectX::Image& image) noexcept
+{
+	const DirectX::XMVECTOR half = DirectX::XMVectorSet(0.5f, 0.5f, 0.5f, 1.0f);
+	const DirectX::XMVECTOR bias = DirectX::XMVectorSet(0.5f, 0.5f, 0.5f, 0.0f);
+	for (size_t y = 0; y < level.height; ++y)
+	{
+		DirectX::PackedVector::XMUBYTEN4* row = reinterpret_cast<DirectX::PackedVector::XMUBYTEN4*>(image.pixels + y * image.rowPitch);
+		const DirectX::XMVECTOR* source = level.texels.data() + y * level.width;
+		for (size_t x = 0; x < level.width; ++x)
+		{
+			DirectX::XMVECTOR texel = source[x];
+			switch (usage)
+			{
+			case Usage::Diffuse:
+			case Usage::Specular:
+			{
+				texel = DirectX::XMColorRGBToSRGB(DirectX::XMVectorSaturate(texel));
+				break;
+			}
+			case Usage::Normal:
+			{
+				texel = DirectX::XMVectorMultiplyAdd(texel, half, bias);
+				break;
+			}
+			}
+			DirectX::PackedVector::XMStoreUByteN4(row + x, DirectX::XMVectorSaturate(texel));
+		}
+	}
+}
+
+void TextureCook::DownsampleBox(const Level& source, Level& destination) noexcept
+{
+	const DirectX::XMVECTOR quarter = DirectX::XMVectorReplicate(0.25f);
+	for (size_t y = 0; y < destination.height; ++y)
+	{
+		// Odd sizes are clamped to last row or column
+		const DirectX::XMVECTOR* row0 = source.texels.data() + std::min(y * 2, source.height - 1) * source.width;
+		const DirectX::XMVECTOR* row1 = source.texels.data() + std::min(y * 2 + 1, source.height - 1) * source.width;
+		DirectX::XMVECTOR* dest = destination.texels.data() + y * destination.width;
+		for (size_t x = 0; x < destination.width; ++x)
+		{
+			const size_t x0 = std::min(x * 2, source.width - 1);
+			const size_t x1 = std::min(x * 2 + 1, source.width - 1);
+			dest[x] = DirectX::XMVectorMultiply(DirectX::XMVectorAdd(DirectX::XMVectorAdd(row0[x0], row0[x1]),
+				DirectX::XMVectorAdd(row1[x0], row1[x1])), quarter);
+		}
+	}
+}
+
+void TextureCook::DownsampleKaiser(const Level& source, Level& destination) noexcept
+{
+	const float* weights = GetKaiserWeights();
+	auto clamp = [](ptrdiff_t i, size_t size) { return static_cast<size_t>(std::clamp(i, ptrdiff_t(0), static_cast<ptrdiff_t>(size) - 1)); };
+
+	// Horizontal pass: source height x destination width
+	std::vector<DirectX::XMVECTOR> temp(destination.width * source.height);
+	for (size_t y = 0; y < source.height; ++y)
+	{
+		const DirectX::XMVECTOR* row = source.texels.data() + y * source.width;
+		DirectX::XMVECTOR* dest = temp.data() + y * destination.width;
+		for (size_t x = 0; x < destination.width; ++x)
+		{
+			if (source.width == 1)
+			{
+				dest[x] = row[0];
+				continue;
+			}
+			DirectX::XMVECTOR sum = DirectX::XMVectorZero();
+			const ptrdiff_t start = static_cast<ptrdiff_t>(x * 2) - KAISER_TAPS / 2 + 1;
+			for (size_t i = 0; i < KAISER_TAPS; ++i)
+				sum = DirectX::XMVectorMultiplyAdd(row[clamp(start + i, source.width)], DirectX::XMVectorReplicate(weights[i]), sum);
+			dest[x] = sum;
+		}
+	}
+	// Vertical pass
+	for (size_t y = 0; y < destination.height; ++y)
+	{
+		DirectX::XMVECTOR* dest = destination.texels.data() + y * destination.width;
+		if (source.height == 1)
+		{
+			std::copy(temp.begin(), temp.begin() + destination.width, dest);
+			continue;
+		}
+		const ptrdiff_t start = static_cast<ptrdiff_t>(y * 2) - KAISER_TAPS / 2 + 1;
+		for (size_t x = 0; x < destination.width; ++x)
+			dest[x] = DirectX::XMVectorZero();
+		for (size_t i = 0; i < KAISER_TAPS; ++i)
+		{
+			const DirectX::XMVECTOR weight = DirectX::XMVectorReplicate(weights[i]);
+			const DirectX::XMVECTOR* row = temp.data() + clamp(start + i, source.height) * destination.width;
+			for (size_t x = 0; x < destination.width; ++x)
+				dest[x] = DirectX::XMVectorMultiplyAdd(row[x], weight, dest[x]);
+		}
+	}
+}
+
+void TextureCook::Normalize(Level& level, Usage usage) noexcept
+{
+	if (usage == Usage::Normal)
+	{
+		const DirectX::XMVECTOR maskW = DirectX::XMVectorSelectControl(0, 0, 0, 1);
+		for (auto& texel : level.texels)
+			texel = DirectX::XMVectorSelect(DirectX::XMVector3Normalize(texel), texel, maskW);
+	}
+	else
+	{
+		// Kaiser lobes can overshoot valid range
+		for (auto& texel : level.texels)
+			texel = DirectX::XMVectorSaturate(texel);
+	}
+}
+
+DXGI_FORMAT TextureCook::GetFormat(Usage usage, bool alpha) noexcept
+{
+	switch (usage)
+	{
+	case Usage::Diffuse:
+		return alpha ? DXGI_FORMAT_BC7_UNORM : DXGI_FORMAT_BC1_UNORM;
+	case Usage::Normal:
+		return DXGI_FORMAT_BC5_UNORM;
+	case Usage::Specular:
+		return alpha ? DXGI_FORMAT_BC3_UNORM : DXGI_FORMAT_BC1_UNORM;
+	default:
+		return DXGI_FORMAT_BC4_UNORM;
+	}
+}
+
+TextureCook::Usage TextureCook::GuessUsage(const std::string& file) noexcept
+{
+	std::string name = std::filesystem::path(file).stem().string();
+	std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	auto contains = [&name](const char* key) { return name.find(key) != std::string::npos; };
+	if (contains("ddn") || contains("normal") || contains("_nrm") || name.ends_with("_n"))
+		return Usage::Normal;
+	if (contains("spec"))
+		return Usage::Specular;
+	if (contains("bump") || contains("height") || contains("disp") || contains("parallax"))
+		return Usage::Height;
+	return Usage::Diffuse;
+}
+
+bool TextureCook::ParseUsage(const std::string& name, Usage& usage) noexcept
+{
+	if (name == "diffuse")
+		usage = Usage::Diffuse;
+	else if (name == "normal")
+		usage = Usage::Normal;
+	else if (name == "specular")
+		usage = Usage::Specular;
+	else if (name == "height")
+		usage = Usage::Height;
+	else
+		return false;
+	return true;
+}
+
+bool TextureCook::ParseFilter(const std::string& name, Filter& filter) noexcept
+{
+	if (name == "box")
+		filter = Filter::Box;
+	else if (name == "kaiser")
+		filter = Filter::Kaiser;
+	else
+		return false;
+	return true;
+}
+
+std::string TextureCook::GetCookedName(const std::string& file) noexcept
+{
+	return std::filesystem::path(file).replace_extension(".dds").string();
+}
+
+void TextureCook::Cook(const std::string& source, const std::string& destination, Usage usage, Filter filter)
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+	GFX::Surface surface(source);
+	const bool alpha = usage != Usage::Normal && usage != Usage::Height && surface.HasAlpha();
+
+	const size_t mipCount = 1 + static_cast<size_t>(std::log2(std::max(surface.GetWidth(), surface.GetHeight())));
+	DirectX::ScratchImage mips;
+	HRESULT hr = mips.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, surface.GetWidth(), surface.GetHeight(), 1, mipCount);
+	if (FAILED(hr))
+		throw GFX::Surface::DirectXTexException(__LINE__, __FILE__, hr, "Creating mip chain for \"" + source + "\": failed.");
+
+	Level current, next;
+	Decode(surface.GetMip(0), usage, current);
+	Encode(current, usage, *mips.GetImage(0, 0, 0));
+	for (size_t mip = 1; mip < mipCount; ++mip)
+	{
+		next.width = std::max(current.width / 2, static_cast<size_t>(1));
+		next.height = std::max(current.height / 2, static_cast<size_t>(1));
+		next.texels.resize(next.width * next.height);
+		if (filter == Filter::Kaiser)
+			DownsampleKaiser(current, next);
+		else
+			DownsampleBox(current, next);
+		Normalize(next, usage);
+		Encode(next, usage, *mips.GetImage(mip, 0, 0));
+		std::swap(current, next);
+	}
+
+	const DXGI_FORMAT format = GetFormat(usage, alpha);
+	DirectX::ScratchImage compressed;
+	hr = DirectX::Compress(mips.GetImages(), mips.GetImageCount(), mips.GetMetadata(), format,
+		DirectX::TEX_COMPRESS_FLAGS::TEX_COMPRESS_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+	if (FAILED(hr))
+		throw GFX::Surface::DirectXTexException(__LINE__, __FILE__, hr, "Compressing \"" + source + "\": failed.");
+	hr = DirectX::SaveToDDSFile(compressed.GetImages(), compressed.GetImageCount(), compressed.GetMetadata(),
+		DirectX::DDS_FLAGS::DDS_FLAGS_NONE, Utils::ToUtf8(destination).c_str());
+	if (FAILED(hr))
+		throw GFX::Surface::DirectXTexException(__LINE__, __FILE__, hr, "Saving \"" + destination + "\": failed.");
+
+	const auto time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	Utils::Logger::Info("Cooked to \"" + destination + "\" (" + std::to_string(surface.GetWidth()) + "x" + std::to_string(surface.GetHeight()) +
+		", " + std::to_string(mipCount) + " mips, format " + std::to_string(format) + ").", { .file = source, .command = "cook", .duration = time });
+}
+
+size_t TextureCook::Cook(const std::vector<Task>& tasks, Filter filter)
+{
+	// Sources with same name and different extensions (a.png, a.tga) would overwrite each other,
+	// none of them is cooked since it is ambiguous which one engine should load
+	std::unordered_map<std::string, std::vector<const Task*>> outputs;
+	for (const auto& task : tasks)
+	{
+		std::string output = std::filesystem::path(task.destination).lexically_normal().string();
+		std::transform(output.begin(), output.end(), output.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		outputs[output].emplace_back(&task);
+	}
+	std::atomic_size_t failed = 0;
+	std::vector<const Task*> accepted;
+	accepted.reserve(tasks.size());
+	for (const auto& output : outputs)
+	{
+		const auto& sources = output.second;
+		if (sources.size() == 1)
+		{
+			accepted.emplace_back(sources.front());
+			continue;
+		}
+		failed += sources.size();
+		std::string names;
+		for (const Task* task : sources)
+			names += " \"" + task->source + "\"";
+		Utils::Logger::Error("Textures" + names + " would be cooked into same file \"" + sources.front()->destination + "\", rename all but one of them!");
+	}
+
+	// Images are independent, one task per image keeps workers balanced for mixed sizes
+	if (Utils::ThreadPool::IsWorker())
+	{
+		for (const Task* task : accepted)
+		{
+			try
+			{
+				Cook(task->source, task->destination, task->usage, filter);
+			}
+			catch (const std::exception& e)
+			{
+				++failed;
+				Utils::Logger::Error(e.what());
+			}
+		}
+		return failed;
+	}
+	std::vector<std::future<void>> results;
+	results.reserve(accepted.size());
+	for (const Task* task : accepted)
+	{
+		results.emplace_back(Utils::ThreadPool::Get().Schedule([task, &failed, filter]()
+			{
+				try
+				{
+					Cook(task->source, task->destination, task->usage, filter);
+				}
+				catch (const std::exception& e)
+				{
+					++failed;
+					Utils::Logger::Error(e.what());
+				}
+			}));
+	}
+	for (auto& result : results)
+		result.get();
+	return failed;
+}
+
+std::vector<TextureCook::Task> TextureCook::GetDirectoryTasks(const std::string& directory)
+{
+	std::vector<Task> tasks;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+	{
+		if (!entry.is_regular_file())
+			continue;
+		std::string ext = entry.path().extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		if (ext == ".dds" || !GFX::Surface::IsImage(ext))
+			continue;
+		const std::string file = entry.path().string();
+		tasks.push_back({ file, GetCookedName(file), GuessUsage(file) });
+	}
+	return tasks;
+}
+
+size_t TextureCook::CookDirectory(const std::string& directory, Filter filter)
+{
+	return Cook(GetDirectoryTasks(directory), filter);
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <DirectXTex.h>
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+
+class TextureCook
+{
+public:
+	enum class Usage : uint8_t { Diffuse, Normal, Specular, Height };
+	enum class Filter : uint8_t { Box, Kaiser };
+
+	struct Task
+	{
+		std::string source;
+		std::string destination;
+		Usage usage;
+	};
+
+private:
+	// Kaiser window over 6 source texels (3 destination texels support)
+	static constexpr size_t KAISER_TAPS = 6;
+	static constexpr float KAISER_ALPHA = 4.0f;
+	static constexpr float KAISER_WIDTH = 1.5f;
+
+	struct Level
+	{
+		size_t width;
+		size_t height;
+		std::vector<DirectX::XMVECTOR> texels;
+	};
+
+	static const float* GetKaiserWeights() noexcept;
+	static void Decode(const DirectX::Image& image, Usage usage, Level& level) noexcept;
+	static void Encode(const Level& level, Usage usage, const DirectX::Image& image) noexcept;
+	static void DownsampleBox(const Level& source, Level& destination) noexcept;
+	static void DownsampleKaiser(const Level& source, Level& destination) noexcept;
+	static void Normalize(Level& level, Usage usage) noexcept;
+	static DXGI_FORMAT GetFormat(Usage usage, bool alpha) noexcept;
+
+public:
+	TextureCook() = delete;
+
+	static Usage GuessUsage(const std::string& file) noexcept;
+	static bool ParseUsage(const std::string& name, Usage& usage) noexcept;
+	static bool ParseFilter(const std::string& name, Filter& filter) noexcept;
+	static std::string GetCookedName(const std::string& file) noexcept;
+
+	// Generates full mip chain in linear space and saves as block compressed DDS
+	static void Cook(const std::string& source, const std::string& destination, Usage usage, Filter filter);
+	// Cooks every task on shared thread pool, returns number of failed textures
+	static size_t Cook(const std::vector<Task>& tasks, Filter filter);
+	// Images found in directory (recursively) cooked next to themselves, usage is guessed from file names
+	static std::vector<Task> GetDirectoryTasks(const std::string& directory);
+	// Cooks all images found in directory (recursively), usage is guessed from file names
+	static size_t CookDirectory(const std::string& directory, Filter filter);
+};
\ No newline at end of file
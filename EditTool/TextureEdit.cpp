@@ -1,29 +1,130 @@
 #include "TextureEdit.h"
+#include "PixelKernels.h"
 #include "Surface.h"
 #include "Logger.h"
+#include <optional>
+#include <chrono>
 
-void TextureEdit::NoAlpha(const std::string& source, const std::string& destination)
+#define KERNEL_TIMER_START() const auto kernelStart = std::chrono::high_resolution_clock::now()
+#define KERNEL_TIMER_END() std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - kernelStart).count()
+
+void TextureEdit::LogResult(const std::string& action, const std::string& source, const std::string& destination, size_t bytes, float time)
 {
-	GFX::Surface surface(source);
-	GFX::Surface::Pixel* buffer = surface.GetBuffer();
-	for (size_t i = 0; i < surface.GetSize(); ++i)
-		buffer[i].SetA(255);
-	surface.Save(destination);
+	const std::string throughput = " (" + std::to_string(time > 0.0f ? bytes / (time * 1000.0f) : 0.0f) + " MB/s).";
 	if (source == destination)
-		Logger::InfoNoFile("Reseted alpha channel of \"" + source + "\" and saved to same file.");
+		Utils::Logger::Info(action + " and saved to same file" + throughput, { .file = source, .duration = time });
 	else
-		Logger::InfoNoFile("Reseted alpha channel of \"" + source + "\" and saved to \"" + destination + "\".");
+		Utils::Logger::Info(action + " and saved to \"" + destination + "\"" + throughput, { .file = source, .duration = time });
 }
 
-void TextureEdit::FlipY(const std::string& source, const std::string& destination)
+size_t TextureEdit::NoAlpha(const std::string& source, const std::string& destination)
 {
 	GFX::Surface surface(source);
-	GFX::Surface::Pixel* buffer = surface.GetBuffer();
-	for (size_t i = 0; i < surface.GetSize(); ++i)
-		buffer[i].SetG(255 - buffer[i].GetG());
+	KERNEL_TIMER_START();
+	PixelKernels::Fill(reinterpret_cast<uint32_t*>(surface.GetBuffer()), surface.GetSize(), PixelKernels::GetChannelMask("a"), 0xFFFFFFFFU);
+	const float time = KERNEL_TIMER_END();
 	surface.Save(destination);
-	if (source == destination)
-		Logger::InfoNoFile("Fliped Y (G channel) of \"" + source + "\" and saved to same file.");
-	else
-		Logger::InfoNoFile("Fliped Y (G channel) of \"" + source + "\" and saved to \"" + destination + "\".");
+	const size_t bytes = surface.GetSize() * sizeof(GFX::Surface::Pixel);
+	LogResult("Reseted alpha channel", source, destination, bytes, time);
+	return bytes;
+}
+
+size_t TextureEdit::FlipY(const std::string& source, const std::string& destination)
+{
+	GFX::Surface surface(source);
+	KERNEL_TIMER_START();
+	PixelKernels::Invert(reinterpret_cast<uint32_t*>(surface.GetBuffer()), surface.GetSize(), PixelKernels::GetChannelMask("g"));
+	const float time = KERNEL_TIMER_END();
+	surface.Save(destination);
+	const size_t bytes = surface.GetSize() * sizeof(GFX::Surface::Pixel);
+	LogResult("Fliped Y (G channel)", source, destination, bytes, time);
+	return bytes;
+}
+
+size_t TextureEdit::Invert(const std::string& source, const std::string& destination, const std::string& channels)
+{
+	const uint32_t mask = PixelKernels::GetChannelMask(channels);
+	if (mask == 0)
+	{
+		Utils::Logger::Error("Invalid channels to invert: \"" + channels + "\"!");
+		return 0;
+	}
+	GFX::Surface surface(source);
+	KERNEL_TIMER_START();
+	PixelKernels::Invert(reinterpret_cast<uint32_t*>(surface.GetBuffer()), surface.GetSize(), mask);
+	const float time = KERNEL_TIMER_END();
+	surface.Save(destination);
+	const size_t bytes = surface.GetSize() * sizeof(GFX::Surface::Pixel);
+	LogResult("Inverted channels \"" + channels + "\"", source, destination, bytes, time);
+	return bytes;
+}
+
+size_t TextureEdit::Swizzle(const std::string& source, const std::string& destination, const std::string& pattern)
+{
+	uint8_t order[4];
+	if (!PixelKernels::ParseSwizzle(pattern, order))
+	{
+		Utils::Logger::Error("Invalid swizzle pattern: \"" + pattern + "\"!");
+		return 0;
+	}
+	GFX::Surface surface(source);
+	KERNEL_TIMER_START();
+	PixelKernels::Swizzle(reinterpret_cast<uint32_t*>(surface.GetBuffer()), surface.GetSize(), order);
+	const float time = KERNEL_TIMER_END();
+	surface.Save(destination);
+	const size_t bytes = surface.GetSize() * sizeof(GFX::Surface::Pixel);
+	LogResult("Swizzled channels to \"" + pattern + "\"", source, destination, bytes, time);
+	return bytes;
+}
+
+size_t TextureEdit::Premultiply(const std::string& source, const std::string& destination)
+{
+	GFX::Surface surface(source);
+	KERNEL_TIMER_START();
+	PixelKernels::Premultiply(reinterpret_cast<uint32_t*>(surface.GetBuffer()), surface.GetSize());
+	const float time = KERNEL_TIMER_END();
+	surface.Save(destination);
+	const size_t bytes = surface.GetSize() * sizeof(GFX::Surface::Pixel);
+	LogResult("Premultiplied alpha", source, destination, bytes, time);
+	return bytes;
+}
+
+size_t TextureEdit::PackORM(const std::string& occlusion, const std::string& roughness, const std::string& metallic, const std::string& destination)
+{
+	std::optional<GFX::Surface> sources[3];
+	const std::string* names[3] = { &occlusion, &roughness, &metallic };
+	size_t width = 0, height = 0;
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		if (names[i]->size() == 0)
+			continue;
+		sources[i].emplace(*names[i]);
+		if (width == 0)
+		{
+			width = sources[i]->GetWidth();
+			height = sources[i]->GetHeight();
+		}
+		else if (width != sources[i]->GetWidth() || height != sources[i]->GetHeight())
+		{
+			Utils::Logger::Error("Size of \"" + *names[i] + "\" differs from other ORM sources!");
+			return 0;
+		}
+	}
+	if (width == 0)
+	{
+		Utils::Logger::Error("No ORM sources for \"" + destination + "\"!");
+		return 0;
+	}
+	auto getBuffer = [](const std::optional<GFX::Surface>& surface)
+	{
+		return surface ? reinterpret_cast<const uint32_t*>(surface->GetBuffer()) : nullptr;
+	};
+	GFX::Surface surface(width, height);
+	KERNEL_TIMER_START();
+	PixelKernels::PackORM(reinterpret_cast<uint32_t*>(surface.GetBuffer()), getBuffer(sources[0]), getBuffer(sources[1]), getBuffer(sources[2]), surface.GetSize());
+	const float time = KERNEL_TIMER_END();
+	surface.Save(destination);
+	const size_t bytes = surface.GetSize() * sizeof(GFX::Surface::Pixel);
+	LogResult("Packed ORM map", occlusion + "\", \"" + roughness + "\", \"" + metallic, destination, bytes, time);
+	return bytes;
 }
\ No newline at end of file
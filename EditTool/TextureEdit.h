@@ -3,9 +3,17 @@
 
 class TextureEdit
 {
+	static void LogResult(const std::string& action, const std::string& source, const std::string& destination, size_t bytes, float time);
+
 public:
 	TextureEdit() = delete;
 
-	static void NoAlpha(const std::string& source, const std::string& destination);
-	static void FlipY(const std::string& source, const std::string& destination);
+	// All operations return number of processed bytes
+	static size_t NoAlpha(const std::string& source, const std::string& destination);
+	static size_t FlipY(const std::string& source, const std::string& destination);
+	static size_t Invert(const std::string& source, const std::string& destination, const std::string& channels);
+	static size_t Swizzle(const std::string& source, const std::string& destination, const std::string& pattern);
+	static size_t Premultiply(const std::string& source, const std::string& destination);
+	// Empty source path means default value for given channel
+	static size_t PackORM(const std::string& occlusion, const std::string& roughness, const std::string& metallic, const std::string& destination);
 };
\ No newline at end of file
@@ -0,0 +1,14 @@
+#include "SSAOUtilsPS.hlsli"
+
+Texture2D normalTex   : register(t13); // RG - normal, reduced resolution
+Texture2D depthMap    : register(t14); // R - depth, reduced resolution
+
+float main(float2 tc : TEXCOORD) : SV_TARGET
+{
+	const float2 uv = tc * cb_renderScale;
+	const float2 codedNormal = normalTex.Sample(splr_PR, uv).rg;
+	if (codedNormal.x == 0.0f && codedNormal.y == 0.0f)
+		return 1.0f;
+
+	return GetAmbientOcclusion(tc, DecodeNormal(codedNormal), depthMap.Sample(splr_PR, uv).x, depthMap);
+}
\ No newline at end of file
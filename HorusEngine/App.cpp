@@ -1,6 +1,13 @@
 #include "App.h"
 #include "DialogWindow.h"
 #include "Math.h"
+#include "Profiler.h"
+#include "SceneLoader.h"
+#include "Logger.h"
+#include "ShaderArchive.h"
+#include "ReferenceFrame.h"
+#include "TextureMetadata.h"
+#include "ThreadPool.h"
 
 #pragma region Containers methods
 #define ContainerInvoke(item, function) \
@@ -25,36 +32,43 @@
 
 inline void App::AddLight(GFX::Light::PointLight&& pointLight)
 {
+	// Growing container moves objects referenced by submitted frame
+	framePending = false;
 	objects.emplace(pointLight.GetName(), std::make_pair<Container, size_t>(Container::PointLight, pointLights.size()));
 	pointLights.emplace_back(std::forward<GFX::Light::PointLight&&>(pointLight));
 }
 
 inline void App::AddLight(GFX::Light::SpotLight&& spotLight)
 {
+	framePending = false;
 	objects.emplace(spotLight.GetName(), std::make_pair<Container, size_t>(Container::SpotLight, spotLights.size()));
 	spotLights.emplace_back(std::forward<GFX::Light::SpotLight&&>(spotLight));
 }
 
 inline void App::AddLight(GFX::Light::DirectionalLight&& directionalLight)
 {
+	framePending = false;
 	objects.emplace(directionalLight.GetName(), std::make_pair<Container, size_t>(Container::DirectionalLight, directionalLights.size()));
 	directionalLights.emplace_back(std::forward<GFX::Light::DirectionalLight&&>(directionalLight));
 }
 
 inline void App::AddShape(GFX::Shape::Model&& model)
 {
+	framePending = false;
 	objects.emplace(model.GetName(), std::make_pair<Container, size_t>(Container::Model, models.size()));
 	models.emplace_back(std::forward<GFX::Shape::Model&&>(model));
 }
 
 inline void App::AddShape(std::shared_ptr<GFX::Shape::IShape> shape)
 {
+	framePending = false;
 	objects.emplace(shape->GetName(), std::make_pair<Container, size_t>(Container::Shape, shapes.size()));
 	shapes.emplace_back(shape);
 }
 
 inline void App::DeleteObject(std::map<std::string, std::pair<Container, size_t>>::iterator& object) noexcept
 {
+	framePending = false;
 	switch (object->second.first)
 	{
 	case Container::PointLight:
@@ -116,8 +130,88 @@ inline void App::DeleteObject(std::map<std::string, std::pair<Container, size_t>
 }
 #pragma endregion
 
+void App::LoadScene(const std::string& file)
+{
+	Timer timer;
+	const GFX::SceneFile scene = GFX::SceneFile::Load(file);
+	GFX::SceneLoader loader(scene);
+	scenePreloadTime = loader.GetPreloadTime();
+	GFX::Graphics& gfx = window.Gfx();
+	loader.PrewarmShaders(gfx);
+	shaderPrewarmTime = loader.GetPrewarmTime();
+	shaderPrewarmCount = loader.GetPrewarmedCount();
+
+	// Creation of rest of GPU resources stays on main thread, everything it needs is already decoded
+	for (const auto& camera : scene.cameras)
+	{
+		Camera::CameraParams params(camera.position, camera.name, camera.angleHorizontal, camera.angleVertical, camera.fov, camera.nearClip, camera.farClip);
+		if (camera.type == Camera::CameraType::Floating)
+			cameras.AddCamera(std::make_unique<Camera::FloatingCamera>(gfx, renderer, params));
+		else
+			cameras.AddCamera(std::make_unique<Camera::PersonCamera>(gfx, renderer, params));
+	}
+	for (const auto& light : scene.pointLights)
+		AddLight({ gfx, renderer, light.name, light.intensity, light.color, light.position, light.range, light.radius, light.castShadows });
+	for (const auto& light : scene.spotLights)
+		AddLight({ gfx, renderer, light.name, light.intensity, light.color, light.position, light.range, light.size, light.innerAngle, light.outerAngle, light.direction });
+	for (const auto& light : scene.directionalLights)
+		AddLight({ gfx, renderer, light.name, light.intensity, light.color, light.direction });
+	for (const auto& model : scene.models)
+	{
+		Timer modelTimer;
+		AddShape({ gfx, renderer, model.file, loader.GetModel(model.file), GFX::Shape::ModelParams(model.position, model.rotation, model.name, model.scale) });
+		loader.AddTiming("Create " + model.name, modelTimer.Mark() * 1000.0f);
+	}
+	sceneTimings = loader.GetTimings();
+	sceneLoadTime = timer.Mark() * 1000.0f;
+	sceneFile = file;
+	Utils::Logger::Info("Loaded scene, assets preloaded in " + std::to_string(scenePreloadTime) + " ms, " + std::to_string(shaderPrewarmCount) + " shaders prewarmed in " + std::to_string(shaderPrewarmTime) + " ms.", { .file = sceneFile, .duration = sceneLoadTime });
+	for (const auto& timing : sceneTimings)
+		Utils::Logger::Debug(timing.first + " loaded in " + std::to_string(timing.second) + " ms.");
+}
+
+void App::RenderReferenceFrame()
+{
+	static constexpr const char* REFERENCE_FILE = "reference.png";
+
+	Timer timer;
+	GFX::Graphics& gfx = window.Gfx();
+	GFX::ReferenceFrame frame(GFX::SceneFile::Load(sceneFile), gfx.GetWidth(), gfx.GetHeight(), {});
+	frame.Render(cameras.GetCamera());
+	frame.Save(REFERENCE_FILE);
+	referenceStats = frame.GetStats();
+	Utils::Logger::Info("Reference frame rendered on CPU.", { .file = REFERENCE_FILE, .duration = timer.Mark() * 1000.0f });
+}
+
+inline void App::PickObject(int x, int y) noexcept
+{
+	const auto& camera = cameras.GetCamera();
+	const DirectX::XMMATRIX view = camera.GetView();
+	const DirectX::XMMATRIX projection = camera.GetProjection();
+	const float width = static_cast<float>(window.Gfx().GetWidth());
+	const float height = static_cast<float>(window.Gfx().GetHeight());
+	const DirectX::XMVECTOR nearPoint = DirectX::XMVector3Unproject(DirectX::XMVectorSet(static_cast<float>(x), static_cast<float>(y), 0.0f, 0.0f),
+		0.0f, 0.0f, width, height, 0.0f, 1.0f, projection, view, DirectX::XMMatrixIdentity());
+	const DirectX::XMVECTOR farPoint = DirectX::XMVector3Unproject(DirectX::XMVectorSet(static_cast<float>(x), static_cast<float>(y), 1.0f, 0.0f),
+		0.0f, 0.0f, width, height, 0.0f, 1.0f, projection, view, DirectX::XMMatrixIdentity());
+	float distance;
+	if (auto object = renderer.GetSceneBVH().RayCast(nearPoint, DirectX::XMVector3Normalize(DirectX::XMVectorSubtract(farPoint, nearPoint)), distance))
+		pickedObject = object->GetName();
+}
+
 inline void App::ProcessInput()
 {
+	while (window.Mouse().IsInput())
+	{
+		if (auto opt = window.Mouse().Read())
+		{
+			const auto& event = opt.value();
+			// Select object under cursor on left click, position of click is kept by event
+			if (event.GetType() == WinAPI::Mouse::Event::Type::LeftDown && window.IsCursorEnabled())
+				PickObject(event.GetX(), event.GetY());
+			cameras.ProcessMouseEvent(window, event);
+		}
+	}
 	cameras.ProcessInput(window);
 	while (window.Keyboard().IsKeyReady())
 	{
@@ -167,6 +261,18 @@ inline void App::ShowObjectWindow()
 			}
 			ImGui::EndCombo();
 		}
+		if (pickedObject)
+		{
+			auto picked = objects.find(pickedObject.value());
+			if (picked != objects.end() && picked != currentItem)
+			{
+				ContainerInvoke(currentItem, DisableOutline());
+				currentItem = picked;
+				probe.ResetNode();
+				ContainerInvoke(currentItem, SetOutline());
+			}
+			pickedObject = {};
+		}
 		AddModelButton();
 		ImGui::SameLine();
 		AddLightButton();
@@ -191,6 +297,49 @@ inline void App::ShowOptionsWindow()
 		ImGui::SameLine();
 		ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
 		renderer.ShowWindow(window.Gfx());
+		if (ImGui::CollapsingHeader("Frame pipeline"))
+		{
+			bool pipelined = renderer.IsPipelined();
+			if (ImGui::Checkbox("Submit next frame while drawing", &pipelined))
+			{
+				renderer.SetPipelined(pipelined);
+				framePending = false;
+			}
+			ImGui::Text("Input to present: %.2f ms, frame interval: %.2f ms", frameLatency, frameInterval);
+			ImGui::Text("Submission: %.3f ms, waited for it: %.3f ms", submitTime, submitWaitTime);
+			ImGui::Text("GPU frame: %.2f ms", window.Gfx().GetGpuFrameTime());
+			ImGui::Text("World matrices updated: %llu", static_cast<unsigned long long>(GFX::Object::GetTransformBatch().GetLastFlushed()));
+		}
+		if (ImGui::CollapsingHeader("Scene"))
+		{
+			ImGui::Text("File: %s", sceneFile.c_str());
+			ImGui::Text("Load time: %.1f ms, asset preload: %.1f ms", sceneLoadTime, scenePreloadTime);
+			const GFX::ShaderArchive& archive = GFX::ShaderArchive::Get();
+			if (archive.IsOpen())
+				ImGui::Text("Shader archive: %llu shaders", static_cast<unsigned long long>(archive.GetCount()));
+			else
+				ImGui::Text("Shader archive: not found, using loose files");
+			ImGui::Text("Shader prewarm: %llu shaders in %.1f ms", static_cast<unsigned long long>(shaderPrewarmCount), shaderPrewarmTime);
+			ImGui::Text("First frame: %.1f ms", firstFrameTime);
+			const GFX::TextureMetadata::Stats metadata = GFX::TextureMetadata::GetStats();
+			ImGui::Text("Texture metadata: %llu from sidecar, %llu classified in %.1f ms", static_cast<unsigned long long>(metadata.sidecarHits),
+				static_cast<unsigned long long>(metadata.computed), metadata.computeTime);
+			if (ImGui::TreeNode("Asset timings"))
+			{
+				for (const auto& timing : sceneTimings)
+					ImGui::Text("%8.2f ms  %s", timing.second, timing.first.c_str());
+				ImGui::TreePop();
+			}
+		}
+		if (ImGui::CollapsingHeader("Reference renderer"))
+		{
+			// Only objects from scene file are rendered, without shadows and normal mapping
+			if (ImGui::Button("Render scene on CPU"))
+				RenderReferenceFrame();
+			for (const auto& pass : referenceStats)
+				ImGui::Text("%-18s %8.2f ms %8.1f Mpix/s", pass.name, pass.time, pass.throughput);
+		}
+		Utils::Profiler::Get().ShowWindow();
 	}
 	ImGui::End();
 }
@@ -358,29 +507,132 @@ inline void App::AddLightButton()
 	}
 }
 
+inline void App::UpdateFrameTimings()
+{
+	const auto presentTime = window.Gfx().GetPresentTime();
+	if (presentTime != lastPresentTime && presentedInputTime != std::chrono::steady_clock::time_point())
+	{
+		const float latency = std::chrono::duration<float, std::milli>(presentTime - presentedInputTime).count();
+		const float interval = std::chrono::duration<float, std::milli>(presentTime - lastPresentTime).count();
+		frameLatency += (latency - frameLatency) * TIMING_SMOOTHING;
+		frameInterval += (interval - frameInterval) * TIMING_SMOOTHING;
+	}
+	lastPresentTime = presentTime;
+	if (window.Gfx().GetGpuFrameCount() != lastGpuFrame)
+	{
+		lastGpuFrame = window.Gfx().GetGpuFrameCount();
+		renderer.UpdateRenderScale(window.Gfx().GetGpuFrameTime());
+	}
+}
+
+inline void App::SubmitFrame()
+{
+	const auto start = std::chrono::steady_clock::now();
+	{
+		// Jobs capture world matrices at submission, so changed objects have to be updated first
+		PROFILE_SCOPE("Transforms");
+		GFX::Object::FlushTransforms();
+	}
+	{
+		PROFILE_SCOPE("Submit");
+		cameras.Submit(RenderChannel::Main);
+		for (auto& pointLight : pointLights)
+			pointLight.Submit(RenderChannel::Main | RenderChannel::Light);
+		for (auto& spotLight : spotLights)
+			spotLight.Submit(RenderChannel::Main | RenderChannel::Light);
+		for (auto& directionalLight : directionalLights)
+			directionalLight.Submit(RenderChannel::Main | RenderChannel::Light);
+		for (auto& model : models)
+			model.Submit(RenderChannel::Main | RenderChannel::Shadow);
+		for (auto& shape : shapes)
+			shape->Submit(RenderChannel::Main | RenderChannel::Shadow);
+	}
+	submitTime += (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() - submitTime) * TIMING_SMOOTHING;
+}
+
 void App::MakeFrame()
 {
-	window.Gfx().BeginFrame();
-	ProcessInput();
-	ShowObjectWindow();
-	ShowOptionsWindow();
-	//ImGui::ShowDemoWindow();
-	if (cameras.CameraChanged())
-		renderer.BindMainCamera(cameras.GetCamera());
-	cameras.Submit(RenderChannel::Main);
-	for (auto& pointLight : pointLights)
-		pointLight.Submit(RenderChannel::Main | RenderChannel::Light);
-	for (auto& spotLight : spotLights)
-		spotLight.Submit(RenderChannel::Main | RenderChannel::Light);
-	for (auto& directionalLight : directionalLights)
-		directionalLight.Submit(RenderChannel::Main | RenderChannel::Light);
-	for (auto& model : models)
-		model.Submit(RenderChannel::Main | RenderChannel::Shadow);
-	for (auto& shape : shapes)
-		shape->Submit(RenderChannel::Main | RenderChannel::Shadow);
-	renderer.Execute(window.Gfx());
-	renderer.Reset();
-	window.Gfx().EndFrame();
+	{
+		PROFILE_SCOPE("Frame");
+		window.Gfx().BeginFrame();
+		const auto inputTime = std::chrono::steady_clock::now();
+		{
+			PROFILE_SCOPE("Input");
+			ProcessInput();
+		}
+		{
+			PROFILE_SCOPE("GUI");
+			ShowObjectWindow();
+			ShowOptionsWindow();
+			//ImGui::ShowDemoWindow();
+		}
+		if (cameras.CameraChanged())
+		{
+			renderer.BindMainCamera(cameras.GetCamera());
+			// Removed camera can be still referenced by submitted frame
+			framePending = false;
+		}
+		UpdateFrameTimings();
+		{
+			PROFILE_SCOPE("Texture streaming");
+			GFX::Resource::TextureStreamer::Get().Update(window.Gfx());
+		}
+		if (renderer.IsPipelined())
+		{
+			if (!framePending)
+			{
+				// Pipeline is filled with current scene so no frame is left empty
+				SubmitFrame();
+				renderer.EndSubmission(window.Gfx());
+				pendingInputTime = inputTime;
+			}
+			// Next frame is submitted on worker while previous one is drawn, scene cannot change until both are done
+			auto submission = Utils::ThreadPool::Get().Schedule([this]() { SubmitFrame(); });
+			{
+				PROFILE_SCOPE("Render");
+				try
+				{
+					renderer.Execute(window.Gfx());
+				}
+				catch (...)
+				{
+					submission.wait();
+					throw;
+				}
+				{
+					PROFILE_SCOPE("Wait submission");
+					const auto start = std::chrono::steady_clock::now();
+					submission.get();
+					submitWaitTime += (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() - submitWaitTime) * TIMING_SMOOTHING;
+				}
+				renderer.Reset();
+			}
+		}
+		else
+		{
+			SubmitFrame();
+			renderer.EndSubmission(window.Gfx());
+			pendingInputTime = inputTime;
+			{
+				PROFILE_SCOPE("Render");
+				renderer.Execute(window.Gfx());
+				renderer.Reset();
+			}
+		}
+		{
+			PROFILE_SCOPE("Present");
+			window.Gfx().EndFrame();
+			presentedInputTime = pendingInputTime;
+		}
+		// Submitted frame becomes pending only after drawn one is reset
+		framePending = renderer.IsPipelined();
+		if (framePending)
+		{
+			renderer.EndSubmission(window.Gfx());
+			pendingInputTime = inputTime;
+		}
+	}
+	Utils::Profiler::Get().EndFrame();
 }
 
 App::App(const std::string& commandLine)
@@ -390,47 +642,22 @@ App::App(const std::string& commandLine)
 {
 	window.Gfx().Gui().SetFont("Fonts/Arial.ttf", 14.0f);
 	objects.emplace("---None---", std::make_pair<Container, size_t>(Container::None, 0));
-	// Sample Scene
-	cameras.AddCamera(std::make_unique<Camera::PersonCamera>(window.Gfx(), renderer,
-		Camera::CameraParams({ 0.0f, 40.0f, -4.0f }, "Camera", 0.0f, Math::ToRadians(45.0f), 1.047f, 2.0f, 15.0f)));
-	AddLight({ window.Gfx(), renderer, "Light bulb", 1.0f, GFX::Data::ColorFloat3(1.0f, 1.0f, 1.0f), DirectX::XMFLOAT3(-20.0f, 2.0f, -4.0f), 50 });
-	AddLight({ window.Gfx(), renderer, "Pumpkin candle", 5.0f, GFX::Data::ColorFloat3(1.0f, 0.96f, 0.27f), DirectX::XMFLOAT3(14.0f, -6.3f, -5.0f), 85 });
-	AddLight({ window.Gfx(), renderer, "Torch", 5.0f, GFX::Data::ColorFloat3(1.0f, 0.0f, 0.2f), DirectX::XMFLOAT3(21.95f, -1.9f, 9.9f), 70 });
-	AddLight({ window.Gfx(), renderer, "Blue ilumination", 10.0f, GFX::Data::ColorFloat3(0.0f, 0.46f, 1.0f), DirectX::XMFLOAT3(43.0f, 27.0f, 1.8f), 70 });
-	DirectX::XMFLOAT3 direction = { -0.64f, -1.0f, 0.5f };
-	AddLight({ window.Gfx(), renderer, "Space light", 8.0f, GFX::Data::ColorFloat3(1.3f, 2.3f, 1.3f),
-		DirectX::XMFLOAT3(7.5f, 60.0f, -5.0f), 126, 2.0f, Math::ToRadians(15.0f), Math::ToRadians(24.5f), Math::NormalizeStore(direction) });
-	direction = { -1.0f, 1.0f, -0.7f };
-	AddLight({ window.Gfx(), renderer,"Lion flare", 9.0f, GFX::Data::ColorFloat3(0.8f, 0.0f, 0.8f),
-		DirectX::XMFLOAT3(-61.0f, -6.0f, 5.0f), 150, 1.0f, Math::ToRadians(35.0f), Math::ToRadians(45.0f), Math::NormalizeStore(direction) });
-	direction = { -0.6f, 0.75f, 0.3f };
-	AddLight({ window.Gfx(), renderer,"Dragon flame", 3.0f, GFX::Data::ColorFloat3(0.04f, 0.0f, 0.52f),
-		DirectX::XMFLOAT3(-35.0f, -8.0f, 2.0f), 175, 0.5f, Math::ToRadians(27.0f), Math::ToRadians(43.0f), Math::NormalizeStore(direction) });
-	direction = { 0.0f, -0.7f, -0.7f };
-	AddLight({ window.Gfx(), renderer, "Moon", 0.1f, GFX::Data::ColorFloat3(0.7608f, 0.7725f, 0.8f), Math::NormalizeStore(direction) });
-	GFX::Shape::ModelParams params({ 0.0f, -8.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, "Sponza", 0.045f);
-	AddShape({ window.Gfx(), renderer, "Models/Sponza/sponza.obj", params });
-	params = { DirectX::XMFLOAT3(0.0f, -8.2f, 6.0f), DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), "Nanosuit", 0.70f };
-	AddShape({ window.Gfx(), renderer, "Models/nanosuit/nanosuit.obj", params });
-	params = { DirectX::XMFLOAT3(13.5f, -8.2f, -5.0f), DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), "Jack O'Lantern", 13.00f };
-	AddShape({ window.Gfx(), renderer, "Models/Jack/Jack_O_Lantern.3ds", params });
-	params = { DirectX::XMFLOAT3(-5.0f, -2.0f, 7.0f), DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), "Wall", 2.0f };
-	AddShape({ window.Gfx(), renderer, "Models/bricks/brick_wall.obj", params });
-	//params = { DirectX::XMFLOAT3(-39.0f, -8.1f, 2.0f), DirectX::XMFLOAT3(0.0f, Math::ToRadians(290.0f), 0.0f), "Black Dragon", 0.15f };
-	//AddShape({ window.Gfx(), renderer, "Models/Black Dragon/Dragon 2.5.fbx", params });
-	//params = { DirectX::XMFLOAT3(-20.0f, 0.0f, -6.0f), DirectX::XMFLOAT3(Math::ToRadians(35.0f), Math::ToRadians(270.0f), Math::ToRadians(110.0f)), "Sting Sword", 0.2f };
-	//AddShape({ window.Gfx(), renderer, "Models/Sting_Sword/Sting_Sword.obj", params });
-	//params = { DirectX::XMFLOAT3(41.6f, 18.5f, 8.5f), DirectX::XMFLOAT3(0.0f, Math::ToRadians(87.1f), Math::ToRadians(301.0f)), "TIE", 3.6f };
-	//AddShape({ window.Gfx(), renderer, "Models/tie/tie.obj", params });
+	LoadScene(commandLine.size() ? commandLine : DEFAULT_SCENE);
 }
 
 size_t App::Run()
 {
+	Timer frameTimer;
 	while (run)
 	{
 		if (const auto status = WinAPI::Window::ProcessMessage())
 			return status.value();
 		MakeFrame();
+		if (firstFrameTime == 0.0f)
+		{
+			firstFrameTime = frameTimer.Mark() * 1000.0f;
+			Utils::Logger::Info("First frame finished in " + std::to_string(firstFrameTime) + " ms.");
+		}
 	}
 	return 0U;
 }
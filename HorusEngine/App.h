@@ -4,6 +4,7 @@
 #include "Shapes.h"
 #include "Lights.h"
 #include "MainPipelineGraph.h"
+#include "SoftwareRenderer.h"
 #include <map>
 
 class App
@@ -11,6 +12,8 @@ class App
 	enum class Container : uint8_t { None, PointLight, SpotLight, DirectionalLight, Model, Shape };
 
 	static constexpr const char* WINDOW_TITLE = "Horus Engine Alpha";
+	static constexpr const char* DEFAULT_SCENE = "Scenes/Sponza.json";
+	static constexpr float TIMING_SMOOTHING = 0.05f;
 
 	WinAPI::Window window;
 	GFX::Pipeline::MainPipelineGraph renderer;
@@ -23,6 +26,32 @@ class App
 	std::vector<GFX::Shape::Model> models;
 	std::vector<std::shared_ptr<GFX::Shape::IShape>> shapes;
 	std::map<std::string, std::pair<Container, size_t>> objects;
+	std::optional<std::string> pickedObject = {};
+	// Input time of frame waiting for present, latency and interval are smoothed in ms
+	std::chrono::steady_clock::time_point presentedInputTime;
+	// Input time of frame submitted to renderer but not drawn yet
+	std::chrono::steady_clock::time_point pendingInputTime;
+	std::chrono::steady_clock::time_point lastPresentTime;
+	float frameLatency = 0.0f;
+	float frameInterval = 0.0f;
+	// Pipelined renderer holds frame submitted during drawing of previous one, it is dropped when scene objects are added or removed
+	bool framePending = false;
+	// Smoothed time of submission and of waiting for it after drawing, in ms
+	float submitTime = 0.0f;
+	float submitWaitTime = 0.0f;
+	// Last GPU frame time passed to dynamic resolution, vsync keeps present interval at refresh rate so it cannot be used
+	uint64_t lastGpuFrame = 0;
+	// Load statistics of current scene in ms
+	std::string sceneFile;
+	float sceneLoadTime = 0.0f;
+	float scenePreloadTime = 0.0f;
+	float shaderPrewarmTime = 0.0f;
+	size_t shaderPrewarmCount = 0;
+	// Includes creation of every resource that was not ready before first frame
+	float firstFrameTime = 0.0f;
+	std::vector<std::pair<std::string, float>> sceneTimings;
+	// Pass timings of last scene frame rendered on CPU
+	std::vector<GFX::SoftwareRenderer::PassStats> referenceStats;
 
 	inline void AddLight(GFX::Light::PointLight&& pointLight);
 	inline void AddLight(GFX::Light::SpotLight&& spotLight);
@@ -31,7 +60,12 @@ class App
 	inline void AddShape(std::shared_ptr<GFX::Shape::IShape> shape);
 	inline void DeleteObject(std::map<std::string, std::pair<Container, size_t>>::iterator& object) noexcept;
 
+	void LoadScene(const std::string& file);
+	void RenderReferenceFrame();
+	inline void UpdateFrameTimings();
+	inline void PickObject(int x, int y) noexcept;
 	inline void ProcessInput();
+	inline void SubmitFrame();
 	inline void ShowObjectWindow();
 	inline void ShowOptionsWindow();
 	inline void AddModelButton();
@@ -0,0 +1,94 @@
+#include "AutoExposurePass.h"
+#include "RenderPassesBase.h"
+#include "PipelineResources.h"
+#include "GfxResources.h"
+#include "Profiler.h"
+
+namespace GFX::Pipeline::RenderPass
+{
+	AutoExposurePass::AutoExposurePass(Graphics& gfx, const std::string& name)
+		: BindingPass(name), FullscreenPass(gfx, name), luminance(static_cast<size_t>(LUMINANCE_WIDTH) * LUMINANCE_HEIGHT),
+		lastUpdate(std::chrono::steady_clock::now())
+	{
+		luminanceTarget = GfxResPtr<Resource::RenderTargetReadback>(gfx, LUMINANCE_WIDTH, LUMINANCE_HEIGHT, DXGI_FORMAT_R32_FLOAT);
+		renderTarget = luminanceTarget;
+
+		AddBindableSink<Resource::RenderTargetShaderInput>("scene");
+		RegisterSink(Base::SinkDirectBindable<GFX::Resource::ConstBufferExPixelCache>::Make("gammaCorrection", gammaCorrection));
+
+		AddBind(GFX::Resource::PixelShader::Get(gfx, "LuminancePS"));
+		AddBind(GFX::Resource::Blender::Get(gfx, GFX::Resource::Blender::Type::None));
+	}
+
+	void AutoExposurePass::SetEnabled(bool enable) noexcept
+	{
+		enabled = enable;
+		if (enabled)
+			autoExposure.Reset();
+	}
+
+	void AutoExposurePass::Prepare(Graphics& gfx)
+	{
+		if (!enabled)
+			return;
+		PROFILE_SCOPE("Exposure readback");
+		if (luminanceTarget->Read(gfx, luminance.data(), sizeof(float)))
+		{
+			const auto now = std::chrono::steady_clock::now();
+			const float deltaTime = std::chrono::duration<float>(now - lastUpdate).count();
+			lastUpdate = now;
+			gammaCorrection->GetBuffer()["hdrExposure"] = autoExposure.Update(luminance.data(), luminance.size(), deltaTime);
+			// Uploaded before recording so all passes see same exposure
+			gammaCorrection->Bind(gfx);
+		}
+	}
+
+	void AutoExposurePass::Execute(Graphics& gfx)
+	{
+		if (!enabled)
+			return;
+		DRAW_TAG_START(gfx, GetName());
+		BindAll(gfx);
+		gfx.DrawIndexed(6U);
+		luminanceTarget->Unbind(gfx);
+		luminanceTarget->Copy(gfx);
+		DRAW_TAG_END(gfx);
+	}
+
+	void AutoExposurePass::ShowWindow(Graphics& gfx)
+	{
+		auto& params = autoExposure.GetParams();
+		ImGui::Columns(2, "##auto_exposure", false);
+		ImGui::Text("Key value");
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputFloat("##exposure_key", &params.key, 0.01f, 0.0f, "%.2f") && params.key < 0.01f)
+			params.key = 0.01f;
+		ImGui::Text("Low percentile");
+		ImGui::SetNextItemWidth(-1.0f);
+		ImGui::SliderFloat("##low_percentile", &params.lowPercentile, 0.0f, params.highPercentile, "%.2f");
+		ImGui::Text("Speed up");
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputFloat("##speed_up", &params.speedUp, 0.1f, 0.0f, "%.1f") && params.speedUp < 0.0f)
+			params.speedUp = 0.0f;
+		ImGui::NextColumn();
+		ImGui::Text("Max exposure");
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputFloat("##max_exposure", &params.maxExposure, 0.1f, 0.0f, "%.1f") && params.maxExposure < params.minExposure)
+			params.maxExposure = params.minExposure;
+		ImGui::Text("High percentile");
+		ImGui::SetNextItemWidth(-1.0f);
+		ImGui::SliderFloat("##high_percentile", &params.highPercentile, params.lowPercentile, 1.0f, "%.2f");
+		ImGui::Text("Speed down");
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputFloat("##speed_down", &params.speedDown, 0.1f, 0.0f, "%.1f") && params.speedDown < 0.0f)
+			params.speedDown = 0.0f;
+		ImGui::Columns(1);
+
+		std::array<float, AutoExposure::BIN_COUNT> bins;
+		for (uint32_t i = 0; i < AutoExposure::BIN_COUNT; ++i)
+			bins.at(i) = static_cast<float>(autoExposure.GetHistogram().at(i));
+		ImGui::PlotHistogram("##luminance_histogram", bins.data(), static_cast<int>(bins.size()), 0, "Log luminance", 0.0f, FLT_MAX, ImVec2(-1.0f, 60.0f));
+		ImGui::Text("Exposure: %.3f, average log luminance: %.2f (adapted %.2f)", autoExposure.GetExposure(),
+			autoExposure.GetTargetLogLuminance(), autoExposure.GetAdaptedLogLuminance());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include "FullscreenPass.h"
+#include "ConstBufferExCache.h"
+#include "RenderTargetReadback.h"
+#include "AutoExposure.h"
+
+namespace GFX::Pipeline::RenderPass
+{
+	class AutoExposurePass : public Base::FullscreenPass
+	{
+		// Scene luminance is always reduced to fixed size so cost does not depend on resolution
+		static constexpr UINT LUMINANCE_WIDTH = 64U;
+		static constexpr UINT LUMINANCE_HEIGHT = 32U;
+
+		bool enabled = true;
+		AutoExposure autoExposure;
+		std::vector<float> luminance;
+		std::chrono::steady_clock::time_point lastUpdate;
+		GfxResPtr<Resource::RenderTargetReadback> luminanceTarget;
+		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> gammaCorrection;
+
+	public:
+		AutoExposurePass(Graphics& gfx, const std::string& name);
+		virtual ~AutoExposurePass() = default;
+
+		constexpr bool IsEnabled() const noexcept { return enabled; }
+		constexpr float GetExposure() const noexcept { return autoExposure.GetExposure(); }
+		// When disabled exposure in gamma correction buffer is left unchanged
+		void SetEnabled(bool enable) noexcept;
+
+		// Reads luminance of one of previous frames and adapts exposure
+		void Prepare(Graphics& gfx) override;
+		void Execute(Graphics& gfx) override;
+		void ShowWindow(Graphics& gfx);
+	};
+}
\ No newline at end of file
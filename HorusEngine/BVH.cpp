@@ -0,0 +1,341 @@
+#include "BVH.h"
+#include <algorithm>
+
+namespace GFX::Pipeline
+{
+	inline float BVH::GetArea(const DirectX::BoundingBox& box) noexcept
+	{
+		return box.Extents.x * box.Extents.y + box.Extents.y * box.Extents.z + box.Extents.z * box.Extents.x;
+	}
+
+	inline DirectX::BoundingBox BVH::Merge(const DirectX::BoundingBox& box1, const DirectX::BoundingBox& box2) noexcept
+	{
+		DirectX::BoundingBox merged;
+		DirectX::BoundingBox::CreateMerged(merged, box1, box2);
+		return merged;
+	}
+
+	uint32_t BVH::BuildNode(std::vector<uint32_t>& items, size_t begin, size_t end, uint32_t parent) noexcept
+	{
+		const uint32_t index = static_cast<uint32_t>(nodes.size());
+		nodes.emplace_back();
+		nodes.back().parent = parent;
+		if (end - begin == 1)
+		{
+			const uint32_t proxy = items.at(begin);
+			nodes.back().box = proxies.at(proxy).box;
+			nodes.back().proxy = proxy;
+			proxies.at(proxy).node = index;
+			return index;
+		}
+
+		// Bounds of centroids to place items into bins
+		DirectX::XMVECTOR minCenter = DirectX::XMLoadFloat3(&proxies.at(items.at(begin)).box.Center);
+		DirectX::XMVECTOR maxCenter = minCenter;
+		for (size_t i = begin + 1; i < end; ++i)
+		{
+			const DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&proxies.at(items.at(i)).box.Center);
+			minCenter = DirectX::XMVectorMin(minCenter, center);
+			maxCenter = DirectX::XMVectorMax(maxCenter, center);
+		}
+		DirectX::XMFLOAT3 minBound, size;
+		DirectX::XMStoreFloat3(&minBound, minCenter);
+		DirectX::XMStoreFloat3(&size, DirectX::XMVectorSubtract(maxCenter, minCenter));
+		const float* minAxis = &minBound.x;
+		const float* sizeAxis = &size.x;
+
+		size_t bestAxis = 0, bestSplit = 0;
+		float bestCost = FLT_MAX;
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			if (sizeAxis[axis] <= FLT_EPSILON)
+				continue;
+			struct Bin
+			{
+				DirectX::BoundingBox box;
+				size_t count = 0;
+			} bins[SAH_BINS];
+			const float scale = SAH_BINS / sizeAxis[axis];
+			for (size_t i = begin; i < end; ++i)
+			{
+				const auto& box = proxies.at(items.at(i)).box;
+				const size_t bin = std::min(static_cast<size_t>(((&box.Center.x)[axis] - minAxis[axis]) * scale), static_cast<size_t>(SAH_BINS - 1));
+				bins[bin].box = bins[bin].count++ ? Merge(bins[bin].box, box) : box;
+			}
+			// Sweep from right to gather costs of right sides
+			float rightArea[SAH_BINS];
+			size_t rightCount[SAH_BINS];
+			DirectX::BoundingBox accumulated;
+			size_t count = 0;
+			for (size_t i = SAH_BINS - 1; i > 0; --i)
+			{
+				if (bins[i].count)
+				{
+					accumulated = count ? Merge(accumulated, bins[i].box) : bins[i].box;
+					count += bins[i].count;
+				}
+				rightArea[i] = count ? GetArea(accumulated) : 0.0f;
+				rightCount[i] = count;
+			}
+			count = 0;
+			for (size_t i = 0; i < SAH_BINS - 1; ++i)
+			{
+				if (bins[i].count)
+				{
+					accumulated = count ? Merge(accumulated, bins[i].box) : bins[i].box;
+					count += bins[i].count;
+				}
+				if (count == 0 || rightCount[i + 1] == 0)
+					continue;
+				const float cost = GetArea(accumulated) * count + rightArea[i + 1] * rightCount[i + 1];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i;
+				}
+			}
+		}
+
+		size_t middle = begin + (end - begin) / 2;
+		if (bestCost < FLT_MAX)
+		{
+			const float scale = SAH_BINS / sizeAxis[bestAxis];
+			auto it = std::partition(items.begin() + begin, items.begin() + end, [&](uint32_t proxy)
+				{
+					const auto& box = proxies.at(proxy).box;
+					return std::min(static_cast<size_t>(((&box.Center.x)[bestAxis] - minAxis[bestAxis]) * scale), static_cast<size_t>(SAH_BINS - 1)) <= bestSplit;
+				});
+			middle = it - items.begin();
+		}
+		// All centroids in same place
+		if (middle == begin || middle == end)
+			middle = begin + (end - begin) / 2;
+
+		const uint32_t left = BuildNode(items, begin, middle, index);
+		const uint32_t right = BuildNode(items, middle, end, index);
+		Node& node = nodes.at(index);
+		node.left = left;
+		node.right = right;
+		node.box = Merge(nodes.at(left).box, nodes.at(right).box);
+		return index;
+	}
+
+	void BVH::Build() noexcept
+	{
+		nodes.clear();
+		dirtyProxies.clear();
+		root = INVALID_INDEX;
+		rebuildNeeded = false;
+		++rebuildCount;
+
+		std::vector<uint32_t> items;
+		items.reserve(proxies.size());
+		for (uint32_t i = 0, size = static_cast<uint32_t>(proxies.size()); i < size; ++i)
+			if (proxies.at(i).data)
+				items.emplace_back(i);
+		if (items.size() == 0)
+		{
+			buildCost = 0.0f;
+			return;
+		}
+		nodes.reserve(items.size() * 2 - 1);
+		root = BuildNode(items, 0, items.size(), INVALID_INDEX);
+		buildCost = GetCost();
+	}
+
+	void BVH::Refit() noexcept
+	{
+		for (uint32_t proxy : dirtyProxies)
+		{
+			uint32_t index = proxies.at(proxy).node;
+			nodes.at(index).box = proxies.at(proxy).box;
+			index = nodes.at(index).parent;
+			while (index != INVALID_INDEX)
+			{
+				Node& node = nodes.at(index);
+				node.box = Merge(nodes.at(node.left).box, nodes.at(node.right).box);
+				index = node.parent;
+			}
+		}
+		dirtyProxies.clear();
+		if (GetCost() > buildCost * REBUILD_COST_RATIO)
+			Build();
+	}
+
+	float BVH::GetCost() const noexcept
+	{
+		if (root == INVALID_INDEX)
+			return 0.0f;
+		// Expected number of visited nodes for random ray
+		float cost = 0.0f;
+		for (const auto& node : nodes)
+			if (node.proxy == INVALID_INDEX)
+				cost += GetArea(node.box);
+		const float rootArea = GetArea(nodes.at(root).box);
+		return rootArea > FLT_EPSILON ? cost / rootArea : 0.0f;
+	}
+
+	void BVH::Prepare() noexcept
+	{
+		if (rebuildNeeded)
+			Build();
+		else if (dirtyProxies.size())
+			Refit();
+	}
+
+	template<typename Volume>
+	uint64_t BVH::Mark(const Volume& volume) noexcept
+	{
+		Prepare();
+		const uint64_t stamp = ++queryStamp;
+		if (root == INVALID_INDEX)
+			return stamp;
+		traversalStack.clear();
+		traversalStack.emplace_back(root);
+		while (traversalStack.size())
+		{
+			const uint32_t index = traversalStack.back();
+			traversalStack.pop_back();
+			const Node& node = nodes.at(index);
+			const DirectX::ContainmentType containment = volume.Contains(node.box);
+			if (containment == DirectX::ContainmentType::DISJOINT)
+				continue;
+			if (node.proxy != INVALID_INDEX)
+				proxies.at(node.proxy).stamp = stamp;
+			else if (containment == DirectX::ContainmentType::CONTAINS)
+			{
+				// Whole subtree inside, no more tests needed
+				const size_t stackBase = traversalStack.size();
+				traversalStack.emplace_back(index);
+				while (traversalStack.size() > stackBase)
+				{
+					const Node& inner = nodes.at(traversalStack.back());
+					traversalStack.pop_back();
+					if (inner.proxy != INVALID_INDEX)
+						proxies.at(inner.proxy).stamp = stamp;
+					else
+					{
+						traversalStack.emplace_back(inner.left);
+						traversalStack.emplace_back(inner.right);
+					}
+				}
+			}
+			else
+			{
+				traversalStack.emplace_back(node.left);
+				traversalStack.emplace_back(node.right);
+			}
+		}
+		return stamp;
+	}
+
+	uint32_t BVH::Insert(const DirectX::BoundingBox& box, JobData* data) noexcept
+	{
+		uint32_t proxy;
+		if (freeProxies.size())
+		{
+			proxy = freeProxies.back();
+			freeProxies.pop_back();
+		}
+		else
+		{
+			proxy = static_cast<uint32_t>(proxies.size());
+			proxies.emplace_back();
+		}
+		proxies.at(proxy) = { box, data, INVALID_INDEX, 0 };
+		rebuildNeeded = true;
+		return proxy;
+	}
+
+	void BVH::Update(uint32_t proxy, const DirectX::BoundingBox& box) noexcept
+	{
+		proxies.at(proxy).box = box;
+		if (!rebuildNeeded)
+			dirtyProxies.emplace_back(proxy);
+	}
+
+	void BVH::Remove(uint32_t proxy) noexcept
+	{
+		proxies.at(proxy) = {};
+		freeProxies.emplace_back(proxy);
+		rebuildNeeded = true;
+	}
+
+	uint64_t BVH::MarkInside(const DirectX::BoundingFrustum& frustum) noexcept
+	{
+		return Mark(frustum);
+	}
+
+	uint64_t BVH::MarkInside(const DirectX::BoundingSphere& sphere) noexcept
+	{
+		return Mark(sphere);
+	}
+
+	uint64_t BVH::MarkInside(const DirectX::BoundingOrientedBox& box) noexcept
+	{
+		return Mark(box);
+	}
+
+	JobData* BVH::RayCast(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float& distance) noexcept
+	{
+		Prepare();
+		JobData* hit = nullptr;
+		// Boxes containing ray origin (ex. surrounding level geometry) are chosen only when nothing else is hit
+		JobData* surroundingHit = nullptr;
+		distance = FLT_MAX;
+		if (root == INVALID_INDEX)
+			return hit;
+		float rootDistance;
+		if (!nodes.at(root).box.Intersects(origin, direction, rootDistance))
+			return hit;
+		// Closer children visited first
+		rayStack.clear();
+		rayStack.emplace_back(root, rootDistance);
+		while (rayStack.size())
+		{
+			const auto [index, entry] = rayStack.back();
+			rayStack.pop_back();
+			if (entry >= distance)
+				continue;
+			const Node& node = nodes.at(index);
+			if (node.proxy != INVALID_INDEX)
+			{
+				if (node.box.Contains(origin) != DirectX::ContainmentType::DISJOINT)
+				{
+					if (surroundingHit == nullptr)
+						surroundingHit = proxies.at(node.proxy).data;
+				}
+				else
+				{
+					distance = entry;
+					hit = proxies.at(node.proxy).data;
+				}
+				continue;
+			}
+			float leftDistance = FLT_MAX, rightDistance = FLT_MAX;
+			const bool leftHit = nodes.at(node.left).box.Intersects(origin, direction, leftDistance);
+			const bool rightHit = nodes.at(node.right).box.Intersects(origin, direction, rightDistance);
+			if (leftHit && rightHit)
+			{
+				if (leftDistance < rightDistance)
+				{
+					rayStack.emplace_back(node.right, rightDistance);
+					rayStack.emplace_back(node.left, leftDistance);
+				}
+				else
+				{
+					rayStack.emplace_back(node.left, leftDistance);
+					rayStack.emplace_back(node.right, rightDistance);
+				}
+			}
+			else if (leftHit)
+				rayStack.emplace_back(node.left, leftDistance);
+			else if (rightHit)
+				rayStack.emplace_back(node.right, rightDistance);
+		}
+		if (hit == nullptr && surroundingHit)
+			distance = 0.0f;
+		return hit ? hit : surroundingHit;
+	}
+}
\ No newline at end of file
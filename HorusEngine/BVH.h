@@ -0,0 +1,89 @@
+#pragma once
+#include <DirectXCollision.h>
+#include <vector>
+#include <mutex>
+
+namespace GFX::Pipeline
+{
+	// Dynamic bounding volume hierarchy over world space boxes of scene objects.
+	// Built with binned SAH, moving objects only refit their ancestors until tree quality degrades.
+	class BVH
+	{
+	public:
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	private:
+		static constexpr uint32_t SAH_BINS = 16;
+		// Rebuild when SAH cost after refits grows past this ratio of cost after build
+		static constexpr float REBUILD_COST_RATIO = 1.5f;
+
+		struct Proxy
+		{
+			DirectX::BoundingBox box;
+			class JobData* data = nullptr;
+			uint32_t node = INVALID_INDEX;
+			uint64_t stamp = 0;
+		};
+		struct Node
+		{
+			DirectX::BoundingBox box;
+			uint32_t parent = INVALID_INDEX;
+			uint32_t left = INVALID_INDEX;
+			uint32_t right = INVALID_INDEX;
+			// Valid only for leaves
+			uint32_t proxy = INVALID_INDEX;
+		};
+
+		std::vector<Proxy> proxies;
+		std::vector<uint32_t> freeProxies;
+		std::vector<Node> nodes;
+		std::vector<uint32_t> dirtyProxies;
+		std::vector<uint32_t> traversalStack;
+		// Entries of (node, entry distance) for ray casts, kept between queries like traversal stack
+		std::vector<std::pair<uint32_t, float>> rayStack;
+		std::mutex queryMutex;
+		uint32_t root = INVALID_INDEX;
+		uint64_t queryStamp = 0;
+		float buildCost = 0.0f;
+		bool rebuildNeeded = false;
+		size_t rebuildCount = 0;
+
+		static inline float GetArea(const DirectX::BoundingBox& box) noexcept;
+		static inline DirectX::BoundingBox Merge(const DirectX::BoundingBox& box1, const DirectX::BoundingBox& box2) noexcept;
+
+		uint32_t BuildNode(std::vector<uint32_t>& items, size_t begin, size_t end, uint32_t parent) noexcept;
+		void Build() noexcept;
+		void Refit() noexcept;
+		float GetCost() const noexcept;
+		// Brings tree up to date with latest proxy changes
+		void Prepare() noexcept;
+		template<typename Volume>
+		uint64_t Mark(const Volume& volume) noexcept;
+
+	public:
+		BVH() = default;
+		BVH(const BVH&) = delete;
+		BVH& operator=(const BVH&) = delete;
+		~BVH() = default;
+
+		// Marks are shared by all queries, they have to be read under this lock when passes record in parallel
+		constexpr std::mutex& GetQueryMutex() noexcept { return queryMutex; }
+		constexpr size_t GetRebuildCount() const noexcept { return rebuildCount; }
+		constexpr float GetBuildCost() const noexcept { return buildCost; }
+		inline size_t GetObjectCount() const noexcept { return proxies.size() - freeProxies.size(); }
+		inline size_t GetNodeCount() const noexcept { return nodes.size(); }
+		inline bool IsMarked(uint32_t proxy, uint64_t stamp) const noexcept { return proxies.at(proxy).stamp == stamp; }
+		inline void SetData(uint32_t proxy, class JobData* data) noexcept { proxies.at(proxy).data = data; }
+
+		uint32_t Insert(const DirectX::BoundingBox& box, class JobData* data) noexcept;
+		void Update(uint32_t proxy, const DirectX::BoundingBox& box) noexcept;
+		void Remove(uint32_t proxy) noexcept;
+
+		// Marks objects intersecting volume with stamp that is returned
+		uint64_t MarkInside(const DirectX::BoundingFrustum& frustum) noexcept;
+		uint64_t MarkInside(const DirectX::BoundingSphere& sphere) noexcept;
+		uint64_t MarkInside(const DirectX::BoundingOrientedBox& box) noexcept;
+		// Returns closest object whose box is hit by ray (direction have to be normalized)
+		class JobData* RayCast(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float& distance) noexcept;
+	};
+}
\ No newline at end of file
@@ -50,14 +50,16 @@ namespace Camera
 		inline void DisableOutline() noexcept override { indicator->DisableOutline(); }
 
 		inline void BindVS(GFX::Graphics& gfx) override { UpdateBufferVS(gfx); positionBuffer->Bind(gfx); }
-		inline void BindPS(GFX::Graphics& gfx) override { UpdateBufferPS(); cameraBuffer->Bind(gfx); }
+		inline void BindPS(GFX::Graphics& gfx) override { cameraBuffer->Bind(gfx); }
 
 		DirectX::XMMATRIX GetProjection() const noexcept override;
 		DirectX::XMMATRIX GetView() const noexcept override;
 		DirectX::BoundingFrustum GetFrustum() const noexcept override;
+		inline const GFX::Data::CBuffer::DynamicCBuffer& GetBufferPS() const noexcept override { return cameraBuffer->GetBufferConst(); }
 
 		void MoveZ(float dZ) noexcept override;
 		void Roll(float delta) noexcept override;
+		inline void Prepare() noexcept override { UpdateBufferPS(); }
 		void BindCamera(GFX::Graphics& gfx) const noexcept override;
 		bool Accept(GFX::Graphics& gfx, GFX::Probe::BaseProbe& probe) noexcept override;
 		void Submit(uint64_t channelFilter) noexcept override;
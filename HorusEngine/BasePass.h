@@ -24,10 +24,16 @@ namespace GFX::Pipeline::RenderPass::Base
 		constexpr const std::vector<std::unique_ptr<Sink>>& GetSinks() const noexcept { return sinks; }
 
 		virtual inline void Reset() noexcept {}
+		// CPU work run in graph order before any pass records commands, results can be used by following passes
+		virtual inline void Prepare(Graphics& gfx) {}
 		virtual inline std::vector<BasePass*> GetInnerPasses() { return {}; }
 		virtual inline BasePass& GetInnerPass(std::deque<std::string> nameChain) { throw RGC_EXCEPT("Pass \"" + name + "\" don't have inner pass named: " + nameChain.front()); }
 
 		virtual void Execute(Graphics& gfx) = 0;
+		// Parts pass can be recorded in when recording in parallel, valid after Prepare()
+		virtual inline size_t GetChunkCount() const noexcept { return 1; }
+		// Records single part into own command list, so every chunk has to bind state of pass again
+		virtual inline void ExecuteChunk(Graphics& gfx, size_t chunk) { Execute(gfx); }
 		virtual void Finalize();
 		void SetSinkLinkage(const std::string& registeredName, const std::string& targetName);
 		Sink& GetSink(const std::string& registeredName);
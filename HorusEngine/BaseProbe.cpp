@@ -1,6 +1,8 @@
 #include "BaseProbe.h"
 #include "BaseShape.h"
+#include "BasicObject.h"
 #include "Math.h"
+#include "GBufferEncoding.h"
 
 #define Tag(label) MakeTag(label).c_str()
 
@@ -32,6 +34,43 @@ namespace GFX::Probe
 		return dirty;
 	}
 
+	bool BaseProbe::VisitScale(float& scale) const noexcept
+	{
+		const bool dirty = ImGui::InputFloat(Tag("Scale"), &scale, 0.01f, 0.0f, "%.3f");
+		if (scale < 0.001f)
+			scale = 0.001f;
+		return dirty;
+	}
+
+	bool BaseProbe::VisitPosition(DirectX::XMFLOAT3& position) const noexcept
+	{
+		bool dirty = false;
+		ImGui::Columns(2, "##mesh_options", false);
+		ImGui::Text("Position");
+		ImGui::SetNextItemWidth(-15.0f);
+		dirty |= ImGui::InputFloat(Tag("X##position"), &position.x, 0.1f, 0.0f, "%.2f");
+		ImGui::SetNextItemWidth(-15.0f);
+		dirty |= ImGui::InputFloat(Tag("Y##position"), &position.y, 0.1f, 0.0f, "%.2f");
+		ImGui::SetNextItemWidth(-15.0f);
+		dirty |= ImGui::InputFloat(Tag("Z##position"), &position.z, 0.1f, 0.0f, "%.2f");
+		ImGui::NextColumn();
+		return dirty;
+	}
+
+	bool BaseProbe::VisitRotation(DirectX::XMFLOAT3& rotation) const noexcept
+	{
+		bool dirty = false;
+		ImGui::Text("Rotation");
+		ImGui::SetNextItemWidth(-15.0f);
+		dirty |= ImGui::SliderAngle(Tag("X##rotation"), &rotation.x, 0.0f, 360.0f, "%.2f");
+		ImGui::SetNextItemWidth(-15.0f);
+		dirty |= ImGui::SliderAngle(Tag("Y##rotation"), &rotation.y, 0.0f, 360.0f, "%.2f");
+		ImGui::SetNextItemWidth(-15.0f);
+		dirty |= ImGui::SliderAngle(Tag("Z##rotation"), &rotation.z, 0.0f, 360.0f, "%.2f");
+		ImGui::Columns(1);
+		return dirty;
+	}
+
 	bool BaseProbe::VisitObject(Data::CBuffer::DynamicCBuffer& buffer) const noexcept
 	{
 		bool dirty = false;
@@ -40,35 +79,32 @@ namespace GFX::Probe
 		//	dirty |= ImGui::DragFloat(Tag("Offset"), &offset, 0.001f, 0.001f, FLT_MAX, "%.3f");
 		//}
 		if (auto scale = buffer["scale"]; scale.Exists())
+			dirty |= VisitScale(static_cast<float&>(scale));
+		if (auto position = buffer["position"]; position.Exists())
+			dirty |= VisitPosition(static_cast<DirectX::XMFLOAT3&>(position));
+		if (auto angle = buffer["angle"]; angle.Exists())
+			dirty |= VisitRotation(static_cast<DirectX::XMFLOAT3&>(angle));
+		return dirty;
+	}
+
+	bool BaseProbe::VisitObject(BasicObject& object) const noexcept
+	{
+		bool dirty = false;
+		if (float scale = object.GetScale(); VisitScale(scale))
 		{
-			dirty |= ImGui::InputFloat(Tag("Scale"), &scale, 0.01f, 0.0f, "%.3f");
-			if (static_cast<float>(scale) < 0.001f)
-				scale = 0.001f;
+			object.SetScale(scale);
+			dirty = true;
 		}
-		if (auto position = buffer["position"]; position.Exists())
+		if (DirectX::XMFLOAT3 position = object.GetPos(); VisitPosition(position))
 		{
-			ImGui::Columns(2, "##mesh_options", false);
-			DirectX::XMFLOAT3& pos = static_cast<DirectX::XMFLOAT3&>(position);
-			ImGui::Text("Position");
-			ImGui::SetNextItemWidth(-15.0f);
-			dirty |= ImGui::InputFloat(Tag("X##position"), &pos.x, 0.1f, 0.0f, "%.2f");
-			ImGui::SetNextItemWidth(-15.0f);
-			dirty |= ImGui::InputFloat(Tag("Y##position"), &pos.y, 0.1f, 0.0f, "%.2f");
-			ImGui::SetNextItemWidth(-15.0f);
-			dirty |= ImGui::InputFloat(Tag("Z##position"), &pos.z, 0.1f, 0.0f, "%.2f");
-			ImGui::NextColumn();
+			object.SetPos(position);
+			dirty = true;
 		}
-		if (auto angle = buffer["angle"]; angle.Exists())
+		// Euler angles are only edited, object keeps quaternion
+		if (DirectX::XMFLOAT3 rotation = object.GetAngle(); VisitRotation(rotation))
 		{
-			DirectX::XMFLOAT3& rotation = static_cast<DirectX::XMFLOAT3&>(angle);
-			ImGui::Text("Rotation");
-			ImGui::SetNextItemWidth(-15.0f);
-			dirty |= ImGui::SliderAngle(Tag("X##rotation"), &rotation.x, 0.0f, 360.0f, "%.2f");
-			ImGui::SetNextItemWidth(-15.0f);
-			dirty |= ImGui::SliderAngle(Tag("Y##rotation"), &rotation.y, 0.0f, 360.0f, "%.2f");
-			ImGui::SetNextItemWidth(-15.0f);
-			dirty |= ImGui::SliderAngle(Tag("Z##rotation"), &rotation.z, 0.0f, 360.0f, "%.2f");
-			ImGui::Columns(1);
+			object.SetAngle(rotation);
+			dirty = true;
 		}
 		return dirty;
 	}
@@ -104,6 +140,9 @@ namespace GFX::Probe
 			dirty |= ImGui::InputFloat(Tag(compact ? "##spec_int" : "Specular intensity"), &intensity, 0.1f, 0.0f, "%.2f");
 			if (static_cast<float>(intensity) < 0.01f)
 				intensity = 0.01f;
+			// Brighter specular is clipped by G-buffer encoding
+			else if (static_cast<float>(intensity) > GBufferEncoding::SPECULAR_RANGE)
+				intensity = GBufferEncoding::SPECULAR_RANGE;
 			if (!compact)
 				ImGui::NextColumn();
 		}
@@ -5,6 +5,7 @@
 namespace GFX
 {
 	class Graphics;
+	class BasicObject;
 
 	namespace Pipeline
 	{
@@ -24,6 +25,10 @@ namespace GFX::Probe
 		bool compact = false;
 
 		inline std::string MakeTag(const std::string& label) const noexcept;
+		bool VisitScale(float& scale) const noexcept;
+		// Position opens columns closed by rotation
+		bool VisitPosition(DirectX::XMFLOAT3& position) const noexcept;
+		bool VisitRotation(DirectX::XMFLOAT3& rotation) const noexcept;
 
 	public:
 		BaseProbe() = default;
@@ -39,6 +44,7 @@ namespace GFX::Probe
 
 		bool Visit(Data::CBuffer::DynamicCBuffer& buffer) const noexcept;
 		bool VisitObject(Data::CBuffer::DynamicCBuffer& buffer) const noexcept;
+		bool VisitObject(BasicObject& object) const noexcept;
 		bool VisitMaterial(Data::CBuffer::DynamicCBuffer& buffer) const noexcept;
 		bool VisitLight(Data::CBuffer::DynamicCBuffer& buffer) const noexcept;
 		void VisitShape(Graphics& gfx, Shape::BaseShape& shape) const noexcept;
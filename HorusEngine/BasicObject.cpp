@@ -2,37 +2,39 @@
 
 namespace GFX
 {
-	inline Data::CBuffer::DCBLayout BasicObject::MakeLayout() noexcept
+	BasicObject::BasicObject(const DirectX::XMFLOAT3& position, const std::string& name, float scale) noexcept
+		: name(name)
 	{
-		static Data::CBuffer::DCBLayout layout;
-		static bool initNeeded = true;
-		if (initNeeded)
+		trs.position = position;
+		trs.scale = scale;
+	}
+
+	const DirectX::XMFLOAT3& BasicObject::GetAngle() const noexcept
+	{
+		if (!eulerValid)
 		{
-			layout.Add(DCBElementType::Float3, "position");
-			layout.Add(DCBElementType::Float, "scale");
-			layout.Add(DCBElementType::Float3, "angle");
-			initNeeded = false;
+			eulerAngle = TransformBatch::GetEulerAngles(trs.rotation);
+			eulerValid = true;
 		}
-		return layout;
+		return eulerAngle;
 	}
 
-	BasicObject::BasicObject(const DirectX::XMFLOAT3& position, const std::string& name, float scale) noexcept
-		: buffer(MakeLayout()), name(name)
+	void BasicObject::SetAngle(const DirectX::XMFLOAT3& meshAngle) noexcept
 	{
-		buffer["position"] = position;
-		buffer["angle"] = std::move(DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f));
-		buffer["scale"] = scale;
+		eulerAngle = meshAngle;
+		eulerValid = true;
+		DirectX::XMStoreFloat4(&trs.rotation, DirectX::XMQuaternionRollPitchYawFromVector(DirectX::XMLoadFloat3(&meshAngle)));
 	}
 
 	void BasicObject::UpdatePos(const DirectX::XMFLOAT3& delta) noexcept
 	{
-		DirectX::XMStoreFloat3(&buffer["position"], DirectX::XMVectorAdd(DirectX::XMLoadFloat3(&buffer["position"]), DirectX::XMLoadFloat3(&delta)));
+		DirectX::XMStoreFloat3(&trs.position, DirectX::XMVectorAdd(DirectX::XMLoadFloat3(&trs.position), DirectX::XMLoadFloat3(&delta)));
 	}
 
 	void BasicObject::UpdateAngle(const DirectX::XMFLOAT3& deltaAngle) noexcept
 	{
-		DirectX::XMStoreFloat3(&buffer["angle"],
-			DirectX::XMVectorModAngles(DirectX::XMVectorAdd(DirectX::XMLoadFloat3(&buffer["angle"]),
-				DirectX::XMLoadFloat3(&deltaAngle))));
+		DirectX::XMStoreFloat4(&trs.rotation, DirectX::XMQuaternionNormalize(DirectX::XMQuaternionMultiply(DirectX::XMLoadFloat4(&trs.rotation),
+			DirectX::XMQuaternionRollPitchYawFromVector(DirectX::XMLoadFloat3(&deltaAngle)))));
+		eulerValid = false;
 	}
 }
\ No newline at end of file
@@ -1,14 +1,16 @@
 #pragma once
 #include "IObject.h"
+#include "TransformBatch.h"
 
 namespace GFX
 {
 	class BasicObject : public IObject
 	{
-		static inline Data::CBuffer::DCBLayout MakeLayout() noexcept;
-
 	protected:
-		Data::CBuffer::DynamicCBuffer buffer;
+		TRS trs;
+		// Editor view of rotation, recomputed from quaternion when needed
+		mutable DirectX::XMFLOAT3 eulerAngle = { 0.0f, 0.0f, 0.0f };
+		mutable bool eulerValid = true;
 		std::string name = "";
 
 	public:
@@ -20,20 +22,23 @@ namespace GFX
 		BasicObject& operator=(const BasicObject&) = default;
 		virtual ~BasicObject() = default;
 
-		inline const DirectX::XMFLOAT3& GetAngle() const noexcept override { return buffer["angle"]; }
-		inline void SetAngle(const DirectX::XMFLOAT3& meshAngle) noexcept override { buffer["angle"] = meshAngle; }
+		constexpr const TRS& GetTRS() const noexcept { return trs; }
+
+		const DirectX::XMFLOAT3& GetAngle() const noexcept override;
+		void SetAngle(const DirectX::XMFLOAT3& meshAngle) noexcept override;
 
-		inline float GetScale() const noexcept override { return buffer["scale"]; }
-		inline void SetScale(float newScale) noexcept override { buffer["scale"] = newScale; }
+		inline float GetScale() const noexcept override { return trs.scale; }
+		inline void SetScale(float newScale) noexcept override { trs.scale = newScale; }
 
-		inline const DirectX::XMFLOAT3& GetPos() const noexcept override { return buffer["position"]; }
-		inline void SetPos(const DirectX::XMFLOAT3& position) noexcept override { buffer["position"] = position; }
+		inline const DirectX::XMFLOAT3& GetPos() const noexcept override { return trs.position; }
+		inline void SetPos(const DirectX::XMFLOAT3& position) noexcept override { trs.position = position; }
 
 		inline const std::string& GetName() const noexcept override { return name; }
 		inline void SetName(const std::string& newName) noexcept override { name = newName; }
 
-		inline bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override { return probe.VisitObject(buffer); }
+		inline bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override { return probe.VisitObject(*this); }
 		void UpdatePos(const DirectX::XMFLOAT3& delta) noexcept override;
+		// Rotation by given angles is applied after current orientation
 		void UpdateAngle(const DirectX::XMFLOAT3& deltaAngle) noexcept override;
 	};
 }
\ No newline at end of file
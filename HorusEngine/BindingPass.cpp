@@ -26,8 +26,21 @@ namespace GFX::Pipeline::RenderPass::Base
 	void BindingPass::BindAll(Graphics& gfx)
 	{
 		BindResources(gfx);
-		for (auto& bind : binds)
-			bind->Bind(gfx);
+		if (pipelineBindCount && GFX::Resource::PipelineState::Enabled())
+		{
+			// Created on first use since finalization have no access to Graphics
+			if (pipelineState == nullptr)
+				pipelineState = GFX::Resource::PipelineState::Get(gfx, binds);
+			for (auto& bind : resourceBinds)
+				bind->Bind(gfx);
+			pipelineState->Bind(gfx);
+		}
+		else
+		{
+			for (auto& bind : binds)
+				bind->Bind(gfx);
+			GFX::Resource::PipelineState::AddIssued(pipelineBindCount);
+		}
 	}
 
 	void BindingPass::Finalize()
@@ -35,5 +48,14 @@ namespace GFX::Pipeline::RenderPass::Base
 		if (renderTarget == nullptr && depthStencil == nullptr)
 			throw RGC_EXCEPT("BindingPass \"" + GetName() + "\" needs at least one RenderTarget or DepthStencil!");
 		BasePass::Finalize();
+		resourceBinds.clear();
+		pipelineBindCount = 0;
+		for (auto& bind : binds)
+		{
+			if (GFX::Resource::PipelineState::IsGroupable(*bind))
+				++pipelineBindCount;
+			else
+				resourceBinds.emplace_back(bind);
+		}
 	}
 }
\ No newline at end of file
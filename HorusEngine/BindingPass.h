@@ -1,6 +1,7 @@
 #pragma once
 #include "BasePass.h"
 #include "IRenderTarget.h"
+#include "PipelineState.h"
 
 namespace GFX::Pipeline::RenderPass::Base
 {
@@ -9,6 +10,10 @@ namespace GFX::Pipeline::RenderPass::Base
 		using BasePass::BasePass;
 
 		std::vector<GfxResPtr<GFX::Resource::IBindable>> binds;
+		// Binds that are not part of pipeline state, all others are grouped into single state bundle
+		std::vector<GfxResPtr<GFX::Resource::IBindable>> resourceBinds;
+		size_t pipelineBindCount = 0;
+		GfxResPtr<GFX::Resource::PipelineState> pipelineState;
 
 		void BindResources(Graphics& gfx);
 
@@ -19,7 +19,8 @@ namespace GFX::Resource
 		static inline ResPtr<Blender> Get(Graphics& gfx, Type type) { return Codex::Resolve<Blender>(gfx, type); }
 		static inline std::string GenerateRID(Type type) noexcept { return "B" + std::to_string(type); }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->OMSetBlendState(state.Get(), nullptr, 0xFFFFFFFFU); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->OMSetBlendState(state.Get(), nullptr, 0xFFFFFFFFU); GetBoundState(gfx, PipelineSlot::Blender) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::Blender; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(type); }
 	};
 
@@ -19,4 +19,11 @@ namespace GFX::Data
         box.Transform(transformed, transform);
         return frustum.Intersects(transformed);
     }
+
+    bool BoundingBox::Intersects(const DirectX::BoundingSphere& sphere, const DirectX::XMMATRIX& transform) const noexcept
+    {
+        DirectX::BoundingBox transformed;
+        box.Transform(transformed, transform);
+        return sphere.Intersects(transformed);
+    }
 }
\ No newline at end of file
@@ -24,7 +24,11 @@ namespace GFX::Data
 		constexpr DirectX::XMFLOAT3& GetPositive() noexcept { return box.Center; }
 		constexpr DirectX::XMFLOAT3& GetNegative() noexcept { return box.Extents; }
 
+		inline void GetCorners(DirectX::XMFLOAT3* corners) const noexcept { box.GetCorners(corners); }
+		inline DirectX::BoundingBox GetTransformed(const DirectX::XMMATRIX& transform) const noexcept { DirectX::BoundingBox transformed; box.Transform(transformed, transform); return transformed; }
+
 		void Finalize() noexcept;
 		bool Intersects(const DirectX::BoundingFrustum& frustum, const DirectX::XMMATRIX& transform) const noexcept;
+		bool Intersects(const DirectX::BoundingSphere& sphere, const DirectX::XMMATRIX& transform) const noexcept;
 	};
 }
\ No newline at end of file
@@ -13,7 +13,5 @@ namespace GFX::Shape
 		virtual ~Box() = default;
 
 		inline void SetTopologyMesh(Graphics& gfx) noexcept override { SetTopology(gfx, D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ); }
-
-		void UpdateTransformMatrix() noexcept override;
 	};
 }
\ No newline at end of file
@@ -3,40 +3,37 @@
 
 namespace Camera
 {
+	void CameraPool::ProcessMouseEvent(WinAPI::Window& window, const WinAPI::Mouse::Event& event) noexcept
+	{
+		if (event.IsRightDown() && window.IsCursorEnabled())
+			GetCamera().Rotate(rotateSpeed * static_cast<float>(event.GetDY()) / window.Gfx().GetHeight(),
+				rotateSpeed * static_cast<float>(event.GetDX()) / window.Gfx().GetWidth());
+		switch (event.GetType())
+		{
+		case WinAPI::Mouse::Event::Type::WheelForward:
+		{
+			if (!window.IsCursorEnabled() && moveSpeed <= MAX_MOVE_SPEED - 0.01f - FLT_EPSILON)
+				moveSpeed += 0.01f;
+			break;
+		}
+		case WinAPI::Mouse::Event::Type::WheelBackward:
+		{
+			if (!window.IsCursorEnabled() && moveSpeed >= 0.012f + FLT_EPSILON)
+				moveSpeed -= 0.01f;
+			break;
+		}
+		}
+	}
+
 	void CameraPool::ProcessInput(WinAPI::Window& window) noexcept
 	{
 		auto& camera = GetCamera();
-		while (window.Mouse().IsInput())
+		// All raw movement since last frame is applied as single rotation
+		if (auto delta = window.Mouse().ReadRawDelta())
 		{
-			if (auto opt = window.Mouse().Read())
-			{
-				const auto& value = opt.value();
-				if (value.IsRightDown() && window.IsCursorEnabled())
-					camera.Rotate(rotateSpeed * static_cast<float>(value.GetDY()) / window.Gfx().GetHeight(),
-						rotateSpeed * static_cast<float>(value.GetDX()) / window.Gfx().GetWidth());
-				switch (value.GetType())
-				{
-				case WinAPI::Mouse::Event::Type::WheelForward:
-				{
-					if (!window.IsCursorEnabled() && moveSpeed <= MAX_MOVE_SPEED - 0.01f - FLT_EPSILON)
-						moveSpeed += 0.01f;
-					break;
-				}
-				case WinAPI::Mouse::Event::Type::WheelBackward:
-				{
-					if (!window.IsCursorEnabled() && moveSpeed >= 0.012f + FLT_EPSILON)
-						moveSpeed -= 0.01f;
-					break;
-				}
-				case WinAPI::Mouse::Event::Type::RawMove:
-				{
-					if (!window.IsCursorEnabled())
-						camera.Rotate(rotateSpeed * static_cast<float>(value.GetDY()) / window.Gfx().GetHeight(),
-							rotateSpeed * static_cast<float>(value.GetDX()) / window.Gfx().GetWidth());
-					break;
-				}
-				}
-			}
+			if (!window.IsCursorEnabled() || window.Mouse().IsRightDown())
+				camera.Rotate(rotateSpeed * static_cast<float>(delta->dY) / window.Gfx().GetHeight(),
+					rotateSpeed * static_cast<float>(delta->dX) / window.Gfx().GetWidth());
 		}
 		if (window.Keyboard().IsKeyDown('W'))
 			camera.MoveZ(moveSpeed);
@@ -71,6 +68,8 @@ namespace Camera
 		if (name == active || cameras.size() == 1)
 			return false;
 		cameras.erase(name);
+		// Reported as change, frame submitted before can still reference removed camera
+		cameraChanged = true;
 		return true;
 	}
 
@@ -27,6 +27,8 @@ namespace Camera
 		inline void SetOutline() noexcept { cameras.at(active)->SetOutline(); }
 		inline void DisableOutline() noexcept { cameras.at(active)->DisableOutline(); }
 
+		// Mouse events are read by caller and passed here one by one, rest of input is read directly
+		void ProcessMouseEvent(WinAPI::Window& window, const WinAPI::Mouse::Event& event) noexcept;
 		void ProcessInput(WinAPI::Window& window) noexcept;
 		bool AddCamera(std::unique_ptr<ICamera> camera) noexcept;
 		bool DeleteCamera(const std::string& name) noexcept;
@@ -0,0 +1,36 @@
+#include "CameraSnapshot.h"
+
+namespace Camera
+{
+	CameraSnapshot::CameraSnapshot(GFX::Graphics& gfx, const std::string& name) : ICamera(name)
+	{
+		DirectX::XMStoreFloat4x4(&viewMatrix, DirectX::XMMatrixIdentity());
+		DirectX::XMStoreFloat4x4(&projectionMatrix, DirectX::XMMatrixIdentity());
+		positionBuffer = GFX::Resource::ConstBufferVertex<DirectX::XMFLOAT4>::Get(gfx, typeid(CameraSnapshot).name() + name, 1U);
+	}
+
+	void CameraSnapshot::Capture(GFX::Graphics& gfx, const ICamera& camera)
+	{
+		DirectX::XMStoreFloat4x4(&viewMatrix, camera.GetView());
+		DirectX::XMStoreFloat4x4(&projectionMatrix, camera.GetProjection());
+		frustum = camera.GetFrustum();
+		position = camera.GetPos();
+		// Layout is taken from first captured camera, all cameras share it
+		if (cameraBuffer)
+			cameraBuffer->GetBuffer().Copy(camera.GetBufferPS());
+		else
+			cameraBuffer = GFX::Resource::ConstBufferExPixelCache::Get(gfx, typeid(CameraSnapshot).name() + name, camera.GetBufferPS(), 2U);
+	}
+
+	void CameraSnapshot::BindCamera(GFX::Graphics& gfx) const noexcept
+	{
+		gfx.SetView(GetView());
+		gfx.SetProjection(GetProjection());
+	}
+
+	void CameraSnapshot::BindVS(GFX::Graphics& gfx)
+	{
+		positionBuffer->Update(gfx, { position.x, position.y, position.z, 0.0f });
+		positionBuffer->Bind(gfx);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "ICamera.h"
+#include "ConstBufferExCache.h"
+#include "ConstBufferVertex.h"
+
+namespace Camera
+{
+	// Camera state captured together with submitted jobs, so frame is drawn from place it was submitted from
+	// while live camera already moves for next frame. It is not part of scene, so it cannot be moved or submitted
+	class CameraSnapshot : public ICamera
+	{
+		DirectX::XMFLOAT4X4 viewMatrix;
+		DirectX::XMFLOAT4X4 projectionMatrix;
+		DirectX::BoundingFrustum frustum;
+		DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+		GfxResPtr<GFX::Resource::ConstBufferVertex<DirectX::XMFLOAT4>> positionBuffer;
+		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> cameraBuffer;
+
+	public:
+		CameraSnapshot(GFX::Graphics& gfx, const std::string& name);
+		CameraSnapshot(const CameraSnapshot&) = delete;
+		CameraSnapshot& operator=(const CameraSnapshot&) = delete;
+		virtual ~CameraSnapshot() = default;
+
+		// Source camera has to be prepared before
+		void Capture(GFX::Graphics& gfx, const ICamera& camera);
+
+		inline void SetPos(const DirectX::XMFLOAT3& pos) noexcept override {}
+		inline const DirectX::XMFLOAT3& GetPos() const noexcept override { return position; }
+		inline DirectX::XMMATRIX GetProjection() const noexcept override { return DirectX::XMLoadFloat4x4(&projectionMatrix); }
+		inline DirectX::XMMATRIX GetView() const noexcept override { return DirectX::XMLoadFloat4x4(&viewMatrix); }
+		inline DirectX::BoundingFrustum GetFrustum() const noexcept override { return frustum; }
+		inline const GFX::Data::CBuffer::DynamicCBuffer& GetBufferPS() const noexcept override { return cameraBuffer->GetBufferConst(); }
+
+		inline void MoveX(float dX) noexcept override {}
+		inline void MoveY(float dY) noexcept override {}
+		inline void MoveZ(float dZ) noexcept override {}
+		inline void Rotate(float angleDX, float angleDY) noexcept override {}
+		inline void Roll(float delta) noexcept override {}
+
+		inline void Prepare() noexcept override {}
+		void BindCamera(GFX::Graphics& gfx) const noexcept override;
+		void BindVS(GFX::Graphics& gfx) override;
+		inline void BindPS(GFX::Graphics& gfx) override { cameraBuffer->Bind(gfx); }
+
+		inline void SetOutline() noexcept override {}
+		inline void DisableOutline() noexcept override {}
+		inline bool Accept(GFX::Graphics& gfx, GFX::Probe::BaseProbe& probe) noexcept override { return false; }
+		inline void Submit(uint64_t channelFilter) noexcept override {}
+	};
+}
\ No newline at end of file
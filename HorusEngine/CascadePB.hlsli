@@ -0,0 +1,17 @@
+static const uint CB_MAX_CASCADES = 4;
+
+cbuffer CascadeBuffer : register(b1)
+{
+	matrix cb_cascadeViewProjection[CB_MAX_CASCADES];
+	float4 cb_cascadeLightPos[CB_MAX_CASCADES]; // XYZ - virtual light position, W - texel size in world units
+	float4 cb_cascadeSplits; // View space depth where every cascade ends
+	uint cb_cascadeCount;
+}
+
+// Position inside 2x2 atlas of cascades
+float2 GetCascadeUV(const in float3 position, const in uint cascade)
+{
+	const float4 shadowSpacePos = mul(float4(position, 1.0f), cb_cascadeViewProjection[cascade]);
+	const float2 uv = (shadowSpacePos.xy * float2(0.5f, -0.5f)) / shadowSpacePos.w + float2(0.5f, 0.5f);
+	return (uv + float2(cascade % 2, cascade / 2)) * 0.5f;
+}
\ No newline at end of file
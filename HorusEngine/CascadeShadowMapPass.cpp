@@ -0,0 +1,54 @@
+#include "CascadeShadowMapPass.h"
+#include "RenderPassesBase.h"
+#include "PipelineResources.h"
+#include "GfxResources.h"
+
+namespace GFX::Pipeline::RenderPass
+{
+	CascadeShadowMapPass::CascadeShadowMapPass(Graphics& gfx, const std::string& name, UINT mapSize)
+		: BindingPass(name), QueuePass(name), mapSize(mapSize), cascades(ShadowCascades::MAX_CASCADES, mapSize)
+	{
+		AddBindableSink<GFX::Resource::IBindable>("shadowBias");
+
+		renderTarget = GfxResPtr<Resource::RenderTargetShaderInput>(gfx, 2U * mapSize, 2U * mapSize, 7U,
+			DXGI_FORMAT::DXGI_FORMAT_R32_FLOAT).CastStatic<Resource::IRenderTarget>();
+		depthStencil = GfxResPtr<Resource::DepthStencil>(gfx, 2U * mapSize, 2U * mapSize, Resource::DepthStencil::Usage::DepthOnly);
+		RegisterSource(Base::SourceDirectBindable<Resource::IRenderTarget>::Make("shadowMap", renderTarget));
+
+		positionBuffer = GFX::Resource::ConstBufferPixel<DirectX::XMFLOAT4>::Get(gfx, "$shadowMapPass");
+		for (UINT i = 0; i < ShadowCascades::MAX_CASCADES; ++i)
+			viewports.at(i) = GFX::Resource::Viewport::Get(gfx, mapSize, mapSize, (i % 2U) * mapSize, (i / 2U) * mapSize);
+
+		AddBind(positionBuffer);
+		AddBind(GFX::Resource::DepthStencilState::Get(gfx, GFX::Resource::DepthStencilState::StencilMode::Off));
+		AddBind(GFX::Resource::Blender::Get(gfx, GFX::Resource::Blender::Type::None));
+		AddBind(GFX::Resource::Rasterizer::Get(gfx, D3D11_CULL_MODE::D3D11_CULL_BACK, false));
+		casterCounts.fill(0);
+	}
+
+	void CascadeShadowMapPass::Execute(Graphics& gfx)
+	{
+		assert(mainCamera);
+		assert(shadowSource);
+
+		const DirectX::XMFLOAT3& direction = shadowSource->GetBuffer()["direction"];
+		cascades.Update(mainCamera->GetView(), mainCamera->GetProjection(), direction);
+		mainCamera->BindVS(gfx);
+
+		renderTarget->Clear(gfx, { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX });
+		depthStencil->Clear(gfx);
+		DRAW_TAG_START(gfx, GetName());
+		BindAll(gfx);
+		for (uint32_t i = 0; i < cascades.GetCount(); ++i)
+		{
+			const auto& cascade = cascades.GetCascade(i);
+			viewports.at(i)->Bind(gfx);
+			positionBuffer->Update(gfx, { cascade.lightPos.x, cascade.lightPos.y, cascade.lightPos.z, 0.0f });
+			gfx.SetView(DirectX::XMLoadFloat4x4(&cascade.view));
+			gfx.SetProjection(DirectX::XMLoadFloat4x4(&cascade.projection));
+			// Only casters inside light volume of the slice can throw shadow onto it
+			casterCounts.at(i) += ExecuteInside(gfx, cascade.casterVolume);
+		}
+		DRAW_TAG_END(gfx);
+	}
+}
\ No newline at end of file
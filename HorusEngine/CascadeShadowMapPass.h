@@ -0,0 +1,36 @@
+#pragma once
+#include "QueuePass.h"
+#include "ILight.h"
+#include "ConstBufferVertex.h"
+#include "Viewport.h"
+#include "ShadowCascades.h"
+
+namespace GFX::Pipeline::RenderPass
+{
+	class CascadeShadowMapPass : public Base::QueuePass
+	{
+		UINT mapSize;
+		ShadowCascades cascades;
+		// Casters drawn into every cascade since last clear, summed over all lights
+		std::array<size_t, ShadowCascades::MAX_CASCADES> casterCounts;
+
+		Camera::ICamera* mainCamera = nullptr;
+		Light::ILight* shadowSource = nullptr;
+		GfxResPtr<GFX::Resource::ConstBufferPixel<DirectX::XMFLOAT4>> positionBuffer;
+		// Every cascade occupies one tile of 2x2 atlas
+		std::array<GfxResPtr<GFX::Resource::Viewport>, ShadowCascades::MAX_CASCADES> viewports;
+
+	public:
+		CascadeShadowMapPass(Graphics& gfx, const std::string& name, UINT mapSize);
+		virtual ~CascadeShadowMapPass() = default;
+
+		constexpr UINT GetMapSize() const noexcept { return mapSize; }
+		constexpr ShadowCascades& GetCascades() noexcept { return cascades; }
+		constexpr const std::array<size_t, ShadowCascades::MAX_CASCADES>& GetCasterCounts() const noexcept { return casterCounts; }
+		constexpr void BindCamera(Camera::ICamera& camera) noexcept { mainCamera = &camera; }
+		constexpr void BindLight(Light::ILight& light) noexcept { shadowSource = &light; }
+		inline void ClearCasterCounts() noexcept { casterCounts.fill(0); }
+
+		void Execute(Graphics& gfx) override;
+	};
+}
\ No newline at end of file
@@ -1,12 +1,15 @@
 #pragma once
 #include "ResPtr.h"
 #include <unordered_map>
+#include <mutex>
 
 namespace GFX::Resource
 {
+	// Resources can be resolved from multiple threads, creation itself is done outside of lock
 	class Codex
 	{
 		bool running = true;
+		mutable std::mutex mutex;
 		std::unordered_map<std::string, ResPtr<IBindable>> binds;
 
 		static inline Codex& Get() noexcept
@@ -15,7 +18,7 @@ namespace GFX::Resource
 			return codex;
 		}
 
-		inline void RemoveResource(const std::string& rid) noexcept { if (running) binds.erase(rid); }
+		inline void RemoveResource(const std::string& rid) noexcept;
 		template<typename T, typename ...Params>
 		inline bool CheckIfNotStored(Params&& ...p) const noexcept;
 		template<typename T, typename ...Params>
@@ -31,25 +34,49 @@ namespace GFX::Resource
 		template<typename T, typename ...Params>
 		static inline bool NotStored(Params&& ...p) noexcept { return Get().CheckIfNotStored<T>(std::forward<Params>(p)...); }
 		static inline void Remove(const std::string& rid) noexcept { Get().RemoveResource(rid); }
+		// Number of resources alive in codex
+		static inline size_t GetCount() noexcept { std::lock_guard<std::mutex> lock(Get().mutex); return Get().binds.size(); }
 	};
 
+	inline void Codex::RemoveResource(const std::string& rid) noexcept
+	{
+		if (running)
+		{
+			// Destroying resource can release other ones so it cannot happen under lock
+			decltype(binds)::node_type node;
+			std::lock_guard<std::mutex> lock(mutex);
+			// Other thread could take resource from codex again after its last outside owner was released
+			const auto it = binds.find(rid);
+			if (it != binds.end() && it->second.GetUseCount() == 1)
+				node = binds.extract(it);
+		}
+	}
+
 	template<typename T, typename ...Params>
 	inline bool Codex::CheckIfNotStored(Params&& ...p) const noexcept
 	{
-		return binds.end() == binds.find(IBindable::GenerateRID<T>(std::forward<Params>(p)...));
+		const std::string id = IBindable::GenerateRID<T>(std::forward<Params>(p)...);
+		std::lock_guard<std::mutex> lock(mutex);
+		return binds.end() == binds.find(id);
 	}
 
 	template<typename T, typename ...Params>
 	ResPtr<T> Codex::Find(Graphics& gfx, Params&& ...p) noexcept
 	{
 		const std::string id = IBindable::GenerateRID<T>(std::forward<Params>(p)...);
-		const auto it = binds.find(id);
-		if (it == binds.end())
 		{
-			ResPtr<T> bind(gfx, std::forward<Params>(p)...);
-			binds[id] = bind;
-			return std::move(bind);
+			std::lock_guard<std::mutex> lock(mutex);
+			const auto it = binds.find(id);
+			if (it != binds.end())
+				return std::move(it->second.CastDynamic<T>());
 		}
-		return std::move(it->second.CastDynamic<T>());
+		ResPtr<T> bind(gfx, std::forward<Params>(p)...);
+		std::lock_guard<std::mutex> lock(mutex);
+		// Other thread could create same resource in the meantime
+		const auto it = binds.find(id);
+		if (it != binds.end())
+			return std::move(it->second.CastDynamic<T>());
+		binds[id] = bind;
+		return std::move(bind);
 	}
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ namespace GFX::Resource
 	class ConstBufferExCache : public T
 	{
 		using ConstBufferEx::GetContext;
+		using ConstBufferEx::IsDeferred;
 		using ConstBufferEx::constantBuffer;
 		using ConstBufferEx::rootLayout;
 		using ConstBufferEx::name;
@@ -39,6 +40,7 @@ namespace GFX::Resource
 		static inline std::string GenerateRID(const std::string& tag,
 			const Data::CBuffer::DynamicCBuffer& buffer, UINT slot = 0U) noexcept;
 
+		// While passes record in parallel only buffers used by single pass can be changed
 		constexpr Data::CBuffer::DynamicCBuffer& GetBuffer() noexcept { dirty = true; return buffer; }
 		constexpr const Data::CBuffer::DynamicCBuffer& GetBufferConst() const noexcept { return buffer; }
 
@@ -113,7 +115,11 @@ namespace GFX::Resource
 	template<typename T>
 	inline void ConstBufferExCache<T>::Bind(Graphics& gfx)
 	{
-		if (dirty)
+		// Every command list uploads own copy and leaves dirty flag to immediate context,
+		// so passes recording in parallel only read cached data
+		if (IsDeferred(gfx))
+			ConstBufferEx::Update(gfx, buffer);
+		else if (dirty)
 		{
 			ConstBufferEx::Update(gfx, buffer);
 			dirty = false;
@@ -6,7 +6,9 @@ namespace GFX::Resource
 
 	Data::CBuffer::Transform ConstBufferTransform::GetBufferData(Graphics& gfx) noexcept
 	{
-		const DirectX::XMMATRIX transform = GetTransform();
+		// Object may be already moved for next frame, drawn job carries its own copy of world matrix
+		const DirectX::XMFLOAT4X4* drawTransform = gfx.GetDrawTransform();
+		const DirectX::XMMATRIX transform = drawTransform ? DirectX::XMLoadFloat4x4(drawTransform) : GetTransform();
 		return
 		{
 			std::move(DirectX::XMMatrixTranspose(transform)),
@@ -5,6 +5,8 @@
 
 namespace GFX
 {
+	thread_local uint64_t DXGIDebugInfoManager::offset = 0U;
+
 	DXGIDebugInfoManager::DXGIDebugInfoManager()
 	{
 		GFX_ENABLE_EXCEPT();
@@ -12,7 +12,8 @@ namespace GFX
 	// Manager to get info from DirectX Debug Layer
 	class DXGIDebugInfoManager
 	{
-		uint64_t offset = 0U;
+		// Every recording thread watches messages from its own starting point
+		static thread_local uint64_t offset;
 		Microsoft::WRL::ComPtr<IDXGIInfoQueue> infoQueue = nullptr;
 		Microsoft::WRL::ComPtr<IDXGIDebug> debug = nullptr;
 
@@ -19,7 +19,8 @@ namespace GFX::Resource
 		static inline GfxResPtr<DepthStencilState> Get(Graphics& gfx, StencilMode mode) { return Codex::Resolve<DepthStencilState>(gfx, mode); }
 		static inline std::string GenerateRID(StencilMode mode) noexcept { return "DSS" + std::to_string(mode); }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->OMSetDepthStencilState(state.Get(), 0xFF); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->OMSetDepthStencilState(state.Get(), 0xFF); GetBoundState(gfx, PipelineSlot::DepthStencil) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::DepthStencil; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(mode); }
 	};
 
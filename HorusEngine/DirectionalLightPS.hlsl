@@ -4,15 +4,40 @@
 #include "HDRGammaPB.hlsli"
 #include "CameraPB.hlsli"
 #include "BiasPB.hlsli"
-#include "ShadowSpacePB.hlsli"
+#include "CascadePB.hlsli"
+#include "RenderScalePB.hlsli"
 
 Texture2D colorTex    : register(t4); // RGB - color, A = 0.0f: solid; 0.5f: light source; 1.0f: normal
-Texture2D normalTex   : register(t5); // RG - normal
-Texture2D specularTex : register(t6); // RGB - color, A - power
+Texture2D normalTex   : register(t5); // RG - octahedral normal
+Texture2D specularTex : register(t6); // RGB - color, A - power (packed)
 
 Texture2D shadowMap : register(t7);
 Texture2D depthMap  : register(t8);
 
+// Picks first cascade containing pixel, near tile border next cascade is used so PCF do not sample neighbour tile
+float GetCascadeShadowLevel(const in float3 position, const in float viewDepth, const in float3 directionToLight)
+{
+	const float border = 1.0f / cb_mapSize;
+	[loop]
+	for (uint i = 0; i < cb_cascadeCount; ++i)
+	{
+		[branch]
+		if (viewDepth <= cb_cascadeSplits[i])
+		{
+			const float2 uv = GetCascadeUV(position, i);
+			const float2 tile = float2(i % 2, i / 2) * 0.5f;
+			[branch]
+			if (all(uv > tile + border) && all(uv < tile + 0.5f - border))
+			{
+				// Further cascades have bigger texels so they need bigger bias
+				const float lightDistance = length(position - cb_cascadeLightPos[i].xyz) - cb_cascadeLightPos[i].w;
+				return GetShadowLevel(normalize(cb_cameraPos - position), lightDistance, directionToLight, uv, splr_AB, shadowMap, 2.0f * cb_mapSize);
+			}
+		}
+	}
+	return 1.0f;
+}
+
 struct PSOut
 {
 	float4 color : SV_TARGET0;
@@ -24,24 +49,26 @@ PSOut main(float2 tc : TEXCOORD)
 	PSOut pso;
 	const float3 lightColor = DeleteGammaCorr(cb_lightColor) * cb_lightIntensity;
 
-	const float isSolid = colorTex.Sample(splr_PW, tc).a;
+	const float2 uv = tc * cb_renderScale;
+	const float isSolid = colorTex.Sample(splr_PW, uv).a;
 	[branch]
 	if (isSolid == 0.0f)
 	{
-		const float3 position = GetWorldPosition(tc, depthMap.Sample(splr_PW, tc).x, cb_inverseViewProjection);
+		const float depth = depthMap.Sample(splr_PW, uv).x;
+		const float3 position = GetWorldPosition(tc, depth, cb_inverseViewProjection);
 		const float3 shadowColor = DeleteGammaCorr(cb_shadowColor);
+		const float3 directionToLight = -cb_direction;
 
 		// Shadow test (cb_mapSize from BiasPB is bound implicitly from Shadow Mapping Pass since it has to be run always before Lighting Pass)
-		const float shadowLevel = 1.0f; // GetShadowLevel(normalize(cb_cameraPos - position), lightDistance, directionToLight, GetShadowUV(position), splr_AB, shadowMap, cb_mapSize);
+		const float shadowLevel = GetCascadeShadowLevel(position, GetLinearDepth(depth, cb_nearClip, cb_farClip), directionToLight);
 		if (shadowLevel != 0.0f)
 		{
-			const float3 normal = DecodeNormal(normalTex.Sample(splr_PW, tc).rg);
-			const float3 directionToLight = -cb_direction;
+			const float3 normal = DecodeNormal(normalTex.Sample(splr_PW, uv).rg);
 			pso.color = float4(lerp(shadowColor, GetDiffuse(lightColor, directionToLight, normal), shadowLevel), 0.0f);
 
 			if (shadowLevel > 0.98f)
 			{
-				const float4 specularData = specularTex.Sample(splr_PW, tc);
+				const float4 specularData = DecodeSpecular(specularTex.Sample(splr_PW, uv));
 				pso.specular = float4(GetSpecular(cb_cameraPos, directionToLight, position, normal,
 					pso.color.rgb * specularData.rgb, specularData.a), 0.0f);
 			}
@@ -11,7 +11,12 @@ namespace GFX::Pipeline::RenderPass
 		static bool initNeeded = true;
 		if (initNeeded)
 		{
-			layout.Add(DCBElementType::Matrix, "shadowViewProjection");
+			layout.Add(DCBElementType::Array, "cascadeViewProjection");
+			layout["cascadeViewProjection"].InitArray(DCBElementType::Matrix, ShadowCascades::MAX_CASCADES);
+			layout.Add(DCBElementType::Array, "cascadeLightPos");
+			layout["cascadeLightPos"].InitArray(DCBElementType::Float4, ShadowCascades::MAX_CASCADES);
+			layout.Add(DCBElementType::Float4, "cascadeSplits");
+			layout.Add(DCBElementType::UInteger, "cascadeCount");
 			initNeeded = false;
 		}
 		return layout;
@@ -19,7 +24,7 @@ namespace GFX::Pipeline::RenderPass
 
 	DirectionalLightingPass::DirectionalLightingPass(Graphics& gfx, const std::string& name, UINT mapSize)
 		: BindingPass(name), QueuePass(name), FullscreenPass(gfx, name),
-		shadowMapPass(gfx, "shadowMap", DirectX::XMMatrixOrthographicLH(static_cast<float>(mapSize), static_cast<float>(mapSize), 0.01f, 1000.0f))
+		shadowMapPass(gfx, "shadowMap", mapSize)
 	{
 		AddBindableSink<Resource::IRenderTarget>("shadowMap");
 		SetSinkLinkage("shadowMap", name + ".shadowMap.shadowMap");
@@ -31,7 +36,7 @@ namespace GFX::Pipeline::RenderPass
 		RegisterSink(Base::SinkDirectBuffer<Resource::IRenderTarget>::Make("lightBuffer", renderTarget));
 		RegisterSource(Base::SourceDirectBuffer<Resource::IRenderTarget>::Make("lightBuffer", renderTarget));
 
-		shadowBuffer = GFX::Resource::ConstBufferExPixelCache::Get(gfx, typeid(ShadowMapPass).name(), MakeLayout(), 1U);
+		shadowBuffer = GFX::Resource::ConstBufferExPixelCache::Get(gfx, typeid(CascadeShadowMapPass).name(), MakeLayout(), 1U);
 		AddBind(shadowBuffer);
 		AddBind(GFX::Resource::PixelShader::Get(gfx, "DirectionalLightPS"));
 		AddBind(GFX::Resource::Blender::Get(gfx, GFX::Resource::Blender::Type::Light));
@@ -55,12 +60,26 @@ namespace GFX::Pipeline::RenderPass
 		assert(mainCamera);
 		DRAW_TAG_START(gfx, GetName());
 		mainCamera->BindPS(gfx);
+		shadowMapPass.ClearCasterCounts();
 		for (auto& job : GetJobs())
 		{
 			DRAW_TAG_START(gfx, job.GetData().GetName());
-			//shadowMapPass.BindLight(dynamic_cast<Light::ILight&>(job.GetData()));
-			//shadowMapPass.Execute(gfx);
-			//DirectX::XMStoreFloat4x4(&shadowBuffer->GetBuffer()["shadowViewProjection"], DirectX::XMMatrixTranspose(gfx.GetView() * gfx.GetProjection()));
+			shadowMapPass.BindLight(dynamic_cast<Light::ILight&>(job.GetData()));
+			shadowMapPass.Execute(gfx);
+
+			auto& buffer = shadowBuffer->GetBuffer();
+			const ShadowCascades& cascades = shadowMapPass.GetCascades();
+			float splits[ShadowCascades::MAX_CASCADES] = { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX };
+			for (uint32_t i = 0; i < cascades.GetCount(); ++i)
+			{
+				const auto& cascade = cascades.GetCascade(i);
+				DirectX::XMStoreFloat4x4(&buffer["cascadeViewProjection"][i],
+					DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&cascade.view) * DirectX::XMLoadFloat4x4(&cascade.projection)));
+				buffer["cascadeLightPos"][i] = DirectX::XMFLOAT4(cascade.lightPos.x, cascade.lightPos.y, cascade.lightPos.z, cascade.texelSize);
+				splits[i] = cascade.splitFar;
+			}
+			buffer["cascadeSplits"] = DirectX::XMFLOAT4(splits[0], splits[1], splits[2], splits[3]);
+			buffer["cascadeCount"] = cascades.GetCount();
 			mainCamera->BindCamera(gfx);
 			BindAll(gfx);
 			job.Execute(gfx);
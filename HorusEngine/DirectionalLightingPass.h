@@ -1,12 +1,12 @@
 #pragma once
-#include "ShadowMapPass.h"
+#include "CascadeShadowMapPass.h"
 #include "FullscreenPass.h"
 
 namespace GFX::Pipeline::RenderPass
 {
 	class DirectionalLightingPass : public Base::QueuePass, public Base::FullscreenPass
 	{
-		ShadowMapPass shadowMapPass;
+		CascadeShadowMapPass shadowMapPass;
 		Camera::ICamera* mainCamera = nullptr;
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> shadowBuffer;
 
@@ -16,6 +16,7 @@ namespace GFX::Pipeline::RenderPass
 		DirectionalLightingPass(Graphics& gfx, const std::string& name, UINT mapSize);
 		virtual ~DirectionalLightingPass() = default;
 
+		constexpr CascadeShadowMapPass& GetShadowMapPass() noexcept { return shadowMapPass; }
 		constexpr void BindCamera(Camera::ICamera& camera) noexcept { mainCamera = &camera; shadowMapPass.BindCamera(camera); }
 		inline std::vector<Base::BasePass*> GetInnerPasses() override { return { &shadowMapPass }; }
 
@@ -19,7 +19,8 @@ namespace GFX::Resource
 		constexpr const std::string& GetName() const noexcept { return name; }
 		inline ID3DBlob* GetBytecode() const noexcept { return bytecode.Get(); }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->GSSetShader(geometryShader.Get(), nullptr, 0U); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->GSSetShader(geometryShader.Get(), nullptr, 0U); GetBoundState(gfx, PipelineSlot::GeometryShader) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::GeometryShader; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(name); }
 	};
 
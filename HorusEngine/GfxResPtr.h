@@ -7,10 +7,9 @@ namespace GFX::Resource
 	template<typename ...Params>
 	ResPtr<R>::ResPtr(Params && ...p)
 	{
-		uint8_t* memory = static_cast<uint8_t*>(::operator new(sizeof(R) + sizeof(uint64_t), ALIGNMENT));
+		uint8_t* memory = static_cast<uint8_t*>(::operator new(sizeof(R) + sizeof(std::atomic<uint64_t>), ALIGNMENT));
 		ptr = new(memory) R(std::forward<Params>(p)...);
-		count = (uint64_t*)(memory + sizeof(R));
-		*count = 1U;
+		count = new(memory + sizeof(R)) std::atomic<uint64_t>(1U);
 	}
 
 	template<typename R>
@@ -18,7 +17,16 @@ namespace GFX::Resource
 	{
 		if (count)
 		{
-			switch (--(*count))
+			// Owner that leaves codex as the only one removes resource from it,
+			// id is read while still owning it as other thread can release resource right after
+			std::string rid;
+			uint64_t current = count->load(std::memory_order_relaxed);
+			do
+			{
+				if (current == 2U && rid.empty())
+					rid = ptr->GetRID();
+			} while (!count->compare_exchange_weak(current, current - 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+			switch (current - 1)
 			{
 			case 0U:
 			{
@@ -29,7 +37,6 @@ namespace GFX::Resource
 			}
 			case 1U:
 			{
-				std::string rid = ptr->GetRID();
 				if (rid != IBindable::GetNoCodexRID())
 					Codex::Remove(rid);
 				break;
@@ -39,16 +46,16 @@ namespace GFX::Resource
 	}
 
 	template<typename R>
-	constexpr ResPtr<R>& ResPtr<R>::operator=(const ResPtr& rp) noexcept
+	ResPtr<R>& ResPtr<R>::operator=(const ResPtr& rp) noexcept
 	{
 		count = rp.count;
 		ptr = rp.ptr;
-		++(*count);
+		count->fetch_add(1, std::memory_order_relaxed);
 		return *this;
 	}
 
 	template<typename R>
-	constexpr ResPtr<R>& ResPtr<R>::operator=(ResPtr&& rp) noexcept
+	ResPtr<R>& ResPtr<R>::operator=(ResPtr&& rp) noexcept
 	{
 		count = rp.count;
 		ptr = rp.ptr;
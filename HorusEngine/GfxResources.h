@@ -17,9 +17,11 @@
 #include "InputLayout.h"
 #include "NullGeometryShader.h"
 #include "NullPixelShader.h"
+#include "PipelineState.h"
 #include "PixelShader.h"
 #include "Rasterizer.h"
 #include "Sampler.h"
+#include "ScissorRect.h"
 #include "ShadowRasterizer.h"
 #include "Texture.h"
 #include "TextureCube.h"
@@ -4,7 +4,9 @@
 
 namespace GFX
 {
-	Graphics::Graphics(HWND hWnd, unsigned int width, unsigned int height)
+	thread_local Graphics::Recorder* Graphics::threadRecorder = nullptr;
+
+	Graphics::Graphics(HWND hWnd, unsigned int width, unsigned int height, bool software)
 	{
 		GFX_ENABLE_EXCEPT();
 		DXGI_SWAP_CHAIN_DESC swapDesc = { 0 };
@@ -33,16 +35,26 @@ namespace GFX
 			D3D_FEATURE_LEVEL::D3D_FEATURE_LEVEL_11_1,
 			D3D_FEATURE_LEVEL::D3D_FEATURE_LEVEL_11_0,
 		};
-		GFX_THROW_FAILED(D3D11CreateDeviceAndSwapChain(nullptr, D3D_DRIVER_TYPE::D3D_DRIVER_TYPE_HARDWARE, nullptr,
-			createFlags, nullptr, 0, D3D11_SDK_VERSION, &swapDesc, &swapChain, &device, features, &context));
+		GFX_THROW_FAILED(D3D11CreateDeviceAndSwapChain(nullptr, software ? D3D_DRIVER_TYPE::D3D_DRIVER_TYPE_WARP : D3D_DRIVER_TYPE::D3D_DRIVER_TYPE_HARDWARE, nullptr,
+			createFlags, nullptr, 0, D3D11_SDK_VERSION, &swapDesc, &swapChain, &device, features, &immediate.context));
 
 		Microsoft::WRL::ComPtr<ID3D11Resource> backBuffer = nullptr;
 		GFX_THROW_FAILED(swapChain->GetBuffer(0, IID_PPV_ARGS(&backBuffer))); // Get texture subresource (back buffer)
 		renderTarget = GfxResPtr<Pipeline::Resource::RenderTarget>(*this, width, height, backBuffer, swapDesc.BufferDesc.Format); // Create view to back buffer allowing writing data
 #ifdef _DEBUG
-		GFX_THROW_FAILED(context->QueryInterface(IID_PPV_ARGS(&tagManager)));
+		GFX_THROW_FAILED(immediate.context->QueryInterface(IID_PPV_ARGS(&immediate.tagManager)));
 #endif
-		ImGui_ImplDX11_Init(device.Get(), context.Get());
+		D3D11_QUERY_DESC queryDesc = { 0 };
+		for (auto& query : frameQueries)
+		{
+			queryDesc.Query = D3D11_QUERY::D3D11_QUERY_TIMESTAMP_DISJOINT;
+			GFX_THROW_FAILED(device->CreateQuery(&queryDesc, &query.disjoint));
+			queryDesc.Query = D3D11_QUERY::D3D11_QUERY_TIMESTAMP;
+			GFX_THROW_FAILED(device->CreateQuery(&queryDesc, &query.begin));
+			GFX_THROW_FAILED(device->CreateQuery(&queryDesc, &query.end));
+		}
+		ImGui_ImplDX11_Init(device.Get(), immediate.context.Get());
+		presentTime = std::chrono::steady_clock::now();
 	}
 
 	Graphics::~Graphics()
@@ -56,9 +68,121 @@ namespace GFX
 #endif
 	}
 
+	void Graphics::Present()
+	{
+		HRESULT result;
+		GFX_SET_DEBUG_WATCH();
+		if (FAILED(result = swapChain->Present(1U, 0U)))
+		{
+			if (result == DXGI_ERROR_DEVICE_REMOVED)
+				throw GFX_DEV_REMOVED_EXCEPT(device->GetDeviceRemovedReason());
+			else
+				throw GFX_EXCEPT(result);
+		}
+		presentTime = std::chrono::steady_clock::now();
+	}
+
+	void Graphics::ResolveFrameQueries() noexcept
+	{
+		// Oldest query is the one that will be reused next, stop at first one that GPU has not reached yet
+		for (size_t i = 0; i < FRAME_QUERY_COUNT; ++i)
+		{
+			auto& query = frameQueries.at((currentQuery + i) % FRAME_QUERY_COUNT);
+			if (!query.pending)
+				continue;
+			D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+			UINT64 begin = 0, end = 0;
+			if (immediate.context->GetData(query.disjoint.Get(), &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK
+				|| immediate.context->GetData(query.begin.Get(), &begin, sizeof(begin), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK
+				|| immediate.context->GetData(query.end.Get(), &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+				break;
+			query.pending = false;
+			// Timestamps are not reliable when GPU clock changed during frame
+			if (!disjoint.Disjoint && disjoint.Frequency && end > begin)
+			{
+				gpuFrameTime = static_cast<float>(static_cast<double>(end - begin) * 1000.0 / static_cast<double>(disjoint.Frequency));
+				++gpuFrameCount;
+			}
+		}
+	}
+
+	void Graphics::CreateDeferredContexts(size_t count)
+	{
+		GFX_ENABLE_EXCEPT();
+		while (deferred.size() < count)
+		{
+			auto recorder = std::make_unique<Recorder>();
+			GFX_THROW_FAILED(device->CreateDeferredContext(0U, &recorder->context));
+#ifdef _DEBUG
+			GFX_THROW_FAILED(recorder->context->QueryInterface(IID_PPV_ARGS(&recorder->tagManager)));
+#endif
+			deferred.emplace_back(std::move(recorder));
+		}
+	}
+
+	void Graphics::BeginRecording(size_t index) noexcept
+	{
+		assert(index < deferred.size());
+		threadRecorder = deferred.at(index).get();
+		threadRecorder->states.fill(nullptr);
+		threadRecorder->projection = immediate.projection;
+		threadRecorder->view = immediate.view;
+	}
+
+	Microsoft::WRL::ComPtr<ID3D11CommandList> Graphics::EndRecording()
+	{
+		assert(threadRecorder);
+		GFX_ENABLE_EXCEPT();
+		Microsoft::WRL::ComPtr<ID3D11CommandList> commands = nullptr;
+		ID3D11DeviceContext* recordContext = threadRecorder->context.Get();
+		threadRecorder = nullptr;
+		GFX_THROW_FAILED(recordContext->FinishCommandList(FALSE, &commands));
+		return commands;
+	}
+
+	void Graphics::CancelRecording() noexcept
+	{
+		if (threadRecorder)
+		{
+			Microsoft::WRL::ComPtr<ID3D11CommandList> commands = nullptr;
+			threadRecorder->context->FinishCommandList(FALSE, &commands);
+			threadRecorder = nullptr;
+		}
+	}
+
+	void Graphics::ExecuteCommands(ID3D11CommandList* commands) noexcept
+	{
+		// State is not restored, every recording starts from defaults and binds everything it needs
+		immediate.context->ExecuteCommandList(commands, FALSE);
+		immediate.states.fill(nullptr);
+	}
+
 	void Graphics::DrawIndexed(UINT count) noexcept(!IS_DEBUG)
 	{
-		GFX_THROW_FAILED_INFO(context->DrawIndexed(count, 0U, 0U));
+		GFX_THROW_FAILED_INFO(GetRecorder().context->DrawIndexed(count, 0U, 0U));
+	}
+
+	void Graphics::ReadBackBuffer(std::vector<uint32_t>& texels)
+	{
+		GFX_ENABLE_EXCEPT();
+		Microsoft::WRL::ComPtr<ID3D11Texture2D> backBuffer = nullptr;
+		GFX_THROW_FAILED(swapChain->GetBuffer(0, IID_PPV_ARGS(&backBuffer)));
+		D3D11_TEXTURE2D_DESC desc;
+		backBuffer->GetDesc(&desc);
+		desc.Usage = D3D11_USAGE::D3D11_USAGE_STAGING;
+		desc.BindFlags = 0U;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_FLAG::D3D11_CPU_ACCESS_READ;
+		desc.MiscFlags = 0U;
+		Microsoft::WRL::ComPtr<ID3D11Texture2D> staging = nullptr;
+		GFX_THROW_FAILED(device->CreateTexture2D(&desc, nullptr, &staging));
+		immediate.context->CopyResource(staging.Get(), backBuffer.Get());
+
+		D3D11_MAPPED_SUBRESOURCE subres;
+		GFX_THROW_FAILED(immediate.context->Map(staging.Get(), 0U, D3D11_MAP::D3D11_MAP_READ, 0U, &subres));
+		texels.resize(static_cast<size_t>(desc.Width) * desc.Height);
+		for (UINT y = 0; y < desc.Height; ++y)
+			memcpy(texels.data() + static_cast<size_t>(y) * desc.Width, static_cast<const uint8_t*>(subres.pData) + static_cast<size_t>(y) * subres.RowPitch, desc.Width * sizeof(uint32_t));
+		immediate.context->Unmap(staging.Get(), 0U);
 	}
 
 	void Graphics::EndFrame()
@@ -70,23 +194,34 @@ namespace GFX
 			PushDrawTag("ImGui");
 #endif
 			ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData()); // Pass it to DirectX
+			immediate.states.fill(nullptr);
 #ifdef _DEBUG
 			PopDrawTag();
 #endif
 		}
-		HRESULT result;
-		GFX_SET_DEBUG_WATCH();
-		if (FAILED(result = swapChain->Present(1U, 0U)))
+		if (queryActive)
 		{
-			if (result == DXGI_ERROR_DEVICE_REMOVED)
-				throw GFX_DEV_REMOVED_EXCEPT(device->GetDeviceRemovedReason());
-			else
-				throw GFX_EXCEPT(result);
+			auto& query = frameQueries.at(currentQuery);
+			immediate.context->End(query.end.Get());
+			immediate.context->End(query.disjoint.Get());
+			query.pending = true;
+			queryActive = false;
+			currentQuery = (currentQuery + 1) % FRAME_QUERY_COUNT;
 		}
+		Present();
+		ResolveFrameQueries();
 	}
 
 	void Graphics::BeginFrame() noexcept
 	{
+		// When GPU is more frames behind than there are queries, frame is not timed
+		auto& query = frameQueries.at(currentQuery);
+		if (!query.pending)
+		{
+			immediate.context->Begin(query.disjoint.Get());
+			immediate.context->End(query.begin.Get());
+			queryActive = true;
+		}
 		if (guiEnabled)
 		{
 			ImGui_ImplDX11_NewFrame();
@@ -6,6 +6,8 @@
 #include "Utils.h"
 #include "ImGui/imgui_impl_dx11.h"
 #include <d3d11_1.h>
+#include <chrono>
+#include <array>
 
 namespace GFX
 {
@@ -13,30 +15,69 @@ namespace GFX
 	{
 		friend class Resource::IBindable;
 
+		// Destination of recorded commands with its camera state, immediate context or deferred one owned by worker thread
+		struct Recorder
+		{
+			DirectX::XMMATRIX projection;
+			DirectX::XMMATRIX view;
+			// World matrix captured by job being drawn, used instead of live transform of object
+			const DirectX::XMFLOAT4X4* drawTransform = nullptr;
+			Microsoft::WRL::ComPtr<ID3D11DeviceContext> context = nullptr;
+			// Last bindables that set pipeline state, cleared whenever context state is reset outside of them
+			std::array<const Resource::IBindable*, static_cast<size_t>(Resource::PipelineSlot::None)> states = {};
+#ifdef _DEBUG
+			Microsoft::WRL::ComPtr<ID3DUserDefinedAnnotation> tagManager = nullptr;
+#endif
+		};
+
+		// Timestamps around single frame, read back few frames later so CPU does not wait for GPU
+		struct FrameQuery
+		{
+			Microsoft::WRL::ComPtr<ID3D11Query> disjoint = nullptr;
+			Microsoft::WRL::ComPtr<ID3D11Query> begin = nullptr;
+			Microsoft::WRL::ComPtr<ID3D11Query> end = nullptr;
+			bool pending = false;
+		};
+
+		static constexpr size_t FRAME_QUERY_COUNT = 4;
+		static thread_local Recorder* threadRecorder;
+
 #ifdef _DEBUG
-		Microsoft::WRL::ComPtr<ID3DUserDefinedAnnotation> tagManager = nullptr;
 		DXGIDebugInfoManager debugInfoManager;
 #endif
 		GUI::GUIManager guiManager;
 		bool guiEnabled = true;
-		DirectX::XMMATRIX projection;
-		DirectX::XMMATRIX view;
 		Microsoft::WRL::ComPtr<ID3D11Device> device = nullptr; // Resources allocation
 		Microsoft::WRL::ComPtr<IDXGISwapChain> swapChain = nullptr; // Using pipeline: https://docs.microsoft.com/en-us/windows/win32/direct3d11/overviews-direct3d-11-graphics-pipeline
-		Microsoft::WRL::ComPtr<ID3D11DeviceContext> context = nullptr; // Configure pipeline
+		Recorder immediate; // Configure pipeline
+		std::vector<std::unique_ptr<Recorder>> deferred;
 		GfxResPtr<Pipeline::Resource::RenderTarget> renderTarget; // Back buffer from swap chain
+		std::chrono::steady_clock::time_point presentTime;
+		std::array<FrameQuery, FRAME_QUERY_COUNT> frameQueries;
+		size_t currentQuery = 0;
+		bool queryActive = false;
+		float gpuFrameTime = 0.0f;
+		uint64_t gpuFrameCount = 0;
+
+		void Present();
+		void ResolveFrameQueries() noexcept;
+
+		inline Recorder& GetRecorder() noexcept { return threadRecorder ? *threadRecorder : immediate; }
 
 	public:
-		Graphics(HWND hWnd, unsigned int width, unsigned int height);
+		// Software device runs on WARP rasterizer, slow but gives same image on every machine
+		Graphics(HWND hWnd, unsigned int width, unsigned int height, bool software = false);
 		Graphics(const Graphics&) = delete;
 		Graphics& operator=(const Graphics&) = delete;
 		~Graphics();
 
 		constexpr GUI::GUIManager& Gui() noexcept { return guiManager; }
-		constexpr const DirectX::XMMATRIX& GetProjection() const noexcept { return projection; }
-		constexpr void SetProjection(DirectX::XMMATRIX&& projectionMatrix) noexcept { projection = std::move(projectionMatrix); }
-		constexpr const DirectX::XMMATRIX& GetView() const noexcept { return view; }
-		constexpr void SetView(DirectX::XMMATRIX&& cameraMatrix) noexcept { view = std::move(cameraMatrix); }
+		inline const DirectX::XMMATRIX& GetProjection() noexcept { return GetRecorder().projection; }
+		inline void SetProjection(DirectX::XMMATRIX&& projectionMatrix) noexcept { GetRecorder().projection = std::move(projectionMatrix); }
+		inline const DirectX::XMMATRIX& GetView() noexcept { return GetRecorder().view; }
+		inline void SetView(DirectX::XMMATRIX&& cameraMatrix) noexcept { GetRecorder().view = std::move(cameraMatrix); }
+		inline const DirectX::XMFLOAT4X4* GetDrawTransform() noexcept { return GetRecorder().drawTransform; }
+		inline void SetDrawTransform(const DirectX::XMFLOAT4X4* transform) noexcept { GetRecorder().drawTransform = transform; }
 		constexpr void EnableGUI() noexcept { guiEnabled = true; }
 		constexpr void DisableGUI() noexcept { guiEnabled = false; }
 		constexpr void SwitchGUI() noexcept { guiEnabled = !guiEnabled; }
@@ -45,13 +86,28 @@ namespace GFX
 		constexpr unsigned int GetHeight() const noexcept { return renderTarget->GetHeight(); }
 		constexpr float GetRatio() { return static_cast<float>(GetWidth()) / GetHeight(); }
 		inline GfxResPtr<Pipeline::Resource::RenderTarget> GetBackBuffer() noexcept { return renderTarget; }
+		inline size_t GetDeferredCount() const noexcept { return deferred.size(); }
+		// Completion time of last finished present
+		constexpr std::chrono::steady_clock::time_point GetPresentTime() const noexcept { return presentTime; }
+		// GPU time in ms of last frame whose timestamps are available, count changes whenever new time arrives
+		constexpr float GetGpuFrameTime() const noexcept { return gpuFrameTime; }
+		constexpr uint64_t GetGpuFrameCount() const noexcept { return gpuFrameCount; }
 #ifdef _DEBUG
 		constexpr DXGIDebugInfoManager& GetInfoManager() noexcept { return debugInfoManager; }
-		inline void PushDrawTag(const std::string& tag) { tagManager->BeginEvent(Utils::ToUtf8(tag).c_str()); }
-		inline void PopDrawTag() { tagManager->EndEvent(); }
+		inline void PushDrawTag(const std::string& tag) { GetRecorder().tagManager->BeginEvent(Utils::ToUtf8(tag).c_str()); }
+		inline void PopDrawTag() { GetRecorder().tagManager->EndEvent(); }
 #endif
 
+		void CreateDeferredContexts(size_t count);
+		// Redirects commands issued by calling thread into deferred context, camera state is copied from immediate context
+		void BeginRecording(size_t index) noexcept;
+		Microsoft::WRL::ComPtr<ID3D11CommandList> EndRecording();
+		// Drops commands recorded by calling thread, used when recording fails
+		void CancelRecording() noexcept;
+		void ExecuteCommands(ID3D11CommandList* commands) noexcept;
 		void DrawIndexed(UINT count) noexcept(!IS_DEBUG);
+		// Waits for GPU and copies current back buffer as RGBA texels, used only for diagnostics
+		void ReadBackBuffer(std::vector<uint32_t>& texels);
 		void EndFrame();
 		void BeginFrame() noexcept;
 
@@ -1,11 +1,15 @@
 #include "SamplersPS.hlsli"
 #include "HDRGammaPB.hlsli"
+#include "RenderScalePB.hlsli"
 
 Texture2D tex : register(t0);
 
 float4 main(float2 tc : TEXCOORD) : SV_TARGET
 {
-	const float4 hdrColor = tex.Sample(splr_PW, tc);
+	// With dynamic resolution scene covers only part of texture and is upscaled bilinearly, edge texels are not blended with unused area
+	float2 size;
+	tex.GetDimensions(size.x, size.y);
+	const float4 hdrColor = tex.Sample(splr_LR, min(tc * cb_renderScale, cb_renderScale - 0.5f / size));
 	// Reinhard tone mapping (favor for bright areas)
 	// TODO: Implement http://cs.brown.edu/courses/cs129/results/proj5/njooma/ as HDR image processing (requires bilateral filter http://people.csail.mit.edu/sparis/bf_course/)
 	const float3 mapped = float3(1.0f, 1.0f, 1.0f) - exp(hdrColor.rgb * -cb_hdrExposure);
@@ -1,15 +1,47 @@
 #include "IBindable.h"
-#include "Graphics.h"
+#include "GfxExceptionMacros.h"
+#include "ShaderArchive.h"
+#include "Utils.h"
+#include <d3dcompiler.h>
 
 namespace GFX::Resource
 {
 	ID3D11DeviceContext* IBindable::GetContext(Graphics& gfx) noexcept
 	{
-		return gfx.context.Get();
+		return gfx.GetRecorder().context.Get();
 	}
 
 	ID3D11Device* IBindable::GetDevice(Graphics& gfx) noexcept
 	{
 		return gfx.device.Get();
 	}
+
+	bool IBindable::IsDeferred(Graphics& gfx) noexcept
+	{
+		return &gfx.GetRecorder() != &gfx.immediate;
+	}
+
+	const IBindable*& IBindable::GetBoundState(Graphics& gfx, PipelineSlot slot) noexcept
+	{
+		return gfx.GetRecorder().states.at(static_cast<size_t>(slot));
+	}
+
+	Microsoft::WRL::ComPtr<ID3DBlob> IBindable::LoadShader(Graphics& gfx, const std::string& name)
+	{
+		GFX_ENABLE_ALL(gfx);
+		Microsoft::WRL::ComPtr<ID3DBlob> bytecode;
+		std::optional<ShaderArchive::Bytecode> shader = {};
+		if (ShaderArchive::IsEnabled())
+			shader = ShaderArchive::Get().Find(name);
+		if (shader)
+		{
+			GFX_THROW_FAILED(D3DCreateBlob(shader->size, &bytecode));
+			memcpy(bytecode->GetBufferPointer(), shader->data, shader->size);
+		}
+		else
+		{
+			GFX_THROW_FAILED(D3DReadFileToBlob(Utils::ToUtf8(std::string(ShaderArchive::SHADER_DIRECTORY) + "\\" + name + ".cso").c_str(), &bytecode));
+		}
+		return bytecode;
+	}
 }
\ No newline at end of file
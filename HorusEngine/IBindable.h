@@ -14,6 +14,9 @@ namespace GFX::Resource
 		static constexpr bool generate{ false };
 	};
 
+	// Parts of pipeline state that can be grouped into single PipelineState, None for other bindables
+	enum class PipelineSlot : uint8_t { VertexShader, InputLayout, GeometryShader, PixelShader, Blender, Rasterizer, DepthStencil, Topology, None };
+
 	class IBindable : public Probe::IProbeable
 	{
 		static constexpr const char* NO_CODEX_RID = "?";
@@ -21,6 +24,12 @@ namespace GFX::Resource
 	protected:
 		static ID3D11DeviceContext* GetContext(Graphics& gfx) noexcept;
 		static ID3D11Device* GetDevice(Graphics& gfx) noexcept;
+		// Calling thread records into deferred context, which does not see dynamic resources uploaded outside of it
+		static bool IsDeferred(Graphics& gfx) noexcept;
+		// Compiled shader taken from shader archive, when not present there loaded from its .cso file
+		static Microsoft::WRL::ComPtr<ID3DBlob> LoadShader(Graphics& gfx, const std::string& name);
+		// Bindable that last set given part of pipeline state on current context, empty after context state is reset
+		static const IBindable*& GetBoundState(Graphics& gfx, PipelineSlot slot) noexcept;
 
 	public:
 		IBindable() = default;
@@ -37,6 +46,7 @@ namespace GFX::Resource
 		}
 
 		inline bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override { return false; }
+		virtual inline PipelineSlot GetPipelineSlot() const noexcept { return PipelineSlot::None; }
 
 		virtual std::string GetRID() const noexcept = 0;
 		virtual void Bind(Graphics& gfx) = 0;
@@ -22,6 +22,8 @@ namespace GFX::Pipeline::Resource
 
 		constexpr unsigned int GetWidth() const noexcept { return viewport->GetWidth(); }
 		constexpr unsigned int GetHeight() const noexcept { return viewport->GetHeight(); }
+		// Allows sharing single dynamic viewport between buffers
+		inline void SetViewport(const GfxResPtr<GFX::Resource::Viewport>& newViewport) noexcept { viewport = newViewport; }
 
 		virtual inline void Unbind(Graphics& gfx) noexcept { UnbindAll(gfx); }
 		virtual void Clear(Graphics& gfx) noexcept = 0;
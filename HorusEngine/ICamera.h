@@ -1,5 +1,6 @@
 #pragma once
 #include "IRenderable.h"
+#include "DynamicCBuffer.h"
 #include <DirectXCollision.h>
 
 namespace Camera
@@ -25,6 +26,8 @@ namespace Camera
 		virtual DirectX::XMMATRIX GetProjection() const noexcept = 0;
 		virtual DirectX::XMMATRIX GetView() const noexcept = 0;
 		virtual DirectX::BoundingFrustum GetFrustum() const noexcept = 0;
+		// Data of pixel shader buffer, valid after Prepare()
+		virtual const GFX::Data::CBuffer::DynamicCBuffer& GetBufferPS() const noexcept = 0;
 
 		virtual void MoveX(float dX) noexcept = 0;
 		virtual void MoveY(float dY) noexcept = 0;
@@ -33,6 +36,8 @@ namespace Camera
 		virtual void Rotate(float angleDX, float angleDY) noexcept = 0;
 		virtual void Roll(float delta) noexcept = 0;
 
+		// Resolves lazily computed matrices and shader data, after that camera is only read while passes record
+		virtual void Prepare() noexcept = 0;
 		virtual void BindCamera(GFX::Graphics& gfx) const noexcept = 0;
 		virtual void BindVS(GFX::Graphics& gfx) = 0;
 		virtual void BindPS(GFX::Graphics& gfx) = 0;
@@ -22,6 +22,7 @@ namespace GFX::Light
 		virtual ~ILight() = default;
 
 		inline const Data::CBuffer::DynamicCBuffer& GetBuffer() const noexcept { return lightBuffer->GetBufferConst(); }
+		inline float GetRange() const noexcept { return Volume::IVolume::GetVolume(lightBuffer->GetBufferConst()); }
 
 		inline const Data::BoundingBox& GetBoundingBox() const noexcept override { return Data::BoundingBox::GetEmpty(); }
 		inline UINT GetIndexCount() const noexcept override { return volume->GetIndexCount(); }
@@ -13,5 +13,6 @@ namespace GFX::Shape
 
 		inline const std::string& GetName() const noexcept { return name; }
 		inline bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override { return Object::Accept(gfx, probe) || BaseShape::Accept(gfx, probe); }
+		inline void Submit(uint64_t channelFilter) noexcept override { ResolveTransform(); BaseShape::Submit(channelFilter); }
 	};
 }
\ No newline at end of file
@@ -24,6 +24,8 @@ namespace GFX::Visual
 		inline DirectX::XMMATRIX GetTransform() const noexcept { return transformBuffer->GetTransform(); }
 		virtual inline void SetTransformBuffer(Graphics& gfx, const GfxObject& parent) { transformBuffer = GfxResPtr<Resource::ConstBufferTransform>(gfx, parent); }
 		virtual inline void Bind(Graphics& gfx, RenderChannel mode) { Bind(gfx); }
+		// Projected size in pixels of object using this visual, drives texture streaming
+		virtual inline void ReportScreenSize(float screenSize) noexcept {}
 
 		template<typename R>
 		R* GetResource() noexcept;
@@ -9,8 +9,6 @@ namespace GFX::Light::Volume
 	{
 		GfxResPtr<Resource::ConstBufferTransform> transformBuffer;
 
-		static float GetVolume(const Data::CBuffer::DynamicCBuffer& lightBuffer);
-
 	protected:
 		GfxResPtr<Resource::IndexBuffer> indexBuffer;
 		GfxResPtr<Resource::VertexBuffer> vertexBuffer;
@@ -22,6 +20,9 @@ namespace GFX::Light::Volume
 	public:
 		virtual ~IVolume() = default;
 
+		// Range of visible light influence
+		static float GetVolume(const Data::CBuffer::DynamicCBuffer& lightBuffer);
+
 		inline UINT GetIndexCount() const noexcept { return indexBuffer->GetCount(); }
 
 		void Update(const Data::CBuffer::DynamicCBuffer& lightBuffer) noexcept;
@@ -17,7 +17,8 @@ namespace GFX::Resource
 		static inline GfxResPtr<InputLayout> Get(Graphics& gfx, std::shared_ptr<Data::VertexLayout> vertexLayout, const GfxResPtr<VertexShader>& shader);
 		static inline std::string GenerateRID(std::shared_ptr<Data::VertexLayout> vertexLayout, const GfxResPtr<VertexShader>& shader) noexcept;
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->IASetInputLayout(inputLayout.Get()); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->IASetInputLayout(inputLayout.Get()); GetBoundState(gfx, PipelineSlot::InputLayout) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::InputLayout; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(vertexLayout, shader); }
 	};
 
@@ -3,15 +3,22 @@
 
 namespace GFX::Pipeline
 {
-	bool Job::IsInsideFrustum(const DirectX::BoundingFrustum& volume) const noexcept
+	Job::Job(JobData* data, TechniqueStep* step) noexcept
+		: position(step->GetTransformPos()), bvhProxy(data->GetSceneProxy()), box(&data->GetBoundingBox()),
+		occluder(data->GetOccluder()), data(data), step(step)
 	{
-		return data->GetBoundingBox().Intersects(volume, step->GetTransform());
+		const DirectX::XMMATRIX world = step->GetTransform();
+		DirectX::XMStoreFloat4x4(&transform, world);
+		worldBox = box->GetTransformed(world);
 	}
 
 	void Job::Execute(Graphics& gfx, RenderChannel mode)
 	{
 		data->Bind(gfx);
+		// Transform buffer of visual is filled from matrix captured at submission
+		gfx.SetDrawTransform(&transform);
 		step->Bind(gfx, mode);
+		gfx.SetDrawTransform(nullptr);
 		gfx.DrawIndexed(data->GetIndexCount());
 	}
 }
\ No newline at end of file
@@ -1,25 +1,55 @@
 #pragma once
 #include "Graphics.h"
 #include "RenderChannels.h"
-#include <DirectXCollision.h>
+#include "BoundingBox.h"
+#include "OccluderGeometry.h"
+#include "BVH.h"
 
 namespace GFX::Pipeline
 {
+	// Render proxy of single draw, state needed by culling and sorting is gathered once at submission
+	// so passes can process their queues linearly without going through visuals.
 	class Job
 	{
-		class JobData* data = nullptr;
-		class TechniqueStep* step = nullptr;
+		DirectX::XMFLOAT4X4 transform;
+		DirectX::BoundingBox worldBox;
+		DirectX::XMFLOAT3 position;
+		uint32_t bvhProxy;
+		const Data::BoundingBox* box;
+		const Data::OccluderGeometry* occluder;
+		class JobData* data;
+		class TechniqueStep* step;
 
 	public:
-		constexpr Job(class JobData* data, class TechniqueStep* step) noexcept : data(data), step(step) {}
+		Job(class JobData* data, class TechniqueStep* step) noexcept;
 		Job(const Job&) = default;
 		Job& operator=(const Job&) = default;
 		~Job() = default;
 
 		constexpr class JobData& GetData() noexcept { return *data; }
 		constexpr const class TechniqueStep& GetStep() const noexcept { return *step; }
+		constexpr const DirectX::BoundingBox& GetWorldBox() const noexcept { return worldBox; }
+		constexpr const DirectX::XMFLOAT3& GetPosition() const noexcept { return position; }
+		constexpr const Data::BoundingBox& GetBoundingBox() const noexcept { return *box; }
+		constexpr const Data::OccluderGeometry* GetOccluder() const noexcept { return occluder; }
+		constexpr const DirectX::XMFLOAT4X4& GetTransformFloat4x4() const noexcept { return transform; }
+		inline DirectX::XMMATRIX GetTransform() const noexcept { return DirectX::XMLoadFloat4x4(&transform); }
+
+		// When stamp is non zero objects from scene hierarchy are checked against result of last query
+		inline bool IsInsideFrustum(const DirectX::BoundingFrustum& volume, const BVH* bvh, uint64_t stamp = 0) const noexcept
+		{
+			if (stamp && bvhProxy != BVH::INVALID_INDEX)
+				return bvh->IsMarked(bvhProxy, stamp);
+			return volume.Intersects(worldBox);
+		}
+		template<typename Volume>
+		inline bool IsInsideVolume(const Volume& volume, const BVH* bvh, uint64_t stamp = 0) const noexcept
+		{
+			if (stamp && bvhProxy != BVH::INVALID_INDEX)
+				return bvh->IsMarked(bvhProxy, stamp);
+			return volume.Intersects(worldBox);
+		}
 
-		bool IsInsideFrustum(const DirectX::BoundingFrustum& volume) const noexcept;
 		void Execute(Graphics& gfx, RenderChannel mode = RenderChannel::All);
 	};
 }
\ No newline at end of file
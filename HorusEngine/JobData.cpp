@@ -2,6 +2,17 @@
 
 namespace GFX::Pipeline
 {
+	void JobData::UpdateSceneBVH(const DirectX::BoundingBox& worldBox) noexcept
+	{
+		if (sceneBVH)
+		{
+			if (IsInSceneBVH())
+				sceneBVH->Update(bvhProxy, worldBox);
+			else
+				bvhProxy = sceneBVH->Insert(worldBox, this);
+		}
+	}
+
 	void JobData::SetTechniques(Graphics& gfx, std::vector<Technique>&& newTechniques, const GfxObject& parent) noexcept
 	{
 		techniques = std::move(newTechniques);
@@ -9,6 +20,25 @@ namespace GFX::Pipeline
 			technique.SetParentReference(gfx, parent);
 	}
 
+	JobData& JobData::operator=(JobData&& data) noexcept
+	{
+		techniques = std::move(data.techniques);
+		if (IsInSceneBVH())
+			sceneBVH->Remove(bvhProxy);
+		sceneBVH = data.sceneBVH;
+		bvhProxy = data.bvhProxy;
+		data.bvhProxy = BVH::INVALID_INDEX;
+		if (IsInSceneBVH())
+			sceneBVH->SetData(bvhProxy, this);
+		return *this;
+	}
+
+	JobData::~JobData()
+	{
+		if (IsInSceneBVH())
+			sceneBVH->Remove(bvhProxy);
+	}
+
 	Technique* JobData::GetTechnique(const std::string& name) noexcept
 	{
 		for (auto& technique : techniques)
@@ -2,14 +2,22 @@
 #include "IRenderable.h"
 #include "Technique.h"
 #include "BoundingBox.h"
+#include "OccluderGeometry.h"
+#include "BVH.h"
 
 namespace GFX::Pipeline
 {
 	class JobData : public virtual IRenderable
 	{
+		BVH* sceneBVH = nullptr;
+		uint32_t bvhProxy = BVH::INVALID_INDEX;
+
 	protected:
 		std::vector<Technique> techniques;
 
+		// Inserts or moves object inside scene hierarchy
+		void UpdateSceneBVH(const DirectX::BoundingBox& worldBox) noexcept;
+
 		inline void AddTechnique(Graphics& gfx, Technique&& technique) noexcept { techniques.emplace_back(std::forward<Technique&&>(technique)); }
 
 		void SetTechniques(Graphics& gfx, std::vector<Technique>&& newTechniques, const GfxObject& parent) noexcept;
@@ -17,12 +25,18 @@ namespace GFX::Pipeline
 	public:
 		JobData() = default;
 		inline JobData(JobData&& data) noexcept { *this = std::forward<JobData&&>(data); }
-		inline JobData& operator=(JobData&& data) noexcept { techniques = std::move(data.techniques); return *this; }
-		virtual ~JobData() = default;
+		JobData& operator=(JobData&& data) noexcept;
+		virtual ~JobData();
+
+		constexpr void SetSceneBVH(BVH& bvh) noexcept { sceneBVH = &bvh; }
+		constexpr bool IsInSceneBVH() const noexcept { return bvhProxy != BVH::INVALID_INDEX; }
+		constexpr uint32_t GetSceneProxy() const noexcept { return bvhProxy; }
+		inline bool IsMarked(uint64_t stamp) const noexcept { return IsInSceneBVH() && sceneBVH->IsMarked(bvhProxy, stamp); }
 
 		virtual const std::string& GetName() const noexcept = 0;
 		virtual const Data::BoundingBox& GetBoundingBox() const noexcept = 0;
 		virtual UINT GetIndexCount() const noexcept = 0;
+		virtual const Data::OccluderGeometry* GetOccluder() const noexcept { return nullptr; }
 		virtual void Bind(Graphics& gfx) = 0;
 
 		Technique* GetTechnique(const std::string& name) noexcept;
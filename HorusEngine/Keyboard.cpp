@@ -2,31 +2,27 @@
 
 namespace WinAPI
 {
-	template<typename T>
-	void Keyboard::TrimBuffer(std::deque<T>& buffer) noexcept
+	void Keyboard::ClearStates() noexcept
 	{
-		while (buffer.size() > BUFFER_SIZE)
-			buffer.pop_back();
+		for (auto& state : keystates)
+			state.store(0, std::memory_order_relaxed);
 	}
 
 	void Keyboard::OnKeyDown(unsigned char keycode) noexcept
 	{
-		keystates[keycode] = true;
-		keybuffer.emplace_back(Keyboard::Event::Type::Down, keycode);
-		TrimBuffer(keybuffer);
+		keystates[keycode / STATE_WORD_BITS].fetch_or(1ULL << (keycode % STATE_WORD_BITS), std::memory_order_relaxed);
+		keybuffer.Push({ Keyboard::Event::Type::Down, keycode });
 	}
 
 	void Keyboard::OnKeyUp(unsigned char keycode) noexcept
 	{
-		keystates[keycode] = false;
-		keybuffer.emplace_back(Keyboard::Event::Type::Up, keycode);
-		TrimBuffer(keybuffer);
+		keystates[keycode / STATE_WORD_BITS].fetch_and(~(1ULL << (keycode % STATE_WORD_BITS)), std::memory_order_relaxed);
+		keybuffer.Push({ Keyboard::Event::Type::Up, keycode });
 	}
 
 	void Keyboard::OnChar(char character) noexcept
 	{
-		charbuffer.emplace_back(character);
-		TrimBuffer(charbuffer);
+		charbuffer.Push(character);
 	}
 
 	void Keyboard::Flush() noexcept
@@ -34,26 +30,4 @@ namespace WinAPI
 		FlushKeys();
 		FlushChars();
 	}
-
-	std::optional<Keyboard::Event> Keyboard::ReadKey() noexcept
-	{
-		if (keybuffer.size() > 0)
-		{
-			Keyboard::Event e = keybuffer.front();
-			keybuffer.pop_front();
-			return e;
-		}
-		return {};
-	}
-
-	std::optional<char> Keyboard::ReadChar() noexcept
-	{
-		if (charbuffer.size() > 0)
-		{
-			char charcode = charbuffer.front();
-			charbuffer.pop_front();
-			return charcode;
-		}
-		return {};
-	}
 }
\ No newline at end of file
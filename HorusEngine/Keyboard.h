@@ -1,10 +1,10 @@
 #pragma once
-#include <bitset>
-#include <deque>
-#include <optional>
+#include "RingBuffer.h"
+#include <chrono>
 
 namespace WinAPI
 {
+	// Events are written by window procedure and can be read from other thread
 	class Keyboard
 	{
 		friend class Window;
@@ -16,11 +16,13 @@ namespace WinAPI
 			enum class Type : bool { Down, Up };
 
 		private:
-			Type type;
-			unsigned char code;
+			Type type = Type::Up;
+			unsigned char code = 0;
+			std::chrono::steady_clock::time_point time;
 
 		public:
-			constexpr Event(Type type, unsigned char code) noexcept : type(type), code(code) {}
+			Event() = default;
+			inline Event(Type type, unsigned char code) noexcept : type(type), code(code), time(std::chrono::steady_clock::now()) {}
 			Event(const Event&) = default;
 			Event& operator=(const Event&) = default;
 			~Event() = default;
@@ -28,22 +30,20 @@ namespace WinAPI
 			constexpr bool IsDown() const noexcept { return type == Type::Down; }
 			constexpr bool IsUp() const noexcept { return type == Type::Up; }
 			constexpr unsigned char GetCode() const noexcept { return code; }
+			constexpr std::chrono::steady_clock::time_point GetTime() const noexcept { return time; }
 		};
 
 	private:
 		static constexpr size_t NUMBER_OF_VKEYS = 256U;
+		static constexpr size_t STATE_WORD_BITS = 64U;
 		static constexpr size_t BUFFER_SIZE = 32U;
 
-		bool autorepeatEnabled = false; // Accounting long key press
-		std::bitset<NUMBER_OF_VKEYS> keystates; // States for all virtual keys from WinAPI
-		std::deque<Event> keybuffer; // Buffer for KEY_UP/DOWN events
-		std::deque<char> charbuffer; // Buffer for ON_CHAR events
-
-		inline void ClearStates() noexcept { keystates.reset(); }
-
-		template<typename T>
-		static void TrimBuffer(std::deque<T>& buffer) noexcept;
+		std::atomic_bool autorepeatEnabled = false; // Accounting long key press
+		std::atomic_uint64_t keystates[NUMBER_OF_VKEYS / STATE_WORD_BITS] = {}; // States for all virtual keys from WinAPI
+		Utils::RingBuffer<Event, BUFFER_SIZE> keybuffer; // Buffer for KEY_UP/DOWN events
+		Utils::RingBuffer<char, BUFFER_SIZE> charbuffer; // Buffer for ON_CHAR events
 
+		void ClearStates() noexcept;
 		void OnKeyDown(unsigned char keycode) noexcept;
 		void OnKeyUp(unsigned char keycode) noexcept;
 		void OnChar(char character) noexcept;
@@ -54,18 +54,18 @@ namespace WinAPI
 		Keyboard& operator=(const Keyboard&) = delete;
 		~Keyboard() = default;
 
-		constexpr bool IsAutorepeat() const noexcept { return autorepeatEnabled; }
-		constexpr void SetAutorepeat(bool mode) noexcept { autorepeatEnabled = mode; }
+		inline bool IsAutorepeat() const noexcept { return autorepeatEnabled.load(std::memory_order_relaxed); }
+		inline void SetAutorepeat(bool mode) noexcept { autorepeatEnabled.store(mode, std::memory_order_relaxed); }
 
-		constexpr bool IsKeyDown(unsigned char keycode) const noexcept { return keystates[keycode]; }
-		inline bool IsKeyReady() const noexcept { return keybuffer.size(); }
-		inline bool IsCharReady() const noexcept { return charbuffer.size(); }
-		inline void FlushKeys() noexcept { keybuffer = std::deque<Event>(); }
-		inline void FlushChars() noexcept { charbuffer = std::deque<char>(); }
+		inline bool IsKeyDown(unsigned char keycode) const noexcept { return keystates[keycode / STATE_WORD_BITS].load(std::memory_order_relaxed) & (1ULL << (keycode % STATE_WORD_BITS)); }
+		inline bool IsKeyReady() const noexcept { return !keybuffer.IsEmpty(); }
+		inline bool IsCharReady() const noexcept { return !charbuffer.IsEmpty(); }
+		inline void FlushKeys() noexcept { keybuffer.Clear(); }
+		inline void FlushChars() noexcept { charbuffer.Clear(); }
 
 		void Flush() noexcept;
 
-		std::optional<Event> ReadKey() noexcept;
-		std::optional<char> ReadChar() noexcept;
+		inline std::optional<Event> ReadKey() noexcept { return keybuffer.Pop(); }
+		inline std::optional<char> ReadChar() noexcept { return charbuffer.Pop(); }
 	};
 }
\ No newline at end of file
@@ -18,15 +18,29 @@ namespace GFX::Pipeline::RenderPass
 		AddBind(GFX::Resource::DepthStencilState::Get(gfx, GFX::Resource::DepthStencilState::StencilMode::Off));
 		AddBind(GFX::Resource::Rasterizer::Get(gfx, D3D11_CULL_BACK));
 		AddBind(GFX::Resource::Blender::Get(gfx, GFX::Resource::Blender::Type::None)); // Maybe other for transluscent objects and if so then add in material
+		SetChunkJobs(CHUNK_JOBS);
 	}
 
-	void LambertianClassicPass::Execute(Graphics& gfx)
+	void LambertianClassicPass::Prepare(Graphics& gfx)
 	{
 		assert(mainCamera);
 		CullFrustum(*mainCamera);
+		ReportScreenSize(*mainCamera, static_cast<float>(gfx.GetHeight()));
 		// For transparent surfaces
 		SortBackFront(mainCamera->GetPos());
+	}
+
+	void LambertianClassicPass::Execute(Graphics& gfx)
+	{
+		assert(mainCamera);
 		mainCamera->BindCamera(gfx);
 		QueuePass::Execute(gfx);
 	}
+
+	void LambertianClassicPass::ExecuteChunk(Graphics& gfx, size_t chunk)
+	{
+		assert(mainCamera);
+		mainCamera->BindCamera(gfx);
+		QueuePass::ExecuteChunk(gfx, chunk);
+	}
 }
\ No newline at end of file
@@ -5,6 +5,9 @@ namespace GFX::Pipeline::RenderPass
 {
 	class LambertianClassicPass : public Base::QueuePass
 	{
+		// Large enough that binding pass again is small part of every recording
+		static constexpr size_t CHUNK_JOBS = 256;
+
 		Camera::ICamera* mainCamera = nullptr;
 
 	public:
@@ -13,6 +16,8 @@ namespace GFX::Pipeline::RenderPass
 
 		constexpr void BindCamera(Camera::ICamera& camera) noexcept { mainCamera = &camera; }
 
+		void Prepare(Graphics& gfx) override;
 		void Execute(Graphics& gfx) override;
+		void ExecuteChunk(Graphics& gfx, size_t chunk) override;
 	};
 }
\ No newline at end of file
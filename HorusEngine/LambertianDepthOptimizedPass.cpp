@@ -7,7 +7,8 @@
 namespace GFX::Pipeline::RenderPass
 {
 	LambertianDepthOptimizedPass::LambertianDepthOptimizedPass(Graphics& gfx, const std::string& name)
-		: BindingPass(name), QueuePass(name)
+		: BindingPass(name), QueuePass(name),
+		occlusionBuffer(OCCLUSION_BUFFER_WIDTH, static_cast<UINT>(OCCLUSION_BUFFER_WIDTH / gfx.GetRatio()))
 	{
 		RegisterSink(Base::SinkDirectBuffer<Resource::IRenderTarget>::Make("geometryBuffer", renderTarget));
 		RegisterSink(Base::SinkDirectBuffer<Resource::DepthStencil>::Make("depthStencil", depthStencil));
@@ -24,11 +25,26 @@ namespace GFX::Pipeline::RenderPass
 		AddBind(GFX::Resource::Blender::Get(gfx, GFX::Resource::Blender::Type::None));
 	}
 
-	void LambertianDepthOptimizedPass::Execute(Graphics& gfx)
+	void LambertianDepthOptimizedPass::Prepare(Graphics& gfx)
 	{
 		assert(mainCamera);
 		CullFrustum(*mainCamera);
+		testedCount = GetJobs().size();
+		if (occlusionCulling)
+			occludedCount = CullOcclusion(occlusionBuffer, *mainCamera);
+		else
+		{
+			// Light passes should not use depth from previous frames
+			occludedCount = 0;
+			occlusionBuffer.Clear();
+		}
+		ReportScreenSize(*mainCamera, static_cast<float>(gfx.GetHeight()));
 		SortFrontBack(mainCamera->GetPos());
+	}
+
+	void LambertianDepthOptimizedPass::Execute(Graphics& gfx)
+	{
+		assert(mainCamera);
 		mainCamera->BindCamera(gfx);
 		// Depth only pass
 		depthOnlyPS->Bind(gfx);
@@ -47,4 +63,14 @@ namespace GFX::Pipeline::RenderPass
 		}
 		DRAW_TAG_END(gfx);
 	}
+
+	void LambertianDepthOptimizedPass::ShowWindow(Graphics& gfx)
+	{
+		if (ImGui::CollapsingHeader("Occlusion culling"))
+		{
+			ImGui::Checkbox("Enable##occlusion_culling", &occlusionCulling);
+			ImGui::Text("Occluder triangles: %llu", occlusionCulling ? static_cast<unsigned long long>(occlusionBuffer.GetTriangleCount()) : 0ULL);
+			ImGui::Text("Occluded objects: %llu / %llu", static_cast<unsigned long long>(occludedCount), static_cast<unsigned long long>(testedCount));
+		}
+	}
 }
\ No newline at end of file
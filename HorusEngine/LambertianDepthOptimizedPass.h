@@ -8,6 +8,12 @@ namespace GFX::Pipeline::RenderPass
 {
 	class LambertianDepthOptimizedPass : public Base::QueuePass
 	{
+		static constexpr UINT OCCLUSION_BUFFER_WIDTH = 256U;
+
+		bool occlusionCulling = true;
+		size_t occludedCount = 0;
+		size_t testedCount = 0;
+		OcclusionBuffer occlusionBuffer;
 		Camera::ICamera* mainCamera = nullptr;
 		GfxResPtr<GFX::Resource::NullPixelShader> depthOnlyPS;
 		GfxResPtr<GFX::Resource::VertexShader> depthOnlyVS;
@@ -19,7 +25,11 @@ namespace GFX::Pipeline::RenderPass
 		virtual ~LambertianDepthOptimizedPass() = default;
 
 		constexpr void BindCamera(Camera::ICamera& camera) noexcept { mainCamera = &camera; }
+		// Holds depth of occluders from current frame after pass is prepared
+		constexpr const OcclusionBuffer& GetOcclusionBuffer() const noexcept { return occlusionBuffer; }
 
+		void Prepare(Graphics& gfx) override;
 		void Execute(Graphics& gfx) override;
+		void ShowWindow(Graphics& gfx);
 	};
 }
\ No newline at end of file
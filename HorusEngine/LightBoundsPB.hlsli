@@ -0,0 +1,4 @@
+cbuffer LightBoundsBuffer : register(b3)
+{
+	float2 cb_depthBounds; // View space depth range of light volume
+};
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "SamplersPS.hlsli"
 #include "LightAmbientPB.hlsli"
 #include "HDRGammaPB.hlsli"
+#include "RenderScalePB.hlsli"
 
 Texture2D colorTex    : register(t4);  // RGB - color, A = 0.0f
 
@@ -10,10 +11,11 @@ Texture2D ssaoMap     : register(t11); // R   - ambient occlusion value
 
 float4 main(float2 tc : TEXCOORD) : SV_TARGET
 {
-	const float4 srgb = colorTex.Sample(splr_PW, tc);
+	const float2 uv = tc * cb_renderScale;
+	const float4 srgb = colorTex.Sample(splr_PW, uv);
 	const float3 color = DeleteGammaCorr(srgb.rgb);
-	const float ssao = ssaoMap.Sample(splr_LW, tc).r;
-	const float3 diffuse = ssao * color * (DeleteGammaCorr(cb_ambientLight) + abs(lightingMap.Sample(splr_PW, tc).rgb));
+	const float ssao = ssaoMap.Sample(splr_LW, uv).r;
+	const float3 diffuse = ssao * color * (DeleteGammaCorr(cb_ambientLight) + abs(lightingMap.Sample(splr_PW, uv).rgb));
 
-	return float4(diffuse + specularMap.Sample(splr_PW, tc).rgb, srgb.a);
+	return float4(diffuse + specularMap.Sample(splr_PW, uv).rgb, srgb.a);
 }
\ No newline at end of file
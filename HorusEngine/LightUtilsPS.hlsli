@@ -13,24 +13,24 @@ float3 GetWorldPosition(const in float2 texCoord, const in float depth, uniform
 	return pos.xyz / pos.w;
 }
 
-// Decode normal from modified spherical coordinates
+// Decode normal from octahedral mapping (same as GBuffer::DecodeNormal)
 float3 DecodeNormal(const in float2 codedNormal)
 {
-	/*
-		x = sqrt(1 - z^2) * cos(phi)
-		y = sqrt(1 - z^2) * sin(phi)
-		z = z
-	*/
-	if (codedNormal.x > 90.0f)
-		return float3(0.0f, codedNormal.x - 100.0f, codedNormal.y);
-	else
-	{
-		float2 sinCosPhi;
-		sincos(codedNormal.x, sinCosPhi.x, sinCosPhi.y);
-		sinCosPhi *= sqrt(1.0f - codedNormal.y * codedNormal.y);
+	const float2 octahedron = codedNormal * 2.0f - 1.0f;
+	float3 normal = float3(octahedron, 1.0f - abs(octahedron.x) - abs(octahedron.y));
+	// Unfold lower hemisphere
+	const float fold = saturate(-normal.z);
+	normal.xy += normal.xy >= 0.0f ? -fold : fold;
+	return normalize(normal);
+}
+
+// Unpack specular color and exponent from R8G8B8A8_UNORM layout
+float4 DecodeSpecular(const in float4 codedSpecular)
+{
+	static const float SPECULAR_RANGE = 4.0f;
 
-		return float3(sinCosPhi.y, sinCosPhi.x, codedNormal.y);
-	}
+	// https://gamedev.stackexchange.com/questions/74879/specular-map-what-about-the-specular-reflections-highlight-size
+	return float4(codedSpecular.rgb * SPECULAR_RANGE, exp2(codedSpecular.a * 13.0f));
 }
 
 float GetAttenuation(uniform float attLinear, uniform float attQuad, const in float distanceToLight)
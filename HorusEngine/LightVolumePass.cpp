@@ -0,0 +1,106 @@
+#include "LightVolumePass.h"
+#include "Profiler.h"
+#include <cfloat>
+
+namespace GFX::Pipeline::RenderPass::Base
+{
+	inline Data::CBuffer::DCBLayout LightVolumePass::MakeLayout() noexcept
+	{
+		static Data::CBuffer::DCBLayout layout;
+		static bool initNeeded = true;
+		if (initNeeded)
+		{
+			layout.Add(DCBElementType::Float2, "depthBounds");
+			initNeeded = false;
+		}
+		return layout;
+	}
+
+	LightVolumePass::LightVolumePass(Graphics& gfx, const std::string& name)
+		: BindingPass(name), QueuePass(name), renderWidth(gfx.GetWidth()), renderHeight(gfx.GetHeight())
+	{
+		scissorRect = GfxResPtr<GFX::Resource::ScissorRect>(gfx, static_cast<LONG>(gfx.GetWidth()), static_cast<LONG>(gfx.GetHeight()));
+		boundsBuffer = GFX::Resource::ConstBufferExPixelCache::Get(gfx, name + "LightBounds", MakeLayout(), 3U);
+	}
+
+	void LightVolumePass::BindBounds(Graphics& gfx, const LightBounds::Screen& screen)
+	{
+		scissorRect->SetRect({ screen.left, screen.top, screen.right, screen.bottom });
+		scissorRect->Bind(gfx);
+		boundsBuffer->GetBuffer()["depthBounds"] = DirectX::XMFLOAT2(screen.minDepth, screen.maxDepth);
+		boundsBuffer->Bind(gfx);
+	}
+
+	void LightVolumePass::Reset() noexcept
+	{
+		bounds = {};
+		QueuePass::Reset();
+	}
+
+	void LightVolumePass::Prepare(Graphics& gfx)
+	{
+		assert(mainCamera);
+		PROFILE_SCOPE("Light bounds");
+		const DirectX::XMMATRIX view = mainCamera->GetView();
+		const DirectX::XMMATRIX projection = mainCamera->GetProjection();
+		const DirectX::XMMATRIX viewProjection = DirectX::XMMatrixMultiply(view, projection);
+		DirectX::XMFLOAT4X4 proj;
+		DirectX::XMStoreFloat4x4(&proj, projection);
+		const uint32_t width = renderWidth;
+		const uint32_t height = renderHeight;
+		const bool occlusionTest = occlusionBuffer && occlusionBuffer->GetTriangleCount();
+
+		auto& jobs = GetJobs();
+		bounds.clear();
+		bounds.reserve(jobs.size());
+		stats.clear();
+		stats.reserve(jobs.size());
+		rejectedCount = 0;
+		size_t count = 0;
+		for (size_t i = 0, size = jobs.size(); i < size; ++i)
+		{
+			const auto& light = dynamic_cast<Light::ILight&>(jobs[i].GetData());
+			const DirectX::BoundingSphere volume = GetVolume(light);
+			LightBounds::Screen screen;
+			bool visible = LightBounds::Project(volume, view, projection, width, height, screen);
+			if (visible && occlusionTest)
+			{
+				const float r = volume.Radius;
+				const DirectX::XMFLOAT3& c = volume.Center;
+				visible = occlusionBuffer->IsVisible(Data::BoundingBox(c.y + r, c.y - r, c.x - r, c.x + r, c.z - r, c.z + r), viewProjection);
+			}
+			if (!visible)
+			{
+				stats.push_back({ &light.GetName(), 0, 0 });
+				++rejectedCount;
+				continue;
+			}
+
+			LightStats& lightStats = stats.emplace_back(LightStats{ &light.GetName(), screen.GetArea(), screen.GetArea() });
+			if (boundsEnabled)
+			{
+				// Only pixels with geometry inside volume depth range are shaded
+				if (occlusionTest)
+				{
+					const float coverage = occlusionBuffer->GetDepthCoverage(2.0f * screen.left / width - 1.0f, 1.0f - 2.0f * screen.bottom / height,
+						2.0f * screen.right / width - 1.0f, 1.0f - 2.0f * screen.top / height,
+						proj._33 + proj._43 / screen.minDepth, proj._33 + proj._43 / screen.maxDepth);
+					lightStats.pixelsAfter = static_cast<uint64_t>(static_cast<double>(lightStats.pixelsBefore) * coverage);
+				}
+			}
+			else
+				screen = { 0, 0, static_cast<int32_t>(width), static_cast<int32_t>(height), 0.0f, FLT_MAX };
+			bounds.emplace_back(screen);
+			jobs[count++] = jobs[i];
+		}
+		jobs.erase(jobs.begin() + count, jobs.end());
+	}
+
+	void LightVolumePass::ShowStats() const noexcept
+	{
+		ImGui::Text("%s: rejected lights %llu", GetName().c_str(), static_cast<unsigned long long>(rejectedCount));
+		for (const auto& light : stats)
+			ImGui::BulletText("%s: %llu -> %llu px", light.name->c_str(),
+				static_cast<unsigned long long>(light.pixelsBefore), static_cast<unsigned long long>(light.pixelsAfter));
+	}
+}
\ No newline at end of file
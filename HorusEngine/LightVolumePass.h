@@ -0,0 +1,67 @@
+#pragma once
+#include "QueuePass.h"
+#include "ILight.h"
+#include "ScissorRect.h"
+#include "ConstBufferExCache.h"
+#include "LightBounds.h"
+
+namespace GFX::Pipeline::RenderPass::Base
+{
+	// Light pass drawing volumes of lights only inside their screen bounds.
+	// Scissor rect and view depth range of every light are computed on CPU,
+	// lights outside of view or hidden behind occluders are removed from queue
+	class LightVolumePass : public QueuePass
+	{
+	public:
+		struct LightStats
+		{
+			// Owned by light, lights outlive frames they are drawn in
+			const std::string* name;
+			// Estimated pixels shaded without and with bounds
+			uint64_t pixelsBefore;
+			uint64_t pixelsAfter;
+		};
+
+	private:
+		bool boundsEnabled = true;
+		// Size of rendered part of screen sized targets
+		uint32_t renderWidth;
+		uint32_t renderHeight;
+		size_t rejectedCount = 0;
+		const OcclusionBuffer* occlusionBuffer = nullptr;
+		// Aligned with jobs, recreated every frame
+		Utils::FrameVector<LightBounds::Screen> bounds;
+		// Kept between frames for display
+		std::vector<LightStats> stats;
+		GfxResPtr<GFX::Resource::ScissorRect> scissorRect;
+		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> boundsBuffer;
+
+		static inline Data::CBuffer::DCBLayout MakeLayout() noexcept;
+
+	protected:
+		Camera::ICamera* mainCamera = nullptr;
+
+		LightVolumePass(Graphics& gfx, const std::string& name);
+
+		virtual DirectX::BoundingSphere GetVolume(const Light::ILight& light) const noexcept = 0;
+
+		constexpr uint64_t GetRenderArea() const noexcept { return static_cast<uint64_t>(renderWidth) * renderHeight; }
+		constexpr const LightBounds::Screen& GetBounds(size_t job) const noexcept { return bounds.at(job); }
+		// Should be called after BindAll()
+		inline void BindBounds(Graphics& gfx, size_t job) { BindBounds(gfx, bounds.at(job)); }
+		void BindBounds(Graphics& gfx, const LightBounds::Screen& screen);
+
+	public:
+		virtual ~LightVolumePass() = default;
+
+		constexpr void SetRenderSize(uint32_t width, uint32_t height) noexcept { renderWidth = width; renderHeight = height; }
+		constexpr void SetOcclusionBuffer(const OcclusionBuffer& buffer) noexcept { occlusionBuffer = &buffer; }
+		constexpr bool& BoundsEnabled() noexcept { return boundsEnabled; }
+		constexpr size_t GetRejectedCount() const noexcept { return rejectedCount; }
+		constexpr const std::vector<LightStats>& GetStats() const noexcept { return stats; }
+
+		void Reset() noexcept override;
+		void Prepare(Graphics& gfx) override;
+		void ShowStats() const noexcept;
+	};
+}
\ No newline at end of file
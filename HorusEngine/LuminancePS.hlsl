@@ -0,0 +1,21 @@
+#include "SamplersPS.hlsli"
+#include "RenderScalePB.hlsli"
+
+Texture2D tex : register(t0);
+
+static const float MIN_LUMINANCE = 0.0001f;
+
+// Log2 luminance of scene reduced into small target of fixed size, every texel averages 4 bilinear taps
+float main(float2 tc : TEXCOORD) : SV_TARGET
+{
+	const float2 offset = float2(ddx(tc).x, ddy(tc).y) * 0.25f;
+	float logLuminance = 0.0f;
+	[unroll]
+	for (uint i = 0; i < 4; ++i)
+	{
+		const float2 uv = (tc + offset * float2(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f)) * cb_renderScale;
+		const float3 color = tex.Sample(splr_LR, uv).rgb;
+		logLuminance += log2(max(dot(color, float3(0.2126f, 0.7152f, 0.0722f)), MIN_LUMINANCE));
+	}
+	return logLuminance * 0.25f;
+}
\ No newline at end of file
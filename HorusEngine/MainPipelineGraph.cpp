@@ -3,6 +3,7 @@
 #include "GfxResources.h"
 #include "DialogWindow.h"
 #include "Math.h"
+#include "ThreadPool.h"
 
 #define MakePass(pass, ...) std::make_unique<RenderPass::pass>(__VA_ARGS__)
 
@@ -28,6 +29,41 @@ namespace GFX::Pipeline
 		}
 	}
 
+	void MainPipelineGraph::SetRenderScale(float scale)
+	{
+		if (scale == renderScale)
+			return;
+		renderScale = scale;
+		renderViewport->SetScale(scale);
+		const float scaleX = renderViewport->GetScaleX();
+		const float scaleY = renderViewport->GetScaleY();
+		renderScaleBuffer->GetBuffer()["renderScale"] = DirectX::XMFLOAT2(scaleX, scaleY);
+
+		const uint32_t width = static_cast<uint32_t>(scaleX * renderViewport->GetWidth());
+		const uint32_t height = static_cast<uint32_t>(scaleY * renderViewport->GetHeight());
+		dynamic_cast<RenderPass::SpotLightingPass&>(FindPass("spotLighting")).SetRenderSize(width, height);
+		dynamic_cast<RenderPass::PointLightingPass&>(FindPass("pointLighting")).SetRenderSize(width, height);
+	}
+
+	void MainPipelineGraph::CaptureGlobals(Graphics& gfx)
+	{
+		assert(mainCamera);
+		mainCamera->Prepare();
+		frameCamera.Capture(gfx, *mainCamera);
+	}
+
+	void MainPipelineGraph::PrepareGlobals(Graphics& gfx)
+	{
+		frameCamera.BindCamera(gfx);
+	}
+
+	void MainPipelineGraph::BindGlobals(Graphics& gfx)
+	{
+		for (auto& sampler : samplers)
+			sampler.Bind(gfx);
+		renderScaleBuffer->Bind(gfx);
+	}
+
 	void MainPipelineGraph::SetKernel() noexcept(!IS_DEBUG)
 	{
 		assert(radius <= MAX_RADIUS);
@@ -45,7 +81,8 @@ namespace GFX::Pipeline
 	}
 
 	MainPipelineGraph::MainPipelineGraph(Graphics& gfx, float hdrExposure, int radius, float sigma, float gamma, int bias, float normalOffset)
-		: RenderGraph(gfx), bias(bias), radius(radius), sigma(sigma), gamma(gamma), hdrExposure(hdrExposure), normalOffset(normalOffset)
+		: RenderGraph(gfx), bias(bias), radius(radius), sigma(sigma), gamma(gamma), hdrExposure(hdrExposure), normalOffset(normalOffset),
+		frameCamera(gfx, "Frame camera")
 	{
 		SetupSamplers(gfx);
 
@@ -57,7 +94,7 @@ namespace GFX::Pipeline
 		depthOnly = GfxResPtr<Resource::DepthStencilShaderInput>(gfx, 8U, Resource::DepthStencil::Usage::DepthOnly);
 		AddGlobalSource(RenderPass::Base::SourceDirectBuffer<Resource::DepthStencilShaderInput>::Make("depthOnly", depthOnly));
 
-		geometryBuffer = Resource::RenderTargetEx::Get(gfx, 4U, { DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R16G16B16A16_FLOAT });
+		geometryBuffer = Resource::RenderTargetEx::Get(gfx, 4U, { DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_R16G16_UNORM, DXGI_FORMAT_R8G8B8A8_UNORM });
 		AddGlobalSource(RenderPass::Base::SourceDirectBuffer<Resource::RenderTargetEx>::Make("geometryBuffer", geometryBuffer));
 		lightBuffer = Resource::RenderTargetEx::Get(gfx, 9U, { DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R16G16B16A16_FLOAT });
 		AddGlobalSource(RenderPass::Base::SourceDirectBuffer<Resource::RenderTargetEx>::Make("lightBuffer", lightBuffer));
@@ -67,6 +104,14 @@ namespace GFX::Pipeline
 		sceneTarget = GfxResPtr<Resource::RenderTargetShaderInput>(gfx, 0U, DXGI_FORMAT::DXGI_FORMAT_R16G16B16A16_FLOAT);
 		AddGlobalSource(RenderPass::Base::SourceDirectBuffer<Resource::RenderTargetShaderInput>::Make("sceneTarget", sceneTarget));
 
+		// Screen sized targets are allocated at max size, dynamic resolution renders only to part of them
+		renderViewport = GFX::Resource::Viewport::MakeDynamic(gfx, gfx.GetWidth(), gfx.GetHeight());
+		GetDepthStencil()->SetViewport(renderViewport);
+		depthOnly->SetViewport(renderViewport);
+		geometryBuffer->SetViewport(renderViewport);
+		lightBuffer->SetViewport(renderViewport);
+		sceneTarget->SetViewport(renderViewport);
+
 #pragma region CBuffers setup
 		// Setup gamma cbuffer
 		Data::CBuffer::DCBLayout gammaLayout;
@@ -114,6 +159,13 @@ namespace GFX::Pipeline
 		biasBuffer["normalOffset"] = normalOffset;
 		shadowBias = GfxResPtr<GFX::Resource::ConstBufferExPixelCache>(gfx, "$shadowBias", biasBuffer, 10U);
 		AddGlobalSource(RenderPass::Base::SourceDirectBindable<GFX::Resource::ConstBufferExPixelCache>::Make("shadowBias", shadowBias));
+
+		// Setup dynamic resolution cbuffer
+		Data::CBuffer::DCBLayout renderScaleLayout;
+		renderScaleLayout.Add(DCBElementType::Float2, "renderScale");
+		Data::CBuffer::DynamicCBuffer renderScaleData(std::move(renderScaleLayout));
+		renderScaleData["renderScale"] = DirectX::XMFLOAT2(1.0f, 1.0f);
+		renderScaleBuffer = GfxResPtr<GFX::Resource::ConstBufferExPixelCache>(gfx, "$renderScale", renderScaleData, 5U);
 #pragma endregion
 
 		// Setup all passes
@@ -161,8 +213,6 @@ namespace GFX::Pipeline
 			pass->SetSinkLinkage("lightBuffer", "clearLBuff.buffer");
 			pass->SetSinkLinkage("gammaCorrection", "$.gammaCorrection");
 			pass->SetSinkLinkage("shadowBias", "$.shadowBias");
-			pass->SetSinkLinkage("shadowMapDepth", "$.shadowMapDepth");
-			pass->SetSinkLinkage("shadowMapTarget", "$.shadowMapTarget");
 			AppendPass(std::move(pass));
 		}
 		{
@@ -172,8 +222,8 @@ namespace GFX::Pipeline
 			pass->SetSinkLinkage("lightBuffer", "dirLighting.lightBuffer");
 			pass->SetSinkLinkage("gammaCorrection", "$.gammaCorrection");
 			pass->SetSinkLinkage("shadowBias", "$.shadowBias");
-			pass->SetSinkLinkage("shadowMapDepth", "dirLighting.shadowMap.depth");
-			pass->SetSinkLinkage("shadowMapTarget", "dirLighting.shadowMap.scratch");
+			pass->SetSinkLinkage("shadowMapDepth", "$.shadowMapDepth");
+			pass->SetSinkLinkage("shadowMapTarget", "$.shadowMapTarget");
 			AppendPass(std::move(pass));
 		}
 		{
@@ -256,6 +306,12 @@ namespace GFX::Pipeline
 			pass->SetSinkLinkage("depthStencil", "skybox.depthStencil");
 			AppendPass(std::move(pass));
 		}
+		{
+			auto pass = MakePass(AutoExposurePass, gfx, "autoExposure");
+			pass->SetSinkLinkage("scene", "wireframe.renderTarget");
+			pass->SetSinkLinkage("gammaCorrection", "$.gammaCorrection");
+			AppendPass(std::move(pass));
+		}
 		{
 			auto pass = MakePass(HDRGammaCorrectionPass, gfx, "hdrGamma");
 			pass->SetSinkLinkage("scene", "wireframe.renderTarget");
@@ -266,17 +322,20 @@ namespace GFX::Pipeline
 #pragma endregion
 		SetSinkSource("backbuffer", "hdrGamma.renderTarget");
 		Finalize();
-	}
 
-	void MainPipelineGraph::BindMainCamera(Camera::ICamera& camera)
-	{
-		dynamic_cast<RenderPass::LambertianDepthOptimizedPass&>(FindPass("lambertianDepthOptimized")).BindCamera(camera);
-		dynamic_cast<RenderPass::LambertianClassicPass&>(FindPass("lambertianClassic")).BindCamera(camera);
-		dynamic_cast<RenderPass::DirectionalLightingPass&>(FindPass("dirLighting")).BindCamera(camera);
-		dynamic_cast<RenderPass::SpotLightingPass&>(FindPass("spotLighting")).BindCamera(camera);
-		dynamic_cast<RenderPass::PointLightingPass&>(FindPass("pointLighting")).BindCamera(camera);
-		dynamic_cast<RenderPass::SSAOPass&>(FindPass("ssao")).BindCamera(camera);
-		dynamic_cast<RenderPass::SkyboxPass&>(FindPass("skybox")).BindCamera(camera);
+		// Light volumes are tested against occluders gathered by geometry pass
+		const auto& occlusionBuffer = dynamic_cast<RenderPass::LambertianDepthOptimizedPass&>(FindPass("lambertianDepthOptimized")).GetOcclusionBuffer();
+		dynamic_cast<RenderPass::SpotLightingPass&>(FindPass("spotLighting")).SetOcclusionBuffer(occlusionBuffer);
+		dynamic_cast<RenderPass::PointLightingPass&>(FindPass("pointLighting")).SetOcclusionBuffer(occlusionBuffer);
+		dynamic_cast<RenderPass::SSAOPass&>(FindPass("ssao")).SetViewport(renderViewport);
+
+		dynamic_cast<RenderPass::LambertianDepthOptimizedPass&>(FindPass("lambertianDepthOptimized")).BindCamera(frameCamera);
+		dynamic_cast<RenderPass::LambertianClassicPass&>(FindPass("lambertianClassic")).BindCamera(frameCamera);
+		dynamic_cast<RenderPass::DirectionalLightingPass&>(FindPass("dirLighting")).BindCamera(frameCamera);
+		dynamic_cast<RenderPass::SpotLightingPass&>(FindPass("spotLighting")).BindCamera(frameCamera);
+		dynamic_cast<RenderPass::PointLightingPass&>(FindPass("pointLighting")).BindCamera(frameCamera);
+		dynamic_cast<RenderPass::SSAOPass&>(FindPass("ssao")).BindCamera(frameCamera);
+		dynamic_cast<RenderPass::SkyboxPass&>(FindPass("skybox")).BindCamera(frameCamera);
 	}
 
 	void MainPipelineGraph::SetKernel(int radius, float sigma) noexcept(!IS_DEBUG)
@@ -286,6 +345,19 @@ namespace GFX::Pipeline
 		SetKernel();
 	}
 
+	void MainPipelineGraph::UpdateRenderScale(float frameTime)
+	{
+		if (dynamicResolution)
+			SetRenderScale(resolutionController.Update(frameTime));
+	}
+
+	void MainPipelineGraph::SetAutoExposure(bool enable)
+	{
+		dynamic_cast<RenderPass::AutoExposurePass&>(FindPass("autoExposure")).SetEnabled(enable);
+		if (!enable)
+			gammaCorrection->GetBuffer()["hdrExposure"] = hdrExposure;
+	}
+
 	std::optional<std::string> MainPipelineGraph::ChangeSkybox(Graphics& gfx, const std::string& path)
 	{
 		auto files = GUI::DialogWindow::GetDirContent(std::filesystem::directory_entry(path), GUI::DialogWindow::FileType::Image);
@@ -334,16 +406,24 @@ namespace GFX::Pipeline
 				gammaCorrection->GetBuffer()["deGamma"] = 1.0f / gamma;
 			}
 			ImGui::NextColumn();
-			ImGui::Text("HDR exposure");
-			ImGui::SetNextItemWidth(-1.0f);
-			if (ImGui::InputFloat("##hdr", &hdrExposure, 0.1f, 0.0f, "%.1f"))
+			auto& exposurePass = dynamic_cast<RenderPass::AutoExposurePass&>(FindPass("autoExposure"));
+			bool autoExposure = exposurePass.IsEnabled();
+			if (ImGui::Checkbox("Auto exposure", &autoExposure))
+				SetAutoExposure(autoExposure);
+			if (!autoExposure)
 			{
-				if (hdrExposure < 0.1f)
-					hdrExposure = 0.1f;
-				gammaCorrection->GetBuffer()["hdrExposure"] = hdrExposure;
-				kernel->GetBuffer()["intensity"] = hdrExposure < 1.0f ? 1.0f / hdrExposure : 1.0f;
+				ImGui::SetNextItemWidth(-1.0f);
+				if (ImGui::InputFloat("##hdr", &hdrExposure, 0.1f, 0.0f, "%.1f"))
+				{
+					if (hdrExposure < 0.1f)
+						hdrExposure = 0.1f;
+					gammaCorrection->GetBuffer()["hdrExposure"] = hdrExposure;
+					kernel->GetBuffer()["intensity"] = hdrExposure < 1.0f ? 1.0f / hdrExposure : 1.0f;
+				}
 			}
 			ImGui::Columns(1);
+			if (autoExposure)
+				exposurePass.ShowWindow(gfx);
 		}
 		if (ImGui::CollapsingHeader("Shadows"))
 		{
@@ -364,8 +444,90 @@ namespace GFX::Pipeline
 				shadowBias->GetBuffer()["normalOffset"] = normalOffset;
 			}
 			ImGui::Columns(1);
+
+			auto& cascadePass = dynamic_cast<RenderPass::DirectionalLightingPass&>(FindPass("dirLighting")).GetShadowMapPass();
+			ShadowCascades& cascades = cascadePass.GetCascades();
+			ImGui::Columns(2, "##cascade_options", false);
+			ImGui::Text("Cascades");
+			ImGui::SetNextItemWidth(-1.0f);
+			int cascadeCount = static_cast<int>(cascades.GetCount());
+			if (ImGui::SliderInt("##cascade_count", &cascadeCount, 1, ShadowCascades::MAX_CASCADES))
+				cascades.SetCount(static_cast<uint32_t>(cascadeCount));
+			ImGui::NextColumn();
+			ImGui::Text("Split lambda");
+			ImGui::SetNextItemWidth(-1.0f);
+			ImGui::SliderFloat("##split_lambda", &cascades.Lambda(), 0.0f, 1.0f, "%.2f");
+			ImGui::NextColumn();
+			ImGui::Text("Caster distance");
+			ImGui::SetNextItemWidth(-1.0f);
+			if (ImGui::InputFloat("##caster_distance", &cascades.CasterDistance(), 1.0f, 0.0f, "%.1f") && cascades.CasterDistance() < 0.0f)
+				cascades.CasterDistance() = 0.0f;
+			ImGui::Columns(1);
+			const auto& casters = cascadePass.GetCasterCounts();
+			for (uint32_t i = 0; i < cascades.GetCount(); ++i)
+				ImGui::Text("Cascade %u: up to %.1f, texel %.3f, casters: %llu", i, cascades.GetCascade(i).splitFar,
+					cascades.GetCascade(i).texelSize, static_cast<unsigned long long>(casters.at(i)));
 			dynamic_cast<RenderPass::LightCombinePass&>(FindPass("lightCombiner")).ShowWindow(gfx);
 		}
-		dynamic_cast<RenderPass::SSAOPass&>(FindPass("ssao")).ShowWindow(gfx);
+		auto& ssaoPass = dynamic_cast<RenderPass::SSAOPass&>(FindPass("ssao"));
+		ssaoPass.ShowWindow(gfx);
+		const bool ssaoBlur = ssaoPass.GetQuality() == RenderPass::SSAOPass::Quality::Full;
+		dynamic_cast<RenderPass::SSAOBlurPass&>(FindPass("ssaoHalfBlur")).SetEnabled(ssaoBlur);
+		dynamic_cast<RenderPass::SSAOBlurPass&>(FindPass("ssaoFullBlur")).SetEnabled(ssaoBlur);
+		dynamic_cast<RenderPass::LambertianDepthOptimizedPass&>(FindPass("lambertianDepthOptimized")).ShowWindow(gfx);
+		if (ImGui::CollapsingHeader("Dynamic resolution"))
+		{
+			auto& params = resolutionController.GetParams();
+			if (ImGui::Checkbox("Enable##dynamic_resolution", &dynamicResolution))
+			{
+				resolutionController.Reset();
+				SetRenderScale(resolutionController.GetScale());
+			}
+			bool change = ImGui::SliderFloat("Frame budget", &params.targetTime, 4.0f, 50.0f, "%.1f ms");
+			change |= ImGui::SliderFloat("Min scale", &params.minScale, 0.25f, params.maxScale, "%.2f");
+			if (change)
+			{
+				resolutionController.Reset();
+				if (dynamicResolution)
+					SetRenderScale(resolutionController.GetScale());
+			}
+			ImGui::Text("Scale: %.3f, filtered GPU time: %.2f ms", renderScale, resolutionController.GetFilteredTime());
+			ImGui::Text("Render size: %ux%u", static_cast<unsigned int>(renderViewport->GetScaleX() * renderViewport->GetWidth()),
+				static_cast<unsigned int>(renderViewport->GetScaleY() * renderViewport->GetHeight()));
+		}
+		if (ImGui::CollapsingHeader("Light culling"))
+		{
+			auto& spotLighting = dynamic_cast<RenderPass::SpotLightingPass&>(FindPass("spotLighting"));
+			auto& pointLighting = dynamic_cast<RenderPass::PointLightingPass&>(FindPass("pointLighting"));
+			if (ImGui::Checkbox("Scissor and depth bounds", &pointLighting.BoundsEnabled()))
+				spotLighting.BoundsEnabled() = pointLighting.BoundsEnabled();
+			spotLighting.ShowStats();
+			pointLighting.ShowWindow(gfx);
+		}
+		Resource::TextureStreamer::Get().ShowWindow();
+		if (ImGui::CollapsingHeader("Command recording"))
+		{
+			ImGui::Checkbox("Parallel passes", &ParallelRecording());
+			ImGui::Text("Record time: %.3f ms, worker threads: %llu", GetRecordTime(),
+				static_cast<unsigned long long>(Utils::ThreadPool::Get().GetWorkersCount()));
+			if (ImGui::Button("Check parity"))
+				RequestParityCheck();
+			const Parity& parity = GetParity();
+			if (parity.checked)
+			{
+				ImGui::SameLine();
+				ImGui::Text("Different texels: %llu, max difference: %u", static_cast<unsigned long long>(parity.differentTexels), static_cast<unsigned int>(parity.maxDifference));
+			}
+			ImGui::Checkbox("Pipeline state bundles", &GFX::Resource::PipelineState::Enabled());
+			const auto& stats = GFX::Resource::PipelineState::GetLastFrameStats();
+			ImGui::Text("Pass states set: %llu, skipped: %llu, bundles: %llu", static_cast<unsigned long long>(stats.issued),
+				static_cast<unsigned long long>(stats.skipped), static_cast<unsigned long long>(stats.bundles));
+		}
+		if (ImGui::CollapsingHeader("Scene hierarchy"))
+		{
+			const BVH& bvh = GetSceneBVH();
+			ImGui::Text("Objects: %llu, nodes: %llu", static_cast<unsigned long long>(bvh.GetObjectCount()), static_cast<unsigned long long>(bvh.GetNodeCount()));
+			ImGui::Text("SAH cost: %.2f, rebuilds: %llu", bvh.GetBuildCost(), static_cast<unsigned long long>(bvh.GetRebuildCount()));
+		}
 	}
 }
\ No newline at end of file
@@ -6,7 +6,8 @@
 #include "ConstBufferExCache.h"
 #include "Sampler.h"
 #include "TextureCube.h"
-#include "ICamera.h"
+#include "CameraSnapshot.h"
+#include "ResolutionController.h"
 
 namespace GFX::Pipeline
 {
@@ -21,6 +22,12 @@ namespace GFX::Pipeline
 		float gamma;
 		float hdrExposure;
 		float normalOffset;
+		bool dynamicResolution = false;
+		float renderScale = 1.0f;
+		ResolutionController resolutionController;
+		Camera::ICamera* mainCamera = nullptr;
+		// Passes draw from camera captured with submitted jobs, main camera can move meanwhile
+		Camera::CameraSnapshot frameCamera;
 
 		std::vector<GFX::Resource::Sampler> samplers;
 		GfxResPtr<GFX::Resource::TextureCube> skyboxTexture;
@@ -33,21 +40,34 @@ namespace GFX::Pipeline
 
 		GfxResPtr<Resource::RenderTargetShaderInput> shadowMapTarget;
 		GfxResPtr<Resource::RenderTargetShaderInput> sceneTarget;
+		// Shared by all screen sized targets, scaled with dynamic resolution
+		GfxResPtr<GFX::Resource::Viewport> renderViewport;
 
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> gammaCorrection;
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> kernel;
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> blurDirection;
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> shadowBias;
+		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> renderScaleBuffer;
 
 		inline void SetupSamplers(Graphics& gfx);
 		void SetKernel() noexcept(!IS_DEBUG);
+		void SetRenderScale(float scale);
+
+	protected:
+		void CaptureGlobals(Graphics& gfx) override;
+		void PrepareGlobals(Graphics& gfx) override;
+		void BindGlobals(Graphics& gfx) override;
 
 	public:
 		MainPipelineGraph(Graphics& gfx, float hdrExposure = 1.5f, int radius = 7, float sigma = 2.6f, float gamma = 2.2f, int bias = 26, float normalOffset = 0.001f);
 		virtual ~MainPipelineGraph() = default;
 
-		void BindMainCamera(Camera::ICamera& camera);
+		constexpr void BindMainCamera(Camera::ICamera& camera) noexcept { mainCamera = &camera; }
 		void SetKernel(int radius, float sigma) noexcept(!IS_DEBUG);
+		// Picks resolution of next frame based on GPU time of last measured one (in ms)
+		void UpdateRenderScale(float frameTime);
+		// With fixed exposure image does not depend on previous frames and their timing
+		void SetAutoExposure(bool enable);
 		std::optional<std::string> ChangeSkybox(Graphics& gfx, const std::string& path);
 		void ShowWindow(Graphics& gfx);
 	};
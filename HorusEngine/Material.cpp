@@ -1,9 +1,22 @@
 #include "Material.h"
 #include "GfxResources.h"
 #include "Math.h"
+#include "GBufferEncoding.h"
 
 namespace GFX::Visual
 {
+	inline Data::CBuffer::DCBLayout Material::MakeShadowLayout() noexcept
+	{
+		static Data::CBuffer::DCBLayout layout;
+		static bool initNeeded = true;
+		if (initNeeded)
+		{
+			layout.Add(DCBElementType::Float, "parallaxScale");
+			initNeeded = false;
+		}
+		return layout;
+	}
+
 	Material::Material(Graphics& gfx, Data::ColorFloat3 color, const std::string& name)
 	{
 		AddBind(Resource::PixelShader::Get(gfx, "SolidPS"));
@@ -45,6 +58,29 @@ namespace GFX::Visual
 		pixelBuffer = Resource::ConstBufferExPixelCache::Get(gfx, name, std::move(cbuffer));
 	}
 
+	void Material::GetTexturePaths(const aiMaterial& material, const std::string& path, std::vector<std::string>& paths)
+	{
+		aiString texFile;
+		for (aiTextureType type : { aiTextureType_DIFFUSE, aiTextureType_NORMALS, aiTextureType_HEIGHT, aiTextureType_SPECULAR })
+			if (material.GetTexture(type, 0, &texFile) == aiReturn_SUCCESS)
+				paths.emplace_back(path + std::string(texFile.C_Str()));
+	}
+
+	ShaderPermutation Material::GetPermutation(const aiMaterial& material) noexcept
+	{
+		ShaderPermutation permutation;
+		aiString texFile;
+		if (material.GetTexture(aiTextureType_DIFFUSE, 0, &texFile) == aiReturn_SUCCESS)
+			permutation.Add(ShaderPermutation::Texture);
+		if (material.GetTexture(aiTextureType_NORMALS, 0, &texFile) == aiReturn_SUCCESS)
+			permutation.Add(ShaderPermutation::Normal);
+		if (material.GetTexture(aiTextureType_HEIGHT, 0, &texFile) == aiReturn_SUCCESS)
+			permutation.Add(ShaderPermutation::Parallax);
+		if (material.GetTexture(aiTextureType_SPECULAR, 0, &texFile) == aiReturn_SUCCESS)
+			permutation.Add(ShaderPermutation::Specular);
+		return permutation;
+	}
+
 	Material::Material(Graphics& gfx, aiMaterial& material, const std::string& path)
 	{
 		GFX::Data::CBuffer::DCBLayout cbufferLayout;
@@ -52,8 +88,6 @@ namespace GFX::Visual
 		cbufferLayout.Add(DCBElementType::Float, "specularIntensity");
 		cbufferLayout.Add(DCBElementType::Float, "specularPower");
 		aiString texFile;
-		std::string shaderCodePS = "PhongPS";
-		std::string shaderCodeVS = "PhongVS";
 		vertexLayout = std::make_shared<Data::VertexLayout>();
 		vertexLayout->Append(VertexAttribute::Normal);
 
@@ -62,8 +96,7 @@ namespace GFX::Visual
 		{
 			diffuseTexture = Resource::Texture::Get(gfx, path + std::string(texFile.C_Str()), 0U, true);
 			translucent = diffuseTexture->HasAlpha();
-			shaderCodePS += "Texture";
-			shaderCodeVS += "Texture";
+			permutation.Add(ShaderPermutation::Texture);
 			vertexLayout->Append(VertexAttribute::Texture2D);
 		}
 		else
@@ -73,8 +106,7 @@ namespace GFX::Visual
 		if (material.GetTexture(aiTextureType_NORMALS, 0, &texFile) == aiReturn_SUCCESS)
 		{
 			normalMap = Resource::Texture::Get(gfx, path + std::string(texFile.C_Str()), 1U);
-			shaderCodePS += "Normal";
-			shaderCodeVS += "Normal";
+			permutation.Add(ShaderPermutation::Normal);
 			vertexLayout->Append(VertexAttribute::Texture2D).Append(VertexAttribute::Bitangent);
 		}
 
@@ -82,8 +114,7 @@ namespace GFX::Visual
 		if (material.GetTexture(aiTextureType_HEIGHT, 0, &texFile) == aiReturn_SUCCESS)
 		{
 			parallaxMap = Resource::Texture::Get(gfx, path + std::string(texFile.C_Str()), 3U);
-			shaderCodePS += "Parallax";
-			shaderCodeVS += "Parallax";
+			permutation.Add(ShaderPermutation::Parallax);
 			cbufferLayout.Add(DCBElementType::Float, "parallaxScale");
 		}
 
@@ -91,14 +122,14 @@ namespace GFX::Visual
 		if (material.GetTexture(aiTextureType_SPECULAR, 0, &texFile) == aiReturn_SUCCESS)
 		{
 			specularMap = Resource::Texture::Get(gfx, path + std::string(texFile.C_Str()), 2U, true);
-			shaderCodePS += "Specular";
+			permutation.Add(ShaderPermutation::Specular);
 			vertexLayout->Append(VertexAttribute::Texture2D);
 			cbufferLayout.Add(DCBElementType::Bool, "useSpecularPowerAlpha");
 		}
 
 		// Common elements
-		AddBind(Resource::PixelShader::Get(gfx, shaderCodePS));
-		auto vertexShader = Resource::VertexShader::Get(gfx, shaderCodeVS);
+		AddBind(Resource::PixelShader::Get(gfx, permutation.GetPhongPS()));
+		auto vertexShader = Resource::VertexShader::Get(gfx, permutation.GetPhongVS());
 		AddBind(Resource::InputLayout::Get(gfx, vertexLayout, vertexShader));
 		AddBind(std::move(vertexShader));
 
@@ -108,6 +139,8 @@ namespace GFX::Visual
 			cbuffer["specularColor"] = std::move(Data::ColorFloat3(1.0f, 1.0f, 1.0f));
 		if (material.Get(AI_MATKEY_SHININESS_STRENGTH, static_cast<float&>(cbuffer["specularIntensity"])) != aiReturn_SUCCESS)
 			cbuffer["specularIntensity"] = 0.9f;
+		else if (static_cast<float>(cbuffer["specularIntensity"]) > GBufferEncoding::SPECULAR_RANGE)
+			cbuffer["specularIntensity"] = GBufferEncoding::SPECULAR_RANGE;
 		float specularPower;
 		if (material.Get(AI_MATKEY_SHININESS, specularPower) == aiReturn_SUCCESS)
 		{
@@ -127,6 +160,33 @@ namespace GFX::Visual
 			cbuffer["useSpecularPowerAlpha"] = specularMap->HasAlpha();
 		// Maybe path needed too, TODO: Check this
 		pixelBuffer = Resource::ConstBufferExPixelCache::Get(gfx, material.GetName().C_Str(), std::move(cbuffer));
+		if (IsParallax())
+		{
+			shadowBuffer = Resource::ConstBufferExPixelCache::Get(gfx, pixelBuffer->GetRID() + "_shadowPax", MakeShadowLayout(), 1U);
+			shadowBuffer->GetBuffer()["parallaxScale"] = static_cast<float>(pixelBuffer->GetBufferConst()["parallaxScale"]);
+		}
+	}
+
+	bool Material::Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept
+	{
+		if (!pixelBuffer->Accept(gfx, probe))
+			return false;
+		// Copy for shadow passes is changed here, so it is never written while passes record
+		if (shadowBuffer != nullptr)
+			shadowBuffer->GetBuffer()["parallaxScale"] = static_cast<float>(pixelBuffer->GetBufferConst()["parallaxScale"]);
+		return true;
+	}
+
+	void Material::ReportScreenSize(float screenSize) noexcept
+	{
+		if (diffuseTexture != nullptr)
+			diffuseTexture->ReportUsage(screenSize);
+		if (normalMap != nullptr)
+			normalMap->ReportUsage(screenSize);
+		if (parallaxMap != nullptr)
+			parallaxMap->ReportUsage(screenSize);
+		if (specularMap != nullptr)
+			specularMap->ReportUsage(screenSize);
 	}
 
 	void Material::SetDepthOnly(Graphics& gfx)
@@ -1,5 +1,6 @@
 #pragma once
 #include "IVisual.h"
+#include "ShaderPermutation.h"
 #include "Texture.h"
 #include "InputLayout.h"
 #include "ConstBufferExCache.h"
@@ -10,14 +11,19 @@ namespace GFX::Visual
 	class Material : public IVisual
 	{
 		bool translucent = false;
+		ShaderPermutation permutation;
 		GfxResPtr<Resource::InputLayout> depthOnlyInputLayout;
 		GfxResPtr<Resource::Texture> diffuseTexture;
 		GfxResPtr<Resource::Texture> normalMap;
 		GfxResPtr<Resource::Texture> parallaxMap;
 		GfxResPtr<Resource::Texture> specularMap;
 		GfxResPtr<Resource::ConstBufferExPixelCache> pixelBuffer;
+		// Parallax scale used by shadow passes, updated together with pixel buffer
+		GfxResPtr<Resource::ConstBufferExPixelCache> shadowBuffer;
 		std::shared_ptr<Data::VertexLayout> vertexLayout = nullptr;
 
+		static inline Data::CBuffer::DCBLayout MakeShadowLayout() noexcept;
+
 	public:
 		Material(Graphics& gfx, Data::ColorFloat3 color, const std::string& name);
 		Material(Graphics& gfx, Data::ColorFloat4 color, const std::string& name);
@@ -26,7 +32,12 @@ namespace GFX::Visual
 		Material& operator=(const Material&) = default;
 		virtual ~Material() = default;
 
+		// Files of all textures used by material, allows decoding them before material is created
+		static void GetTexturePaths(const aiMaterial& material, const std::string& path, std::vector<std::string>& paths);
+		static ShaderPermutation GetPermutation(const aiMaterial& material) noexcept;
+
 		constexpr bool IsTranslucent() const noexcept { return translucent; }
+		constexpr ShaderPermutation GetPermutation() const noexcept { return permutation; }
 		inline bool IsTexture() const noexcept { return diffuseTexture != nullptr; }
 		inline bool IsParallax() const noexcept { return parallaxMap != nullptr; }
 
@@ -35,10 +46,12 @@ namespace GFX::Visual
 		inline GfxResPtr<Resource::Texture> GetParallaxMap() noexcept { return parallaxMap; }
 		inline Resource::ConstBufferExPixelCache& GetPixelBuffer() noexcept { return *pixelBuffer; }
 		inline GfxResPtr<Resource::ConstBufferExPixelCache> GetBuffer() noexcept { return pixelBuffer; }
+		inline GfxResPtr<Resource::ConstBufferExPixelCache> GetShadowBuffer() noexcept { return shadowBuffer; }
 		inline std::shared_ptr<Data::VertexLayout> GerVertexLayout() noexcept { return vertexLayout; }
-		inline bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override { return pixelBuffer->Accept(gfx, probe); }
 		inline void Bind(Graphics& gfx) override { Bind(gfx, RenderChannel::All); }
 
+		bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override;
+		void ReportScreenSize(float screenSize) noexcept override;
 		void SetDepthOnly(Graphics& gfx);
 		void Bind(Graphics& gfx, RenderChannel mode) override;
 	};
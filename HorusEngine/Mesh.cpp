@@ -3,9 +3,10 @@
 namespace GFX::Shape
 {
 	Mesh::Mesh(Graphics& gfx, const std::string& name, GfxResPtr<Resource::IndexBuffer>&& indexBuffer,
-		GfxResPtr<Resource::VertexBuffer>&& vertexBuffer, std::vector<Pipeline::Technique>&& techniques)
+		GfxResPtr<Resource::VertexBuffer>&& vertexBuffer, std::vector<Pipeline::Technique>&& techniques,
+		std::shared_ptr<Data::OccluderGeometry> occluder)
 		: BaseShape(gfx, std::forward<GfxResPtr<Resource::IndexBuffer>&&>(indexBuffer), std::forward<GfxResPtr<Resource::VertexBuffer>&&>(vertexBuffer)),
-		GfxObject(false), name(&name)
+		GfxObject(false), name(&name), occluder(occluder)
 	{
 		SetTechniques(gfx, std::forward<std::vector<Pipeline::Technique>&&>(techniques), *this);
 	}
@@ -6,12 +6,16 @@ namespace GFX::Shape
 	class Mesh : public BaseShape, public GfxObject
 	{
 		const std::string* name;
+		std::shared_ptr<Data::OccluderGeometry> occluder = nullptr;
 
 	public:
 		Mesh(Graphics& gfx, const std::string& name, GfxResPtr<Resource::IndexBuffer>&& indexBuffer,
-			GfxResPtr<Resource::VertexBuffer>&& vertexBuffer, std::vector<Pipeline::Technique>&& techniques);
+			GfxResPtr<Resource::VertexBuffer>&& vertexBuffer, std::vector<Pipeline::Technique>&& techniques,
+			std::shared_ptr<Data::OccluderGeometry> occluder = nullptr);
 		virtual ~Mesh() = default;
 
 		inline const std::string& GetName() const noexcept { return *name; }
+		inline void UpdateWorldBox(const DirectX::XMMATRIX& transform) noexcept { UpdateSceneBVH(GetBoundingBox().GetTransformed(transform)); }
+		inline const Data::OccluderGeometry* GetOccluder() const noexcept override { return occluder && !occluder->IsEmpty() ? occluder.get() : nullptr; }
 	};
 }
\ No newline at end of file
@@ -35,13 +35,20 @@ namespace GFX::Shape
 		else
 			vertexBuffer = Resource::VertexBuffer::Get(gfx, meshID, { vertexLayout });
 
+		// Only opaque geometry can hide other objects
+		std::shared_ptr<Data::OccluderGeometry> occluder = nullptr;
+		if (!material->IsTranslucent())
+			occluder = std::make_shared<Data::OccluderGeometry>(mesh);
+
 		std::vector<Pipeline::Technique> techniques;
 		techniques.reserve(3);
 		techniques.emplace_back(Pipeline::TechniqueFactory::MakeShadowMap(gfx, graph, material));
 		techniques.emplace_back(Pipeline::TechniqueFactory::MakeLambertian(gfx, graph, std::move(material)));
 		techniques.emplace_back(Pipeline::TechniqueFactory::MakeOutlineBlur(gfx, graph, meshID, std::move(vertexLayout)));
 
-		return std::make_shared<Mesh>(gfx, *name, std::move(indexBuffer), std::move(vertexBuffer), std::move(techniques));
+		auto newMesh = std::make_shared<Mesh>(gfx, *name, std::move(indexBuffer), std::move(vertexBuffer), std::move(techniques), std::move(occluder));
+		newMesh->SetSceneBVH(graph.GetSceneBVH());
+		return newMesh;
 	}
 
 	std::unique_ptr<ModelNode> Model::ParseNode(const aiNode& node, uint64_t& id)
@@ -60,10 +67,46 @@ namespace GFX::Shape
 		return currentNode;
 	}
 
+	void Model::ParseScene(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& file, const aiScene& scene, const ModelParams& params)
+	{
+		meshes.reserve(scene.mNumMeshes);
+		materials.reserve(scene.mNumMaterials);
+		std::filesystem::path filePath(file);
+		bool flipYZ = filePath.extension().string() == ".3ds";
+		std::string path = filePath.remove_filename().string();
+		for (unsigned int i = 0; i < scene.mNumMaterials; ++i)
+			materials.emplace_back(std::make_shared<Visual::Material>(gfx, *scene.mMaterials[i], path));
+		for (unsigned int i = 0; i < scene.mNumMeshes; ++i)
+			meshes.emplace_back(ParseMesh(gfx, graph, path, *scene.mMeshes[i]));
+		unsigned long long startID = 0ULL;
+		root = ParseNode(*scene.mRootNode, startID);
+		root->SetScale(params.scale);
+		root->SetPos(params.position);
+		if (flipYZ)
+		{
+			DirectX::XMFLOAT3 rot = params.rotation;
+			rot.x += M_PI_2;
+			root->SetAngle(rot);
+		}
+		else
+			root->SetAngle(params.rotation);
+	}
+
 	Model::Model(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& file, const ModelParams& params)
 		: name(std::make_unique<std::string>(params.name))
 	{
 		Assimp::Importer importer;
+		ParseScene(gfx, graph, file, ReadFile(importer, file), params);
+	}
+
+	Model::Model(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& file, const aiScene& scene, const ModelParams& params)
+		: name(std::make_unique<std::string>(params.name))
+	{
+		ParseScene(gfx, graph, file, scene, params);
+	}
+
+	const aiScene& Model::ReadFile(Assimp::Importer& importer, const std::string& file)
+	{
 		importer.SetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, 80.0f);
 		importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS,
 			aiComponent_COLORS | aiComponent_CAMERAS | aiComponent_ANIMATIONS | aiComponent_LIGHTS);
@@ -89,34 +132,14 @@ namespace GFX::Shape
 		if (!scene || error.size())
 			throw ModelException(__LINE__, __FILE__, error);
 
-		meshes.reserve(scene->mNumMeshes);
-		materials.reserve(scene->mNumMaterials);
-		std::filesystem::path filePath(file);
-		bool flipYZ = filePath.extension().string() == ".3ds";
-		if (flipYZ) // Fix for incorrect format with YZ coords
+		if (std::filesystem::path(file).extension().string() == ".3ds") // Fix for incorrect format with YZ coords
 		{
 			float temp = scene->mRootNode->mTransformation.b2;
 			scene->mRootNode->mTransformation.b2 = -scene->mRootNode->mTransformation.b3;
 			scene->mRootNode->mTransformation.b3 = temp;
 			std::swap(scene->mRootNode->mTransformation.c2, scene->mRootNode->mTransformation.c3);
 		}
-		std::string path = filePath.remove_filename().string();
-		for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
-			materials.emplace_back(std::make_shared<Visual::Material>(gfx, *scene->mMaterials[i], path));
-		for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
-			meshes.emplace_back(ParseMesh(gfx, graph, path, *scene->mMeshes[i]));
-		unsigned long long startID = 0ULL;
-		root = ParseNode(*scene->mRootNode, startID);
-		root->SetScale(params.scale);
-		root->SetPos(params.position);
-		if (flipYZ)
-		{
-			DirectX::XMFLOAT3 rot = params.rotation;
-			rot.x += M_PI_2;
-			root->SetAngle(rot);
-		}
-		else
-			root->SetAngle(params.rotation);
+		return *scene;
 	}
 
 	Model& Model::operator=(Model&& model) noexcept
@@ -4,6 +4,11 @@
 #include "Visuals.h"
 #include "BasicException.h"
 
+namespace Assimp
+{
+	class Importer;
+}
+
 namespace GFX::Shape
 {
 	class Model : public IObject
@@ -16,16 +21,22 @@ namespace GFX::Shape
 
 		std::shared_ptr<Mesh> ParseMesh(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& path, aiMesh& mesh);
 		std::unique_ptr<ModelNode> ParseNode(const aiNode& node, uint64_t& id);
+		void ParseScene(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& file, const aiScene& scene, const ModelParams& params);
 
 	public:
 		inline Model(Model&& model) noexcept { *this = std::forward<Model&&>(model); }
 
 		Model(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& file, const ModelParams& params);
+		// Creates model from scene already imported by ReadFile(), scene can be shared by multiple models
+		Model(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& file, const aiScene& scene, const ModelParams& params);
 		Model& operator=(Model&& model) noexcept;
 		Model(const Model&) = delete;
 		Model& operator=(const Model&) = delete;
 		virtual ~Model() = default;
 
+		// Does not require graphics so can be called from any thread, scene lives as long as importer
+		static const aiScene& ReadFile(Assimp::Importer& importer, const std::string& file);
+
 		constexpr bool IsOutline() const noexcept { return isOutline; }
 		inline void Submit(uint64_t channelFilter) noexcept override { root->Submit(channelFilter); }
 
@@ -1,4 +1,5 @@
 #include "ModelNode.h"
+#include <cstring>
 
 namespace GFX::Shape
 {
@@ -30,9 +31,19 @@ namespace GFX::Shape
 
 	void ModelNode::Submit(uint64_t channelFilter, const DirectX::XMMATRIX& higherTransform) noexcept
 	{
+		// Node transform is needed right away for children
+		ResolveTransform();
 		const DirectX::XMMATRIX transformMatrix = DirectX::XMLoadFloat4x4(transform.get()) *
 			DirectX::XMLoadFloat4x4(&baseTransform) * higherTransform;
-		DirectX::XMStoreFloat4x4(currentTransform.get(), transformMatrix);
+		DirectX::XMFLOAT4X4 newTransform;
+		DirectX::XMStoreFloat4x4(&newTransform, transformMatrix);
+		// Refit scene hierarchy only for moved nodes
+		if (std::memcmp(&newTransform, currentTransform.get(), sizeof(DirectX::XMFLOAT4X4)))
+		{
+			*currentTransform = newTransform;
+			for (const auto& mesh : meshes)
+				mesh->UpdateWorldBox(transformMatrix);
+		}
 		for (const auto& mesh : meshes)
 			mesh->Submit(channelFilter);
 		for (const auto& child : children)
@@ -1,82 +1,77 @@
 #include "Mouse.h"
 #include "WinAPI.h"
+#ifndef WHEEL_DELTA
+#define WHEEL_DELTA 120
+#endif
 
 namespace WinAPI
 {
-	void Mouse::TrimBuffer() noexcept
+	void Mouse::SetPosition(int x, int y) noexcept
 	{
-		while (eventBuffer.size() > BUFFER_SIZE)
-			eventBuffer.pop_back();
+		this->x.store(x, std::memory_order_relaxed);
+		this->y.store(y, std::memory_order_relaxed);
 	}
 
 	void Mouse::OnLeftDown(int x, int y) noexcept
 	{
 		left = true;
-		eventBuffer.emplace_back(Event::Type::LeftDown, *this, x, y);
-		this->x = x;
-		this->y = y;
-		TrimBuffer();
+		PushEvent(Event::Type::LeftDown, x, y);
+		SetPosition(x, y);
 	}
 
 	void Mouse::OnLeftUp(int x, int y) noexcept
 	{
 		left = false;
-		eventBuffer.emplace_back(Event::Type::LeftUp, *this, x, y);
-		this->x = x;
-		this->y = y;
-		TrimBuffer();
+		PushEvent(Event::Type::LeftUp, x, y);
+		SetPosition(x, y);
 	}
 
 	void Mouse::OnRightDown(int x, int y) noexcept
 	{
 		right = true;
-		eventBuffer.emplace_back(Event::Type::RightDown, *this, x, y);
-		this->x = x;
-		this->y = y;
-		TrimBuffer();
+		PushEvent(Event::Type::RightDown, x, y);
+		SetPosition(x, y);
 	}
 
 	void Mouse::OnRightUp(int x, int y) noexcept
 	{
 		right = false;
-		eventBuffer.emplace_back(Event::Type::RightUp, *this, x, y);
-		this->x = x;
-		this->y = y;
-		TrimBuffer();
+		PushEvent(Event::Type::RightUp, x, y);
+		SetPosition(x, y);
 	}
 
 	void Mouse::OnWheelDown(int x, int y) noexcept
 	{
 		wheel = true;
-		eventBuffer.emplace_back(Event::Type::WheelDown, *this, x, y);
-		this->x = x;
-		this->y = y;
-		TrimBuffer();
+		PushEvent(Event::Type::WheelDown, x, y);
+		SetPosition(x, y);
 	}
 
 	void Mouse::OnWheelUp(int x, int y) noexcept
 	{
 		wheel = false;
-		eventBuffer.emplace_back(Event::Type::WheelUp, *this, x, y);
-		this->x = x;
-		this->y = y;
-		TrimBuffer();
+		PushEvent(Event::Type::WheelUp, x, y);
+		SetPosition(x, y);
 	}
 
 	void Mouse::OnMouseMove(int x, int y) noexcept
 	{
-		eventBuffer.emplace_back(Event::Type::Move, *this, x, y);
-		this->x = x;
-		this->y = y;
-		TrimBuffer();
+		PushEvent(Event::Type::Move, x, y);
+		SetPosition(x, y);
 	}
 
 	void Mouse::OnRawDelta(int dx, int dy) noexcept
 	{
-		this->x += dx;
-		this->y += dy;
-		eventBuffer.emplace_back(Event::Type::RawMove, *this, Event::RawInput({ dx, dy }));
-		TrimBuffer();
+		SetPosition(GetX() + dx, GetY() + dy);
+		const auto time = std::chrono::steady_clock::now();
+		if (pendingDelta.count == 0)
+			pendingDelta.first = time;
+		pendingDelta.dX += dx;
+		pendingDelta.dY += dy;
+		pendingDelta.last = time;
+		++pendingDelta.count;
+		if (rawBuffer.Push(pendingDelta))
+			pendingDelta = {};
 	}
 
 	void Mouse::OnWheelRotation(int rotation) noexcept
@@ -97,38 +92,44 @@ namespace WinAPI
 
 	void Mouse::OnWheelForward() noexcept
 	{
-		eventBuffer.emplace_back(Event::Type::WheelForward, *this, x, y);
-		TrimBuffer();
+		PushEvent(Event::Type::WheelForward, GetX(), GetY());
 	}
 
 	void Mouse::OnWheelBackward() noexcept
 	{
-		eventBuffer.emplace_back(Event::Type::WheelBackward, *this, x, y);
-		TrimBuffer();
+		PushEvent(Event::Type::WheelBackward, GetX(), GetY());
 	}
 
 	void Mouse::OnEnter() noexcept
 	{
 		window = true;
-		eventBuffer.emplace_back(Event::Type::Enter, *this, x, y);
-		TrimBuffer();
+		PushEvent(Event::Type::Enter, GetX(), GetY());
 	}
 
 	void Mouse::OnLeave() noexcept
 	{
 		window = false;
-		eventBuffer.emplace_back(Event::Type::Leave, *this, x, y);
-		TrimBuffer();
+		PushEvent(Event::Type::Leave, GetX(), GetY());
 	}
 
 	std::optional<Mouse::Event> Mouse::Read() noexcept
 	{
-		if (eventBuffer.size() > 0)
+		return eventBuffer.Pop();
+	}
+
+	std::optional<Mouse::RawDelta> Mouse::ReadRawDelta() noexcept
+	{
+		std::optional<RawDelta> delta = rawBuffer.Pop();
+		if (delta)
 		{
-			Event input = eventBuffer.front();
-			eventBuffer.pop_front();
-			return input;
+			while (auto next = rawBuffer.Pop())
+			{
+				delta->dX += next->dX;
+				delta->dY += next->dY;
+				delta->count += next->count;
+				delta->last = next->last;
+			}
 		}
-		return {};
+		return delta;
 	}
 }
\ No newline at end of file
@@ -1,9 +1,10 @@
 #pragma once
-#include <deque>
-#include <optional>
+#include "RingBuffer.h"
+#include <chrono>
 
 namespace WinAPI
 {
+	// Events are written by window procedure and can be read from other thread
 	class Mouse
 	{
 		friend class Window;
@@ -16,28 +17,25 @@ namespace WinAPI
 			{
 				LeftUp, LeftDown, RightUp, RightDown,
 				WheelUp, WheelDown, WheelForward, WheelBackward,
-				Move, RawMove, Enter, Leave
-			};
-			struct RawInput
-			{
-				int dX;
-				int dY;
+				Move, Enter, Leave
 			};
 
 		private:
-			Type type;
-			int x;
-			int y;
-			RawInput delta;
-			bool left;
-			bool right;
-			bool wheel;
+			Type type = Type::Move;
+			int x = 0;
+			int y = 0;
+			int dX = 0;
+			int dY = 0;
+			bool left = false;
+			bool right = false;
+			bool wheel = false;
+			std::chrono::steady_clock::time_point time;
 
 		public:
-			constexpr Event(Type type, const Mouse& mouse, int x, int y) noexcept
-				: type(type), x(x), y(y), delta({ x - mouse.x, y - mouse.y }), left(mouse.left), right(mouse.right), wheel(mouse.wheel) {}
-			constexpr Event(Type type, const Mouse& mouse, RawInput delta) noexcept
-				: type(type), x(mouse.x), y(mouse.y), delta(delta), left(mouse.left), right(mouse.right), wheel(mouse.wheel) {}
+			Event() = default;
+			inline Event(Type type, const Mouse& mouse, int x, int y) noexcept
+				: type(type), x(x), y(y), dX(x - mouse.GetX()), dY(y - mouse.GetY()), left(mouse.IsLeftDown()),
+				right(mouse.IsRightDown()), wheel(mouse.IsWheelDown()), time(std::chrono::steady_clock::now()) {}
 			Event(const Event&) = default;
 			Event& operator=(const Event&) = default;
 			~Event() = default;
@@ -46,26 +44,43 @@ namespace WinAPI
 			constexpr std::pair<int, int> GetPosition() const noexcept { return std::move(std::make_pair(x, y)); }
 			constexpr int GetX() const noexcept { return x; }
 			constexpr int GetY() const noexcept { return y; }
-			constexpr int GetDX() const noexcept { return delta.dX; }
-			constexpr int GetDY() const noexcept { return delta.dY; }
+			constexpr int GetDX() const noexcept { return dX; }
+			constexpr int GetDY() const noexcept { return dY; }
 			constexpr bool IsLeftDown() const noexcept { return left; }
 			constexpr bool IsRightDown() const noexcept { return right; }
 			constexpr bool IsWheelDown() const noexcept { return wheel; }
+			constexpr std::chrono::steady_clock::time_point GetTime() const noexcept { return time; }
+		};
+
+		// Sum of raw movement reported since last read
+		struct RawDelta
+		{
+			int dX = 0;
+			int dY = 0;
+			// Number of raw messages merged into this delta
+			uint32_t count = 0;
+			std::chrono::steady_clock::time_point first;
+			std::chrono::steady_clock::time_point last;
 		};
 
 	private:
 		static constexpr size_t BUFFER_SIZE = 256U;
+		static constexpr size_t RAW_BUFFER_SIZE = 256U;
 
-		int x = 0;
-		int y = 0;
+		std::atomic_int x = 0;
+		std::atomic_int y = 0;
 		int wheelRotation = 0;
-		bool left = false;
-		bool right = false;
-		bool wheel = false;
-		bool window = false;
-		std::deque<Event> eventBuffer;
+		std::atomic_bool left = false;
+		std::atomic_bool right = false;
+		std::atomic_bool wheel = false;
+		std::atomic_bool window = false;
+		Utils::RingBuffer<Event, BUFFER_SIZE> eventBuffer;
+		Utils::RingBuffer<RawDelta, RAW_BUFFER_SIZE> rawBuffer;
+		// Movement not fitting into full raw buffer, added to next pushed delta
+		RawDelta pendingDelta;
 
-		void TrimBuffer() noexcept;
+		inline void PushEvent(Event::Type type, int x, int y) noexcept { eventBuffer.Push({ type, *this, x, y }); }
+		void SetPosition(int x, int y) noexcept;
 		void OnLeftDown(int x, int y) noexcept;
 		void OnLeftUp(int x, int y) noexcept;
 		void OnRightDown(int x, int y) noexcept;
@@ -86,16 +101,18 @@ namespace WinAPI
 		Mouse& operator=(const Mouse&) = delete;
 		~Mouse() = default;
 
-		constexpr std::pair<int, int> GetPosition() const noexcept { return std::move(std::make_pair(x, y)); }
-		constexpr int GetX() const noexcept { return x; }
-		constexpr int GetY() const noexcept { return y; }
-		constexpr bool IsLeftDown() const noexcept { return left; }
-		constexpr bool IsRightDown() const noexcept { return right; }
-		constexpr bool IsWheelDown() const noexcept { return wheel; }
-		constexpr bool IsInWindow() const noexcept { return window; }
-		inline bool IsInput() const noexcept { return eventBuffer.size(); }
-		inline void Flush() noexcept { eventBuffer = std::deque<Event>{}; }
+		inline std::pair<int, int> GetPosition() const noexcept { return std::move(std::make_pair(GetX(), GetY())); }
+		inline int GetX() const noexcept { return x.load(std::memory_order_relaxed); }
+		inline int GetY() const noexcept { return y.load(std::memory_order_relaxed); }
+		inline bool IsLeftDown() const noexcept { return left.load(std::memory_order_relaxed); }
+		inline bool IsRightDown() const noexcept { return right.load(std::memory_order_relaxed); }
+		inline bool IsWheelDown() const noexcept { return wheel.load(std::memory_order_relaxed); }
+		inline bool IsInWindow() const noexcept { return window.load(std::memory_order_relaxed); }
+		inline bool IsInput() const noexcept { return !eventBuffer.IsEmpty(); }
+		inline void Flush() noexcept { eventBuffer.Clear(); rawBuffer.Clear(); }
 
 		std::optional<Event> Read() noexcept;
+		// Coalesces all raw movement waiting in buffer into single delta
+		std::optional<RawDelta> ReadRawDelta() noexcept;
 	};
 }
\ No newline at end of file
@@ -12,7 +12,8 @@ namespace GFX::Resource
 		static inline GfxResPtr<NullGeometryShader> Get(Graphics& gfx) noexcept { return Codex::Resolve<NullGeometryShader>(gfx); }
 		static inline std::string GenerateRID() noexcept { return "NG"; }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->GSSetShader(nullptr, nullptr, 0U); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->GSSetShader(nullptr, nullptr, 0U); GetBoundState(gfx, PipelineSlot::GeometryShader) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::GeometryShader; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(); }
 	};
 
@@ -12,7 +12,8 @@ namespace GFX::Resource
 		static inline GfxResPtr<NullPixelShader> Get(Graphics& gfx) noexcept { return Codex::Resolve<NullPixelShader>(gfx); }
 		static inline std::string GenerateRID() noexcept { return "NP"; }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->PSSetShader(nullptr, nullptr, 0U); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->PSSetShader(nullptr, nullptr, 0U); GetBoundState(gfx, PipelineSlot::PixelShader) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::PixelShader; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(); }
 	};
 
@@ -2,74 +2,95 @@
 
 namespace GFX
 {
-	DirectX::XMMATRIX Object::CreateTransformMatrix() const noexcept
+	void Object::MarkDirty() noexcept
 	{
-		float scale = GetScale();
-		return DirectX::XMMatrixScaling(scale, scale, scale) *
-			DirectX::XMMatrixRotationRollPitchYawFromVector(DirectX::XMLoadFloat3(&GetAngle())) *
-			DirectX::XMMatrixTranslationFromVector(DirectX::XMLoadFloat3(&GetPos()));
-	}
-
-	Object::Object(const DirectX::XMFLOAT3& position) noexcept : BasicObject(position)
-	{
-		DirectX::XMStoreFloat4x4(transform.get(), DirectX::XMMatrixTranslationFromVector(DirectX::XMLoadFloat3(&position)));
-	}
-
-	Object::Object(const std::string& name) noexcept : BasicObject(name)
-	{
-		DirectX::XMStoreFloat4x4(transform.get(), DirectX::XMMatrixIdentity());
+		if (!transformDirty)
+		{
+			transformDirty = true;
+			nextDirty = firstDirty;
+			if (firstDirty)
+				firstDirty->prevDirty = this;
+			firstDirty = this;
+		}
 	}
 
-	Object::Object(const DirectX::XMFLOAT3& position, const std::string& name, float scale) noexcept
-		: BasicObject(position, name, scale)
+	void Object::UnlinkDirty() noexcept
 	{
-		DirectX::XMStoreFloat4x4(transform.get(), DirectX::XMMatrixScaling(scale, scale, scale) *
-			DirectX::XMMatrixTranslationFromVector(DirectX::XMLoadFloat3(&position)));
+		if (transformDirty)
+		{
+			if (prevDirty)
+				prevDirty->nextDirty = nextDirty;
+			else
+				firstDirty = nextDirty;
+			if (nextDirty)
+				nextDirty->prevDirty = prevDirty;
+			prevDirty = nextDirty = nullptr;
+			transformDirty = false;
+		}
 	}
 
-	void Object::SetAngle(const DirectX::XMFLOAT3& meshAngle) noexcept
+	void Object::ResolveTransform() noexcept
 	{
-		BasicObject::SetAngle(meshAngle);
-		UpdateTransformMatrix();
+		if (transformDirty)
+		{
+			StoreTransform();
+			UnlinkDirty();
+		}
 	}
 
-	void Object::SetScale(float newScale) noexcept
+	Object::Object(const DirectX::XMFLOAT3& position) noexcept : BasicObject(position)
 	{
-		BasicObject::SetScale(newScale);
-		UpdateTransformMatrix();
+		StoreTransform();
 	}
 
-	void Object::SetPos(const DirectX::XMFLOAT3& position) noexcept
+	Object::Object(const std::string& name) noexcept : BasicObject(name)
 	{
-		BasicObject::SetPos(position);
-		UpdateTransformMatrix();
+		StoreTransform();
 	}
 
-	void Object::Update(const DirectX::XMFLOAT3& delta, const DirectX::XMFLOAT3& deltaAngle) noexcept
+	Object::Object(const DirectX::XMFLOAT3& position, const std::string& name, float scale) noexcept
+		: BasicObject(position, name, scale)
 	{
-		BasicObject::UpdatePos(delta);
-		UpdateAngle(deltaAngle);
+		StoreTransform();
 	}
 
-	void Object::UpdatePos(const DirectX::XMFLOAT3& delta) noexcept
+	Object::Object(const Object& object) noexcept
+		: GfxObject(object), BasicObject(object), localScale(object.localScale)
 	{
-		BasicObject::UpdatePos(delta);
-		UpdateTransformMatrix();
+		// Links of source object are not shared, copy joins list on its own
+		if (object.transformDirty)
+			MarkDirty();
 	}
 
-	void Object::UpdateAngle(const DirectX::XMFLOAT3& deltaAngle) noexcept
+	Object& Object::operator=(const Object& object) noexcept
 	{
-		BasicObject::UpdateAngle(deltaAngle);
-		UpdateTransformMatrix();
+		if (this != &object)
+		{
+			GfxObject::operator=(object);
+			BasicObject::operator=(object);
+			localScale = object.localScale;
+			if (object.transformDirty)
+				MarkDirty();
+		}
+		return *this;
 	}
 
-	bool Object::Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept
+	void Object::FlushTransforms()
 	{
-		if (probe.VisitObject(buffer))
+		// Batch keeps pointers only until Flush() below, objects cannot be destroyed in the meantime
+		size_t count = 0;
+		for (Object* object = firstDirty; object; object = object->nextDirty)
+			++count;
+		transformBatch.Reserve(count);
+		for (Object* object = firstDirty; object;)
 		{
-			UpdateTransformMatrix();
-			return true;
+			Object* next = object->nextDirty;
+			transformBatch.Push(object->trs, object->localScale, *object->transform);
+			object->prevDirty = object->nextDirty = nullptr;
+			object->transformDirty = false;
+			object = next;
 		}
-		return false;
+		firstDirty = nullptr;
+		transformBatch.Flush();
 	}
 }
\ No newline at end of file
@@ -6,25 +6,42 @@ namespace GFX
 {
 	class Object : public GfxObject, public BasicObject
 	{
+		// World matrices of changed objects are computed together before submission
+		static inline TransformBatch transformBatch;
+		// Intrusive list of objects with outdated world matrix, marking object never allocates
+		static inline Object* firstDirty = nullptr;
+
+		// Scaling of mesh applied before object transform
+		DirectX::XMFLOAT3 localScale = { 1.0f, 1.0f, 1.0f };
+		bool transformDirty = false;
+		Object* prevDirty = nullptr;
+		Object* nextDirty = nullptr;
+
+		inline void StoreTransform() noexcept { DirectX::XMStoreFloat4x4(transform.get(), TransformBatch::GetMatrix(trs, localScale)); }
+		void MarkDirty() noexcept;
+		void UnlinkDirty() noexcept;
+
 	protected:
-		DirectX::XMMATRIX CreateTransformMatrix() const noexcept;
+		inline void SetLocalScale(const DirectX::XMFLOAT3& scale) noexcept { localScale = scale; MarkDirty(); }
+		// Updates world matrix immediately, for objects needing it before FlushTransforms()
+		void ResolveTransform() noexcept;
 
 	public:
 		Object(const DirectX::XMFLOAT3& position) noexcept;
 		Object(const std::string& name = "") noexcept;
 		Object(const DirectX::XMFLOAT3& position, const std::string& name, float scale = 1.0f) noexcept;
-		Object(const Object&) = default;
-		Object& operator=(const Object&) = default;
-		virtual ~Object() = default;
+		Object(const Object& object) noexcept;
+		Object& operator=(const Object& object) noexcept;
+		virtual ~Object() { UnlinkDirty(); }
 
-		virtual inline void UpdateTransformMatrix() noexcept { DirectX::XMStoreFloat4x4(transform.get(), CreateTransformMatrix()); }
+		// Computes world matrices of all changed objects, has to be called before they are submitted
+		static void FlushTransforms();
+		static inline const TransformBatch& GetTransformBatch() noexcept { return transformBatch; }
 
-		void SetAngle(const DirectX::XMFLOAT3& meshAngle) noexcept override;
-		void SetScale(float newScale) noexcept override;
-		void SetPos(const DirectX::XMFLOAT3& position) noexcept override;
-		void Update(const DirectX::XMFLOAT3& delta, const DirectX::XMFLOAT3& deltaAngle) noexcept override;
-		void UpdatePos(const DirectX::XMFLOAT3& delta) noexcept override;
-		void UpdateAngle(const DirectX::XMFLOAT3& deltaAngle) noexcept override;
-		bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override;
+		inline void SetAngle(const DirectX::XMFLOAT3& meshAngle) noexcept override { BasicObject::SetAngle(meshAngle); MarkDirty(); }
+		inline void SetScale(float newScale) noexcept override { BasicObject::SetScale(newScale); MarkDirty(); }
+		inline void SetPos(const DirectX::XMFLOAT3& position) noexcept override { BasicObject::SetPos(position); MarkDirty(); }
+		inline void UpdatePos(const DirectX::XMFLOAT3& delta) noexcept override { BasicObject::UpdatePos(delta); MarkDirty(); }
+		inline void UpdateAngle(const DirectX::XMFLOAT3& deltaAngle) noexcept override { BasicObject::UpdateAngle(deltaAngle); MarkDirty(); }
 	};
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "OccluderGeometry.h"
+#include <algorithm>
+
+namespace GFX::Data
+{
+	OccluderGeometry::OccluderGeometry(const aiMesh& mesh) noexcept
+	{
+		if (mesh.mNumVertices == 0)
+			return;
+		DirectX::XMVECTOR min = DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(mesh.mVertices));
+		DirectX::XMVECTOR max = min;
+		for (unsigned int i = 1; i < mesh.mNumVertices; ++i)
+		{
+			const DirectX::XMVECTOR pos = DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(mesh.mVertices + i));
+			min = DirectX::XMVectorMin(min, pos);
+			max = DirectX::XMVectorMax(max, pos);
+		}
+		DirectX::XMFLOAT3 size;
+		DirectX::XMStoreFloat3(&size, DirectX::XMVectorSubtract(max, min));
+		const float minArea = MIN_AREA_FACTOR * std::max({ size.x * size.y, size.y * size.z, size.x * size.z });
+
+		// Gather big enough triangles as (area, face index)
+		std::vector<std::pair<float, unsigned int>> candidates;
+		for (unsigned int i = 0; i < mesh.mNumFaces; ++i)
+		{
+			const auto& face = mesh.mFaces[i];
+			if (face.mNumIndices != 3)
+				continue;
+			const DirectX::XMVECTOR v0 = DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(mesh.mVertices + face.mIndices[0]));
+			const DirectX::XMVECTOR v1 = DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(mesh.mVertices + face.mIndices[1]));
+			const DirectX::XMVECTOR v2 = DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(mesh.mVertices + face.mIndices[2]));
+			const float area = 0.5f * DirectX::XMVectorGetX(DirectX::XMVector3Length(
+				DirectX::XMVector3Cross(DirectX::XMVectorSubtract(v1, v0), DirectX::XMVectorSubtract(v2, v0))));
+			if (area >= minArea)
+				candidates.emplace_back(area, i);
+		}
+		if (candidates.size() > MAX_TRIANGLES)
+		{
+			std::partial_sort(candidates.begin(), candidates.begin() + MAX_TRIANGLES, candidates.end(),
+				[](const auto& t1, const auto& t2) { return t1.first > t2.first; });
+			candidates.resize(MAX_TRIANGLES);
+		}
+
+		// Compact used vertices
+		std::vector<unsigned int> remap(mesh.mNumVertices, UINT_MAX);
+		indices.reserve(candidates.size() * 3);
+		for (const auto& triangle : candidates)
+		{
+			const auto& face = mesh.mFaces[triangle.second];
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				unsigned int& index = remap.at(face.mIndices[i]);
+				if (index == UINT_MAX)
+				{
+					index = static_cast<unsigned int>(vertices.size());
+					vertices.emplace_back(*reinterpret_cast<const DirectX::XMFLOAT3*>(mesh.mVertices + face.mIndices[i]));
+				}
+				indices.emplace_back(index);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include "assimp/scene.h"
+#include <DirectXMath.h>
+#include <vector>
+
+namespace GFX::Data
+{
+	// Coarse occluder made from biggest triangles of mesh, used in CPU occlusion culling
+	class OccluderGeometry
+	{
+		static constexpr size_t MAX_TRIANGLES = 256;
+		// Minimal triangle area relative to biggest face of mesh bounding box
+		static constexpr float MIN_AREA_FACTOR = 0.02f;
+
+		std::vector<DirectX::XMFLOAT3> vertices;
+		std::vector<unsigned int> indices;
+
+	public:
+		OccluderGeometry(const aiMesh& mesh) noexcept;
+		OccluderGeometry(const OccluderGeometry&) = default;
+		OccluderGeometry& operator=(const OccluderGeometry&) = default;
+		~OccluderGeometry() = default;
+
+		constexpr const std::vector<DirectX::XMFLOAT3>& GetVertices() const noexcept { return vertices; }
+		constexpr const std::vector<unsigned int>& GetIndices() const noexcept { return indices; }
+		inline size_t GetTriangleCount() const noexcept { return indices.size() / 3; }
+		inline bool IsEmpty() const noexcept { return indices.size() == 0; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "OcclusionBuffer.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GFX::Pipeline
+{
+	void OcclusionBuffer::SetupTriangle(Triangle& triangle, const DirectX::XMFLOAT4& v0, const DirectX::XMFLOAT4& v1, const DirectX::XMFLOAT4& v2) const noexcept
+	{
+		triangle.minX = triangle.minY = 0;
+		triangle.maxX = triangle.maxY = -1;
+		// Skip triangles crossing near plane, they can only make culling less aggressive
+		if (v0.w <= NEAR_EPSILON || v1.w <= NEAR_EPSILON || v2.w <= NEAR_EPSILON)
+			return;
+		// Same as rasterizer culling back faces, in screen space clockwise triangles are front facing
+		const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+		if (area <= FLT_EPSILON)
+			return;
+
+		const int width = static_cast<int>(GetWidth());
+		const int height = static_cast<int>(GetHeight());
+		triangle.minX = std::max(0, static_cast<int>(std::floor(std::min({ v0.x, v1.x, v2.x }))));
+		triangle.maxX = std::min(width - 1, static_cast<int>(std::ceil(std::max({ v0.x, v1.x, v2.x }))));
+		triangle.minY = std::max(0, static_cast<int>(std::floor(std::min({ v0.y, v1.y, v2.y }))));
+		triangle.maxY = std::min(height - 1, static_cast<int>(std::ceil(std::max({ v0.y, v1.y, v2.y }))));
+		if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+			return;
+
+		// Edges opposite to v2, v0, v1
+		triangle.edgeA = { v0.y - v1.y, v1.x - v0.x, v1.y * v0.x - v1.x * v0.y };
+		triangle.edgeB = { v1.y - v2.y, v2.x - v1.x, v2.y * v1.x - v2.x * v1.y };
+		triangle.edgeC = { v2.y - v0.y, v0.x - v2.x, v0.y * v2.x - v0.x * v2.y };
+		// z = z0 + (E_C(p) * (z1 - z0) + E_A(p) * (z2 - z0)) / area, where E_C is weight of v1 and E_A of v2
+		const float dz1 = (v1.z - v0.z) / area;
+		const float dz2 = (v2.z - v0.z) / area;
+		triangle.depth =
+		{
+			triangle.edgeC.x * dz1 + triangle.edgeA.x * dz2,
+			triangle.edgeC.y * dz1 + triangle.edgeA.y * dz2,
+			v0.z + triangle.edgeC.z * dz1 + triangle.edgeA.z * dz2
+		};
+	}
+
+	void OcclusionBuffer::RasterizeBand(uint32_t minY, uint32_t maxY) noexcept
+	{
+		const DirectX::XMVECTOR offsetX = DirectX::XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+		const DirectX::XMVECTOR zero = DirectX::XMVectorZero();
+		auto& target = levels.front();
+		for (size_t i = 0; i < triangleCount; ++i)
+		{
+			const Triangle& triangle = triangles.at(i);
+			const int startY = std::max(triangle.minY, static_cast<int>(minY));
+			const int endY = std::min(triangle.maxY, static_cast<int>(maxY) - 1);
+			if (startY > endY)
+				continue;
+			const DirectX::XMVECTOR edgeAx = DirectX::XMVectorReplicate(triangle.edgeA.x);
+			const DirectX::XMVECTOR edgeBx = DirectX::XMVectorReplicate(triangle.edgeB.x);
+			const DirectX::XMVECTOR edgeCx = DirectX::XMVectorReplicate(triangle.edgeC.x);
+			const DirectX::XMVECTOR depthX = DirectX::XMVectorReplicate(triangle.depth.x);
+			const int startX = triangle.minX & ~3;
+			for (int y = startY; y <= endY; ++y)
+			{
+				const float centerY = static_cast<float>(y) + 0.5f;
+				const DirectX::XMVECTOR rowA = DirectX::XMVectorReplicate(triangle.edgeA.y * centerY + triangle.edgeA.z);
+				const DirectX::XMVECTOR rowB = DirectX::XMVectorReplicate(triangle.edgeB.y * centerY + triangle.edgeB.z);
+				const DirectX::XMVECTOR rowC = DirectX::XMVectorReplicate(triangle.edgeC.y * centerY + triangle.edgeC.z);
+				const DirectX::XMVECTOR rowDepth = DirectX::XMVectorReplicate(triangle.depth.y * centerY + triangle.depth.z);
+				float* row = target.depth.data() + static_cast<size_t>(y) * target.width;
+				for (int x = startX; x <= triangle.maxX; x += 4)
+				{
+					const DirectX::XMVECTOR centerX = DirectX::XMVectorAdd(DirectX::XMVectorReplicate(static_cast<float>(x)), offsetX);
+					const DirectX::XMVECTOR inside = DirectX::XMVectorAndInt(
+						DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorMultiplyAdd(edgeAx, centerX, rowA), zero),
+						DirectX::XMVectorAndInt(
+							DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorMultiplyAdd(edgeBx, centerX, rowB), zero),
+							DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorMultiplyAdd(edgeCx, centerX, rowC), zero)));
+					if (DirectX::XMVector4EqualInt(inside, zero))
+						continue;
+					DirectX::XMFLOAT4* pixels = reinterpret_cast<DirectX::XMFLOAT4*>(row + x);
+					const DirectX::XMVECTOR current = DirectX::XMLoadFloat4(pixels);
+					const DirectX::XMVECTOR depth = DirectX::XMVectorMin(current, DirectX::XMVectorMultiplyAdd(depthX, centerX, rowDepth));
+					DirectX::XMStoreFloat4(pixels, DirectX::XMVectorSelect(current, depth, inside));
+				}
+			}
+		}
+	}
+
+	void OcclusionBuffer::BuildHierarchy() noexcept
+	{
+		for (size_t i = 1, size = levels.size(); i < size; ++i)
+		{
+			const Level& source = levels.at(i - 1);
+			Level& level = levels.at(i);
+			for (uint32_t y = 0; y < level.height; ++y)
+			{
+				const uint32_t y0 = y * 2;
+				const uint32_t y1 = std::min(y0 + 1, source.height - 1);
+				for (uint32_t x = 0; x < level.width; ++x)
+				{
+					const uint32_t x0 = x * 2;
+					const uint32_t x1 = std::min(x0 + 1, source.width - 1);
+					level.depth.at(static_cast<size_t>(y) * level.width + x) = std::max(
+						std::max(source.depth.at(static_cast<size_t>(y0) * source.width + x0), source.depth.at(static_cast<size_t>(y0) * source.width + x1)),
+						std::max(source.depth.at(static_cast<size_t>(y1) * source.width + x0), source.depth.at(static_cast<size_t>(y1) * source.width + x1)));
+				}
+			}
+		}
+	}
+
+	OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height) noexcept
+	{
+		// Rows processed by SIMD in groups of 4 pixels and split in bands between threads
+		width = std::max((width + 3U) & ~3U, 4U);
+		height = std::max((height + BAND_HEIGHT - 1U) / BAND_HEIGHT * BAND_HEIGHT, BAND_HEIGHT);
+		levels.push_back({ width, height, std::vector<float>(static_cast<size_t>(width) * height, 1.0f) });
+		while (width > 1 || height > 1)
+		{
+			width = (width + 1) / 2;
+			height = (height + 1) / 2;
+			levels.push_back({ width, height, std::vector<float>(static_cast<size_t>(width) * height, 1.0f) });
+		}
+	}
+
+	void OcclusionBuffer::Clear() noexcept
+	{
+		for (auto& level : levels)
+			std::fill(level.depth.begin(), level.depth.end(), 1.0f);
+		triangleCount = 0;
+	}
+
+	void OcclusionBuffer::Rasterize(const Utils::FrameVector<Occluder>& occluders, const DirectX::XMMATRIX& viewProjection) noexcept
+	{
+		std::fill(levels.front().depth.begin(), levels.front().depth.end(), 1.0f);
+
+		// Offsets of occluders in shared vertex and triangle arrays
+		Utils::FrameVector<std::pair<size_t, size_t>> offsets;
+		offsets.reserve(occluders.size());
+		size_t vertexCount = 0;
+		triangleCount = 0;
+		for (const auto& occluder : occluders)
+		{
+			offsets.emplace_back(vertexCount, triangleCount);
+			vertexCount += occluder.geometry->GetVertices().size();
+			triangleCount += occluder.geometry->GetTriangleCount();
+		}
+		if (vertices.size() < vertexCount)
+			vertices.resize(vertexCount);
+		if (triangles.size() < triangleCount)
+			triangles.resize(triangleCount);
+
+		auto& pool = Utils::ThreadPool::Get();
+		const float halfWidth = 0.5f * GetWidth();
+		const float halfHeight = 0.5f * GetHeight();
+		pool.ParallelFor(occluders.size(), [&](size_t begin, size_t end)
+			{
+				PROFILE_SCOPE("Transform occluders");
+				for (size_t i = begin; i < end; ++i)
+				{
+					const auto& occluder = occluders.at(i);
+					const DirectX::XMMATRIX transform = DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&occluder.transform), viewProjection);
+					DirectX::XMFLOAT4* screen = vertices.data() + offsets.at(i).first;
+					for (const auto& vertex : occluder.geometry->GetVertices())
+					{
+						DirectX::XMStoreFloat4(screen, DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&vertex), transform));
+						if (screen->w > NEAR_EPSILON)
+						{
+							const float invW = 1.0f / screen->w;
+							screen->x = (screen->x * invW + 1.0f) * halfWidth;
+							screen->y = (1.0f - screen->y * invW) * halfHeight;
+							screen->z *= invW;
+						}
+						++screen;
+					}
+					screen = vertices.data() + offsets.at(i).first;
+					Triangle* triangle = triangles.data() + offsets.at(i).second;
+					const auto& indices = occluder.geometry->GetIndices();
+					for (size_t j = 0, size = indices.size(); j < size; j += 3, ++triangle)
+						SetupTriangle(*triangle, screen[indices.at(j)], screen[indices.at(j + 1)], screen[indices.at(j + 2)]);
+				}
+			}, 8U);
+
+		const uint32_t bands = GetHeight() / BAND_HEIGHT;
+		pool.ParallelFor(bands, [this](size_t begin, size_t end)
+			{
+				PROFILE_SCOPE("Rasterize occluders");
+				RasterizeBand(static_cast<uint32_t>(begin) * BAND_HEIGHT, static_cast<uint32_t>(end) * BAND_HEIGHT);
+			});
+		BuildHierarchy();
+	}
+
+	bool OcclusionBuffer::IsVisible(const Data::BoundingBox& box, const DirectX::XMMATRIX& transform) const noexcept
+	{
+		DirectX::XMFLOAT3 corners[8];
+		box.GetCorners(corners);
+		float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+		for (const auto& corner : corners)
+		{
+			DirectX::XMFLOAT4 position;
+			DirectX::XMStoreFloat4(&position, DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&corner), transform));
+			// Box crossing near plane is always treated as visible (also handles NaNs)
+			if (!(position.w > NEAR_EPSILON))
+				return true;
+			const float invW = 1.0f / position.w;
+			minX = std::min(minX, position.x * invW);
+			maxX = std::max(maxX, position.x * invW);
+			minY = std::min(minY, position.y * invW);
+			maxY = std::max(maxY, position.y * invW);
+			minZ = std::min(minZ, position.z * invW);
+		}
+		if (minZ <= 0.0f)
+			return true;
+
+		const float width = static_cast<float>(GetWidth());
+		const float height = static_cast<float>(GetHeight());
+		// Screen rectangle rounded outwards
+		const int left = std::max(0, static_cast<int>(std::floor((minX + 1.0f) * 0.5f * width)));
+		const int right = std::min(static_cast<int>(GetWidth()) - 1, static_cast<int>(std::floor((maxX + 1.0f) * 0.5f * width)));
+		const int top = std::max(0, static_cast<int>(std::floor((1.0f - maxY) * 0.5f * height)));
+		const int bottom = std::min(static_cast<int>(GetHeight()) - 1, static_cast<int>(std::floor((1.0f - minY) * 0.5f * height)));
+		if (left > right || top > bottom)
+			return true;
+
+		// Pick level where rectangle covers at most QUERY_SIZE texels in each dimension
+		size_t level = 0;
+		const uint32_t extent = static_cast<uint32_t>(std::max(right - left, bottom - top)) / QUERY_SIZE;
+		while ((extent >> level) > 0 && level + 1 < levels.size())
+			++level;
+		const Level& data = levels.at(level);
+		for (int y = top >> level, endY = bottom >> level; y <= endY; ++y)
+			for (int x = left >> level, endX = right >> level; x <= endX; ++x)
+				if (minZ <= data.depth.at(static_cast<size_t>(y) * data.width + x))
+					return true;
+		return false;
+	}
+
+	float OcclusionBuffer::GetDepthCoverage(float minX, float minY, float maxX, float maxY, float minDepth, float maxDepth) const noexcept
+	{
+		if (triangleCount == 0)
+			return 0.0f;
+		const Level& data = levels.front();
+		const float width = static_cast<float>(data.width);
+		const float height = static_cast<float>(data.height);
+		const int left = std::max(0, static_cast<int>(std::floor((minX + 1.0f) * 0.5f * width)));
+		const int right = std::min(static_cast<int>(data.width) - 1, static_cast<int>(std::floor((maxX + 1.0f) * 0.5f * width)));
+		const int top = std::max(0, static_cast<int>(std::floor((1.0f - maxY) * 0.5f * height)));
+		const int bottom = std::min(static_cast<int>(data.height) - 1, static_cast<int>(std::floor((1.0f - minY) * 0.5f * height)));
+		if (left > right || top > bottom)
+			return 0.0f;
+
+		size_t inside = 0;
+		for (int y = top; y <= bottom; ++y)
+		{
+			for (int x = left; x <= right; ++x)
+			{
+				const float depth = data.depth.at(static_cast<size_t>(y) * data.width + x);
+				if (depth >= minDepth && depth <= maxDepth)
+					++inside;
+			}
+		}
+		return static_cast<float>(inside) / static_cast<float>((right - left + 1) * (bottom - top + 1));
+	}
+}
\ No newline at end of file
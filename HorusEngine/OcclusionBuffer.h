@@ -0,0 +1,70 @@
+#pragma once
+#include "OccluderGeometry.h"
+#include "BoundingBox.h"
+#include "FrameArena.h"
+#include <cstdint>
+
+namespace GFX::Pipeline
+{
+	// Low resolution software depth buffer with max depth hierarchy for occlusion queries
+	class OcclusionBuffer
+	{
+		static constexpr uint32_t BAND_HEIGHT = 8U;
+		static constexpr float NEAR_EPSILON = 0.0001f;
+		// Texels checked in single dimension of hierarchy level during query
+		static constexpr uint32_t QUERY_SIZE = 4U;
+
+		struct Level
+		{
+			uint32_t width;
+			uint32_t height;
+			std::vector<float> depth;
+		};
+		struct Triangle
+		{
+			// Edge functions E(x, y) = a * x + b * y + c
+			DirectX::XMFLOAT3 edgeA;
+			DirectX::XMFLOAT3 edgeB;
+			DirectX::XMFLOAT3 edgeC;
+			// Depth plane z(x, y) = a * x + b * y + c
+			DirectX::XMFLOAT3 depth;
+			int minX;
+			int maxX;
+			int minY;
+			int maxY;
+		};
+
+		std::vector<Level> levels;
+		std::vector<DirectX::XMFLOAT4> vertices;
+		std::vector<Triangle> triangles;
+		size_t triangleCount = 0;
+
+		void SetupTriangle(Triangle& triangle, const DirectX::XMFLOAT4& v0, const DirectX::XMFLOAT4& v1, const DirectX::XMFLOAT4& v2) const noexcept;
+		void RasterizeBand(uint32_t minY, uint32_t maxY) noexcept;
+		void BuildHierarchy() noexcept;
+
+	public:
+		struct Occluder
+		{
+			const Data::OccluderGeometry* geometry;
+			DirectX::XMFLOAT4X4 transform;
+		};
+
+		OcclusionBuffer(uint32_t width, uint32_t height) noexcept;
+		OcclusionBuffer(const OcclusionBuffer&) = default;
+		OcclusionBuffer& operator=(const OcclusionBuffer&) = default;
+		~OcclusionBuffer() = default;
+
+		constexpr uint32_t GetWidth() const noexcept { return levels.front().width; }
+		constexpr uint32_t GetHeight() const noexcept { return levels.front().height; }
+		// Triangles written in last rasterization
+		constexpr size_t GetTriangleCount() const noexcept { return triangleCount; }
+
+		// Removes all occluders
+		void Clear() noexcept;
+		void Rasterize(const Utils::FrameVector<Occluder>& occluders, const DirectX::XMMATRIX& viewProjection) noexcept;
+		bool IsVisible(const Data::BoundingBox& box, const DirectX::XMMATRIX& transform) const noexcept;
+		// Part of texels inside NDC rectangle with depth in given range, 0 when no occluders were rasterized
+		float GetDepthCoverage(float minX, float minY, float maxX, float maxY, float minDepth, float maxDepth) const noexcept;
+	};
+}
\ No newline at end of file
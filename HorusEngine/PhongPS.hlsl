@@ -18,8 +18,8 @@ Texture2D spec : register(t2);
 struct PSOut
 {
 	float4 color : SV_TARGET0;    // RGB - color, A = 0.0f
-	float2 normal : SV_TARGET1;
-	float4 specular : SV_TARGET2; // RGB - color, A - power
+	float2 normal : SV_TARGET1;   // RG - octahedral normal
+	float4 specular : SV_TARGET2; // RGB - color, A - power (packed)
 };
 
 PSOut main(float3 worldPos : POSITION, float3 worldNormal : NORMAL
@@ -60,10 +60,10 @@ PSOut main(float3 worldPos : POSITION, float3 worldNormal : NORMAL
 
 #ifdef _TEX_SPEC
 	const float4 specularTex = spec.Sample(splr_AW, tc);
-	pso.specular = float4(specularTex.rgb * cb_specularIntensity,
-		GetSampledSpecularPower(cb_useSpecularPowerAlpha ? specularTex.a : cb_specularPower));
+	pso.specular = EncodeSpecular(specularTex.rgb * cb_specularIntensity,
+		cb_useSpecularPowerAlpha ? specularTex.a : cb_specularPower);
 #else
-	pso.specular = float4(cb_specularColor * cb_specularIntensity, GetSampledSpecularPower(cb_specularPower));
+	pso.specular = EncodeSpecular(cb_specularColor * cb_specularIntensity, cb_specularPower);
 #endif
 	return pso;
 }
\ No newline at end of file
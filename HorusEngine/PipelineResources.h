@@ -3,4 +3,5 @@
 #include "DepthStencilShaderInput.h"
 #include "RenderTarget.h"
 #include "RenderTargetEx.h"
+#include "RenderTargetReadback.h"
 #include "RenderTargetShaderInput.h"
\ No newline at end of file
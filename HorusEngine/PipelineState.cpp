@@ -0,0 +1,60 @@
+#include "PipelineState.h"
+
+namespace GFX::Resource
+{
+	std::array<GfxResPtr<IBindable>, PipelineState::SLOT_COUNT> PipelineState::GetStates(const std::vector<GfxResPtr<IBindable>>& binds) noexcept
+	{
+		std::array<GfxResPtr<IBindable>, SLOT_COUNT> states;
+		for (auto it = binds.rbegin(); it != binds.rend(); ++it)
+		{
+			if (*it != nullptr && IsGroupable(**it))
+			{
+				auto& state = states.at(static_cast<size_t>((*it)->GetPipelineSlot()));
+				if (state == nullptr)
+					state = *it;
+			}
+		}
+		return states;
+	}
+
+	std::string PipelineState::MakeRID(const std::array<GfxResPtr<IBindable>, SLOT_COUNT>& states) noexcept
+	{
+		std::string rid = "PSO";
+		for (const auto& state : states)
+		{
+			rid += "#";
+			if (state != nullptr)
+				rid += state->GetRID();
+		}
+		return rid;
+	}
+
+	void PipelineState::EndFrame() noexcept
+	{
+		lastFrame.bundles = bundleCount.exchange(0);
+		lastFrame.issued = issuedCount.exchange(0);
+		lastFrame.skipped = skippedCount.exchange(0);
+	}
+
+	void PipelineState::Bind(Graphics& gfx)
+	{
+		uint64_t issued = 0;
+		uint64_t skipped = 0;
+		for (size_t i = 0; i < SLOT_COUNT; ++i)
+		{
+			auto& state = states.at(i);
+			if (state == nullptr)
+				continue;
+			if (GetBoundState(gfx, static_cast<PipelineSlot>(i)) == &*state)
+				++skipped;
+			else
+			{
+				state->Bind(gfx);
+				++issued;
+			}
+		}
+		++bundleCount;
+		issuedCount += issued;
+		skippedCount += skipped;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+#include "GfxResPtr.h"
+#include <array>
+#include <atomic>
+
+namespace GFX::Resource
+{
+	// Immutable group of pipeline states bound at once, only states differing from ones already on context are set
+	class PipelineState : public IBindable
+	{
+	public:
+		struct Stats
+		{
+			uint64_t bundles = 0;
+			uint64_t issued = 0;
+			uint64_t skipped = 0;
+		};
+
+	private:
+		static constexpr size_t SLOT_COUNT = static_cast<size_t>(PipelineSlot::None);
+
+		static inline bool enabled = true;
+		static inline std::atomic_uint64_t bundleCount = 0;
+		static inline std::atomic_uint64_t issuedCount = 0;
+		static inline std::atomic_uint64_t skippedCount = 0;
+		static inline Stats lastFrame;
+
+		std::array<GfxResPtr<IBindable>, SLOT_COUNT> states;
+
+		// Later bindables override earlier ones in same slot, as they would when bound one by one
+		static std::array<GfxResPtr<IBindable>, SLOT_COUNT> GetStates(const std::vector<GfxResPtr<IBindable>>& binds) noexcept;
+		static std::string MakeRID(const std::array<GfxResPtr<IBindable>, SLOT_COUNT>& states) noexcept;
+
+	public:
+		inline PipelineState(Graphics& gfx, const std::vector<GfxResPtr<IBindable>>& binds) noexcept : states(GetStates(binds)) {}
+		virtual ~PipelineState() = default;
+
+		static inline GfxResPtr<PipelineState> Get(Graphics& gfx, const std::vector<GfxResPtr<IBindable>>& binds) { return Codex::Resolve<PipelineState>(gfx, binds); }
+		static inline std::string GenerateRID(const std::vector<GfxResPtr<IBindable>>& binds) noexcept { return MakeRID(GetStates(binds)); }
+		// Only immutable states shared through codex can be grouped
+		static inline bool IsGroupable(const IBindable& bind) noexcept { return bind.GetPipelineSlot() != PipelineSlot::None && bind.GetRID() != GetNoCodexRID(); }
+
+		// When disabled passes bind every state separately
+		static constexpr bool& Enabled() noexcept { return enabled; }
+		static constexpr const Stats& GetLastFrameStats() noexcept { return lastFrame; }
+		// Records number of states set separately, without grouping
+		static inline void AddIssued(uint64_t count) noexcept { issuedCount += count; }
+		static void EndFrame() noexcept;
+
+		void Bind(Graphics& gfx) override;
+		inline std::string GetRID() const noexcept override { return MakeRID(states); }
+	};
+
+	template<>
+	struct is_resolvable_by_codex<PipelineState>
+	{
+		static constexpr bool generate{ true };
+	};
+}
\ No newline at end of file
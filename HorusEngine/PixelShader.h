@@ -15,7 +15,8 @@ namespace GFX::Resource
 		static inline GfxResPtr<PixelShader> Get(Graphics& gfx, const std::string& name) { return Codex::Resolve<PixelShader>(gfx, name); }
 		static inline std::string GenerateRID(const std::string& name) noexcept { return "P" + name; }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->PSSetShader(pixelShader.Get(), nullptr, 0U); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->PSSetShader(pixelShader.Get(), nullptr, 0U); GetBoundState(gfx, PipelineSlot::PixelShader) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::PixelShader; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(name); }
 	};
 
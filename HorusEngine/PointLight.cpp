@@ -24,8 +24,8 @@ namespace GFX::Light
 	}
 
 	PointLight::PointLight(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& name, float intensity,
-		const Data::ColorFloat3& color, const DirectX::XMFLOAT3& position, size_t range, float radius)
-		: range(range)
+		const Data::ColorFloat3& color, const DirectX::XMFLOAT3& position, size_t range, float radius, bool castShadows)
+		: range(range), castShadows(castShadows)
 	{
 		Data::CBuffer::DynamicCBuffer buffer(MakeLayout());
 		buffer["lightIntensity"] = intensity;
@@ -48,6 +48,7 @@ namespace GFX::Light
 		ImGui::Columns(2, "##point_light", false);
 		if (ImGui::InputScalar("Range", ImGuiDataType_U64, &range, &STEP))
 			SetAttenuation(range);
+		ImGui::Checkbox("Cast shadows", &castShadows);
 		ImGui::NextColumn();
 		if (ILight::Accept(gfx, probe))
 		{
@@ -8,16 +8,20 @@ namespace GFX::Light
 	class PointLight : public ILight
 	{
 		size_t range;
+		// Lights without shadows can be drawn together in batches
+		bool castShadows;
 
 		static inline Data::CBuffer::DCBLayout MakeLayout() noexcept;
 
 	public:
 		PointLight(Graphics& gfx, Pipeline::RenderGraph& graph, const std::string& name, float intensity,
-			const Data::ColorFloat3& color, const DirectX::XMFLOAT3& position, size_t range, float radius = 0.5f);
+			const Data::ColorFloat3& color, const DirectX::XMFLOAT3& position, size_t range, float radius = 0.5f, bool castShadows = true);
 		inline PointLight(PointLight&& light) noexcept { *this = std::forward<PointLight&&>(light); }
-		inline PointLight& operator=(PointLight&& light) noexcept { this->ILight::operator=(std::forward<ILight&&>(light)); range = light.range;  return *this; }
+		inline PointLight& operator=(PointLight&& light) noexcept { this->ILight::operator=(std::forward<ILight&&>(light)); range = light.range; castShadows = light.castShadows; return *this; }
 		virtual ~PointLight() = default;
 
+		constexpr bool CastsShadows() const noexcept { return castShadows; }
+
 		bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override;
 	};
 }
\ No newline at end of file
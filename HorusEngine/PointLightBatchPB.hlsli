@@ -0,0 +1,10 @@
+static const uint MAX_BATCH_LIGHTS = 16;
+
+cbuffer PointLightBatchBuffer : register(b4)
+{
+	float4 cb_batchLightPos[MAX_BATCH_LIGHTS];    // XYZ - position, W - linear attenuation
+	float4 cb_batchLightColor[MAX_BATCH_LIGHTS];  // RGB - color, A - intensity
+	float4 cb_batchLightParams[MAX_BATCH_LIGHTS]; // X - quadratic attenuation, YZ - view space depth range
+	float4 cb_batchLightRect[MAX_BATCH_LIGHTS];   // Screen rectangle in pixels (left, top, right, bottom)
+	uint cb_batchLightCount;
+};
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "LightUtilsPS.hlsli"
+#include "SamplersPS.hlsli"
+#include "PointLightBatchPB.hlsli"
+#include "HDRGammaPB.hlsli"
+#include "CameraPB.hlsli"
+#include "RenderScalePB.hlsli"
+
+Texture2D colorTex    : register(t4); // RGB - color, A = 0.0f: solid; 0.5f: light source; 1.0f: normal
+Texture2D normalTex   : register(t5); // RG - octahedral normal
+Texture2D specularTex : register(t6); // RGB - color, A - power (packed)
+
+Texture2D depthMap    : register(t8);
+
+struct PSOut
+{
+	float4 color : SV_TARGET0;
+	float4 specular : SV_TARGET1;
+};
+
+// Point lights that do not cast shadows, small ones drawn together in single fullscreen quad
+PSOut main(float2 tc : TEXCOORD, float4 pixel : SV_POSITION)
+{
+	PSOut pso;
+	pso.color = pso.specular = float4(0.0f, 0.0f, 0.0f, 0.0f);
+
+	const float2 uv = tc * cb_renderScale;
+	const float depth = depthMap.Sample(splr_PW, uv).x;
+	const float linearDepth = GetLinearDepth(depth, cb_nearClip, cb_farClip);
+	const float3 position = GetWorldPosition(tc, depth, cb_inverseViewProjection);
+	const bool isSolid = colorTex.Sample(splr_PW, uv).a == 0.0f;
+	float3 normal = float3(0.0f, 0.0f, 0.0f);
+	float4 specularData = float4(0.0f, 0.0f, 0.0f, 0.0f);
+	[branch]
+	if (isSolid)
+	{
+		normal = DecodeNormal(normalTex.Sample(splr_PW, uv).rg);
+		specularData = DecodeSpecular(specularTex.Sample(splr_PW, uv));
+	}
+
+	[loop]
+	for (uint i = 0; i < cb_batchLightCount; ++i)
+	{
+		const float4 rect = cb_batchLightRect[i];
+		const float4 params = cb_batchLightParams[i];
+		[branch]
+		if (all(pixel.xy >= rect.xy) && all(pixel.xy < rect.zw) && linearDepth >= params.y && linearDepth <= params.z)
+		{
+			float3 directionToLight = cb_batchLightPos[i].xyz - position;
+			const float lightDistance = length(directionToLight);
+			const float3 lightColor = DeleteGammaCorr(cb_batchLightColor[i].rgb) *
+				(cb_batchLightColor[i].a / GetAttenuation(cb_batchLightPos[i].w, params.x, lightDistance));
+			directionToLight /= lightDistance;
+
+			if (isSolid)
+			{
+				const float3 diffuse = GetDiffuse(lightColor, directionToLight, normal);
+				pso.color.rgb += diffuse;
+				pso.specular.rgb += GetSpecular(cb_cameraPos, directionToLight, position, normal, diffuse * specularData.rgb, specularData.a);
+			}
+			else
+				pso.color.rgb += lightColor;
+		}
+	}
+	return pso;
+}
\ No newline at end of file
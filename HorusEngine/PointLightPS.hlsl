@@ -4,10 +4,12 @@
 #include "HDRGammaPB.hlsli"
 #include "CameraPB.hlsli"
 #include "BiasPB.hlsli"
+#include "LightBoundsPB.hlsli"
+#include "RenderScalePB.hlsli"
 
 Texture2D colorTex    : register(t4); // RGB - color, A = 0.0f: solid; 0.5f: light source; 1.0f: normal
-Texture2D normalTex   : register(t5); // RG - normal
-Texture2D specularTex : register(t6); // RGB - color, A - power
+Texture2D normalTex   : register(t5); // RG - octahedral normal
+Texture2D specularTex : register(t6); // RGB - color, A - power (packed)
 
 TextureCube shadowMap : register(t7);
 Texture2D depthMap    : register(t8);
@@ -23,14 +25,20 @@ PSOut main(float3 texPos : TEX_POSITION)
 	PSOut pso;
 
 	const float2 tc = float2(0.5f, -0.5f) * (texPos.xy / texPos.z) + 0.5f;
-	const float3 position = GetWorldPosition(tc, depthMap.Sample(splr_PW, tc).x, cb_inverseViewProjection);
+	const float2 uv = tc * cb_renderScale;
+	const float depth = depthMap.Sample(splr_PW, uv).x;
+	// Depth bounds test, geometry outside of light volume cannot be lit
+	const float linearDepth = GetLinearDepth(depth, cb_nearClip, cb_farClip);
+	if (linearDepth < cb_depthBounds.x || linearDepth > cb_depthBounds.y)
+		discard;
+	const float3 position = GetWorldPosition(tc, depth, cb_inverseViewProjection);
 
 	float3 directionToLight = cb_lightPos - position;
 	const float lightDistance = length(directionToLight);
 	const float3 lightColor = DeleteGammaCorr(cb_lightColor) * (cb_lightIntensity / GetAttenuation(cb_atteuationLinear, cb_attenuationQuad, lightDistance));
 	directionToLight /= lightDistance;
 
-	const float isSolid = colorTex.Sample(splr_PW, tc).a;
+	const float isSolid = colorTex.Sample(splr_PW, uv).a;
 	[branch]
 	if (isSolid == 0.0f)
 	{
@@ -40,12 +48,12 @@ PSOut main(float3 texPos : TEX_POSITION)
 		const float shadowLevel = GetShadowLevel(normalize(cb_cameraPos - position), lightDistance, directionToLight, splr_AW, shadowMap, cb_mapSize);
 		if (shadowLevel != 0.0f)
 		{
-			const float3 normal = DecodeNormal(normalTex.Sample(splr_PW, tc).rg);
+			const float3 normal = DecodeNormal(normalTex.Sample(splr_PW, uv).rg);
 			pso.color = float4(lerp(shadowColor, GetDiffuse(lightColor, directionToLight, normal), shadowLevel), 0.0f);
 
 			if (shadowLevel > 0.98f)
 			{
-				const float4 specularData = specularTex.Sample(splr_PW, tc);
+				const float4 specularData = DecodeSpecular(specularTex.Sample(splr_PW, uv));
 				pso.specular = float4(GetSpecular(cb_cameraPos, directionToLight, position, normal,
 					pso.color.rgb * specularData.rgb, specularData.a), 0.0f);
 			}
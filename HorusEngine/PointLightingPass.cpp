@@ -2,11 +2,88 @@
 #include "RenderPassesBase.h"
 #include "PipelineResources.h"
 #include "GfxResources.h"
+#include "Primitives.h"
+#include "PointLight.h"
 
 namespace GFX::Pipeline::RenderPass
 {
+	inline Data::CBuffer::DCBLayout PointLightingPass::MakeBatchLayout() noexcept
+	{
+		static Data::CBuffer::DCBLayout layout;
+		static bool initNeeded = true;
+		if (initNeeded)
+		{
+			layout.Add(DCBElementType::Array, "lightPos");
+			layout["lightPos"].InitArray(DCBElementType::Float4, MAX_BATCH_LIGHTS);
+			layout.Add(DCBElementType::Array, "lightColor");
+			layout["lightColor"].InitArray(DCBElementType::Float4, MAX_BATCH_LIGHTS);
+			layout.Add(DCBElementType::Array, "lightParams");
+			layout["lightParams"].InitArray(DCBElementType::Float4, MAX_BATCH_LIGHTS);
+			layout.Add(DCBElementType::Array, "lightRect");
+			layout["lightRect"].InitArray(DCBElementType::Float4, MAX_BATCH_LIGHTS);
+			layout.Add(DCBElementType::UInteger, "lightCount");
+			initNeeded = false;
+		}
+		return layout;
+	}
+
+	void PointLightingPass::ExecuteBatch(Graphics& gfx, const Utils::FrameVector<uint32_t>& batch, uint64_t batchArea)
+	{
+		DRAW_TAG_START(gfx, GetName() + "_batch");
+		mainCamera->BindCamera(gfx);
+		BindAll(gfx);
+		for (auto& bind : batchBinds)
+			bind->Bind(gfx);
+
+		auto& jobs = GetJobs();
+		for (size_t offset = 0, size = batch.size(); offset < size;)
+		{
+			auto& buffer = batchBuffer->GetBuffer();
+			// Big lights are drawn alone so union of light rectangles stays tight
+			size_t count = 1;
+			if (GetBounds(batch.at(offset)).GetArea() <= batchArea)
+			{
+				while (offset + count < size && count < MAX_BATCH_LIGHTS && GetBounds(batch.at(offset + count)).GetArea() <= batchArea)
+					++count;
+			}
+			// Whole batch is limited to union of light rectangles and depth ranges
+			LightBounds::Screen area = GetBounds(batch.at(offset));
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint32_t index = batch.at(offset + i);
+				const auto& light = dynamic_cast<Light::ILight&>(jobs.at(index).GetData()).GetBuffer();
+				const auto& bounds = GetBounds(index);
+				area.left = std::min(area.left, bounds.left);
+				area.top = std::min(area.top, bounds.top);
+				area.right = std::max(area.right, bounds.right);
+				area.bottom = std::max(area.bottom, bounds.bottom);
+				area.minDepth = std::min(area.minDepth, bounds.minDepth);
+				area.maxDepth = std::max(area.maxDepth, bounds.maxDepth);
+
+				const DirectX::XMFLOAT3& position = light["lightPos"];
+				const Data::ColorFloat3& color = light["lightColor"];
+				buffer["lightPos"][i] = DirectX::XMFLOAT4(position.x, position.y, position.z, static_cast<float>(light["atteuationLinear"]));
+				buffer["lightColor"][i] = DirectX::XMFLOAT4(color.col.x, color.col.y, color.col.z, static_cast<float>(light["lightIntensity"]));
+				buffer["lightParams"][i] = DirectX::XMFLOAT4(static_cast<float>(light["attenuationQuad"]), bounds.minDepth, bounds.maxDepth, 0.0f);
+				buffer["lightRect"][i] = DirectX::XMFLOAT4(static_cast<float>(bounds.left), static_cast<float>(bounds.top),
+					static_cast<float>(bounds.right), static_cast<float>(bounds.bottom));
+			}
+			buffer["lightCount"] = static_cast<uint32_t>(count);
+			batchBuffer->Bind(gfx);
+			BindBounds(gfx, area);
+			gfx.DrawIndexed(6U);
+			offset += count;
+		}
+		DRAW_TAG_END(gfx);
+	}
+
+	DirectX::BoundingSphere PointLightingPass::GetVolume(const Light::ILight& light) const noexcept
+	{
+		return { light.GetPos(), light.GetRange() };
+	}
+
 	PointLightingPass::PointLightingPass(Graphics& gfx, const std::string& name, UINT shadowMapSize)
-		: BindingPass(name), QueuePass(name), shadowMapPass(gfx, "shadowMap", shadowMapSize)
+		: BindingPass(name), LightVolumePass(gfx, name), shadowMapPass(gfx, "shadowMap", shadowMapSize)
 	{
 		AddBindableSink<GFX::Resource::IBindable>("shadowMap");
 		SetSinkLinkage("shadowMap", name + ".shadowMap.shadowMap");
@@ -21,18 +98,39 @@ namespace GFX::Pipeline::RenderPass
 		AddBind(GFX::Resource::NullGeometryShader::Get(gfx));
 		AddBind(GFX::Resource::PixelShader::Get(gfx, "PointLightPS"));
 		AddBind(GFX::Resource::Blender::Get(gfx, GFX::Resource::Blender::Type::Light));
-		AddBind(GFX::Resource::Rasterizer::Get(gfx, D3D11_CULL_MODE::D3D11_CULL_FRONT, false));
+		AddBind(GFX::Resource::Rasterizer::Get(gfx, D3D11_CULL_MODE::D3D11_CULL_FRONT, false, true));
 
 		auto vertexShader = GFX::Resource::VertexShader::Get(gfx, "LightVS");
 		AddBind(GFX::Resource::InputLayout::Get(gfx, std::make_shared<Data::VertexLayout>(), vertexShader));
 		AddBind(std::move(vertexShader));
 		AddBind(GFX::Resource::Topology::Get(gfx, D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST));
+
+		// Fullscreen quad for batched lights, bound over pass state
+		batchBuffer = GFX::Resource::ConstBufferExPixelCache::Get(gfx, name + "Batch", MakeBatchLayout(), 4U);
+		const std::string typeName = Primitive::Square::GetNameNDC2D();
+		if (GFX::Resource::VertexBuffer::NotStored(typeName) && GFX::Resource::IndexBuffer::NotStored(typeName))
+		{
+			auto list = Primitive::Square::MakeNDC2D();
+			batchBinds.emplace_back(GFX::Resource::VertexBuffer::Get(gfx, typeName, list.vertices).CastStatic<GFX::Resource::IBindable>());
+			batchBinds.emplace_back(GFX::Resource::IndexBuffer::Get(gfx, typeName, list.indices).CastStatic<GFX::Resource::IBindable>());
+		}
+		else
+		{
+			Primitive::IndexedTriangleList list;
+			batchBinds.emplace_back(GFX::Resource::VertexBuffer::Get(gfx, typeName, list.vertices).CastStatic<GFX::Resource::IBindable>());
+			batchBinds.emplace_back(GFX::Resource::IndexBuffer::Get(gfx, typeName, list.indices).CastStatic<GFX::Resource::IBindable>());
+		}
+		auto batchVS = GFX::Resource::VertexShader::Get(gfx, "FullscreenVS");
+		batchBinds.emplace_back(GFX::Resource::InputLayout::Get(gfx, Primitive::Square::GetLayoutNDC2D(), batchVS).CastStatic<GFX::Resource::IBindable>());
+		batchBinds.emplace_back(batchVS.CastStatic<GFX::Resource::IBindable>());
+		batchBinds.emplace_back(GFX::Resource::PixelShader::Get(gfx, "PointLightBatchPS").CastStatic<GFX::Resource::IBindable>());
+		batchBinds.emplace_back(GFX::Resource::Rasterizer::Get(gfx, D3D11_CULL_MODE::D3D11_CULL_NONE, false, true).CastStatic<GFX::Resource::IBindable>());
 	}
 
 	void PointLightingPass::Reset() noexcept
 	{
 		shadowMapPass.Reset();
-		QueuePass::Reset();
+		LightVolumePass::Reset();
 	}
 
 	Base::BasePass& PointLightingPass::GetInnerPass(std::deque<std::string> nameChain)
@@ -47,16 +145,38 @@ namespace GFX::Pipeline::RenderPass
 		assert(mainCamera);
 		DRAW_TAG_START(gfx, GetName());
 		mainCamera->BindPS(gfx);
-		for (auto& job : GetJobs())
+		auto& jobs = GetJobs();
+		Utils::FrameVector<uint32_t> batch;
+		for (uint32_t i = 0, size = static_cast<uint32_t>(jobs.size()); i < size; ++i)
 		{
+			auto& job = jobs.at(i);
+			auto& light = dynamic_cast<Light::PointLight&>(job.GetData());
+			// Shadowless batch shader gives same result only for lights that do not cast shadows
+			if (!light.CastsShadows())
+			{
+				batch.emplace_back(i);
+				continue;
+			}
 			DRAW_TAG_START(gfx, job.GetData().GetName());
-			shadowMapPass.BindLight(dynamic_cast<Light::ILight&>(job.GetData()));
+			shadowMapPass.BindLight(light);
 			shadowMapPass.Execute(gfx);
 			mainCamera->BindCamera(gfx);
 			BindAll(gfx);
+			BindBounds(gfx, i);
 			job.Execute(gfx);
 			DRAW_TAG_END(gfx);
 		}
+		batchedCount = batch.size();
+		if (batchedCount)
+			ExecuteBatch(gfx, batch, batching ? static_cast<uint64_t>(batchThreshold * GetRenderArea()) : 0ULL);
 		DRAW_TAG_END(gfx);
 	}
+
+	void PointLightingPass::ShowWindow(Graphics& gfx)
+	{
+		ImGui::Checkbox("Batch small point lights without shadows", &batching);
+		ImGui::SliderFloat("Batch threshold", &batchThreshold, 0.0f, 0.1f, "%.3f of screen");
+		ImGui::Text("Batched point lights: %llu", static_cast<unsigned long long>(batchedCount));
+		ShowStats();
+	}
 }
\ No newline at end of file
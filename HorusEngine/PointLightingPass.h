@@ -1,12 +1,28 @@
 #pragma once
+#include "LightVolumePass.h"
 #include "ShadowMapCubePass.h"
 
 namespace GFX::Pipeline::RenderPass
 {
-	class PointLightingPass : public Base::QueuePass
+	class PointLightingPass : public Base::LightVolumePass
 	{
+		static constexpr uint32_t MAX_BATCH_LIGHTS = 16U;
+
 		ShadowMapCubePass shadowMapPass;
-		Camera::ICamera* mainCamera = nullptr;
+		bool batching = true;
+		// Part of screen area below which lights not casting shadows are drawn together
+		float batchThreshold = 0.01f;
+		size_t batchedCount = 0;
+		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> batchBuffer;
+		std::vector<GfxResPtr<GFX::Resource::IBindable>> batchBinds;
+
+		static inline Data::CBuffer::DCBLayout MakeBatchLayout() noexcept;
+
+		// Draws lights without shadows, only ones not bigger than given area share single quad
+		void ExecuteBatch(Graphics& gfx, const Utils::FrameVector<uint32_t>& batch, uint64_t batchArea);
+
+	protected:
+		DirectX::BoundingSphere GetVolume(const Light::ILight& light) const noexcept override;
 
 	public:
 		PointLightingPass(Graphics& gfx, const std::string& name, UINT shadowMapSize);
@@ -18,5 +34,6 @@ namespace GFX::Pipeline::RenderPass
 		void Reset() noexcept override;
 		Base::BasePass& GetInnerPass(std::deque<std::string> nameChain) override;
 		void Execute(Graphics& gfx) override;
+		void ShowWindow(Graphics& gfx);
 	};
 }
\ No newline at end of file
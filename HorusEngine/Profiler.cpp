@@ -0,0 +1,236 @@
+#include "Profiler.h"
+#include "FrameArena.h"
+#include "ImGui/imgui.h"
+#include <algorithm>
+#include <fstream>
+
+namespace Utils
+{
+	thread_local Profiler::ThreadData* Profiler::threadData = nullptr;
+
+	Profiler::Profiler() : startTicks(GetTicks()), startTime(std::chrono::steady_clock::now())
+	{
+		snapshot.reserve(ThreadData::RING_SIZE);
+	}
+
+	Profiler::ThreadData& Profiler::RegisterThread() noexcept
+	{
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		threadData = threads.emplace_back(std::make_unique<ThreadData>()).get();
+		threadData->id = static_cast<uint32_t>(threads.size() - 1);
+		return *threadData;
+	}
+
+	void Profiler::MeasureOverhead() noexcept
+	{
+		constexpr uint64_t ITERATIONS = 10000;
+		ThreadData& thread = GetThreadData();
+		const uint64_t start = GetTicks();
+		for (uint64_t i = 0; i < ITERATIONS; ++i)
+		{
+			PROFILE_SCOPE("Profiler overhead");
+		}
+		const uint64_t ticks = GetTicks() - start;
+		// Test scopes are not part of any frame
+		thread.read = thread.write.load(std::memory_order_acquire);
+		scopeOverhead = static_cast<float>(ticks / (ticksPerMicrosecond * ITERATIONS) * 1000.0);
+	}
+
+	void Profiler::SaveTrace() const
+	{
+		std::ofstream fout(TRACE_FILE, std::ios_base::trunc);
+		if (!fout.good())
+			return;
+		std::lock_guard<std::mutex> lock(namesMutex);
+		fout << "{\"traceEvents\":[";
+		bool first = true;
+		for (const auto& [thread, event] : capture)
+		{
+			if (!first)
+				fout << ',';
+			first = false;
+			fout << "\n{\"name\":\"";
+			for (const char c : names.at(event.id))
+			{
+				if (c == '"' || c == '\\')
+					fout << '\\';
+				fout << c;
+			}
+			fout << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+				<< ",\"ts\":" << (event.start - startTicks) / ticksPerMicrosecond
+				<< ",\"dur\":" << (event.end - event.start) / ticksPerMicrosecond << '}';
+		}
+		fout << "\n]}" << std::endl;
+		fout.close();
+	}
+
+	void Profiler::EndFrame()
+	{
+		const double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+		if (elapsed > 0.0)
+			ticksPerMicrosecond = (GetTicks() - startTicks) / elapsed;
+		// Wait for stable clock calibration
+		if (scopeOverhead == 0.0f && elapsed > 1000000.0)
+			MeasureOverhead();
+
+		for (auto& total : frameTotals)
+			total = {};
+		{
+			std::lock_guard<std::mutex> lock(threadsMutex);
+			for (auto& thread : threads)
+			{
+				const uint64_t write = thread->write.load(std::memory_order_acquire);
+				// Ring overflowed, oldest events are lost
+				if (write - thread->read > ThreadData::RING_SIZE)
+				{
+					droppedEvents += write - thread->read - ThreadData::RING_SIZE;
+					thread->read = write - ThreadData::RING_SIZE;
+				}
+				// Owning thread keeps recording while ring is read, so events are copied first and then validated
+				// against current write index: slots that writer could reach during copy are dropped as overwritten
+				snapshot.clear();
+				for (uint64_t i = thread->read; i < write; ++i)
+					snapshot.emplace_back(thread->events[i & (ThreadData::RING_SIZE - 1)]);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				const uint64_t current = thread->write.load(std::memory_order_relaxed);
+				size_t first = 0;
+				if (current - thread->read >= ThreadData::RING_SIZE)
+				{
+					first = static_cast<size_t>(std::min(current - ThreadData::RING_SIZE + 1, write) - thread->read);
+					droppedEvents += first;
+				}
+				thread->read = write;
+				for (size_t i = first; i < snapshot.size(); ++i)
+				{
+					const Event& event = snapshot[i];
+					if (event.id >= frameTotals.size())
+						frameTotals.resize(event.id + 1);
+					auto& total = frameTotals[event.id];
+					total.ticks += event.end - event.start;
+					if (event.start < total.first)
+					{
+						total.first = event.start;
+						total.depth = event.depth;
+					}
+					if (captureFrames)
+						capture.emplace_back(thread->id, event);
+				}
+			}
+		}
+
+		if (stats.size() < frameTotals.size())
+			stats.resize(frameTotals.size());
+		for (uint32_t id = 0, size = static_cast<uint32_t>(frameTotals.size()); id < size; ++id)
+		{
+			const FrameTotal& total = frameTotals[id];
+			if (total.first == UINT64_MAX)
+				continue;
+			Stat& stat = stats[id];
+			if (stat.count == 0)
+				statOrder.emplace_back(id);
+			stat.depth = total.depth;
+			stat.lastStart = total.first;
+			stat.samples.at(stat.count++ % STAT_WINDOW) = static_cast<float>(total.ticks / (ticksPerMicrosecond * 1000.0));
+		}
+
+		if (captureFrames && --captureFrames == 0)
+		{
+			SaveTrace();
+			capture.clear();
+		}
+	}
+
+	uint32_t Profiler::Intern(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(namesMutex);
+		auto [it, inserted] = nameIds.try_emplace(name, static_cast<uint32_t>(names.size()));
+		if (inserted)
+			names.emplace_back(name);
+		return it->second;
+	}
+
+	float Profiler::GetAverageTime(const std::string& name) const noexcept
+	{
+		uint32_t id = 0;
+		{
+			std::lock_guard<std::mutex> lock(namesMutex);
+			auto it = nameIds.find(name);
+			if (it == nameIds.end())
+				return 0.0f;
+			id = it->second;
+		}
+		if (id >= stats.size())
+			return 0.0f;
+		const Stat& stat = stats[id];
+		const size_t size = std::min(stat.count, STAT_WINDOW);
+		float sum = 0.0f;
+		for (size_t i = 0; i < size; ++i)
+			sum += stat.samples[i];
+		return size ? sum / static_cast<float>(size) : 0.0f;
+	}
+
+	void Profiler::Capture(size_t frames) noexcept
+	{
+		capture.clear();
+		captureFrames = frames;
+	}
+
+	void Profiler::ShowWindow() noexcept
+	{
+		if (ImGui::CollapsingHeader("Profiler"))
+		{
+			bool enable = IsEnabled();
+			if (ImGui::Checkbox("Enable##profiler", &enable))
+				SetEnabled(enable);
+			ImGui::SameLine();
+			if (captureFrames)
+				ImGui::Text("Capturing trace, %llu frames left", static_cast<unsigned long long>(captureFrames));
+			else if (ImGui::Button("Capture trace"))
+				Capture(60);
+			ImGui::Text("Scope overhead: %.1f ns, dropped events: %llu", scopeOverhead, static_cast<unsigned long long>(droppedEvents));
+			const auto& arena = Utils::FrameArena::Get();
+			ImGui::Text("Frame arena: %llu allocations, %.1f / %.1f KB, heap fallbacks: %llu",
+				static_cast<unsigned long long>(arena.GetLastAllocations()), arena.GetLastSize() / 1024.0f,
+				arena.GetCapacity() / 1024.0f, static_cast<unsigned long long>(arena.GetLastOverflowAllocations()));
+
+			// Parents start before their children so ordering by start gives hierarchy
+			std::sort(statOrder.begin(), statOrder.end(), [this](uint32_t id1, uint32_t id2)
+				{
+					return stats.at(id1).lastStart < stats.at(id2).lastStart;
+				});
+			ImGui::Columns(4, "##profiler_stats", false);
+			ImGui::Text("Scope");
+			ImGui::NextColumn();
+			ImGui::Text("Min [ms]");
+			ImGui::NextColumn();
+			ImGui::Text("Avg [ms]");
+			ImGui::NextColumn();
+			ImGui::Text("P99 [ms]");
+			ImGui::NextColumn();
+			Utils::FrameVector<float> samples;
+			samples.reserve(STAT_WINDOW);
+			std::lock_guard<std::mutex> lock(namesMutex);
+			for (uint32_t id : statOrder)
+			{
+				const Stat& stat = stats.at(id);
+				samples.assign(stat.samples.begin(), stat.samples.begin() + std::min(stat.count, STAT_WINDOW));
+				float sum = 0.0f;
+				for (float sample : samples)
+					sum += sample;
+				const float min = *std::min_element(samples.begin(), samples.end());
+				auto p99 = samples.begin() + (samples.size() * 99) / 100;
+				std::nth_element(samples.begin(), p99, samples.end());
+
+				ImGui::Text("%*s%s", static_cast<int>(stat.depth * 2), "", names.at(id).c_str());
+				ImGui::NextColumn();
+				ImGui::Text("%.3f", min);
+				ImGui::NextColumn();
+				ImGui::Text("%.3f", sum / samples.size());
+				ImGui::NextColumn();
+				ImGui::Text("%.3f", *p99);
+				ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <deque>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace Utils
+{
+	// Hierarchical CPU profiler, scopes are recorded into per-thread rings without locking.
+	// Scope names are interned once into table of stable IDs, events and statistics refer only to these IDs.
+	class Profiler
+	{
+		static constexpr const char* TRACE_FILE = "profile_trace.json";
+		// Frames used for rolling statistics
+		static constexpr size_t STAT_WINDOW = 256;
+
+		struct Event
+		{
+			uint32_t id;
+			uint32_t depth;
+			uint64_t start;
+			uint64_t end;
+		};
+
+		// Written only by owning thread, read by thread ending frame
+		struct ThreadData
+		{
+			static constexpr uint64_t RING_SIZE = 1ULL << 14;
+
+			std::array<Event, RING_SIZE> events;
+			std::atomic_uint64_t write = 0;
+			uint64_t read = 0;
+			uint32_t depth = 0;
+			uint32_t id = 0;
+
+			inline void Push(uint32_t id, uint64_t start, uint64_t end) noexcept
+			{
+				const uint64_t index = write.load(std::memory_order_relaxed);
+				events[index & (RING_SIZE - 1)] = { id, --depth, start, end };
+				write.store(index + 1, std::memory_order_release);
+			}
+		};
+
+		struct Stat
+		{
+			std::array<float, STAT_WINDOW> samples;
+			size_t count = 0;
+			uint32_t depth = 0;
+			uint64_t lastStart = 0;
+		};
+
+		struct FrameTotal
+		{
+			uint64_t ticks = 0;
+			uint64_t first = UINT64_MAX;
+			uint32_t depth = 0;
+		};
+
+		static thread_local ThreadData* threadData;
+
+		std::atomic_bool enabled = true;
+		// Interned scope names, position in table is ID of scope
+		mutable std::mutex namesMutex;
+		std::deque<std::string> names;
+		std::unordered_map<std::string, uint32_t> nameIds;
+		std::mutex threadsMutex;
+		std::vector<std::unique_ptr<ThreadData>> threads;
+		const uint64_t startTicks;
+		const std::chrono::steady_clock::time_point startTime;
+		double ticksPerMicrosecond = 1.0;
+		float scopeOverhead = 0.0f;
+		uint64_t droppedEvents = 0;
+		// Copy of ring taken at end of frame, reused to avoid allocations
+		std::vector<Event> snapshot;
+		// Order of first appearance, gives hierarchical layout for stats table
+		std::vector<uint32_t> statOrder;
+		// Indexed by scope ID
+		std::vector<Stat> stats;
+		std::vector<FrameTotal> frameTotals;
+		size_t captureFrames = 0;
+		std::vector<std::pair<uint32_t, Event>> capture;
+
+		Profiler();
+
+		// Timestamp in ticks of fastest clock available, converted to time by calibration against steady clock
+		static inline uint64_t GetTicks() noexcept
+		{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			return __rdtsc();
+#else
+			return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+		ThreadData& RegisterThread() noexcept;
+		void MeasureOverhead() noexcept;
+		void SaveTrace() const;
+
+	public:
+		class Scope
+		{
+			ThreadData* thread = nullptr;
+			uint32_t id;
+			uint64_t start;
+
+		public:
+			inline Scope(uint32_t id) noexcept : id(id)
+			{
+				if (Get().IsEnabled())
+				{
+					thread = &GetThreadData();
+					++thread->depth;
+					start = GetTicks();
+				}
+			}
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+			inline ~Scope() { if (thread) thread->Push(id, start, GetTicks()); }
+		};
+
+		Profiler(const Profiler&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+		~Profiler() = default;
+
+		static inline Profiler& Get() noexcept { static Profiler profiler; return profiler; }
+		static inline ThreadData& GetThreadData() noexcept { return threadData ? *threadData : Get().RegisterThread(); }
+
+		// Thread safe, same name always gets same ID
+		uint32_t Intern(const std::string& name);
+
+		inline bool IsEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+		inline void SetEnabled(bool enable) noexcept { enabled.store(enable, std::memory_order_relaxed); }
+		// Average cost of single scope in nanoseconds
+		constexpr float GetScopeOverhead() const noexcept { return scopeOverhead; }
+		constexpr uint64_t GetDroppedEvents() const noexcept { return droppedEvents; }
+		// Average time of scope over recorded frames in ms, 0 when scope was never recorded
+		float GetAverageTime(const std::string& name) const noexcept;
+
+		// Collects events of all threads, has to be called once per frame outside of any scope
+		void EndFrame();
+		// Records given number of next frames and saves them as Chrome trace JSON
+		void Capture(size_t frames) noexcept;
+		void ShowWindow() noexcept;
+	};
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// Name is interned on first pass through scope so it has to be constant, names known at runtime go through PROFILE_SCOPE_ID
+#define PROFILE_SCOPE(name) static const uint32_t PROFILE_CONCAT(profileId, __LINE__) = Utils::Profiler::Get().Intern(name); \
+	Utils::Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileId, __LINE__))
+// ID has to come from Profiler::Intern()
+#define PROFILE_SCOPE_ID(id) Utils::Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(id)
\ No newline at end of file
@@ -1,23 +1,45 @@
 #include "QueuePass.h"
 #include "JobData.h"
+#include "TechniqueStep.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
 
 namespace GFX::Pipeline::RenderPass::Base
 {
 	template<bool ascending>
 	inline void QueuePass::Sort(const DirectX::XMFLOAT3& cameraPos) noexcept
 	{
+		PROFILE_SCOPE("Sort");
 		const DirectX::XMVECTOR pos = DirectX::XMLoadFloat3(&cameraPos);
-		std::sort(GetJobs().begin(), GetJobs().end(), [&pos](const Job& j1, const Job& j2)
-			{
-				const auto pos1 = j1.GetStep().GetTransformPos();
-				const auto pos2 = j2.GetStep().GetTransformPos();
-				const float len1 = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&pos1), pos)));
-				const float len2 = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&pos2), pos)));
-				if constexpr (ascending)
-					return len1 < len2;
-				else
-					return len1 > len2;
-			});
+		// Sort small keys and gather jobs once instead of swapping whole records
+		Utils::FrameVector<std::pair<float, uint32_t>> keys;
+		keys.reserve(jobs.size());
+		for (uint32_t i = 0, size = static_cast<uint32_t>(jobs.size()); i < size; ++i)
+		{
+			const float distance = DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&jobs[i].GetPosition()), pos)));
+			keys.emplace_back(ascending ? distance : -distance, i);
+		}
+		std::sort(keys.begin(), keys.end());
+
+		Utils::FrameVector<Job> sorted;
+		sorted.reserve(jobs.capacity());
+		for (const auto& key : keys)
+			sorted.emplace_back(jobs[key.second]);
+		jobs = std::move(sorted);
+	}
+
+	template<typename Volume>
+	inline void QueuePass::GatherInside(const Volume& volume, Utils::FrameVector<uint32_t>& inside) noexcept
+	{
+		inside.reserve(jobs.size());
+		BVH* bvh = hierarchyCulling ? sceneBVH : nullptr;
+		std::unique_lock<std::mutex> lock;
+		if (bvh)
+			lock = std::unique_lock<std::mutex>(bvh->GetQueryMutex());
+		const uint64_t stamp = bvh ? bvh->MarkInside(volume) : 0;
+		for (uint32_t i = 0, size = static_cast<uint32_t>(jobs.size()); i < size; ++i)
+			if (jobs[i].IsInsideVolume(volume, bvh, stamp))
+				inside.emplace_back(i);
 	}
 
 	void QueuePass::SortFrontBack(const DirectX::XMFLOAT3& cameraPos) noexcept
@@ -32,39 +54,146 @@ namespace GFX::Pipeline::RenderPass::Base
 
 	void QueuePass::CullFrustum(const Camera::ICamera& camera) noexcept
 	{
+		PROFILE_SCOPE("Cull frustum");
 		const DirectX::BoundingFrustum volume = camera.GetFrustum();
-		size_t rejectedIndex = 0, rejectedCount = 0;
+		BVH* bvh = hierarchyCulling ? sceneBVH : nullptr;
+		std::unique_lock<std::mutex> lock;
+		if (bvh)
+			lock = std::unique_lock<std::mutex>(bvh->GetQueryMutex());
+		// Objects from scene hierarchy are tested once for all their jobs
+		const uint64_t stamp = bvh ? bvh->MarkInside(volume) : 0;
+		size_t count = 0;
 		for (size_t i = 0, size = jobs.size(); i < size; ++i)
 		{
-			if (!jobs.at(i).IsInsideFrustum(volume))
-				++rejectedCount;
-			else
+			if (jobs[i].IsInsideFrustum(volume, bvh, stamp))
 			{
-				if (rejectedCount)
-				{
-					jobs.erase(jobs.begin() + rejectedIndex, jobs.begin() + rejectedIndex + rejectedCount);
-					i -= rejectedCount;
-					rejectedIndex = i;
-					rejectedCount = 0;
-					size = jobs.size();
-				}
-				++rejectedIndex;
+				if (count != i)
+					jobs[count] = jobs[i];
+				++count;
 			}
 		}
-		if (rejectedCount)
-			jobs.erase(jobs.begin() + rejectedIndex, jobs.begin() + rejectedIndex + rejectedCount);
+		jobs.erase(jobs.begin() + count, jobs.end());
 	}
 
-	void QueuePass::Execute(Graphics& gfx, RenderChannel mode)
+	void QueuePass::Execute(Graphics& gfx, const DirectX::BoundingSphere& volume, RenderChannel mode)
 	{
+		Utils::FrameVector<uint32_t> visible;
+		GatherInside(volume, visible);
 		DRAW_TAG_START(gfx, GetName());
 		BindAll(gfx);
+		for (uint32_t index : visible)
+		{
+			auto& job = jobs[index];
+			DRAW_TAG_START(gfx, job.GetData().GetName());
+			job.Execute(gfx, mode);
+			DRAW_TAG_END(gfx);
+		}
+		DRAW_TAG_END(gfx);
+	}
+
+	size_t QueuePass::ExecuteInside(Graphics& gfx, const DirectX::BoundingOrientedBox& volume, RenderChannel mode)
+	{
+		Utils::FrameVector<uint32_t> inside;
+		GatherInside(volume, inside);
+		for (uint32_t index : inside)
+		{
+			auto& job = jobs[index];
+			DRAW_TAG_START(gfx, job.GetData().GetName());
+			job.Execute(gfx, mode);
+			DRAW_TAG_END(gfx);
+		}
+		return inside.size();
+	}
+
+	void QueuePass::ReportScreenSize(const Camera::ICamera& camera, float screenHeight) noexcept
+	{
+		PROFILE_SCOPE("Report screen size");
+		// Projected diameter of bounding sphere: 2r * cot(fov / 2) / distance in NDC
+		const float scale = DirectX::XMVectorGetY(camera.GetProjection().r[1]) * screenHeight;
+		const DirectX::XMFLOAT3& cameraPos = camera.GetPos();
+		const DirectX::XMVECTOR eye = DirectX::XMLoadFloat3(&cameraPos);
 		for (auto& job : jobs)
 		{
+			const DirectX::BoundingBox& box = job.GetWorldBox();
+			const float radius = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMLoadFloat3(&box.Extents)));
+			const float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&box.Center), eye)));
+			job.GetStep().ReportScreenSize(distance > radius ? radius * scale / distance : screenHeight * 2.0f);
+		}
+	}
+
+	size_t QueuePass::CullOcclusion(OcclusionBuffer& buffer, const Camera::ICamera& camera) noexcept
+	{
+		PROFILE_SCOPE("Cull occlusion");
+		const DirectX::XMMATRIX viewProjection = DirectX::XMMatrixMultiply(camera.GetView(), camera.GetProjection());
+		Utils::FrameVector<OcclusionBuffer::Occluder> occluders;
+		occluders.reserve(jobs.size());
+		for (auto& job : jobs)
+		{
+			if (const auto* occluder = job.GetOccluder())
+				occluders.push_back({ occluder, job.GetTransformFloat4x4() });
+		}
+		buffer.Rasterize(occluders, viewProjection);
+
+		Utils::FrameVector<uint8_t> visible(jobs.size());
+		Utils::ThreadPool::Get().ParallelFor(jobs.size(), [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const auto& job = jobs[i];
+					visible[i] = buffer.IsVisible(job.GetBoundingBox(), DirectX::XMMatrixMultiply(job.GetTransform(), viewProjection));
+				}
+			}, 32U);
+
+		size_t count = 0;
+		for (size_t i = 0, size = jobs.size(); i < size; ++i)
+			if (visible[i])
+				jobs[count++] = jobs[i];
+		const size_t culled = jobs.size() - count;
+		jobs.erase(jobs.begin() + count, jobs.end());
+		return culled;
+	}
+
+	void QueuePass::TakeSubmitted() noexcept
+	{
+		jobs = std::move(submitted);
+		// Capacity stays as estimate of jobs submitted for next frame
+		Utils::FrameVector<Job> nextJobs;
+		nextJobs.reserve(jobs.capacity());
+		submitted = std::move(nextJobs);
+	}
+
+	void QueuePass::Reset() noexcept
+	{
+		// Storage of drawn frame is reclaimed by arena, jobs submitted for next frame stay
+		Utils::FrameVector<Job>().swap(jobs);
+	}
+
+	void QueuePass::ExecuteRange(Graphics& gfx, size_t begin, size_t end, RenderChannel mode)
+	{
+		DRAW_TAG_START(gfx, GetName());
+		BindAll(gfx);
+		for (size_t i = begin; i < end; ++i)
+		{
+			auto& job = jobs[i];
 			DRAW_TAG_START(gfx, job.GetData().GetName());
 			job.Execute(gfx, mode);
 			DRAW_TAG_END(gfx);
 		}
 		DRAW_TAG_END(gfx);
 	}
+
+	size_t QueuePass::GetChunkCount() const noexcept
+	{
+		if (chunkJobs == 0 || jobs.size() <= chunkJobs)
+			return 1;
+		return (jobs.size() + chunkJobs - 1) / chunkJobs;
+	}
+
+	void QueuePass::ExecuteChunk(Graphics& gfx, size_t chunk)
+	{
+		if (chunkJobs == 0)
+			Execute(gfx);
+		else
+			ExecuteRange(gfx, chunk * chunkJobs, std::min((chunk + 1) * chunkJobs, jobs.size()));
+	}
 }
\ No newline at end of file
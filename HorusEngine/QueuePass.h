@@ -2,6 +2,9 @@
 #include "BindingPass.h"
 #include "Job.h"
 #include "ICamera.h"
+#include "OcclusionBuffer.h"
+#include "BVH.h"
+#include "FrameArena.h"
 
 namespace GFX::Pipeline::RenderPass::Base
 {
@@ -9,25 +12,55 @@ namespace GFX::Pipeline::RenderPass::Base
 	{
 		using BindingPass::BindingPass;
 
-		std::vector<Job> jobs;
+		// Jobs of drawn frame and jobs submitted for next one, recreated every frame on frame arena
+		Utils::FrameVector<Job> jobs;
+		Utils::FrameVector<Job> submitted;
+		BVH* sceneBVH = nullptr;
+		// Scene hierarchy is refitted during submission, so it cannot be queried while next frame is submitted in parallel
+		bool hierarchyCulling = true;
+		// Jobs recorded by single chunk, 0 keeps whole queue in one recording
+		size_t chunkJobs = 0;
 
 		template<bool ascending>
 		inline void Sort(const DirectX::XMFLOAT3& cameraPos) noexcept;
+		template<typename Volume>
+		inline void GatherInside(const Volume& volume, Utils::FrameVector<uint32_t>& inside) noexcept;
 
 	protected:
-		constexpr std::vector<Job>& GetJobs() noexcept { return jobs; }
+		constexpr Utils::FrameVector<Job>& GetJobs() noexcept { return jobs; }
+		// Binds pass and draws jobs in range [begin, end)
+		void ExecuteRange(Graphics& gfx, size_t begin, size_t end, RenderChannel mode = RenderChannel::All);
 
 		void SortFrontBack(const DirectX::XMFLOAT3& cameraPos) noexcept;
 		void SortBackFront(const DirectX::XMFLOAT3& cameraPos) noexcept;
 		void CullFrustum(const Camera::ICamera& camera) noexcept;
+		// Executes only jobs touching given volume, rest stays in queue
+		void Execute(Graphics& gfx, const DirectX::BoundingSphere& volume, RenderChannel mode = RenderChannel::All);
+		// Draws jobs touching given volume without binding pass, for passes rendering queue multiple times. Returns number of drawn jobs
+		size_t ExecuteInside(Graphics& gfx, const DirectX::BoundingOrientedBox& volume, RenderChannel mode = RenderChannel::All);
+		// Reports projected size of every job to its visuals, should be called on visible jobs
+		void ReportScreenSize(const Camera::ICamera& camera, float screenHeight) noexcept;
+		// Returns number of removed jobs
+		size_t CullOcclusion(OcclusionBuffer& buffer, const Camera::ICamera& camera) noexcept;
 
 	public:
 		virtual ~QueuePass() = default;
 
-		inline void Add(Job&& job) noexcept { jobs.emplace_back(std::forward<Job>(job)); }
-		inline void Reset() noexcept override { jobs.clear(); }
+		constexpr void SetSceneBVH(BVH& bvh) noexcept { sceneBVH = &bvh; }
+		constexpr void EnableHierarchyCulling(bool enable) noexcept { hierarchyCulling = enable; }
+		// Only for passes that do all CPU work on queue in Prepare() and draw it in order
+		constexpr void SetChunkJobs(size_t count) noexcept { chunkJobs = count; }
+		// Jobs left in queue, after preparing only ones that passed culling
+		inline size_t GetJobCount() const noexcept { return jobs.size(); }
+		inline void Add(Job&& job) noexcept { submitted.emplace_back(std::forward<Job>(job)); }
+		// Jobs submitted since last call become queue of next drawn frame
+		void TakeSubmitted() noexcept;
 		inline void Execute(Graphics& gfx) override { Execute(gfx, RenderChannel::All); }
+		inline void Execute(Graphics& gfx, RenderChannel mode) { ExecuteRange(gfx, 0, jobs.size(), mode); }
 
-		void Execute(Graphics& gfx, RenderChannel mode);
+		size_t GetChunkCount() const noexcept override;
+		void ExecuteChunk(Graphics& gfx, size_t chunk) override;
+
+		void Reset() noexcept override;
 	};
 }
\ No newline at end of file
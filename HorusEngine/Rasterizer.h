@@ -7,17 +7,19 @@ namespace GFX::Resource
 	{
 		D3D11_CULL_MODE culling;
 		bool depthEnable;
+		bool scissorEnable;
 		Microsoft::WRL::ComPtr<ID3D11RasterizerState> state;
 
 	public:
-		Rasterizer(Graphics& gfx, D3D11_CULL_MODE culling, bool depthEnable = true);
+		Rasterizer(Graphics& gfx, D3D11_CULL_MODE culling, bool depthEnable = true, bool scissorEnable = false);
 		virtual ~Rasterizer() = default;
 
-		static inline GfxResPtr<Rasterizer> Get(Graphics& gfx, D3D11_CULL_MODE culling, bool depthEnable = true) { return Codex::Resolve<Rasterizer>(gfx, culling, depthEnable); }
-		static inline std::string GenerateRID(D3D11_CULL_MODE culling, bool depthEnable = true) noexcept;
+		static inline GfxResPtr<Rasterizer> Get(Graphics& gfx, D3D11_CULL_MODE culling, bool depthEnable = true, bool scissorEnable = false) { return Codex::Resolve<Rasterizer>(gfx, culling, depthEnable, scissorEnable); }
+		static inline std::string GenerateRID(D3D11_CULL_MODE culling, bool depthEnable = true, bool scissorEnable = false) noexcept;
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->RSSetState(state.Get()); }
-		inline std::string GetRID() const noexcept override { return GenerateRID(culling, depthEnable); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->RSSetState(state.Get()); GetBoundState(gfx, PipelineSlot::Rasterizer) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::Rasterizer; }
+		inline std::string GetRID() const noexcept override { return GenerateRID(culling, depthEnable, scissorEnable); }
 	};
 
 	template<>
@@ -26,8 +28,8 @@ namespace GFX::Resource
 		static constexpr bool generate{ true };
 	};
 
-	inline std::string Rasterizer::GenerateRID(D3D11_CULL_MODE culling, bool depthEnable) noexcept
+	inline std::string Rasterizer::GenerateRID(D3D11_CULL_MODE culling, bool depthEnable, bool scissorEnable) noexcept
 	{
-		return "R" + std::to_string(depthEnable) + "#" + std::to_string(culling);
+		return "R" + std::to_string(depthEnable) + "#" + std::to_string(culling) + (scissorEnable ? "#S" : "");
 	}
 }
\ No newline at end of file
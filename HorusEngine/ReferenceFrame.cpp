@@ -0,0 +1,132 @@
+#include "ReferenceFrame.h"
+#include "Model.h"
+#include "assimp/Importer.hpp"
+#include <filesystem>
+
+namespace GFX
+{
+	void ReferenceFrame::ParseNode(const aiNode& node, size_t meshOffset, size_t materialOffset, const aiScene& scene, const DirectX::XMMATRIX& higherTransform)
+	{
+		const DirectX::XMMATRIX transform = DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(reinterpret_cast<const DirectX::XMFLOAT4X4*>(&node.mTransformation))) * higherTransform;
+		for (unsigned int i = 0; i < node.mNumMeshes; ++i)
+		{
+			Draw draw = { meshOffset + node.mMeshes[i], materialOffset + scene.mMeshes[node.mMeshes[i]]->mMaterialIndex };
+			DirectX::XMStoreFloat4x4(&draw.transform, transform);
+			draws.emplace_back(draw);
+		}
+		for (unsigned int i = 0; i < node.mNumChildren; ++i)
+			ParseNode(*node.mChildren[i], meshOffset, materialOffset, scene, transform);
+	}
+
+	void ReferenceFrame::AddModel(const SceneFile::Model& model)
+	{
+		Assimp::Importer importer;
+		const aiScene& scene = Shape::Model::ReadFile(importer, model.file);
+		const std::string path = std::filesystem::path(model.file).remove_filename().string();
+
+		const size_t materialOffset = materials.size();
+		for (unsigned int i = 0; i < scene.mNumMaterials; ++i)
+		{
+			// Same defaults as in Visual::Material
+			const aiMaterial& source = *scene.mMaterials[i];
+			SoftwareRenderer::Material& material = materials.emplace_back();
+			aiString texFile;
+			if (source.GetTexture(aiTextureType_DIFFUSE, 0, &texFile) == aiReturn_SUCCESS)
+			{
+				const std::string file = path + texFile.C_Str();
+				auto texture = textures.find(file);
+				if (texture == textures.end())
+					texture = textures.emplace(file, Surface(file)).first;
+				if (texture->second.GetFormat() == DXGI_FORMAT_R8G8B8A8_UNORM)
+				{
+					material.texture = { reinterpret_cast<const uint32_t*>(texture->second.GetBuffer()),
+						static_cast<uint32_t>(texture->second.GetWidth()), static_cast<uint32_t>(texture->second.GetHeight()) };
+				}
+			}
+			else
+			{
+				aiColor4D color;
+				if (source.Get(AI_MATKEY_COLOR_DIFFUSE, color) == aiReturn_SUCCESS)
+					material.color = { color.r, color.g, color.b, color.a };
+			}
+			aiColor3D specularColor;
+			if (source.Get(AI_MATKEY_COLOR_SPECULAR, specularColor) == aiReturn_SUCCESS)
+				material.specularColor = { specularColor.r, specularColor.g, specularColor.b };
+			source.Get(AI_MATKEY_SHININESS_STRENGTH, material.specularIntensity);
+			float specularPower;
+			if (source.Get(AI_MATKEY_SHININESS, specularPower) == aiReturn_SUCCESS)
+			{
+				if (specularPower > 1.0f)
+					specularPower = static_cast<float>(log(static_cast<double>(specularPower)) / log(8192.0));
+				material.specularPower = specularPower;
+			}
+		}
+
+		const size_t meshOffset = meshes.size();
+		for (unsigned int i = 0; i < scene.mNumMeshes; ++i)
+		{
+			const aiMesh& source = *scene.mMeshes[i];
+			SoftwareRenderer::Mesh& mesh = meshes.emplace_back();
+			mesh.vertices.reserve(source.mNumVertices);
+			for (unsigned int j = 0; j < source.mNumVertices; ++j)
+			{
+				SoftwareRenderer::Vertex& vertex = mesh.vertices.emplace_back();
+				vertex.position = *reinterpret_cast<const DirectX::XMFLOAT3*>(&source.mVertices[j]);
+				vertex.normal = *reinterpret_cast<const DirectX::XMFLOAT3*>(&source.mNormals[j]);
+				if (source.HasTextureCoords(0))
+					vertex.texCoord = { source.mTextureCoords[0][j].x, source.mTextureCoords[0][j].y };
+				else
+					vertex.texCoord = { 0.0f, 0.0f };
+			}
+			mesh.indices.reserve(static_cast<size_t>(source.mNumFaces) * 3);
+			for (unsigned int j = 0; j < source.mNumFaces; ++j)
+			{
+				const aiFace& face = source.mFaces[j];
+				assert(face.mNumIndices == 3);
+				mesh.indices.insert(mesh.indices.end(), face.mIndices, face.mIndices + 3);
+			}
+		}
+
+		// Root transform like in Shape::Model
+		DirectX::XMFLOAT3 rotation = model.rotation;
+		if (std::filesystem::path(model.file).extension().string() == ".3ds")
+			rotation.x += DirectX::XM_PIDIV2;
+		ParseNode(*scene.mRootNode, meshOffset, materialOffset, scene, DirectX::XMMatrixScaling(model.scale, model.scale, model.scale) *
+			DirectX::XMMatrixRotationRollPitchYawFromVector(DirectX::XMLoadFloat3(&rotation)) *
+			DirectX::XMMatrixTranslationFromVector(DirectX::XMLoadFloat3(&model.position)));
+	}
+
+	ReferenceFrame::ReferenceFrame(const SceneFile& scene, uint32_t width, uint32_t height, const SoftwareRenderer::Params& params)
+		: renderer(width, height, params)
+	{
+		for (const auto& model : scene.models)
+			AddModel(model);
+		for (const auto& light : scene.pointLights)
+			renderer.AddLight(light);
+		for (const auto& light : scene.spotLights)
+			renderer.AddLight(light);
+		for (const auto& light : scene.directionalLights)
+			renderer.AddLight(light);
+	}
+
+	void ReferenceFrame::Render(const Camera::ICamera& camera)
+	{
+		// Clip planes recovered from perspective projection
+		DirectX::XMFLOAT4X4 projection;
+		DirectX::XMStoreFloat4x4(&projection, camera.GetProjection());
+		const float nearClip = -projection._43 / projection._33;
+		const float farClip = nearClip * projection._33 / (projection._33 - 1.0f);
+		renderer.SetCamera(camera.GetView(), camera.GetProjection(), camera.GetPos(), nearClip, farClip);
+
+		for (const auto& draw : draws)
+			renderer.DrawIndexed(meshes.at(draw.mesh), materials.at(draw.material), DirectX::XMLoadFloat4x4(&draw.transform));
+		renderer.Render();
+	}
+
+	void ReferenceFrame::Save(const std::string& file) const
+	{
+		Surface image(renderer.GetWidth(), renderer.GetHeight());
+		std::memcpy(image.GetBuffer(), renderer.GetImage().data(), renderer.GetImage().size() * sizeof(uint32_t));
+		image.Save(file);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include "SoftwareRenderer.h"
+#include "Surface.h"
+#include "ICamera.h"
+#include "assimp/scene.h"
+#include <unordered_map>
+
+namespace GFX
+{
+	// Scene description rendered on CPU, reference image for output of main pipeline.
+	// Geometry is imported again from model files so it does not depend on GPU resources.
+	class ReferenceFrame
+	{
+		struct Draw
+		{
+			size_t mesh;
+			size_t material;
+			DirectX::XMFLOAT4X4 transform;
+		};
+
+		std::unordered_map<std::string, Surface> textures;
+		std::vector<SoftwareRenderer::Mesh> meshes;
+		std::vector<SoftwareRenderer::Material> materials;
+		std::vector<Draw> draws;
+		SoftwareRenderer renderer;
+
+		void ParseNode(const aiNode& node, size_t meshOffset, size_t materialOffset, const aiScene& scene, const DirectX::XMMATRIX& higherTransform);
+		void AddModel(const SceneFile::Model& model);
+
+	public:
+		ReferenceFrame(const SceneFile& scene, uint32_t width, uint32_t height, const SoftwareRenderer::Params& params);
+		ReferenceFrame(const ReferenceFrame&) = delete;
+		ReferenceFrame& operator=(const ReferenceFrame&) = delete;
+		~ReferenceFrame() = default;
+
+		constexpr const std::vector<SoftwareRenderer::PassStats>& GetStats() const noexcept { return renderer.GetStats(); }
+
+		void Render(const Camera::ICamera& camera);
+		void Save(const std::string& file) const;
+	};
+}
\ No newline at end of file
@@ -2,6 +2,11 @@
 #include "RenderPassesBase.h"
 #include "RenderTarget.h"
 #include "Utils.h"
+#include "FrameArena.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include "Logger.h"
+#include <algorithm>
 
 namespace GFX::Pipeline
 {
@@ -17,20 +22,33 @@ namespace GFX::Pipeline
 	{
 		try
 		{
-			auto nameChain = Utils::SplitString(passName, ".");
-			if (nameChain.size() == 1)
+			// Only nested names need splitting
+			if (passName.find('.') == std::string::npos)
 			{
 				for (auto& pass : passes)
+				{
 					if (pass->GetName() == passName)
-						return dynamic_cast<RenderPass::Base::QueuePass&>(*pass);
+					{
+						auto& queue = dynamic_cast<RenderPass::Base::QueuePass&>(*pass);
+						queue.SetSceneBVH(sceneBVH);
+						return queue;
+					}
+				}
 			}
 			else
 			{
+				auto nameChain = Utils::SplitString(passName, ".");
 				std::string outerName = nameChain.front();
 				nameChain.pop_front();
 				for (auto& pass : passes)
+				{
 					if (pass->GetName() == outerName)
-						return dynamic_cast<RenderPass::Base::QueuePass&>(pass->GetInnerPass(nameChain));
+					{
+						auto& queue = dynamic_cast<RenderPass::Base::QueuePass&>(pass->GetInnerPass(nameChain));
+						queue.SetSceneBVH(sceneBVH);
+						return queue;
+					}
+				}
 			}
 		}
 		catch (std::bad_cast&)
@@ -40,16 +58,155 @@ namespace GFX::Pipeline
 		throw RGC_EXCEPT("Requested RenderQueue not found \"" + passName + "\"!");
 	}
 
+	void RenderGraph::ExecuteParallel(Graphics& gfx)
+	{
+		// Big passes are split into chunks, every one records into own deferred context
+		chunks.clear();
+		for (uint32_t i = 0, size = static_cast<uint32_t>(passes.size()); i < size; ++i)
+			for (uint32_t chunk = 0, count = static_cast<uint32_t>(passes[i]->GetChunkCount()); chunk < count; ++chunk)
+				chunks.emplace_back(i, chunk);
+		if (gfx.GetDeferredCount() < chunks.size())
+			gfx.CreateDeferredContexts(chunks.size());
+		// Slots kept between frames so recording does not touch heap
+		if (recordings.size() < chunks.size())
+			recordings.resize(chunks.size());
+		try
+		{
+			Utils::ThreadPool::Get().ParallelFor(chunks.size(), [this, &gfx](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						const auto [index, chunk] = chunks[i];
+						auto& pass = *passes[index];
+						gfx.BeginRecording(i);
+						try
+						{
+							PROFILE_SCOPE_ID(passScopes[index]);
+							BindGlobals(gfx);
+							if (pass.GetChunkCount() == 1)
+								pass.Execute(gfx);
+							else
+								pass.ExecuteChunk(gfx, chunk);
+						}
+						catch (...)
+						{
+							gfx.CancelRecording();
+							throw;
+						}
+						recordings[i] = gfx.EndRecording();
+					}
+				});
+		}
+		catch (...)
+		{
+			for (auto& recording : recordings)
+				recording = nullptr;
+			throw;
+		}
+		for (size_t i = 0, size = chunks.size(); i < size; ++i)
+		{
+			gfx.ExecuteCommands(recordings[i].Get());
+			recordings[i] = nullptr;
+		}
+	}
+
+	void RenderGraph::ExecuteSerial(Graphics& gfx)
+	{
+		// Passes start from prepared camera, same as recordings started from immediate context
+		const DirectX::XMMATRIX view = gfx.GetView();
+		const DirectX::XMMATRIX projection = gfx.GetProjection();
+		BindGlobals(gfx);
+		for (size_t i = 0, size = passes.size(); i < size; ++i)
+		{
+			PROFILE_SCOPE_ID(passScopes[i]);
+			gfx.SetView(DirectX::XMMATRIX(view));
+			gfx.SetProjection(DirectX::XMMATRIX(projection));
+			passes[i]->Execute(gfx);
+		}
+		gfx.SetView(DirectX::XMMATRIX(view));
+		gfx.SetProjection(DirectX::XMMATRIX(projection));
+	}
+
+	void RenderGraph::CheckParity(Graphics& gfx)
+	{
+		// Texels not written by one of recordings cannot be left over from the other one
+		auto clear = [this, &gfx]()
+		{
+			backbuffer->Clear(gfx, { 0.0f, 0.0f, 0.0f, 0.0f });
+			depthStencil->Clear(gfx);
+		};
+		std::vector<uint32_t> serial;
+		std::vector<uint32_t> parallel;
+		clear();
+		ExecuteSerial(gfx);
+		gfx.ReadBackBuffer(serial);
+		clear();
+		ExecuteParallel(gfx);
+		gfx.ReadBackBuffer(parallel);
+
+		parity = {};
+		parity.checked = true;
+		for (size_t i = 0, size = std::min(serial.size(), parallel.size()); i < size; ++i)
+		{
+			if (serial[i] == parallel[i])
+				continue;
+			++parity.differentTexels;
+			for (uint8_t shift = 0; shift < 32; shift += 8)
+			{
+				const int difference = abs(static_cast<int>((serial[i] >> shift) & 0xFF) - static_cast<int>((parallel[i] >> shift) & 0xFF));
+				parity.maxDifference = std::max(parity.maxDifference, static_cast<uint8_t>(difference));
+			}
+		}
+		if (parity.differentTexels)
+			Utils::Logger::Warning("Parallel recording differs from serial one in " + std::to_string(parity.differentTexels)
+				+ " texels, max difference: " + std::to_string(parity.maxDifference));
+		else
+			Utils::Logger::Info("Parallel recording matches serial one");
+	}
+
+	void RenderGraph::SetPipelined(bool enable) noexcept
+	{
+		pipelined = enable;
+		for (auto queue : queues)
+			queue->EnableHierarchyCulling(!enable);
+	}
+
+	void RenderGraph::EndSubmission(Graphics& gfx)
+	{
+		assert(finalized);
+		for (auto queue : queues)
+			queue->TakeSubmitted();
+		CaptureGlobals(gfx);
+	}
+
 	void RenderGraph::Execute(Graphics& gfx)
 	{
 		assert(finalized);
-		for (auto& pass : passes)
-			pass->Execute(gfx);
+		const auto start = std::chrono::steady_clock::now();
+		{
+			PROFILE_SCOPE("Prepare passes");
+			PrepareGlobals(gfx);
+			for (auto& pass : passes)
+				pass->Prepare(gfx);
+		}
+		if (parityRequested)
+		{
+			parityRequested = false;
+			CheckParity(gfx);
+		}
+		else if (parallelRecording && passes.size() > 1)
+			ExecuteParallel(gfx);
+		else
+			ExecuteSerial(gfx);
+		recordTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		GFX::Resource::PipelineState::EndFrame();
 	}
 
 	void RenderGraph::Reset() noexcept(!IS_DEBUG)
 	{
 		assert(finalized);
+		// Passes recreate their per frame containers on fresh arena buffer
+		Utils::FrameArena::Get().NextFrame();
 		for (auto& pass : passes)
 			pass->Reset();
 	}
@@ -133,8 +290,7 @@ namespace GFX::Pipeline
 
 	RenderPass::Base::BasePass& RenderGraph::FindPass(const std::string& name)
 	{
-		auto nameChain = Utils::SplitString(name, ".");
-		if (nameChain.size() == 1)
+		if (name.find('.') == std::string::npos)
 		{
 			for (auto& pass : passes)
 				if (pass->GetName() == name)
@@ -142,6 +298,7 @@ namespace GFX::Pipeline
 		}
 		else
 		{
+			auto nameChain = Utils::SplitString(name, ".");
 			const std::string outerName = nameChain.front();
 			nameChain.pop_front();
 			for (auto& pass : passes)
@@ -158,6 +315,7 @@ namespace GFX::Pipeline
 			if (p->GetName() == pass->GetName())
 				throw RGC_EXCEPT("Pass name already in RenderGraph: " + pass->GetName());
 		auto& currentPass = *pass;
+		passScopes.emplace_back(Utils::Profiler::Get().Intern(currentPass.GetName()));
 		passes.emplace_back(std::move(pass));
 		// Link outputs from other passes to this pass inputs
 		for (auto& innerPass : currentPass.GetInnerPasses())
@@ -186,7 +344,14 @@ namespace GFX::Pipeline
 	{
 		assert(!finalized);
 		for (auto& pass : passes)
+		{
 			pass->Finalize();
+			if (auto queue = dynamic_cast<RenderPass::Base::QueuePass*>(pass.get()))
+				queues.emplace_back(queue);
+			for (auto innerPass : pass->GetInnerPasses())
+				if (auto queue = dynamic_cast<RenderPass::Base::QueuePass*>(innerPass))
+					queues.emplace_back(queue);
+		}
 		LinkGlobalSinks();
 		finalized = true;
 	}
@@ -5,17 +5,47 @@ namespace GFX::Pipeline
 {
 	class RenderGraph
 	{
+	public:
+		// Comparison of back buffers after recording same prepared frame serially and in parallel
+		struct Parity
+		{
+			bool checked = false;
+			uint64_t differentTexels = 0;
+			uint8_t maxDifference = 0;
+		};
+
+	private:
 		std::vector<std::unique_ptr<RenderPass::Base::BasePass>> passes;
+		// Profiler IDs of pass names, aligned with passes
+		std::vector<uint32_t> passScopes;
 		std::vector<std::unique_ptr<RenderPass::Base::Sink>> globalSinks;
 		std::vector<std::unique_ptr<RenderPass::Base::Source>> globalSources;
 		GfxResPtr<Resource::RenderTarget> backbuffer;
 		GfxResPtr<Resource::DepthStencil> depthStencil;
+		BVH sceneBVH;
+		// Every queue of graph including inner passes, gathered when graph is finalized
+		std::vector<RenderPass::Base::QueuePass*> queues;
+		// Pass index and its chunk for every parallel recording, rebuilt every frame
+		std::vector<std::pair<uint32_t, uint32_t>> chunks;
+		// Command lists of chunks recorded in parallel, submitted in graph order
+		std::vector<Microsoft::WRL::ComPtr<ID3D11CommandList>> recordings;
 		bool finalized = false;
+		bool parallelRecording = true;
+		bool parityRequested = false;
+		bool pipelined = false;
+		Parity parity;
+		float recordTime = 0.0f;
 
 		void LinkSinks(RenderPass::Base::BasePass& pass);
 		void LinkGlobalSinks();
+		// Every pass (or chunk of big pass) records into own deferred context on thread pool, command lists are submitted in graph order.
+		// Passes are prepared before so their CPU results are complete when recording starts
+		void ExecuteParallel(Graphics& gfx);
+		void ExecuteSerial(Graphics& gfx);
+		void CheckParity(Graphics& gfx);
 
 	protected:
+		constexpr GfxResPtr<Resource::DepthStencil>& GetDepthStencil() noexcept { return depthStencil; }
 		inline void AddGlobalSink(std::unique_ptr<RenderPass::Base::Sink> sink) { globalSinks.emplace_back(std::move(sink)); }
 		inline void AddGlobalSource(std::unique_ptr<RenderPass::Base::Source> source) { globalSources.emplace_back(std::move(source)); }
 
@@ -23,6 +53,12 @@ namespace GFX::Pipeline
 		void AppendPass(std::unique_ptr<RenderPass::Base::BasePass> pass);
 		void SetSinkSource(const std::string& sink, const std::string& source);
 		void Finalize();
+		// State shared by passes that can change before submitted frame is drawn, captured together with its jobs
+		virtual void CaptureGlobals(Graphics& gfx) {}
+		// Serial work on state shared by passes before they are prepared, camera bound here is starting camera of every pass
+		virtual void PrepareGlobals(Graphics& gfx) {}
+		// State shared by all passes, bound at start of every command recording
+		virtual void BindGlobals(Graphics& gfx) {}
 
 	public:
 		RenderGraph(Graphics& gfx);
@@ -30,8 +66,23 @@ namespace GFX::Pipeline
 		RenderGraph& operator=(const RenderGraph&) = default;
 		virtual ~RenderGraph() = default;
 
+		constexpr BVH& GetSceneBVH() noexcept { return sceneBVH; }
+		constexpr bool& ParallelRecording() noexcept { return parallelRecording; }
+		// Next frame is recorded both ways and results are compared. Both recordings run on same prepared frame,
+		// so passes carrying state between frames (auto exposure) should be disabled for reliable result
+		constexpr void RequestParityCheck() noexcept { parityRequested = true; }
+		constexpr const Parity& GetParity() const noexcept { return parity; }
+		// CPU time of last graph execution in ms
+		constexpr float GetRecordTime() const noexcept { return recordTime; }
+		constexpr bool IsPipelined() const noexcept { return pipelined; }
+		// Next frame can be submitted on other thread while Execute() draws previous one, scene hierarchy is not used for culling then.
+		// Scene may change only when neither of them is running
+		void SetPipelined(bool enable) noexcept;
+
 		RenderPass::Base::QueuePass& GetRenderQueue(const std::string& passName);
 
+		// Jobs submitted so far become frame drawn by next Execute()
+		void EndSubmission(Graphics& gfx);
 		void Execute(Graphics& gfx);
 		void Reset() noexcept(!IS_DEBUG);
 	};
@@ -1,5 +1,7 @@
 #pragma once
 #include "RenderPassesBase.h"
+#include "AutoExposurePass.h"
+#include "CascadeShadowMapPass.h"
 #include "ClearBufferPass.h"
 #include "DirectionalLightingPass.h"
 #include "HDRGammaCorrectionPass.h"
@@ -0,0 +1,4 @@
+cbuffer RenderScaleBuffer : register(b5)
+{
+	float2 cb_renderScale; // Part of screen sized targets used with dynamic resolution
+};
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "RenderTargetReadback.h"
+#include "Graphics.h"
+#include "GfxExceptionMacros.h"
+
+namespace GFX::Pipeline::Resource
+{
+	RenderTargetReadback::RenderTargetReadback(Graphics& gfx, unsigned int width, unsigned int height, DXGI_FORMAT format)
+		: RenderTarget(width, height, format, gfx)
+	{
+		GFX_ENABLE_ALL(gfx);
+
+		D3D11_TEXTURE2D_DESC textureDesc = { 0 };
+		textureDesc.BindFlags = 0U;
+		texture = CreateTexture(gfx, width, height, textureDesc, format);
+		InitializeTargetView(gfx, textureDesc, texture);
+
+		textureDesc.CPUAccessFlags = D3D11_CPU_ACCESS_FLAG::D3D11_CPU_ACCESS_READ;
+		textureDesc.Usage = D3D11_USAGE::D3D11_USAGE_STAGING;
+		textureDesc.BindFlags = 0U;
+		for (auto& staging : stagingTextures)
+		{
+			GFX_THROW_FAILED(GetDevice(gfx)->CreateTexture2D(&textureDesc, nullptr, &staging));
+		}
+	}
+
+	void RenderTargetReadback::Copy(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->CopyResource(stagingTextures.at(copyCount++ % LATENCY).Get(), texture.Get());
+	}
+
+	bool RenderTargetReadback::Read(Graphics& gfx, void* buffer, UINT texelSize)
+	{
+		if (readCount == copyCount)
+			return false;
+		if (copyCount - readCount > LATENCY)
+			readCount = copyCount - LATENCY;
+
+		GFX_ENABLE_ALL(gfx);
+		ID3D11Texture2D* staging = stagingTextures.at(readCount % LATENCY).Get();
+		D3D11_MAPPED_SUBRESOURCE subResource = { 0 };
+		const HRESULT result = GetContext(gfx)->Map(staging, 0U, D3D11_MAP::D3D11_MAP_READ, D3D11_MAP_FLAG::D3D11_MAP_FLAG_DO_NOT_WAIT, &subResource);
+		if (result == DXGI_ERROR_WAS_STILL_DRAWING)
+			return false;
+		GFX_THROW_FAILED(result);
+
+		const size_t rowSize = static_cast<size_t>(GetWidth()) * texelSize;
+		const char* bytes = static_cast<const char*>(subResource.pData);
+		for (unsigned int y = 0U; y < GetHeight(); ++y)
+			memcpy(static_cast<char*>(buffer) + rowSize * y, bytes + subResource.RowPitch * static_cast<size_t>(y), rowSize);
+		GFX_THROW_FAILED_INFO(GetContext(gfx)->Unmap(staging, 0U));
+		++readCount;
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+#include "RenderTarget.h"
+
+namespace GFX::Pipeline::Resource
+{
+	// Content is copied into ring of staging textures and read back few frames later, so CPU never waits for GPU
+	class RenderTargetReadback : public RenderTarget
+	{
+		static constexpr UINT LATENCY = 3U;
+
+		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture = nullptr;
+		std::array<Microsoft::WRL::ComPtr<ID3D11Texture2D>, LATENCY> stagingTextures;
+		// Copy with given number goes into staging texture number % LATENCY
+		uint64_t copyCount = 0;
+		uint64_t readCount = 0;
+
+	public:
+		RenderTargetReadback(Graphics& gfx, unsigned int width, unsigned int height, DXGI_FORMAT format);
+		virtual ~RenderTargetReadback() = default;
+
+		// Can be recorded on deferred context, oldest unread copy is overwritten when CPU falls behind
+		void Copy(Graphics& gfx) noexcept;
+		// Has to be called on immediate context, fills buffer of width * height texels with oldest finished copy.
+		// Returns false when there is no new copy or GPU has not finished it yet
+		bool Read(Graphics& gfx, void* buffer, UINT texelSize);
+	};
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "IBindable.h"
+#include <atomic>
 
 namespace GFX::Resource
 {
@@ -9,27 +10,30 @@ namespace GFX::Resource
 		static_assert(std::is_base_of_v<IBindable, R>, "ResPtr target type must be a IBindable type!");
 		static constexpr std::align_val_t ALIGNMENT = static_cast<std::align_val_t>(16U);
 
-		uint64_t* count = nullptr;
+		// Shared between threads creating resources in parallel and codex releasing them
+		std::atomic<uint64_t>* count = nullptr;
 		R* ptr = nullptr;
 
 	public:
 		ResPtr() = default;
 		// This should be private, but no idea how to perform cast and access this ctor... BIG TODO: Find a way
-		constexpr ResPtr(uint64_t* count, R* ptr) noexcept : count(count), ptr(ptr) { ++(*count); }
+		inline ResPtr(std::atomic<uint64_t>* count, R* ptr) noexcept : count(count), ptr(ptr) { count->fetch_add(1, std::memory_order_relaxed); }
 		template<typename ...Params>
 		ResPtr(Params&& ...p);
-		constexpr ResPtr(ResPtr& rp) noexcept { *this = rp; }
-		constexpr ResPtr(const ResPtr& rp) noexcept { *this = rp; }
-		constexpr ResPtr(ResPtr&& rp) noexcept { *this = std::forward<ResPtr&&>(rp); }
+		inline ResPtr(ResPtr& rp) noexcept { *this = rp; }
+		inline ResPtr(const ResPtr& rp) noexcept { *this = rp; }
+		inline ResPtr(ResPtr&& rp) noexcept { *this = std::forward<ResPtr&&>(rp); }
 		~ResPtr() noexcept;
 
 		// TODO: Change all static casts into implicit ones
 		template<typename T>
-		constexpr ResPtr<T> CastStatic() const noexcept { return { count, static_cast<T*>(ptr) }; }
+		inline ResPtr<T> CastStatic() const noexcept { return { count, static_cast<T*>(ptr) }; }
 		template<typename T>
-		constexpr operator ResPtr<T>() const noexcept { return CastStatic<T>(); }
+		inline operator ResPtr<T>() const noexcept { return CastStatic<T>(); }
 		template<typename T>
-		constexpr ResPtr<T> CastDynamic() const noexcept { return { count, dynamic_cast<T*>(ptr) }; }
+		inline ResPtr<T> CastDynamic() const noexcept { return { count, dynamic_cast<T*>(ptr) }; }
+		// Number of owners, only stable when no other thread can copy this pointer
+		inline uint64_t GetUseCount() const noexcept { return count ? count->load(std::memory_order_acquire) : 0; }
 
 		constexpr R& operator*() { return *ptr; }
 		constexpr const R& operator*() const { return *ptr; }
@@ -41,7 +45,7 @@ namespace GFX::Resource
 		constexpr bool operator==(std::nullptr_t p) const noexcept { return ptr == p; }
 		constexpr bool operator!=(std::nullptr_t p) const noexcept { return ptr != p; }
 
-		constexpr ResPtr& operator=(const ResPtr& rp) noexcept;
-		constexpr ResPtr& operator=(ResPtr&& rp) noexcept;
+		ResPtr& operator=(const ResPtr& rp) noexcept;
+		ResPtr& operator=(ResPtr&& rp) noexcept;
 	};
 }
\ No newline at end of file
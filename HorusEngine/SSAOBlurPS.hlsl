@@ -1,6 +1,7 @@
 #include "SamplersPS.hlsli"
 #include "BlurDirectionPB.hlsli"
 #include "SSAOKernelPB.hlsli"
+#include "RenderScalePB.hlsli"
 
 Texture2D ssaoMap : register(t11);
 
@@ -12,10 +13,11 @@ float main(float2 tc : TEXCOORD) : SV_TARGET
 	else
 		delta = float2(0.25f / cb_tileDimensions.x, 0.0f);
 
+	const float2 uv = tc * cb_renderScale;
 	static const int RANGE = 3;
 	float result = 0.0f;
 	[unroll]
 	for (int i = -RANGE; i < RANGE; ++i)
-		result += ssaoMap.Sample(splr_LR, tc + delta * i).r;
+		result += ssaoMap.Sample(splr_LR, uv + delta * i).r;
 	return result / (RANGE * 2);
 }
\ No newline at end of file
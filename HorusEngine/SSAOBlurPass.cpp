@@ -22,6 +22,8 @@ namespace GFX::Pipeline::RenderPass
 
 	void SSAOBlurPass::Execute(Graphics& gfx)
 	{
+		if (!enabled)
+			return;
 		DRAW_TAG_START(gfx, GetName());
 		direction->GetBuffer()["vertical"] = !direction->GetBufferConst()["vertical"];
 		direction->Bind(gfx);
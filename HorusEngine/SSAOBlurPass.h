@@ -9,11 +9,15 @@ namespace GFX::Pipeline::RenderPass
 		GfxResPtr<Resource::IRenderTarget> ssaoScratchBuffer;
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> direction;
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> kernelBuffer;
+		bool enabled = true;
 
 	public:
 		SSAOBlurPass(Graphics& gfx, const std::string& name);
 		virtual ~SSAOBlurPass() = default;
 
+		// Not needed when SSAO is upsampled from reduced resolution
+		constexpr void SetEnabled(bool enable) noexcept { enabled = enable; }
+
 		void Execute(Graphics& gfx) override;
 	};
 }
\ No newline at end of file
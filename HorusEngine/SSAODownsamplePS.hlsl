@@ -0,0 +1,44 @@
+#include "SSAOKernelPB.hlsli"
+
+Texture2D normalTex   : register(t5); // RG - octahedral normal
+
+Texture2D depthMap    : register(t8);
+
+struct PSOut
+{
+	float2 normal : SV_TARGET0;
+	float depth : SV_TARGET1;
+};
+
+// Picks single texel from block of downscale x downscale pixels so depth and normal stay consistent.
+// Nearest and farthest surfaces alternate in checkerboard to keep both sides of depth edges
+PSOut main(float2 tc : TEXCOORD, float4 pixel : SV_POSITION)
+{
+	PSOut pso;
+	pso.normal = float2(0.0f, 0.0f);
+	pso.depth = 1.0f;
+
+	const uint2 origin = uint2(pixel.xy) * cb_downscale;
+	const bool selectFar = ((uint(pixel.x) + uint(pixel.y)) & 1U) != 0U;
+	bool found = false;
+	[loop]
+	for (uint y = 0; y < cb_downscale; ++y)
+	{
+		[loop]
+		for (uint x = 0; x < cb_downscale; ++x)
+		{
+			const int3 texel = int3(origin + uint2(x, y), 0);
+			const float2 normal = normalTex.Load(texel).rg;
+			if (normal.x == 0.0f && normal.y == 0.0f)
+				continue;
+			const float depth = depthMap.Load(texel).x;
+			if (!found || (selectFar ? depth > pso.depth : depth < pso.depth))
+			{
+				found = true;
+				pso.normal = normal;
+				pso.depth = depth;
+			}
+		}
+	}
+	return pso;
+}
\ No newline at end of file
@@ -8,4 +8,5 @@ cbuffer SSAOKernelBuffer : register(b13)
 	float cb_sampleRadius;
 	float cb_ssaoPower;
 	uint cb_kernelSize;
+	uint cb_downscale; // Resolution divider of occlusion targets
 }
\ No newline at end of file
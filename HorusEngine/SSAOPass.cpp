@@ -19,6 +19,7 @@ namespace GFX::Pipeline::RenderPass
 			layout.Add(DCBElementType::Float, "sampleRadius");
 			layout.Add(DCBElementType::Float, "ssaoPower");
 			layout.Add(DCBElementType::UInteger, "kernelSize");
+			layout.Add(DCBElementType::UInteger, "downscale");
 			initNeeded = false;
 		}
 		return layout;
@@ -29,13 +30,31 @@ namespace GFX::Pipeline::RenderPass
 	{
 		renderTarget = GfxResPtr<Resource::RenderTargetShaderInput>(gfx, 11U, DXGI_FORMAT_R32_FLOAT);
 		ssaoScratchBuffer = GfxResPtr<Resource::RenderTargetShaderInput>(gfx, 11U, DXGI_FORMAT_R32_FLOAT);
+		for (uint8_t i = 0; i < reducedTargets.size(); ++i)
+		{
+			const uint32_t downscale = GetDownscale(static_cast<Quality>(i + 1));
+			const unsigned int width = (gfx.GetWidth() + downscale - 1) / downscale;
+			const unsigned int height = (gfx.GetHeight() + downscale - 1) / downscale;
+			auto& targets = reducedTargets.at(i);
+			targets.geometry = GfxResPtr<Resource::RenderTargetEx>(gfx, width, height, 13U,
+				std::vector<DXGI_FORMAT>({ DXGI_FORMAT_R16G16_UNORM, DXGI_FORMAT_R32_FLOAT }));
+			targets.occlusion = GfxResPtr<Resource::RenderTargetShaderInput>(gfx, width, height, 15U, DXGI_FORMAT_R32_FLOAT);
+			targets.viewport = GFX::Resource::Viewport::MakeDynamic(gfx, width, height);
+			targets.geometry->SetViewport(targets.viewport);
+			targets.occlusion->SetViewport(targets.viewport);
+		}
+		downsamplePS = GFX::Resource::PixelShader::Get(gfx, "SSAODownsamplePS");
+		occlusionLowPS = GFX::Resource::PixelShader::Get(gfx, "AmbientOcclusionLowPS");
+		upsamplePS = GFX::Resource::PixelShader::Get(gfx, "SSAOUpsamplePS");
 
+		tileDimensions = { 4.0f * (gfx.GetWidth() / SSAO_NOISE_SIZE), 8.0f * (gfx.GetHeight() / SSAO_NOISE_SIZE) };
 		kernelBuffer = GFX::Resource::ConstBufferExPixelCache::Get(gfx, typeid(SSAOPass).name(), MakeLayout(), 13U);
 		kernelBuffer->GetBuffer()["bias"] = bias;
-		kernelBuffer->GetBuffer()["tileDimensions"] = DirectX::XMFLOAT2(4.0f * (gfx.GetWidth() / SSAO_NOISE_SIZE), 8.0f * (gfx.GetHeight() / SSAO_NOISE_SIZE));
+		kernelBuffer->GetBuffer()["tileDimensions"] = tileDimensions;
 		kernelBuffer->GetBuffer()["sampleRadius"] = radius;
 		kernelBuffer->GetBuffer()["ssaoPower"] = power;
 		kernelBuffer->GetBuffer()["kernelSize"] = size;
+		kernelBuffer->GetBuffer()["downscale"] = GetDownscale(quality);
 		std::mt19937_64 engine(std::random_device{}());
 		for (size_t i = 0; i < SSAO_KERNEL_SIZE; ++i)
 		{
@@ -67,11 +86,75 @@ namespace GFX::Pipeline::RenderPass
 		AddBind(GFX::Resource::Texture::Get(gfx, ssaoNoise, "ssaoNoise", 12U));
 	}
 
+	uint64_t SSAOPass::EstimateFetches(Quality quality, uint32_t width, uint32_t height, uint32_t kernelSize) noexcept
+	{
+		const uint64_t pixels = static_cast<uint64_t>(width) * height;
+		// Normal, depth and noise followed by depth for every kernel sample
+		const uint64_t occlusionFetches = 3ULL + kernelSize;
+		if (quality == Quality::Full)
+		{
+			// Two blur passes with 6 taps each
+			return pixels * (occlusionFetches + 12ULL);
+		}
+		const uint64_t downscale = GetDownscale(quality);
+		const uint64_t reducedPixels = ((width + downscale - 1) / downscale) * ((height + downscale - 1) / downscale);
+		// Downsampling reads normal and depth of every pixel, upsampling reads full resolution
+		// normal and depth plus normal, depth and occlusion of 4x4 reduced texels
+		return pixels * 2ULL + reducedPixels * occlusionFetches + pixels * (2ULL + 16ULL * 3ULL);
+	}
+
+	void SSAOPass::SetViewport(const GfxResPtr<GFX::Resource::Viewport>& viewport) noexcept
+	{
+		renderViewport = viewport;
+		renderTarget->SetViewport(viewport);
+		ssaoScratchBuffer->SetViewport(viewport);
+	}
+
+	void SSAOPass::SetQuality(Quality newQuality) noexcept
+	{
+		quality = newQuality;
+		const float downscale = static_cast<float>(GetDownscale(quality));
+		// Noise tiled per reduced pixel gives interleaved kernel rotations after upsampling
+		kernelBuffer->GetBuffer()["tileDimensions"] = DirectX::XMFLOAT2(tileDimensions.x / downscale, tileDimensions.y / downscale);
+		kernelBuffer->GetBuffer()["downscale"] = GetDownscale(quality);
+	}
+
+	void SSAOPass::Prepare(Graphics& gfx)
+	{
+		if (renderViewport != nullptr)
+			for (auto& targets : reducedTargets)
+				targets.viewport->SetScale(renderViewport->GetScaleX());
+	}
+
 	void SSAOPass::Execute(Graphics& gfx)
 	{
 		assert(mainCamera);
 		mainCamera->BindPS(gfx);
-		FullscreenPass::Execute(gfx);
+		if (quality == Quality::Full)
+		{
+			FullscreenPass::Execute(gfx);
+			return;
+		}
+
+		DRAW_TAG_START(gfx, GetName());
+		auto& targets = reducedTargets.at(static_cast<size_t>(quality) - 1);
+		BindAll(gfx);
+		targets.geometry->Unbind(gfx);
+		targets.occlusion->Unbind(gfx);
+		targets.geometry->BindTarget(gfx);
+		downsamplePS->Bind(gfx);
+		gfx.DrawIndexed(6U);
+
+		targets.occlusion->BindTarget(gfx);
+		targets.geometry->Bind(gfx);
+		occlusionLowPS->Bind(gfx);
+		gfx.DrawIndexed(6U);
+
+		renderTarget->BindTarget(gfx);
+		targets.occlusion->Bind(gfx);
+		upsamplePS->Bind(gfx);
+		gfx.DrawIndexed(6U);
+		DRAW_TAG_END(gfx);
 	}
 
 	void SSAOPass::ShowWindow(Graphics& gfx)
@@ -111,6 +194,20 @@ namespace GFX::Pipeline::RenderPass
 			if (ImGui::InputFloat("##ssao_bias", &bias, 0.001f, 0.0f, "%.3f"))
 				kernelBuffer->GetBuffer()["bias"] = bias;
 			ImGui::Columns(1);
+
+			static constexpr const char* QUALITY_NAMES[] = { "Full", "Half", "Quarter" };
+			ImGui::Text("Quality");
+			ImGui::SetNextItemWidth(-1.0f);
+			int selected = static_cast<int>(quality);
+			if (ImGui::Combo("##ssao_quality", &selected, QUALITY_NAMES, 3))
+				SetQuality(static_cast<Quality>(selected));
+			const float scale = renderViewport != nullptr ? renderViewport->GetScaleX() : 1.0f;
+			const uint32_t width = static_cast<uint32_t>(renderTarget->GetWidth() * scale);
+			const uint32_t height = static_cast<uint32_t>(renderTarget->GetHeight() * scale);
+			ImGui::Text("Estimated texture fetches per frame:");
+			for (uint8_t i = 0; i < 3; ++i)
+				ImGui::Text("%s%s: %.2f M", QUALITY_NAMES[i], i == static_cast<uint8_t>(quality) ? " (current)" : "",
+					EstimateFetches(static_cast<Quality>(i), width, height, size) / 1000000.0f);
 		}
 	}
 }
\ No newline at end of file
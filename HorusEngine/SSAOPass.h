@@ -2,11 +2,27 @@
 #include "FullscreenPass.h"
 #include "ICamera.h"
 #include "ConstBufferExCache.h"
+#include "RenderTargetEx.h"
+#include "RenderTargetShaderInput.h"
+#include "PixelShader.h"
 
 namespace GFX::Pipeline::RenderPass
 {
 	class SSAOPass : public Base::FullscreenPass
 	{
+	public:
+		// Reduced modes compute occlusion at half or quarter resolution and use bilateral upsampling instead of blur
+		enum class Quality : uint8_t { Full, Half, Quarter };
+
+	private:
+		// Occlusion computed at reduced resolution with downsampled geometry
+		struct ReducedTargets
+		{
+			GfxResPtr<Resource::RenderTargetEx> geometry;
+			GfxResPtr<Resource::RenderTargetShaderInput> occlusion;
+			GfxResPtr<GFX::Resource::Viewport> viewport;
+		};
+
 		static constexpr size_t SSAO_KERNEL_SIZE = 32;
 		static constexpr size_t SSAO_NOISE_SIZE = 32;
 
@@ -14,19 +30,35 @@ namespace GFX::Pipeline::RenderPass
 		float radius = 0.86f;
 		float power = 2.77f;
 		uint32_t size = SSAO_KERNEL_SIZE;
+		Quality quality = Quality::Full;
+		DirectX::XMFLOAT2 tileDimensions;
 
 		Camera::ICamera* mainCamera = nullptr;
 		GfxResPtr<Resource::IRenderTarget> ssaoScratchBuffer;
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> kernelBuffer;
+		GfxResPtr<GFX::Resource::Viewport> renderViewport;
+		std::array<ReducedTargets, 2> reducedTargets;
+		GfxResPtr<GFX::Resource::PixelShader> downsamplePS;
+		GfxResPtr<GFX::Resource::PixelShader> occlusionLowPS;
+		GfxResPtr<GFX::Resource::PixelShader> upsamplePS;
 
 		static inline Data::CBuffer::DCBLayout MakeLayout() noexcept;
+		static constexpr uint32_t GetDownscale(Quality quality) noexcept { return 1U << static_cast<uint8_t>(quality); }
 
 	public:
 		SSAOPass(Graphics& gfx, const std::string& name);
 		virtual ~SSAOPass() = default;
 
+		// Number of texture fetches per frame, kernel samples are counted as if none of them were rejected
+		static uint64_t EstimateFetches(Quality quality, uint32_t width, uint32_t height, uint32_t kernelSize) noexcept;
+
+		constexpr Quality GetQuality() const noexcept { return quality; }
 		constexpr void BindCamera(Camera::ICamera& camera) noexcept { mainCamera = &camera; }
+		// All SSAO buffers follow scaling of screen sized targets
+		void SetViewport(const GfxResPtr<GFX::Resource::Viewport>& viewport) noexcept;
+		void SetQuality(Quality newQuality) noexcept;
 
+		void Prepare(Graphics& gfx) override;
 		void Execute(Graphics& gfx) override;
 		void ShowWindow(Graphics& gfx);
 	};
@@ -0,0 +1,59 @@
+#include "LightUtilsPS.hlsli"
+#include "SSAOKernelPB.hlsli"
+#include "CameraPB.hlsli"
+#include "RenderScalePB.hlsli"
+
+Texture2D normalTex    : register(t5); // RG - octahedral normal
+
+Texture2D depthMap     : register(t8);
+Texture2D lowNormalTex : register(t13); // RG - normal, reduced resolution
+Texture2D lowDepthMap  : register(t14); // R - depth, reduced resolution
+Texture2D lowSsaoMap   : register(t15); // R - occlusion, reduced resolution
+
+static const float DEPTH_SHARPNESS = 32.0f;
+static const float NORMAL_POWER = 8.0f;
+static const float WEIGHT_EPSILON = 0.0001f;
+
+// Joint bilateral upsampling, tent filter over 4x4 reduced texels weighted by similarity
+// of their depth and normal to full resolution pixel. Replaces separate blur passes
+float main(float2 tc : TEXCOORD, float4 pixel : SV_POSITION) : SV_TARGET
+{
+	const int3 texel = int3(pixel.xy, 0);
+	const float2 codedNormal = normalTex.Load(texel).rg;
+	if (codedNormal.x == 0.0f && codedNormal.y == 0.0f)
+		return 1.0f;
+	const float3 normal = DecodeNormal(codedNormal);
+	const float depth = GetLinearDepth(depthMap.Load(texel).x, cb_nearClip, cb_farClip);
+
+	uint width, height;
+	lowSsaoMap.GetDimensions(width, height);
+	// Only part of reduced targets is used with dynamic resolution
+	const int2 maxTexel = max(int2(float2(width, height) * cb_renderScale) - 1, 0);
+	const float2 lowPos = pixel.xy / cb_downscale - 0.5f;
+	const int2 base = int2(floor(lowPos)) - 1;
+	const float2 fraction = lowPos - floor(lowPos);
+
+	float result = 0.0f;
+	float weightSum = 0.0f;
+	[unroll]
+	for (int y = 0; y < 4; ++y)
+	{
+		[unroll]
+		for (int x = 0; x < 4; ++x)
+		{
+			const int3 sampleTexel = int3(clamp(base + int2(x, y), 0, maxTexel), 0);
+			const float2 lowSphericNormal = lowNormalTex.Load(sampleTexel).rg;
+			if (lowSphericNormal.x == 0.0f && lowSphericNormal.y == 0.0f)
+				continue;
+
+			const float2 tent = saturate(1.0f - abs(float2(x, y) - 1.0f - fraction) * 0.5f);
+			const float lowDepth = GetLinearDepth(lowDepthMap.Load(sampleTexel).x, cb_nearClip, cb_farClip);
+			const float similarity = exp(-abs(lowDepth - depth) / depth * DEPTH_SHARPNESS)
+				* pow(saturate(dot(DecodeNormal(lowSphericNormal), normal)), NORMAL_POWER);
+			const float weight = tent.x * tent.y * (similarity + WEIGHT_EPSILON);
+			result += lowSsaoMap.Load(sampleTexel).r * weight;
+			weightSum += weight;
+		}
+	}
+	return weightSum > 0.0f ? result / weightSum : 1.0f;
+}
\ No newline at end of file
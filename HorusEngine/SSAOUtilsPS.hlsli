@@ -0,0 +1,36 @@
+#include "UtilsPS.hlsli"
+#include "LightUtilsPS.hlsli"
+#include "SamplersPS.hlsli"
+#include "SSAOKernelPB.hlsli"
+#include "CameraPB.hlsli"
+#include "RenderScalePB.hlsli"
+
+Texture2D noiseMap : register(t12); // RG - random vector
+
+// Occlusion around surface visible at given texture coordinates, depth map can have reduced resolution.
+// Noise is tiled per pixel of current target so neighbouring pixels use different kernel rotations
+float GetAmbientOcclusion(const in float2 tc, const in float3 normal, const in float depth, Texture2D depthMap)
+{
+	const float3 position = GetWorldPosition(tc, depth, cb_inverseViewProjection);
+	const float2 noise = noiseMap.Sample(splr_LW, tc * cb_renderScale * cb_tileDimensions).rg;
+
+	const float3x3 TBN = GetTangentToWorldUNorm(normalize(float3(noise, 0.0f)), normal);
+	float occlusion = 0.0f;
+	uint size = cb_kernelSize;
+	[unroll]
+	for (uint i = 0; i < size; ++i)
+	{
+		const float3 sampleRay = mul(cb_kernel[i], TBN);
+		if (dot(normalize(sampleRay), normal) < 0.15f)
+		{
+			--size;
+			continue;
+		}
+		const float4 samplePos = mul(float4(position + sampleRay * cb_sampleRadius, 1.0f), cb_viewProjection); // From tangent to clip space
+		const float2 offset = samplePos.xy / (samplePos.w * 2.0f) + 0.5f; // Perspective divide and transform to 0-1
+		const float sampleDepth = GetLinearDepth(depthMap.Sample(splr_PR, saturate(float2(offset.x, 1.0f - offset.y)) * cb_renderScale).x, cb_nearClip, cb_farClip) + cb_bias;
+		const float rangeCheck = smoothstep(0.0f, 1.0f, cb_sampleRadius / abs(sampleDepth - samplePos.z));
+		occlusion += (sampleDepth >= samplePos.z ? 0.0f : 1.0f) * rangeCheck;
+	}
+	return pow(1.0f - occlusion / size, cb_ssaoPower);
+}
\ No newline at end of file
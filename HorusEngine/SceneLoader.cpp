@@ -0,0 +1,130 @@
+#include "SceneLoader.h"
+#include "Model.h"
+#include "GfxResources.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+#include "assimp/Importer.hpp"
+#include <unordered_set>
+#include <filesystem>
+#include <algorithm>
+
+namespace GFX
+{
+	void SceneLoader::AddTiming(const std::string& asset, float time) noexcept
+	{
+		std::lock_guard<std::mutex> lock(timingsMutex);
+		timings.emplace_back(asset, time);
+	}
+
+	SceneLoader::SceneLoader(const SceneFile& scene)
+	{
+		Timer timer;
+		for (const auto& model : scene.models)
+			if (!importers.contains(model.file))
+				importers.emplace(model.file, std::make_unique<Assimp::Importer>());
+
+		Utils::ThreadPool& pool = Utils::ThreadPool::Get();
+		std::mutex texturesMutex;
+		std::unordered_set<std::string> textures;
+		std::vector<std::future<void>> textureTasks;
+		std::vector<std::future<void>> modelTasks;
+		modelTasks.reserve(importers.size());
+		for (auto& importer : importers)
+		{
+			modelTasks.emplace_back(pool.Schedule([&, file = importer.first, fileImporter = importer.second.get()]()
+			{
+				Timer modelTimer;
+				const aiScene& model = Shape::Model::ReadFile(*fileImporter, file);
+				AddTiming(file, modelTimer.Mark() * 1000.0f);
+
+				std::vector<std::string> paths;
+				const std::string path = std::filesystem::path(file).remove_filename().string();
+				std::vector<uint8_t> modelPermutations;
+				for (unsigned int i = 0; i < model.mNumMaterials; ++i)
+				{
+					Visual::Material::GetTexturePaths(*model.mMaterials[i], path, paths);
+					modelPermutations.emplace_back(Visual::Material::GetPermutation(*model.mMaterials[i]).GetKey());
+				}
+
+				std::lock_guard<std::mutex> lock(texturesMutex);
+				permutations.insert(modelPermutations.begin(), modelPermutations.end());
+				for (auto& texture : paths)
+				{
+					if (textures.emplace(texture).second)
+					{
+						textureTasks.emplace_back(pool.Schedule([this, texture]()
+						{
+							Timer textureTimer;
+							Resource::Texture::Preload(texture);
+							AddTiming(texture, textureTimer.Mark() * 1000.0f);
+						}));
+					}
+				}
+			}));
+		}
+		// Every task has to finish before rethrowing any error since they reference local state
+		for (auto& task : modelTasks)
+			task.wait();
+		for (auto& task : textureTasks)
+			task.wait();
+		preloadTime = timer.Mark() * 1000.0f;
+		try
+		{
+			for (auto& task : modelTasks)
+				task.get();
+			for (auto& task : textureTasks)
+				task.get();
+		}
+		catch (...)
+		{
+			Resource::Texture::ReleasePreloaded();
+			throw;
+		}
+	}
+
+	void SceneLoader::PrewarmShaders(Graphics& gfx)
+	{
+		Timer timer;
+		std::unordered_set<std::string> vertex, geometry, pixel;
+		for (uint8_t key : permutations)
+			Visual::ShaderPermutation(key).GetShaders(vertex, geometry, pixel);
+		std::vector<std::string> names;
+		names.reserve(vertex.size() + geometry.size() + pixel.size());
+		names.insert(names.end(), vertex.begin(), vertex.end());
+		names.insert(names.end(), geometry.begin(), geometry.end());
+		names.insert(names.end(), pixel.begin(), pixel.end());
+
+		// Every slot is written by single task and names are unique so no resource is shared between them
+		shaders.resize(names.size());
+		Utils::ThreadPool::Get().ParallelFor(names.size(), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				if (i < vertex.size())
+					shaders.at(i) = Resource::VertexShader::Get(gfx, names.at(i));
+				else if (i < vertex.size() + geometry.size())
+					shaders.at(i) = Resource::GeometryShader::Get(gfx, names.at(i));
+				else
+					shaders.at(i) = Resource::PixelShader::Get(gfx, names.at(i));
+			}
+		});
+		prewarmTime = timer.Mark() * 1000.0f;
+	}
+
+	SceneLoader::~SceneLoader()
+	{
+		Resource::Texture::ReleasePreloaded();
+	}
+
+	std::vector<std::pair<std::string, float>> SceneLoader::GetTimings() noexcept
+	{
+		std::lock_guard<std::mutex> lock(timingsMutex);
+		std::sort(timings.begin(), timings.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+		return timings;
+	}
+
+	const aiScene& SceneLoader::GetModel(const std::string& file) const
+	{
+		return *importers.at(file)->GetScene();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "SceneFile.h"
+#include "ShaderPermutation.h"
+#include "GfxResPtr.h"
+#include "assimp/scene.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
+
+namespace Assimp
+{
+	class Importer;
+}
+
+namespace GFX
+{
+	// Decodes all assets of scene on thread pool before any object is created.
+	// Every file is loaded once, textures of model are scheduled as soon as its file is imported.
+	class SceneLoader
+	{
+		std::unordered_map<std::string, std::unique_ptr<Assimp::Importer>> importers;
+		// Keys of shader permutations used by scene materials
+		std::unordered_set<uint8_t> permutations;
+		// Prewarmed shaders are kept alive here until scene objects take them from codex
+		std::vector<GfxResPtr<Resource::IBindable>> shaders;
+		std::mutex timingsMutex;
+		// Asset name with its load time in ms
+		std::vector<std::pair<std::string, float>> timings;
+		float preloadTime = 0.0f;
+		float prewarmTime = 0.0f;
+
+	public:
+		SceneLoader(const SceneFile& scene);
+		SceneLoader(const SceneLoader&) = delete;
+		SceneLoader& operator=(const SceneLoader&) = delete;
+		~SceneLoader();
+
+		constexpr float GetPreloadTime() const noexcept { return preloadTime; }
+		constexpr float GetPrewarmTime() const noexcept { return prewarmTime; }
+		inline size_t GetPrewarmedCount() const noexcept { return shaders.size(); }
+		// Sorted from the slowest asset
+		std::vector<std::pair<std::string, float>> GetTimings() noexcept;
+
+		void AddTiming(const std::string& asset, float time) noexcept;
+		// Creates all shader variants needed by scene materials in parallel before first object uses them
+		void PrewarmShaders(Graphics& gfx);
+
+		const aiScene& GetModel(const std::string& file) const;
+	};
+}
\ No newline at end of file
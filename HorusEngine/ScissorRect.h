@@ -0,0 +1,21 @@
+#pragma once
+#include "GfxResPtr.h"
+
+namespace GFX::Resource
+{
+	// Requires rasterizer with scissor enabled, rectangle can change between draws
+	class ScissorRect : public IBindable
+	{
+		D3D11_RECT rect;
+
+	public:
+		inline ScissorRect(Graphics& gfx, LONG width, LONG height) noexcept : rect({ 0, 0, width, height }) {}
+		virtual ~ScissorRect() = default;
+
+		constexpr const D3D11_RECT& GetRect() const noexcept { return rect; }
+		constexpr void SetRect(const D3D11_RECT& newRect) noexcept { rect = newRect; }
+
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->RSSetScissorRects(1U, &rect); }
+		inline std::string GetRID() const noexcept override { return IBindable::GetNoCodexRID(); }
+	};
+}
\ No newline at end of file
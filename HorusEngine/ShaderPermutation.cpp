@@ -0,0 +1,49 @@
+#include "ShaderPermutation.h"
+
+namespace GFX::Visual
+{
+	std::string ShaderPermutation::GetPhongVS() const noexcept
+	{
+		std::string name = "PhongVS";
+		if (Has(Texture))
+			name += "Texture";
+		if (Has(Normal))
+			name += "Normal";
+		if (Has(Parallax))
+			name += "Parallax";
+		return name;
+	}
+
+	std::string ShaderPermutation::GetPhongPS() const noexcept
+	{
+		std::string name = "PhongPS";
+		if (Has(Texture))
+			name += "Texture";
+		if (Has(Normal))
+			name += "Normal";
+		if (Has(Parallax))
+			name += "Parallax";
+		if (Has(Specular))
+			name += "Specular";
+		return name;
+	}
+
+	std::string ShaderPermutation::GetShadowType() const noexcept
+	{
+		if (!Has(Texture))
+			return "";
+		return Has(Parallax) ? "TextureParallax" : "Texture";
+	}
+
+	void ShaderPermutation::GetShaders(std::unordered_set<std::string>& vertex, std::unordered_set<std::string>& geometry, std::unordered_set<std::string>& pixel) const
+	{
+		const std::string shadowType = GetShadowType();
+		vertex.emplace(GetPhongVS());
+		vertex.emplace("SolidVS");
+		vertex.emplace("ShadowVS" + shadowType);
+		vertex.emplace("ShadowCubeVS" + shadowType);
+		geometry.emplace("ShadowCubeGS" + shadowType);
+		pixel.emplace(GetPhongPS());
+		pixel.emplace("ShadowPS" + shadowType);
+	}
+}
\ No newline at end of file
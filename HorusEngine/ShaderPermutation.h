@@ -0,0 +1,37 @@
+#pragma once
+#include <unordered_set>
+#include <string>
+
+namespace GFX::Visual
+{
+	// Key of material features selecting compiled variant of every shader that renders it
+	class ShaderPermutation
+	{
+		uint8_t key = 0;
+
+	public:
+		enum Feature : uint8_t
+		{
+			Texture = 1,
+			Normal = 2,
+			Parallax = 4,
+			Specular = 8
+		};
+
+		ShaderPermutation() = default;
+		constexpr ShaderPermutation(uint8_t key) noexcept : key(key) {}
+
+		constexpr uint8_t GetKey() const noexcept { return key; }
+		constexpr bool Has(Feature feature) const noexcept { return key & feature; }
+		constexpr void Add(Feature feature) noexcept { key |= feature; }
+		constexpr bool operator==(const ShaderPermutation& permutation) const noexcept { return key == permutation.key; }
+
+		std::string GetPhongVS() const noexcept;
+		std::string GetPhongPS() const noexcept;
+		// Shadows are affected only by diffuse alpha and parallax mapping
+		std::string GetShadowType() const noexcept;
+
+		// Names of all shaders used by techniques of objects with this material
+		void GetShaders(std::unordered_set<std::string>& vertex, std::unordered_set<std::string>& geometry, std::unordered_set<std::string>& pixel) const;
+	};
+}
\ No newline at end of file
@@ -83,6 +83,7 @@ namespace GFX::Pipeline::RenderPass
 
 		renderTarget->Clear(gfx, { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX });
 		depthStencil->Clear(gfx);
-		QueuePass::Execute(gfx);
+		// Only objects inside light range can cast shadows visible in the scene
+		QueuePass::Execute(gfx, DirectX::BoundingSphere(pos, shadowSource->GetRange()));
 	}
 }
\ No newline at end of file
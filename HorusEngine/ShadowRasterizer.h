@@ -20,7 +20,8 @@ namespace GFX::Resource
 		constexpr float GetSlopeBias() const noexcept { return slopeBias; }
 		constexpr float GetBiasClamp() const noexcept { return biasClamp; }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->RSSetState(state.Get()); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->RSSetState(state.Get()); GetBoundState(gfx, PipelineSlot::Rasterizer) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::Rasterizer; }
 		inline std::string GetRID() const noexcept override { return IBindable::GetNoCodexRID(); }
 	};
 
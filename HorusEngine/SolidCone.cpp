@@ -34,14 +34,7 @@ namespace GFX::Shape
 		techniques.emplace_back(Pipeline::TechniqueFactory::MakeOutlineBlur(gfx, graph, name, std::move(vertexLayout)));
 		SetTechniques(gfx, std::move(techniques), *this);
 
-		UpdateTransformMatrix();
-	}
-
-	void SolidCone::UpdateTransformMatrix() noexcept
-	{
 		const float circleScale = height * tanf(static_cast<float>(2.0 * M_PI - FLT_EPSILON) * angle / 361.0f);
-		DirectX::XMStoreFloat4x4(transform.get(),
-			DirectX::XMMatrixScaling(circleScale, height, circleScale) *
-			CreateTransformMatrix());
+		SetLocalScale({ circleScale, height, circleScale });
 	}
 }
\ No newline at end of file
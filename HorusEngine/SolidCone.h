@@ -16,7 +16,5 @@ namespace GFX::Shape
 
 		constexpr Resource::ConstBufferExPixelCache& GetMaterial() noexcept { return *materialBuffer; }
 		inline void SetTopologyMesh(Graphics& gfx) noexcept override { SetTopology(gfx, D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ); }
-
-		void UpdateTransformMatrix() noexcept override;
 	};
 }
\ No newline at end of file
@@ -33,13 +33,6 @@ namespace GFX::Shape
 		techniques.emplace_back(Pipeline::TechniqueFactory::MakeOutlineBlur(gfx, graph, name, std::move(vertexLayout)));
 		SetTechniques(gfx, std::move(techniques), *this);
 
-		UpdateTransformMatrix();
-	}
-
-	void SolidGlobe::UpdateTransformMatrix() noexcept
-	{
-		DirectX::XMStoreFloat4x4(transform.get(),
-			DirectX::XMMatrixScalingFromVector(DirectX::XMLoadFloat3(&sizes)) *
-			CreateTransformMatrix());
+		SetLocalScale(sizes);
 	}
 }
\ No newline at end of file
@@ -32,13 +32,6 @@ namespace GFX::Shape
 		techniques.emplace_back(Pipeline::TechniqueFactory::MakeOutlineScale(gfx, graph, name, std::move(vertexLayout)));
 		SetTechniques(gfx, std::move(techniques), *this);
 
-		UpdateTransformMatrix();
-	}
-
-	void SolidRectangle::UpdateTransformMatrix() noexcept
-	{
-		DirectX::XMStoreFloat4x4(transform.get(),
-			DirectX::XMMatrixScaling(width, height, 1.0f) *
-			CreateTransformMatrix());
+		SetLocalScale({ width, height, 1.0f });
 	}
 }
\ No newline at end of file
@@ -12,7 +12,5 @@ namespace GFX::Shape
 		SolidRectangle(Graphics& gfx, Pipeline::RenderGraph& graph, const DirectX::XMFLOAT3& position,
 			const std::string& name, Data::ColorFloat3 color, float width, float height);
 		virtual ~SolidRectangle() = default;
-
-		void UpdateTransformMatrix() noexcept override;
 	};
 }
\ No newline at end of file
@@ -18,8 +18,16 @@ namespace GFX::Pipeline::RenderPass
 		return layout;
 	}
 
+	DirectX::BoundingSphere SpotLightingPass::GetVolume(const Light::ILight& light) const noexcept
+	{
+		const auto& buffer = light.GetBuffer();
+		const DirectX::XMFLOAT3& direction = buffer["direction"];
+		// Same angle extension as in cone volume
+		return LightBounds::GetConeSphere(light.GetPos(), direction, light.GetRange(), static_cast<float>(buffer["outerAngle"]) + 0.22f);
+	}
+
 	SpotLightingPass::SpotLightingPass(Graphics& gfx, const std::string& name)
-		: BindingPass(name), QueuePass(name), shadowMapPass(gfx, "shadowMap", DirectX::XMMatrixPerspectiveFovLH(M_PI_2, 1.0f, 0.01f, 1000.0f))
+		: BindingPass(name), LightVolumePass(gfx, name), shadowMapPass(gfx, "shadowMap", DirectX::XMMatrixPerspectiveFovLH(M_PI_2, 1.0f, 0.01f, 1000.0f))
 	{
 		AddBindableSink<Resource::IRenderTarget>("shadowMap");
 		SetSinkLinkage("shadowMap", name + ".shadowMap.shadowMap");
@@ -35,7 +43,7 @@ namespace GFX::Pipeline::RenderPass
 		AddBind(shadowBuffer);
 		AddBind(GFX::Resource::PixelShader::Get(gfx, "SpotLightPS"));
 		AddBind(GFX::Resource::Blender::Get(gfx, GFX::Resource::Blender::Type::Light));
-		AddBind(GFX::Resource::Rasterizer::Get(gfx, D3D11_CULL_MODE::D3D11_CULL_FRONT, false));
+		AddBind(GFX::Resource::Rasterizer::Get(gfx, D3D11_CULL_MODE::D3D11_CULL_FRONT, false, true));
 
 		auto vertexShader = GFX::Resource::VertexShader::Get(gfx, "LightVS");
 		AddBind(GFX::Resource::InputLayout::Get(gfx, std::make_shared<Data::VertexLayout>(), vertexShader));
@@ -46,7 +54,7 @@ namespace GFX::Pipeline::RenderPass
 	void SpotLightingPass::Reset() noexcept
 	{
 		shadowMapPass.Reset();
-		QueuePass::Reset();
+		LightVolumePass::Reset();
 	}
 
 	Base::BasePass& SpotLightingPass::GetInnerPass(std::deque<std::string> nameChain)
@@ -61,14 +69,17 @@ namespace GFX::Pipeline::RenderPass
 		assert(mainCamera);
 		DRAW_TAG_START(gfx, GetName());
 		mainCamera->BindPS(gfx);
-		for (auto& job : GetJobs())
+		auto& jobs = GetJobs();
+		for (size_t i = 0, size = jobs.size(); i < size; ++i)
 		{
+			auto& job = jobs.at(i);
 			DRAW_TAG_START(gfx, job.GetData().GetName());
 			shadowMapPass.BindLight(dynamic_cast<Light::ILight&>(job.GetData()));
 			shadowMapPass.Execute(gfx);
 			DirectX::XMStoreFloat4x4(&shadowBuffer->GetBuffer()["shadowViewProjection"], DirectX::XMMatrixTranspose(gfx.GetView() * gfx.GetProjection()));
 			mainCamera->BindCamera(gfx);
 			BindAll(gfx);
+			BindBounds(gfx, i);
 			job.Execute(gfx);
 			DRAW_TAG_END(gfx);
 		}
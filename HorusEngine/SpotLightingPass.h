@@ -1,16 +1,19 @@
 #pragma once
+#include "LightVolumePass.h"
 #include "ShadowMapPass.h"
 
 namespace GFX::Pipeline::RenderPass
 {
-	class SpotLightingPass : public Base::QueuePass
+	class SpotLightingPass : public Base::LightVolumePass
 	{
 		ShadowMapPass shadowMapPass;
-		Camera::ICamera* mainCamera = nullptr;
 		GfxResPtr<GFX::Resource::ConstBufferExPixelCache> shadowBuffer;
 
 		static inline Data::CBuffer::DCBLayout MakeLayout() noexcept;
 
+	protected:
+		DirectX::BoundingSphere GetVolume(const Light::ILight& light) const noexcept override;
+
 	public:
 		SpotLightingPass(Graphics& gfx, const std::string& name);
 		virtual ~SpotLightingPass() = default;
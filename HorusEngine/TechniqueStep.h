@@ -21,6 +21,7 @@ namespace GFX::Pipeline
 		inline DirectX::XMMATRIX GetTransform() const noexcept { if (data) return data->GetTransform(); return DirectX::XMMatrixIdentity(); }
 		inline void Submit(JobData& data) noexcept { pass->Add({ &data, this }); }
 		inline void Bind(Graphics& gfx, RenderChannel mode = RenderChannel::All) { if (data) data->Bind(gfx, mode); }
+		inline void ReportScreenSize(float screenSize) const noexcept { if (data) data->ReportScreenSize(screenSize); }
 		inline bool Accept(Graphics& gfx, Probe::BaseProbe& probe) noexcept override { if (data) return data->Accept(gfx, probe); return false; }
 		inline void SetParentReference(Graphics& gfx, const GfxObject& parent) { if (data) data->SetTransformBuffer(gfx, parent); }
 	};
@@ -1,44 +1,220 @@
 #include "Texture.h"
 #include "GfxExceptionMacros.h"
-#include <thread>
+#include <filesystem>
 
 namespace GFX::Resource
 {
-	Texture::Texture(Graphics& gfx, const Surface& surface, const std::string& name, UINT slot, bool alphaEnable) : slot(slot), path(name)
+	std::mutex Texture::preloadMutex;
+	std::unordered_map<std::string, Texture::Preloaded> Texture::preloaded;
+
+	std::string Texture::GetCookedPath(const std::string& path) noexcept
+	{
+		std::filesystem::path cooked = path;
+		if (cooked.extension() != ".dds")
+		{
+			cooked.replace_extension(".dds");
+			// Source edited after cooking takes precedence over stale cooked file
+			std::error_code error;
+			const auto cookedTime = std::filesystem::last_write_time(cooked, error);
+			if (!error)
+			{
+				const auto sourceTime = std::filesystem::last_write_time(path, error);
+				if (error || sourceTime <= cookedTime)
+					return cooked.string();
+			}
+		}
+		return path;
+	}
+
+	bool Texture::IsStreamable(const Surface& surface) noexcept
+	{
+		const size_t width = surface.GetWidth(), height = surface.GetHeight();
+		if (surface.GetMipCount() <= 1 || std::max(width, height) <= TextureResidency::TAIL_SIZE ||
+			(width & (width - 1)) || (height & (height - 1)))
+			return false;
+		if (!surface.IsCompressed())
+			return true;
+		// Smaller dimension of mip tail
+		size_t size = std::min(width, height);
+		for (size_t maxSize = std::max(width, height); maxSize > TextureResidency::TAIL_SIZE; maxSize >>= 1)
+			size >>= 1;
+		return size >= 4;
+	}
+
+	std::shared_ptr<Surface> Texture::LoadSurface(const std::string& path)
+	{
+		{
+			std::lock_guard<std::mutex> lock(preloadMutex);
+			auto it = preloaded.find(path);
+			if (it != preloaded.end())
+				return it->second.surface;
+		}
+		return std::make_shared<Surface>(GetCookedPath(path), false);
+	}
+
+	TextureMetadata Texture::GetMetadata(const std::string& path, const Surface& surface)
+	{
+		{
+			std::lock_guard<std::mutex> lock(preloadMutex);
+			auto it = preloaded.find(path);
+			if (it != preloaded.end() && it->second.surface.get() == &surface)
+				return it->second.metadata;
+		}
+		return TextureMetadata::Get(GetCookedPath(path), surface);
+	}
+
+	void Texture::Preload(const std::string& path)
+	{
+		{
+			std::lock_guard<std::mutex> lock(preloadMutex);
+			if (preloaded.contains(path))
+				return;
+		}
+		const std::string file = GetCookedPath(path);
+		auto surface = std::make_shared<Surface>(file, false);
+		TextureMetadata metadata = TextureMetadata::Get(file, *surface);
+		std::lock_guard<std::mutex> lock(preloadMutex);
+		preloaded.emplace(path, Preloaded{ std::move(surface), std::move(metadata) });
+	}
+
+	void Texture::ReleasePreloaded() noexcept
+	{
+		std::lock_guard<std::mutex> lock(preloadMutex);
+		preloaded.clear();
+	}
+
+	void Texture::CreateView(Graphics& gfx)
 	{
 		GFX_ENABLE_ALL(gfx);
+		D3D11_TEXTURE2D_DESC textureDesc;
+		texture->GetDesc(&textureDesc);
 
-		std::unique_ptr<std::thread> checkAlpha = nullptr;
+		D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc = {};
+		viewDesc.Format = textureDesc.Format;
+		viewDesc.ViewDimension = D3D11_SRV_DIMENSION::D3D11_SRV_DIMENSION_TEXTURE2D;
+		viewDesc.Texture2D.MipLevels = -1;
+		viewDesc.Texture2D.MostDetailedMip = 0;
+		GFX_THROW_FAILED(GetDevice(gfx)->CreateShaderResourceView(texture.Get(), &viewDesc, &textureView));
+		SET_DEBUG_NAME_RID(textureView.Get());
+	}
+
+	void Texture::CreateStreamed(Graphics& gfx, DXGI_FORMAT format, UINT width, UINT height, UINT mipCount, uint8_t firstMip, const Surface* surface)
+	{
+		GFX_ENABLE_ALL(gfx);
+		D3D11_TEXTURE2D_DESC textureDesc = { 0 };
+		textureDesc.Width = std::max(width >> firstMip, 1U);
+		textureDesc.Height = std::max(height >> firstMip, 1U);
+		textureDesc.MipLevels = mipCount - firstMip;
+		textureDesc.ArraySize = 1;
+		textureDesc.Format = format;
+		textureDesc.SampleDesc.Count = 1;
+		textureDesc.SampleDesc.Quality = 0;
+		// Default usage allows copying resident mips when evicting
+		textureDesc.Usage = D3D11_USAGE::D3D11_USAGE_DEFAULT;
+		textureDesc.BindFlags = D3D11_BIND_FLAG::D3D11_BIND_SHADER_RESOURCE;
+		textureDesc.CPUAccessFlags = 0;
+		textureDesc.MiscFlags = 0;
+		std::vector<D3D11_SUBRESOURCE_DATA> mips;
+		if (surface)
+		{
+			mips.resize(textureDesc.MipLevels);
+			for (size_t i = 0; i < mips.size(); ++i)
+			{
+				const auto& mip = surface->GetMip(i + firstMip);
+				mips.at(i).pSysMem = mip.pixels;
+				mips.at(i).SysMemPitch = static_cast<UINT>(mip.rowPitch);
+				mips.at(i).SysMemSlicePitch = static_cast<UINT>(mip.slicePitch);
+			}
+		}
+		GFX_THROW_FAILED(GetDevice(gfx)->CreateTexture2D(&textureDesc, surface ? mips.data() : nullptr, &texture));
+		CreateView(gfx);
+	}
+
+	Texture::Texture(Graphics& gfx, const Surface& surface, const std::string& name, UINT slot, bool alphaEnable) : slot(slot), path(name)
+	{
+		GFX_ENABLE_ALL(gfx);
 		if (alphaEnable)
-			checkAlpha = std::make_unique<std::thread>([&surface, this]() { alpha = surface.HasAlpha(); });
+			alpha = GetMetadata(path, surface).GetAlpha();
+
+		// Only mip tail is uploaded for streamed textures, rest is loaded on demand
+		if (IsStreamable(surface))
+		{
+			streamIndex = TextureStreamer::Get().Register(*this, surface);
+			residentMip = TextureStreamer::Get().GetResidentMip(streamIndex);
+			CreateStreamed(gfx, surface.GetFormat(), static_cast<UINT>(surface.GetWidth()), static_cast<UINT>(surface.GetHeight()),
+				static_cast<UINT>(surface.GetMipCount()), residentMip, &surface);
+			return;
+		}
 
 		D3D11_TEXTURE2D_DESC textureDesc = { 0 };
 		textureDesc.Width = static_cast<UINT>(surface.GetWidth());
 		textureDesc.Height = static_cast<UINT>(surface.GetHeight());
 		textureDesc.Format = surface.GetFormat();
-		textureDesc.MipLevels = 0;
 		textureDesc.ArraySize = 1;
 		textureDesc.SampleDesc.Count = 1;
 		textureDesc.SampleDesc.Quality = 0;
-		textureDesc.Usage = D3D11_USAGE::D3D11_USAGE_DEFAULT;
-		textureDesc.BindFlags = D3D11_BIND_FLAG::D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_FLAG::D3D11_BIND_RENDER_TARGET;
 		textureDesc.CPUAccessFlags = 0;
-		textureDesc.MiscFlags = D3D11_RESOURCE_MISC_FLAG::D3D11_RESOURCE_MISC_GENERATE_MIPS;
-		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
-		GFX_THROW_FAILED(GetDevice(gfx)->CreateTexture2D(&textureDesc, nullptr, &texture));
+		// Pre-mipped or compressed data is uploaded as-is
+		const bool cooked = surface.GetMipCount() > 1 || surface.IsCompressed();
+		if (cooked)
+		{
+			textureDesc.MipLevels = static_cast<UINT>(surface.GetMipCount());
+			textureDesc.Usage = D3D11_USAGE::D3D11_USAGE_IMMUTABLE;
+			textureDesc.BindFlags = D3D11_BIND_FLAG::D3D11_BIND_SHADER_RESOURCE;
+			textureDesc.MiscFlags = 0;
+			std::vector<D3D11_SUBRESOURCE_DATA> mips(textureDesc.MipLevels);
+			for (size_t i = 0; i < mips.size(); ++i)
+			{
+				const auto& mip = surface.GetMip(i);
+				mips.at(i).pSysMem = mip.pixels;
+				mips.at(i).SysMemPitch = static_cast<UINT>(mip.rowPitch);
+				mips.at(i).SysMemSlicePitch = static_cast<UINT>(mip.slicePitch);
+			}
+			GFX_THROW_FAILED(GetDevice(gfx)->CreateTexture2D(&textureDesc, mips.data(), &texture));
+		}
+		else
+		{
+			textureDesc.MipLevels = 0;
+			textureDesc.Usage = D3D11_USAGE::D3D11_USAGE_DEFAULT;
+			textureDesc.BindFlags = D3D11_BIND_FLAG::D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_FLAG::D3D11_BIND_RENDER_TARGET;
+			textureDesc.MiscFlags = D3D11_RESOURCE_MISC_FLAG::D3D11_RESOURCE_MISC_GENERATE_MIPS;
+			GFX_THROW_FAILED(GetDevice(gfx)->CreateTexture2D(&textureDesc, nullptr, &texture));
+			GetContext(gfx)->UpdateSubresource(texture.Get(), 0U, nullptr, surface.GetBuffer(), static_cast<UINT>(surface.GetRowByteSize()), 0U);
+		}
+		CreateView(gfx);
 
-		GetContext(gfx)->UpdateSubresource(texture.Get(), 0U, nullptr, surface.GetBuffer(), static_cast<UINT>(surface.GetRowByteSize()), 0U);
+		if (!cooked)
+			GetContext(gfx)->GenerateMips(textureView.Get());
+	}
 
-		D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc = {};
-		viewDesc.Format = textureDesc.Format;
-		viewDesc.ViewDimension = D3D11_SRV_DIMENSION::D3D11_SRV_DIMENSION_TEXTURE2D;
-		viewDesc.Texture2D.MipLevels = -1;
-		viewDesc.Texture2D.MostDetailedMip = 0;
-		GFX_THROW_FAILED(GetDevice(gfx)->CreateShaderResourceView(texture.Get(), &viewDesc, &textureView));
-		SET_DEBUG_NAME_RID(textureView.Get());
+	Texture::~Texture()
+	{
+		if (IsStreamed())
+			TextureStreamer::Get().Unregister(streamIndex);
+	}
 
-		GetContext(gfx)->GenerateMips(textureView.Get());
-		if (alphaEnable)
-			checkAlpha->join();
+	bool Texture::Stream(Graphics& gfx, const Surface& surface, uint8_t mip)
+	{
+		D3D11_TEXTURE2D_DESC textureDesc;
+		texture->GetDesc(&textureDesc);
+		const UINT mipCount = textureDesc.MipLevels + residentMip;
+		// Source file could change in the meantime
+		if (surface.GetMipCount() != mipCount || surface.GetFormat() != textureDesc.Format)
+			return false;
+		CreateStreamed(gfx, textureDesc.Format, textureDesc.Width << residentMip, textureDesc.Height << residentMip, mipCount, mip, &surface);
+		residentMip = mip;
+		return true;
+	}
+
+	void Texture::Evict(Graphics& gfx, uint8_t mip)
+	{
+		D3D11_TEXTURE2D_DESC textureDesc;
+		texture->GetDesc(&textureDesc);
+		const UINT mipCount = textureDesc.MipLevels + residentMip;
+		Microsoft::WRL::ComPtr<ID3D11Texture2D> previous = std::move(texture);
+		CreateStreamed(gfx, textureDesc.Format, textureDesc.Width << residentMip, textureDesc.Height << residentMip, mipCount, mip, nullptr);
+		for (UINT i = 0, count = mipCount - mip; i < count; ++i)
+			GetContext(gfx)->CopySubresourceRegion(texture.Get(), i, 0U, 0U, 0U, previous.Get(), i + mip - residentMip, nullptr);
+		residentMip = mip;
 	}
 }
\ No newline at end of file
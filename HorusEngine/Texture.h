@@ -1,28 +1,70 @@
 #pragma once
 #include "GfxResPtr.h"
-#include "Surface.h"
+#include "TextureStreamer.h"
+#include "TextureMetadata.h"
+#include <unordered_map>
+#include <mutex>
 
 namespace GFX::Resource
 {
 	class Texture : public IBindable
 	{
+		struct Preloaded
+		{
+			std::shared_ptr<Surface> surface;
+			TextureMetadata metadata;
+		};
+
 		UINT slot;
-		bool alpha = false;
+		TextureMetadata::Alpha alpha = TextureMetadata::Alpha::Opaque;
 		std::string path;
 		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> textureView;
+		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+		uint32_t streamIndex = TextureResidency::INVALID_INDEX;
+		uint8_t residentMip = 0;
+
+		// Surfaces decoded ahead of creation by scene loader
+		static std::mutex preloadMutex;
+		static std::unordered_map<std::string, Preloaded> preloaded;
+
+		// Texture cooked by EditTool is stored next to source file as DDS with full mip chain, used only when not older than source
+		static std::string GetCookedPath(const std::string& path) noexcept;
+		// Block compressed textures need dimensions divisible by 4 on every resident top mip
+		static bool IsStreamable(const Surface& surface) noexcept;
+		static std::shared_ptr<Surface> LoadSurface(const std::string& path);
+		// Metadata computed during preload or read from sidecar of texture file
+		static TextureMetadata GetMetadata(const std::string& path, const Surface& surface);
+
+		void CreateView(Graphics& gfx);
+		// Creates texture containing mips starting from given level, initial data is taken from surface when present
+		void CreateStreamed(Graphics& gfx, DXGI_FORMAT format, UINT width, UINT height, UINT mipCount, uint8_t firstMip, const Surface* surface);
 
 	public:
 		inline Texture(Graphics& gfx, const std::string& path, UINT slot = 0U, bool alphaEnable = false) :
-			Texture(gfx, Surface(path), path, slot, alphaEnable) {}
+			Texture(gfx, *LoadSurface(path), path, slot, alphaEnable) {}
 		Texture(Graphics& gfx, const Surface& surface, const std::string& name, UINT slot = 0U, bool alphaEnable = false);
-		virtual ~Texture() = default;
+		virtual ~Texture();
+
+		// Decodes texture file and classifies its content so later creation only uploads it, safe to call from multiple threads
+		static void Preload(const std::string& path);
+		static void ReleasePreloaded() noexcept;
 
 		static inline GfxResPtr<Texture> Get(Graphics& gfx, const std::string& path, UINT slot = 0U, bool alphaEnable = false);
 		static inline GfxResPtr<Texture> Get(Graphics& gfx, const Surface& surface, const std::string& name, UINT slot = 0U, bool alphaEnable = false);
 		static inline std::string GenerateRID(const std::string& path, UINT slot = 0U, bool alphaEnable = false) noexcept;
 		static inline std::string GenerateRID(const Surface& surface, const std::string& name, UINT slot = 0U, bool alphaEnable = false) noexcept;
 
-		constexpr bool HasAlpha() const noexcept { return alpha; }
+		constexpr bool HasAlpha() const noexcept { return alpha != TextureMetadata::Alpha::Opaque; }
+		constexpr TextureMetadata::Alpha GetAlpha() const noexcept { return alpha; }
+		constexpr bool IsStreamed() const noexcept { return streamIndex != TextureResidency::INVALID_INDEX; }
+		inline std::string GetStreamPath() const noexcept { return GetCookedPath(path); }
+		inline void ReportUsage(float screenSize) noexcept { if (IsStreamed()) TextureStreamer::Get().ReportUsage(streamIndex, screenSize); }
+
+		// Replaces resident mips with ones starting from given level, surface has to contain full mip chain.
+		// Returns false when surface does not match texture and nothing was uploaded
+		bool Stream(Graphics& gfx, const Surface& surface, uint8_t mip);
+		// Drops mips more detailed than given level
+		void Evict(Graphics& gfx, uint8_t mip);
 
 		inline void Bind(Graphics& gfx) override { GetContext(gfx)->PSSetShaderResources(slot, 1U, textureView.GetAddressOf()); }
 		inline std::string GetRID() const noexcept override { return GenerateRID(path, slot); }
@@ -36,7 +78,7 @@ namespace GFX::Resource
 
 	inline GfxResPtr<Texture> Texture::Get(Graphics& gfx, const std::string& path, UINT slot, bool alphaEnable)
 	{
-		return Codex::Resolve<Texture>(gfx, Surface(path), path, slot, alphaEnable);
+		return Codex::Resolve<Texture>(gfx, path, slot, alphaEnable);
 	}
 
 	inline GfxResPtr<Texture> Texture::Get(Graphics& gfx, const Surface& surface, const std::string& name, UINT slot, bool alphaEnable)
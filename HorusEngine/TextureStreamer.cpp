@@ -0,0 +1,111 @@
+#include "TextureStreamer.h"
+#include "Texture.h"
+#include "ThreadPool.h"
+
+namespace GFX::Resource
+{
+	TextureStreamer& TextureStreamer::Get() noexcept
+	{
+		static TextureStreamer* streamer = new TextureStreamer;
+		return *streamer;
+	}
+
+	uint32_t TextureStreamer::Register(Texture& texture, const Surface& surface) noexcept
+	{
+		const uint32_t index = residency.Add(static_cast<uint32_t>(surface.GetWidth()), static_cast<uint32_t>(surface.GetHeight()),
+			static_cast<uint8_t>(surface.GetMipCount()), static_cast<uint32_t>(DirectX::BitsPerPixel(surface.GetFormat())), surface.IsCompressed());
+		if (index >= slots.size())
+			slots.resize(index + 1ULL);
+		slots.at(index).texture = &texture;
+		return index;
+	}
+
+	void TextureStreamer::Unregister(uint32_t index) noexcept
+	{
+		residency.Remove(index);
+		// Loads still in flight are discarded by generation check
+		auto& slot = slots.at(index);
+		slot.texture = nullptr;
+		++slot.generation;
+	}
+
+	void TextureStreamer::Update(Graphics& gfx)
+	{
+		{
+			std::lock_guard<std::mutex> lock(loadedMutex);
+			uploads.swap(loaded);
+		}
+		// Every finished load has to end as completed or cancelled, otherwise its bytes stay pending forever
+		for (size_t i = 0; i < uploads.size(); ++i)
+		{
+			const auto& upload = uploads.at(i);
+			const auto& slot = slots.at(upload.index);
+			if (slot.generation != upload.generation)
+				continue;
+			bool streamed = false;
+			if (upload.surface)
+			{
+				try
+				{
+					streamed = slot.texture->Stream(gfx, *upload.surface, upload.mip);
+				}
+				catch (...)
+				{
+					for (; i < uploads.size(); ++i)
+						if (slots.at(uploads.at(i).index).generation == uploads.at(i).generation)
+							residency.CancelLoad(uploads.at(i).index);
+					uploads.clear();
+					throw;
+				}
+			}
+			if (streamed)
+				residency.CompleteLoad(upload.index);
+			else
+				residency.CancelLoad(upload.index);
+		}
+		uploads.clear();
+		if (!enabled)
+			return;
+
+		loads.clear();
+		evictions.clear();
+		residency.Update(loads, evictions, MAX_LOADS_PER_FRAME);
+		for (const auto& eviction : evictions)
+			slots.at(eviction.texture).texture->Evict(gfx, eviction.mip);
+		for (const auto& load : loads)
+		{
+			LoadedMips mips = { load.texture, slots.at(load.texture).generation, load.mip, nullptr };
+			Utils::ThreadPool::Get().Schedule([this, mips = std::move(mips), path = slots.at(load.texture).texture->GetStreamPath()]() mutable
+				{
+					try
+					{
+						mips.surface = std::make_unique<Surface>(path, false);
+					}
+					catch (...)
+					{
+						mips.surface = nullptr;
+					}
+					std::lock_guard<std::mutex> lock(loadedMutex);
+					loaded.emplace_back(std::move(mips));
+				});
+		}
+	}
+
+	void TextureStreamer::ShowWindow() noexcept
+	{
+		if (ImGui::CollapsingHeader("Texture streaming"))
+		{
+			ImGui::Checkbox("Enable##texture_streaming", &enabled);
+			ImGui::Text("Budget [MB]");
+			ImGui::SetNextItemWidth(-1.0f);
+			if (ImGui::SliderInt("##streaming_budget", &budgetMB, 16, 4096))
+				residency.SetBudget(static_cast<size_t>(budgetMB) * 1024ULL * 1024ULL);
+			constexpr float MB = 1024.0f * 1024.0f;
+			ImGui::Text("Streamed textures: %llu", static_cast<unsigned long long>(residency.GetTextureCount()));
+			ImGui::Text("Resident: %.1f MB, pending: %.1f MB", residency.GetResidentBytes() / MB, residency.GetPendingBytes() / MB);
+			ImGui::Text("Loaded: %.1f MB, evicted: %.1f MB", residency.GetLoadedBytes() / MB, residency.GetEvictedBytes() / MB);
+			ImGui::Text("Mip misses: %llu / %llu", static_cast<unsigned long long>(residency.GetMissCount()),
+				static_cast<unsigned long long>(residency.GetUsedCount()));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include "Graphics.h"
+#include "TextureResidency.h"
+#include "Surface.h"
+#include <mutex>
+
+namespace GFX::Resource
+{
+	class Texture;
+
+	// Streams higher mips of cooked textures on background threads, residency is decided by TextureResidency
+	class TextureStreamer
+	{
+		static constexpr size_t DEFAULT_BUDGET = 256ULL * 1024ULL * 1024ULL;
+		static constexpr size_t MAX_LOADS_PER_FRAME = 4;
+
+		struct Slot
+		{
+			Texture* texture = nullptr;
+			uint32_t generation = 0;
+		};
+
+		struct LoadedMips
+		{
+			uint32_t index;
+			uint32_t generation;
+			uint8_t mip;
+			// Empty when loading failed
+			std::unique_ptr<Surface> surface;
+		};
+
+		bool enabled = true;
+		int budgetMB = static_cast<int>(DEFAULT_BUDGET / (1024ULL * 1024ULL));
+		TextureResidency residency;
+		std::vector<Slot> slots;
+		std::vector<TextureResidency::Request> loads;
+		std::vector<TextureResidency::Request> evictions;
+		std::vector<LoadedMips> uploads;
+		std::mutex loadedMutex;
+		std::vector<LoadedMips> loaded;
+		// Usage is reported by passes that can record in parallel
+		std::mutex usageMutex;
+
+		inline TextureStreamer() noexcept : residency(DEFAULT_BUDGET) {}
+
+	public:
+		TextureStreamer(const TextureStreamer&) = delete;
+		TextureStreamer& operator=(const TextureStreamer&) = delete;
+		~TextureStreamer() = default;
+
+		// Never destroyed, textures kept in Codex can outlive any other static object
+		static TextureStreamer& Get() noexcept;
+
+		inline uint8_t GetResidentMip(uint32_t index) const noexcept { return residency.GetResidentMip(index); }
+		inline void ReportUsage(uint32_t index, float screenSize) noexcept { std::lock_guard<std::mutex> lock(usageMutex); residency.ReportUsage(index, screenSize); }
+
+		// Returns index of streamed texture, only mip tail should be resident after registering
+		uint32_t Register(Texture& texture, const Surface& surface) noexcept;
+		void Unregister(uint32_t index) noexcept;
+		// Uploads finished loads, performs evictions and schedules new loads
+		void Update(Graphics& gfx);
+		void ShowWindow() noexcept;
+	};
+}
\ No newline at end of file
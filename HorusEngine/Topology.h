@@ -14,7 +14,8 @@ namespace GFX::Resource
 		static inline GfxResPtr<Topology> Get(Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type) { return Codex::Resolve<Topology>(gfx, type); }
 		static inline std::string GenerateRID(D3D11_PRIMITIVE_TOPOLOGY type) noexcept { return "T" + std::to_string(type); }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->IASetPrimitiveTopology(type); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->IASetPrimitiveTopology(type); GetBoundState(gfx, PipelineSlot::Topology) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::Topology; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(type); }
 	};
 
@@ -1,20 +1,22 @@
-// Encode normal into modified spherical coordinates
+// Encode normal with octahedral mapping into 0-1 square for R16G16_UNORM target (same as GBuffer::EncodeNormal)
 float2 EncodeNormal(const in float3 normal)
 {
-	/*
-		phi = atan(y/x) (if x=0 then y+100)
-		theta = z
-	*/
-	if (normal.x == 0.0f)
-		return float2(normal.y + 100.0f, normal.z);
-	else
-		return float2(atan2(normal.y, normal.x), normal.z);
+	// Code (0, 0) is reserved for pixels without geometry
+	static const float MIN_CODE = 1.0f / 65535.0f;
+
+	const float2 octahedron = normal.xy / (abs(normal.x) + abs(normal.y) + abs(normal.z));
+	// Lower hemisphere is folded over diagonals of upper one
+	const float2 folded = normal.z >= 0.0f ? octahedron : (1.0f - abs(octahedron.yx)) * (octahedron >= 0.0f ? 1.0f : -1.0f);
+	return max(folded * 0.5f + 0.5f, MIN_CODE);
 }
 
-float GetSampledSpecularPower(const in float specularPower)
+// Pack specular color (already scaled by intensity) and power (before mapping to exponent) for R8G8B8A8_UNORM target
+float4 EncodeSpecular(const in float3 specularColor, const in float specularPower)
 {
-	// https://gamedev.stackexchange.com/questions/74879/specular-map-what-about-the-specular-reflections-highlight-size
-	return pow(2.0f, specularPower * 13.0f);
+	// Max value of color channel (same as GBufferEncoding::SPECULAR_RANGE), brighter specular is clipped
+	static const float SPECULAR_RANGE = 4.0f;
+
+	return float4(saturate(specularColor / SPECULAR_RANGE), saturate(specularPower));
 }
 
 // Get tangent space rotation (not normalized)
@@ -83,8 +85,10 @@ float GetParallaxDepth(const in float2 uv, const in float3 tangentLightDir,
 float3 GetMappedNormal(const in float3x3 TBN, const in float2 texcoord,
 	uniform Texture2D normalMap, uniform SamplerState splr)
 {
-	// Sample normal to tangent space
-	const float3 tangentNormal = normalMap.Sample(splr, texcoord).rgb * 2.0f - 1.0f;
+	// Sample normal to tangent space, Z reconstructed to support two channel (BC5) normal maps
+	float3 tangentNormal;
+	tangentNormal.xy = normalMap.Sample(splr, texcoord).rg * 2.0f - 1.0f;
+	tangentNormal.z = sqrt(saturate(1.0f - dot(tangentNormal.xy, tangentNormal.xy)));
 	// Transform from tangent into world space
 	return normalize(mul(tangentNormal, TBN));
 }
\ No newline at end of file
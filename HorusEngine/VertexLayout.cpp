@@ -33,6 +33,7 @@ namespace GFX::Data
 		return *this;
 	}
 
+#ifdef _WIN32
 	std::vector<D3D11_INPUT_ELEMENT_DESC> VertexLayout::GetDXLayout() const noexcept(!IS_DEBUG)
 	{
 		std::vector<D3D11_INPUT_ELEMENT_DESC> desc;
@@ -41,6 +42,7 @@ namespace GFX::Data
 			desc.emplace_back(e.GetDesc());
 		return desc;
 	}
+#endif
 
 	std::string VertexLayout::GetLayoutCode() const noexcept(!IS_DEBUG)
 	{
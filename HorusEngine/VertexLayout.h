@@ -1,7 +1,12 @@
 #pragma once
 #include "Color.h"
 #include "assimp/scene.h"
+#ifdef _WIN32
 #include <d3d11.h>
+#else
+// Input layouts are created only by Direct3D device, other platforms need just formats of elements
+#include <directx/dxgiformat.h>
+#endif
 #include <vector>
 #include <string>
 
@@ -55,6 +60,7 @@ namespace GFX::Data
 			{
 				static constexpr size_t Exec() noexcept { return sizeof(Desc<Type>::DataType); }
 			};
+#ifdef _WIN32
 			template<VertexLayout::ElementType Type>
 			struct DescGenerate
 			{
@@ -67,6 +73,7 @@ namespace GFX::Data
 					};
 				}
 			};
+#endif
 #pragma endregion
 
 			ElementType type;
@@ -85,7 +92,9 @@ namespace GFX::Data
 			constexpr size_t GetEnd() const noexcept(!IS_DEBUG) { return offset + Size(); }
 			constexpr size_t Size() const noexcept(!IS_DEBUG) { return SizeOf(type); }
 			constexpr const char* GetCode() const noexcept(!IS_DEBUG) { return VertexLayout::Bridge<CodeLookup>(type); }
+#ifdef _WIN32
 			constexpr D3D11_INPUT_ELEMENT_DESC GetDesc() const noexcept(!IS_DEBUG) { return VertexLayout::Bridge<DescGenerate>(type, GetOffset()); }
+#endif
 		};
 
 	private:
@@ -118,7 +127,9 @@ namespace GFX::Data
 		bool Has(ElementType type) const noexcept;
 		const Element& Resolve(ElementType type) const noexcept(!IS_DEBUG);
 		VertexLayout& Append(ElementType type) noexcept(!IS_DEBUG);
+#ifdef _WIN32
 		std::vector<D3D11_INPUT_ELEMENT_DESC> GetDXLayout() const noexcept(!IS_DEBUG);
+#endif
 		std::string GetLayoutCode() const noexcept(!IS_DEBUG);
 
 #pragma region Layout Element Info
@@ -19,7 +19,8 @@ namespace GFX::Resource
 		constexpr const std::string& GetName() const noexcept { return name; }
 		inline ID3DBlob* GetBytecode() const noexcept { return bytecode.Get(); }
 
-		inline void Bind(Graphics& gfx) override { GetContext(gfx)->VSSetShader(vertexShader.Get(), nullptr, 0U); }
+		inline void Bind(Graphics& gfx) override { GetContext(gfx)->VSSetShader(vertexShader.Get(), nullptr, 0U); GetBoundState(gfx, PipelineSlot::VertexShader) = this; }
+		inline PipelineSlot GetPipelineSlot() const noexcept override { return PipelineSlot::VertexShader; }
 		inline std::string GetRID() const noexcept override { return GenerateRID(name); }
 	};
 
@@ -8,19 +8,32 @@ namespace GFX::Resource
 		D3D11_VIEWPORT viewport;
 		unsigned int width;
 		unsigned int height;
+		bool dynamic = false;
 
 	public:
-		constexpr Viewport(Graphics& gfx, unsigned int width, unsigned int height) noexcept;
+		// Offset selects region of target, ex. single tile of shadow atlas
+		constexpr Viewport(Graphics& gfx, unsigned int width, unsigned int height, unsigned int x = 0, unsigned int y = 0) noexcept;
 		virtual ~Viewport() = default;
 
-		static inline GfxResPtr<Viewport> Get(Graphics& gfx, unsigned int width, unsigned int height) { return Codex::Resolve<Viewport>(gfx, width, height); }
-		static inline std::string GenerateRID(unsigned int width, unsigned int height) noexcept;
+		static inline GfxResPtr<Viewport> Get(Graphics& gfx, unsigned int width, unsigned int height, unsigned int x = 0, unsigned int y = 0) { return Codex::Resolve<Viewport>(gfx, width, height, x, y); }
+		// Not shared through codex so it can be scaled for dynamic resolution
+		static inline GfxResPtr<Viewport> MakeDynamic(Graphics& gfx, unsigned int width, unsigned int height);
+		static inline std::string GenerateRID(unsigned int width, unsigned int height, unsigned int x = 0, unsigned int y = 0) noexcept;
 
 		constexpr unsigned int GetWidth() const noexcept { return width; }
 		constexpr unsigned int GetHeight() const noexcept { return height; }
+		// Part of target used after scaling, can differ between axes due to rounding to whole pixels
+		constexpr float GetScaleX() const noexcept { return viewport.Width / static_cast<FLOAT>(width); }
+		constexpr float GetScaleY() const noexcept { return viewport.Height / static_cast<FLOAT>(height); }
+		// Only top left part of target is rendered to, width and height stay unchanged
+		constexpr void SetScale(float scale) noexcept
+		{
+			viewport.Width = static_cast<FLOAT>(static_cast<unsigned int>(scale * width));
+			viewport.Height = static_cast<FLOAT>(static_cast<unsigned int>(scale * height));
+		}
 
 		inline void Bind(Graphics& gfx) override { GetContext(gfx)->RSSetViewports(1U, &viewport); }
-		inline std::string GetRID() const noexcept override { return GenerateRID(width, height); }
+		inline std::string GetRID() const noexcept override { return dynamic ? IBindable::GetNoCodexRID() : GenerateRID(width, height, static_cast<unsigned int>(viewport.TopLeftX), static_cast<unsigned int>(viewport.TopLeftY)); }
 	};
 
 	template<>
@@ -29,19 +42,28 @@ namespace GFX::Resource
 		static constexpr bool generate{ true };
 	};
 
-	constexpr Viewport::Viewport(Graphics& gfx, unsigned int width, unsigned int height) noexcept
+	constexpr Viewport::Viewport(Graphics& gfx, unsigned int width, unsigned int height, unsigned int x, unsigned int y) noexcept
 		: width(width), height(height)
 	{
 		viewport.Width = static_cast<FLOAT>(width);
 		viewport.Height = static_cast<FLOAT>(height);
 		viewport.MinDepth = 0.0f;
 		viewport.MaxDepth = 1.0f;
-		viewport.TopLeftX = 0.0f;
-		viewport.TopLeftY = 0.0f;
+		viewport.TopLeftX = static_cast<FLOAT>(x);
+		viewport.TopLeftY = static_cast<FLOAT>(y);
 	}
 
-	inline std::string Viewport::GenerateRID(unsigned int width, unsigned int height) noexcept
+	inline GfxResPtr<Viewport> Viewport::MakeDynamic(Graphics& gfx, unsigned int width, unsigned int height)
 	{
+		GfxResPtr<Viewport> viewport(gfx, width, height);
+		viewport->dynamic = true;
+		return viewport;
+	}
+
+	inline std::string Viewport::GenerateRID(unsigned int width, unsigned int height, unsigned int x, unsigned int y) noexcept
+	{
+		if (x || y)
+			return "V" + std::to_string(width) + "#" + std::to_string(height) + "#" + std::to_string(x) + "#" + std::to_string(y);
 		return "V" + std::to_string(width) + "#" + std::to_string(height);
 	}
 }
\ No newline at end of file
@@ -204,7 +204,7 @@ namespace WinAPI
 		ClipCursor(&rect);
 	}
 
-	Window::Window(unsigned int width, unsigned int height, const char* name) : wndWidth(width), wndHeight(height)
+	Window::Window(unsigned int width, unsigned int height, const char* name, bool softwareDevice) : wndWidth(width), wndHeight(height)
 	{
 		constexpr DWORD winStyle = WS_CAPTION | WS_MAXIMIZEBOX | WS_MINIMIZEBOX | WS_SYSMENU;
 		constexpr DWORD winStyleEx = 0;
@@ -220,7 +220,7 @@ namespace WinAPI
 		if (hWnd == nullptr)
 			throw WIN_EXCEPT_LAST();
 		ShowWindow(hWnd, SW_SHOW);
-		graphics = std::make_unique<GFX::Graphics>(hWnd, width, height);
+		graphics = std::make_unique<GFX::Graphics>(hWnd, width, height, softwareDevice);
 		ImGui_ImplWin32_Init(hWnd);
 
 		RAWINPUTDEVICE rid;
@@ -47,7 +47,7 @@ namespace WinAPI
 		void TrapCursor() noexcept;
 
 	public:
-		Window(unsigned int width, unsigned int height, const char* name);
+		Window(unsigned int width, unsigned int height, const char* name, bool softwareDevice = false);
 		Window(const Window&) = delete;
 		Window& operator=(const Window&) = delete;
 		~Window();